@@ -0,0 +1,347 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    arena_allocator.h
+
+Abstract:
+
+    A bump allocator for short lived allocations of arbitrary size and
+    alignment which are all freed at once.
+
+    Allocations are carved sequentially out of a single block of memory. If
+    the block is exhausted, a new block at least twice as large is chained in
+    front of it. When the arena is reset, any chained blocks are coalesced
+    into one block large enough to hold everything that was allocated, so once
+    the arena has seen its largest workload allocation and reset are both a
+    pointer bump.
+
+    The arena also tracks the most memory that was ever in use at once, which
+    can be used to size the arena ahead of time.
+
+--*/
+
+#ifndef _COMMON_ARENA_ALLOCATOR_
+#define _COMMON_ARENA_ALLOCATOR_
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common/safe_math.h"
+
+//
+// Defines
+//
+
+#define ARENA_ALLOCATOR_MINIMUM_BLOCK_SIZE 4096
+
+//
+// Types
+//
+
+typedef struct _ARENA_BLOCK {
+    struct _ARENA_BLOCK *previous;
+    size_t capacity;
+    alignas(max_align_t) char data[];
+} ARENA_BLOCK, *PARENA_BLOCK;
+
+typedef struct _ARENA_ALLOCATOR {
+    PARENA_BLOCK block;
+    uintptr_t cursor;
+    uintptr_t end;
+    size_t retired_size;
+    size_t capacity;
+    size_t high_water_mark;
+} ARENA_ALLOCATOR, *PARENA_ALLOCATOR;
+
+typedef const ARENA_ALLOCATOR *PCARENA_ALLOCATOR;
+
+//
+// Static Functions
+//
+
+static
+inline
+size_t
+ArenaAllocatorPadding(
+    _In_ uintptr_t address,
+    _In_ size_t alignment
+    )
+{
+    return (size_t)(-address & (uintptr_t)(alignment - 1));
+}
+
+_Check_return_
+_Success_(return != 0)
+static
+inline
+bool
+ArenaAllocatorAddBlock(
+    _Inout_ PARENA_ALLOCATOR allocator,
+    _In_ size_t minimum_capacity
+    )
+{
+    assert(allocator != NULL);
+
+    size_t capacity = ARENA_ALLOCATOR_MINIMUM_BLOCK_SIZE;
+    while (capacity < minimum_capacity)
+    {
+        bool success = CheckedMultiplySizeT(capacity, 2, &capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+    }
+
+    size_t allocation_size;
+    bool success = CheckedAddSizeT(sizeof(ARENA_BLOCK),
+                                   capacity,
+                                   &allocation_size);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    PARENA_BLOCK block = (PARENA_BLOCK)malloc(allocation_size);
+
+    if (block == NULL)
+    {
+        return false;
+    }
+
+    if (allocator->block != NULL)
+    {
+        allocator->retired_size +=
+            (size_t)(allocator->cursor - (uintptr_t)allocator->block->data);
+    }
+
+    block->previous = allocator->block;
+    block->capacity = capacity;
+
+    allocator->block = block;
+    allocator->cursor = (uintptr_t)block->data;
+    allocator->end = (uintptr_t)block->data + capacity;
+    allocator->capacity += capacity;
+
+    return true;
+}
+
+//
+// Functions
+//
+
+static
+inline
+void
+ArenaAllocatorInitialize(
+    _Out_ PARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    allocator->block = NULL;
+    allocator->cursor = 0;
+    allocator->end = 0;
+    allocator->retired_size = 0;
+    allocator->capacity = 0;
+    allocator->high_water_mark = 0;
+}
+
+_Check_return_
+_Success_(return != 0)
+static
+inline
+bool
+ArenaAllocatorAllocate(
+    _Inout_ PARENA_ALLOCATOR allocator,
+    _In_ _Pre_satisfies_(_Curr_ != 0) size_t size,
+    _In_ _Pre_satisfies_(_Curr_ != 0 && (_Curr_ & (_Curr_ - 1)) == 0) size_t alignment,
+    _Outptr_result_bytebuffer_(size) void **allocation
+    )
+{
+    assert(allocator != NULL);
+    assert(size != 0);
+    assert(alignment != 0);
+    assert((alignment & (alignment - 1)) == 0);
+    assert(allocation != NULL);
+
+    size_t padding = ArenaAllocatorPadding(allocator->cursor, alignment);
+    size_t available = (size_t)(allocator->end - allocator->cursor);
+
+    if (available < padding || available - padding < size)
+    {
+        //
+        // Reserve enough slack to align the allocation within the new block
+        // and at least double the capacity so that growth is geometric.
+        //
+
+        size_t minimum_capacity;
+        bool success = CheckedAddSizeT(size,
+                                       alignment - 1,
+                                       &minimum_capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        if (allocator->block != NULL &&
+            minimum_capacity < allocator->block->capacity * 2)
+        {
+            minimum_capacity = allocator->block->capacity * 2;
+        }
+
+        success = ArenaAllocatorAddBlock(allocator, minimum_capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        padding = ArenaAllocatorPadding(allocator->cursor, alignment);
+    }
+
+    allocator->cursor += padding;
+    *allocation = (void *)allocator->cursor;
+    allocator->cursor += size;
+
+    return true;
+}
+
+static
+inline
+size_t
+ArenaAllocatorGetBytesInUse(
+    _In_ PCARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    if (allocator->block == NULL)
+    {
+        return 0;
+    }
+
+    return allocator->retired_size +
+           (size_t)(allocator->cursor - (uintptr_t)allocator->block->data);
+}
+
+static
+inline
+size_t
+ArenaAllocatorGetHighWaterMark(
+    _In_ PCARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    size_t bytes_in_use = ArenaAllocatorGetBytesInUse(allocator);
+
+    if (allocator->high_water_mark < bytes_in_use)
+    {
+        return bytes_in_use;
+    }
+
+    return allocator->high_water_mark;
+}
+
+static
+inline
+size_t
+ArenaAllocatorGetCapacity(
+    _In_ PCARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    return allocator->capacity;
+}
+
+static
+inline
+void
+ArenaAllocatorFreeAll(
+    _Inout_ PARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    allocator->high_water_mark = ArenaAllocatorGetHighWaterMark(allocator);
+
+    PARENA_BLOCK block = allocator->block;
+
+    if (block == NULL)
+    {
+        return;
+    }
+
+    if (block->previous != NULL)
+    {
+        //
+        // Coalesce the chain into a single block. If that block cannot be
+        // allocated, keep the newest block, which is also the largest.
+        //
+
+        size_t capacity = allocator->capacity;
+
+        PARENA_BLOCK previous = block->previous;
+        while (previous != NULL)
+        {
+            PARENA_BLOCK temp = previous->previous;
+            free(previous);
+            previous = temp;
+        }
+
+        block->previous = NULL;
+        allocator->block = NULL;
+        allocator->capacity = 0;
+
+        bool success = ArenaAllocatorAddBlock(allocator, capacity);
+
+        if (success)
+        {
+            free(block);
+        }
+        else
+        {
+            allocator->block = block;
+            allocator->capacity = block->capacity;
+        }
+
+        block = allocator->block;
+    }
+
+    allocator->cursor = (uintptr_t)block->data;
+    allocator->end = (uintptr_t)block->data + block->capacity;
+    allocator->retired_size = 0;
+}
+
+static
+inline
+void
+ArenaAllocatorDestroy(
+    _Inout_ PARENA_ALLOCATOR allocator
+    )
+{
+    assert(allocator != NULL);
+
+    PARENA_BLOCK block = allocator->block;
+    while (block != NULL)
+    {
+        PARENA_BLOCK temp = block->previous;
+        free(block);
+        block = temp;
+    }
+
+    ArenaAllocatorInitialize(allocator);
+}
+
+#endif // _COMMON_ARENA_ALLOCATOR_
\ No newline at end of file
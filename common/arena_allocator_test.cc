@@ -0,0 +1,150 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    arena_allocator_test.cc
+
+Abstract:
+
+    Unit tests for arena_allocator.h
+
+--*/
+
+extern "C" {
+#include "common/arena_allocator.h"
+}
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+TEST(ArenaAllocatorTest, ArenaAllocatorInitialize)
+{
+    ARENA_ALLOCATOR allocator;
+    ArenaAllocatorInitialize(&allocator);
+    EXPECT_EQ(nullptr, allocator.block);
+    EXPECT_EQ(0u, ArenaAllocatorGetBytesInUse(&allocator));
+    EXPECT_EQ(0u, ArenaAllocatorGetHighWaterMark(&allocator));
+    EXPECT_EQ(0u, ArenaAllocatorGetCapacity(&allocator));
+
+    ArenaAllocatorDestroy(&allocator);
+}
+
+TEST(ArenaAllocatorTest, ArenaAllocatorAllocate)
+{
+    ARENA_ALLOCATOR allocator;
+    ArenaAllocatorInitialize(&allocator);
+
+    std::vector<int *> allocations;
+    for (int i = 0; i < 10000; i++)
+    {
+        int *allocated;
+        ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                           sizeof(int),
+                                           alignof(int),
+                                           (void **)&allocated));
+        *allocated = i;
+        allocations.push_back(allocated);
+    }
+
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_EQ(i, *allocations[i]);
+    }
+
+    EXPECT_EQ(10000u * sizeof(int), ArenaAllocatorGetBytesInUse(&allocator));
+    EXPECT_LE(10000u * sizeof(int), ArenaAllocatorGetCapacity(&allocator));
+
+    ArenaAllocatorDestroy(&allocator);
+}
+
+TEST(ArenaAllocatorTest, ArenaAllocatorAllocateAligned)
+{
+    ARENA_ALLOCATOR allocator;
+    ArenaAllocatorInitialize(&allocator);
+
+    for (size_t alignment = 1; alignment <= 256; alignment *= 2)
+    {
+        void *allocated;
+        ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                           1,
+                                           alignment,
+                                           &allocated));
+        EXPECT_EQ(0u, (uintptr_t)allocated % alignment);
+    }
+
+    void *allocated;
+    ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                       3 * ARENA_ALLOCATOR_MINIMUM_BLOCK_SIZE,
+                                       1024,
+                                       &allocated));
+    EXPECT_EQ(0u, (uintptr_t)allocated % 1024);
+
+    ArenaAllocatorDestroy(&allocator);
+}
+
+TEST(ArenaAllocatorTest, ArenaAllocatorFreeAll)
+{
+    ARENA_ALLOCATOR allocator;
+    ArenaAllocatorInitialize(&allocator);
+
+    ArenaAllocatorFreeAll(&allocator);
+
+    std::set<int *> allocations;
+    for (int i = 0; i < 10000; i++)
+    {
+        int *allocated;
+        ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                           sizeof(int),
+                                           alignof(int),
+                                           (void **)&allocated));
+        allocations.insert(allocated);
+    }
+
+    EXPECT_NE(nullptr, allocator.block->previous);
+    size_t capacity = ArenaAllocatorGetCapacity(&allocator);
+
+    ArenaAllocatorFreeAll(&allocator);
+
+    EXPECT_EQ(nullptr, allocator.block->previous);
+    EXPECT_LE(capacity, ArenaAllocatorGetCapacity(&allocator));
+    EXPECT_EQ(0u, ArenaAllocatorGetBytesInUse(&allocator));
+    EXPECT_EQ(10000u * sizeof(int), ArenaAllocatorGetHighWaterMark(&allocator));
+    capacity = ArenaAllocatorGetCapacity(&allocator);
+
+    std::vector<int *> allocations_in_order;
+    for (int i = 0; i < 10000; i++)
+    {
+        int *allocated;
+        ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                           sizeof(int),
+                                           alignof(int),
+                                           (void **)&allocated));
+        *allocated = i;
+        allocations_in_order.push_back(allocated);
+    }
+
+    EXPECT_EQ(nullptr, allocator.block->previous);
+    EXPECT_EQ(capacity, ArenaAllocatorGetCapacity(&allocator));
+
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_EQ(i, *allocations_in_order[i]);
+    }
+
+    ArenaAllocatorFreeAll(&allocator);
+
+    int *allocated;
+    ASSERT_TRUE(ArenaAllocatorAllocate(&allocator,
+                                       sizeof(int),
+                                       alignof(int),
+                                       (void **)&allocated));
+    EXPECT_EQ(allocations_in_order[0], allocated);
+    EXPECT_EQ(10000u * sizeof(int), ArenaAllocatorGetHighWaterMark(&allocator));
+
+    ArenaAllocatorDestroy(&allocator);
+}
\ No newline at end of file
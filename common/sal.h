@@ -53,6 +53,7 @@ Abstract:
 #define _Out_
 #define _Out_opt_
 #define _Out_writes_(size)
+#define _Out_writes_bytes_(size)
 #define _Out_range_(min, max)
 
 #define _Outptr_
@@ -25,16 +25,40 @@ Abstract:
 // Types
 //
 
+//
+// The leading fields of FULL_HIT_CONTEXT and DEFERRED_HIT_CONTEXT must match so
+// that the hit tester can track the closest hit without knowing which of the
+// two was allocated. A non-NULL finalize_routine marks a deferred hit.
+//
+
 typedef struct _FULL_HIT_CONTEXT {
     HIT hit;
-    HIT_CONTEXT context;
     PDYNAMIC_ALLOCATION allocation_handle;
+    PHIT_FINALIZE_ROUTINE finalize_routine;
     PCMATRIX model_to_world;
     bool premultiplied;
+    HIT_CONTEXT context;
     POINT3 model_hit_point;
     bool model_hit_point_valid;
 } FULL_HIT_CONTEXT, *PFULL_HIT_CONTEXT;
 
 typedef const FULL_HIT_CONTEXT *PCFULL_HIT_CONTEXT;
 
+typedef struct _DEFERRED_HIT_CONTEXT {
+    HIT hit;
+    PDYNAMIC_ALLOCATION allocation_handle;
+    PHIT_FINALIZE_ROUTINE finalize_routine;
+    PCMATRIX model_to_world;
+    bool premultiplied;
+    const void *data;
+    uint32_t front_face;
+    uint32_t back_face;
+    uint32_t primitive;
+    float_t coordinates[2];
+    size_t finalize_data_size;
+    size_t finalize_data_alignment;
+} DEFERRED_HIT_CONTEXT, *PDEFERRED_HIT_CONTEXT;
+
+typedef const DEFERRED_HIT_CONTEXT *PCDEFERRED_HIT_CONTEXT;
+
 #endif // _IRIS_FULL_HIT_CONTEXT_
\ No newline at end of file
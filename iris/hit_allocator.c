@@ -123,6 +123,7 @@ HitAllocatorAllocateInternal(
     }
 
     hit_context->allocation_handle = allocation_handle;
+    hit_context->finalize_routine = NULL;
 
     if (hit_point != NULL)
     {
@@ -211,4 +212,91 @@ HitAllocatorAllocateWithHitPoint(
                                                   hit);
 
     return status;
+}
+
+ISTATUS
+HitAllocatorAllocateDeferred(
+    _Inout_ PHIT_ALLOCATOR allocator,
+    _In_opt_ PHIT next,
+    _In_ float_t distance,
+    _In_ uint32_t front_face,
+    _In_ uint32_t back_face,
+    _In_ uint32_t primitive,
+    _In_ float_t u,
+    _In_ float_t v,
+    _In_ PHIT_FINALIZE_ROUTINE finalize_routine,
+    _In_ size_t additional_data_size,
+    _In_ size_t additional_data_alignment,
+    _Out_ PHIT *hit
+    )
+{
+    if (allocator == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(distance))
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (finalize_routine == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_08;
+    }
+
+    if (additional_data_size == 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_09;
+    }
+
+    if (hit == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_11;
+    }
+
+    if (additional_data_alignment == 0 ||
+        (additional_data_alignment & (additional_data_alignment - 1)) != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_00;
+    }
+
+    if (additional_data_size % additional_data_alignment != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_01;
+    }
+
+    PDEFERRED_HIT_CONTEXT hit_context;
+    PDYNAMIC_ALLOCATION allocation_handle;
+    void *unused_data;
+    bool success = DynamicMemoryAllocatorAllocate(&allocator->allocator,
+                                                  &allocation_handle,
+                                                  sizeof(DEFERRED_HIT_CONTEXT),
+                                                  alignof(DEFERRED_HIT_CONTEXT),
+                                                  (void **)&hit_context,
+                                                  0,
+                                                  0,
+                                                  &unused_data);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    hit_context->hit.next = next;
+    hit_context->hit.distance = distance;
+    hit_context->allocation_handle = allocation_handle;
+    hit_context->finalize_routine = finalize_routine;
+    hit_context->data = allocator->data;
+    hit_context->front_face = front_face;
+    hit_context->back_face = back_face;
+    hit_context->primitive = primitive;
+    hit_context->coordinates[0] = u;
+    hit_context->coordinates[1] = v;
+    hit_context->finalize_data_size = additional_data_size;
+    hit_context->finalize_data_alignment = additional_data_alignment;
+
+    *hit = &hit_context->hit;
+
+    return ISTATUS_SUCCESS;
 }
\ No newline at end of file
@@ -26,6 +26,12 @@ Abstract:
     on. This should only be specified if the hit point must be computed during
     intersection testing and is not worthwhile to specify otherwise.
 
+    Geometry whose additional data is expensive to produce may instead allocate
+    a deferred hit, which records only a primitive index and two coordinates.
+    The additional data is produced by the finalize routine once the closest
+    hit is known, so candidate hits which are later discarded never pay for
+    it. The finalize routine receives the data associated with the hit.
+
     The hits allocated by this allocator are managed by Iris and should not be 
     explicitly freed.
 
@@ -39,6 +45,7 @@ Abstract:
 #include "common/sal.h"
 #include "common/status.h"
 #include "iris/hit.h"
+#include "iris/hit_context.h"
 #include "iris/point.h"
 
 //
@@ -79,4 +86,20 @@ HitAllocatorAllocateWithHitPoint(
     _Out_ PHIT *hit
     );
 
+ISTATUS
+HitAllocatorAllocateDeferred(
+    _Inout_ PHIT_ALLOCATOR allocator,
+    _In_opt_ PHIT next,
+    _In_ float_t distance,
+    _In_ uint32_t front_face,
+    _In_ uint32_t back_face,
+    _In_ uint32_t primitive,
+    _In_ float_t u,
+    _In_ float_t v,
+    _In_ PHIT_FINALIZE_ROUTINE finalize_routine,
+    _In_ size_t additional_data_size,
+    _In_ size_t additional_data_alignment,
+    _Out_ PHIT *hit
+    );
+
 #endif // _IRIS_HIT_ALLOCATOR_
\ No newline at end of file
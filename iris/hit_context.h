@@ -25,11 +25,22 @@ Abstract:
 #endif // __cplusplus
 
 #include "common/sal.h"
+#include "common/status.h"
 
 //
 // Types
 //
 
+typedef
+ISTATUS
+(*PHIT_FINALIZE_ROUTINE)(
+    _In_opt_ const void *data,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    );
+
 typedef struct _HIT_CONTEXT {
     const void *data;
     float_t distance;
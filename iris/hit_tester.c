@@ -44,17 +44,27 @@ HitTesterTestGeometryInternal(
         return ISTATUS_INVALID_ARGUMENT_01;
     }
 
+    //
+    // Consecutive geometry sharing a transform, such as the shapes of an
+    // instance whose matrices were interned, reuses the model space ray.
+    //
+
     PRAY trace_ray;
-    RAY ray_storage;
     if (model_to_world == NULL || premultiplied)
     {
         trace_ray = &hit_tester->world_ray;
     }
     else
     {
-        ray_storage = RayMatrixInverseMultiplyInline(model_to_world,
-                                                     hit_tester->world_ray);
-        trace_ray = &ray_storage;
+        if (hit_tester->model_ray_matrix != model_to_world)
+        {
+            hit_tester->model_ray =
+                RayMatrixInverseMultiplyInline(model_to_world,
+                                               hit_tester->world_ray);
+            hit_tester->model_ray_matrix = model_to_world;
+        }
+
+        trace_ray = &hit_tester->model_ray;
     }
 
     HitAllocatorSetRay(&hit_tester->hit_allocator, trace_ray);
@@ -83,6 +93,10 @@ HitTesterTestGeometryInternal(
         if (hit_tester->minimum_distance <= hit->distance &&
             hit->distance <= hit_tester->maximum_distance)
         {
+            //
+            // Deferred hits share the leading fields written below.
+            //
+
             PFULL_HIT_CONTEXT full_hit_context = (PFULL_HIT_CONTEXT)(void *)hit;
             full_hit_context->model_to_world = model_to_world;
             full_hit_context->premultiplied = premultiplied;
@@ -129,6 +143,27 @@ HitTesterFarthestHitAllowed(
     return ISTATUS_SUCCESS;
 }
 
+ISTATUS
+HitTesterGetTime(
+    _In_ PCHIT_TESTER hit_tester,
+    _Out_ float_t *time
+    )
+{
+    if (hit_tester == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (time == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    *time = hit_tester->time;
+
+    return ISTATUS_SUCCESS;
+}
+
 ISTATUS
 HitTesterTestWorldGeometry(
     _Inout_ PHIT_TESTER hit_tester,
@@ -209,6 +244,30 @@ HitTesterTestGeometry(
     return status;
 }
 
+ISTATUS
+HitTesterTestInterpolatedGeometry(
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ PHIT_TESTER_TEST_GEOMETRY_ROUTINE test_routine,
+    _In_opt_ const void *geometry_data,
+    _In_opt_ const void *hit_data,
+    _In_opt_ PCMATRIX model_to_world0,
+    _In_opt_ PCMATRIX model_to_world1,
+    _In_ float_t weight
+    )
+{
+    ISTATUS status =
+        HitTesterTestInterpolatedGeometryWithLimit(hit_tester,
+                                                   test_routine,
+                                                   geometry_data,
+                                                   hit_data,
+                                                   model_to_world0,
+                                                   model_to_world1,
+                                                   weight,
+                                                   NULL);
+
+    return status;
+}
+
 ISTATUS
 HitTesterTestWorldGeometryWithLimit(
     _Inout_ PHIT_TESTER hit_tester,
@@ -293,6 +352,89 @@ HitTesterTestGeometryWithLimit(
     return status;
 }
 
+ISTATUS
+HitTesterTestInterpolatedGeometryWithLimit(
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ PHIT_TESTER_TEST_GEOMETRY_ROUTINE test_routine,
+    _In_opt_ const void *geometry_data,
+    _In_opt_ const void *hit_data,
+    _In_opt_ PCMATRIX model_to_world0,
+    _In_opt_ PCMATRIX model_to_world1,
+    _In_ float_t weight,
+    _Out_opt_ float_t *maybe_farthest_hit_allowed
+    )
+{
+    if (hit_tester == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (test_routine == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (!isfinite(weight))
+    {
+        return ISTATUS_INVALID_ARGUMENT_06;
+    }
+
+    if (model_to_world0 == model_to_world1)
+    {
+        ISTATUS status =
+            HitTesterTestGeometryInternal(hit_tester,
+                                          test_routine,
+                                          geometry_data,
+                                          hit_data,
+                                          model_to_world0,
+                                          false,
+                                          maybe_farthest_hit_allowed);
+
+        return status;
+    }
+
+    //
+    // The closest hit may reference the interpolated matrix of an earlier
+    // test, so the other of the two slots is overwritten.
+    //
+
+    size_t slot;
+    if (hit_tester->closest_hit->model_to_world ==
+        &hit_tester->interpolated[0][0])
+    {
+        slot = 1;
+    }
+    else
+    {
+        slot = 0;
+    }
+
+    bool success =
+        MatrixInitializeInterpolated(model_to_world0,
+                                     model_to_world1,
+                                     weight,
+                                     &hit_tester->interpolated[slot][0],
+                                     &hit_tester->interpolated[slot][1]);
+
+    if (!success)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    hit_tester->model_ray_matrix = NULL;
+
+    ISTATUS status =
+        HitTesterTestGeometryInternal(hit_tester,
+                                      test_routine,
+                                      geometry_data,
+                                      hit_data,
+                                      &hit_tester->interpolated[slot][0],
+                                      false,
+                                      maybe_farthest_hit_allowed);
+
+    return status;
+}
+
 ISTATUS
 HitTesterTestNestedGeometry(
     _Inout_ PHIT_ALLOCATOR hit_allocator,
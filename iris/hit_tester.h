@@ -32,6 +32,13 @@ Abstract:
     Note, the right thing will happen if the transformation passed in is the 
     identity matrix.
 
+    5) Test against an object which resides in its own coordinate space and
+       whose transformation changes over time. For these objects use
+       HitTesterTestInterpolatedGeometry, passing the transformations at two
+       keyframes and the weight of the second one at the time returned by
+       HitTesterGetTime. The object is tested in the model space of the
+       component-wise interpolation of the two transformations.
+
     There is also one other, related form of hit testing. If an object is nested
     within another object, HitTesterTestNestedGeometry allows for intersection
     testing against the second level object. Iris only supports nested objects
@@ -82,6 +89,12 @@ HitTesterFarthestHitAllowed(
     _Out_ float_t *distance
     );
 
+ISTATUS
+HitTesterGetTime(
+    _In_ PCHIT_TESTER hit_tester,
+    _Out_ float_t *time
+    );
+
 ISTATUS
 HitTesterTestWorldGeometry(
     _Inout_ PHIT_TESTER hit_tester,
@@ -118,6 +131,17 @@ HitTesterTestGeometry(
     _In_ bool premultiplied
     );
 
+ISTATUS
+HitTesterTestInterpolatedGeometry(
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ PHIT_TESTER_TEST_GEOMETRY_ROUTINE test_routine,
+    _In_opt_ const void *geometry_data,
+    _In_opt_ const void *hit_data,
+    _In_opt_ PCMATRIX model_to_world0,
+    _In_opt_ PCMATRIX model_to_world1,
+    _In_ float_t weight
+    );
+
 ISTATUS
 HitTesterTestWorldGeometryWithLimit(
     _Inout_ PHIT_TESTER hit_tester,
@@ -158,6 +182,18 @@ HitTesterTestGeometryWithLimit(
     _Out_opt_ float_t *maybe_farthest_hit_allowed
     );
 
+ISTATUS
+HitTesterTestInterpolatedGeometryWithLimit(
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ PHIT_TESTER_TEST_GEOMETRY_ROUTINE test_routine,
+    _In_opt_ const void *geometry_data,
+    _In_opt_ const void *hit_data,
+    _In_opt_ PCMATRIX model_to_world0,
+    _In_opt_ PCMATRIX model_to_world1,
+    _In_ float_t weight,
+    _Out_opt_ float_t *maybe_farthest_hit_allowed
+    );
+
 ISTATUS
 HitTesterTestNestedGeometry(
     _Inout_ PHIT_ALLOCATOR hit_allocator,
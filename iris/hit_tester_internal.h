@@ -17,6 +17,7 @@ Abstract:
 
 #include "iris/full_hit_context.h"
 #include "iris/hit_allocator_internal.h"
+#include "iris/matrix_internal.h"
 
 //
 // Types
@@ -26,6 +27,10 @@ struct _HIT_TESTER {
     struct _HIT_ALLOCATOR hit_allocator;
     PFULL_HIT_CONTEXT closest_hit;
     RAY world_ray;
+    PCMATRIX model_ray_matrix;
+    RAY model_ray;
+    struct _MATRIX interpolated[2][2];
+    float_t time;
     float_t minimum_distance;
     float_t maximum_distance;
 };
@@ -66,8 +71,12 @@ HitTesterInitialize(
 
     hit_context->hit.distance = INFINITY;
     hit_context->allocation_handle = allocation_handle;
+    hit_context->finalize_routine = NULL;
+    hit_context->model_to_world = NULL;
 
     hit_tester->closest_hit = hit_context;
+    hit_tester->model_ray_matrix = NULL;
+    hit_tester->time = (float_t)0.0;
     hit_tester->minimum_distance = (float_t)0.0;
     hit_tester->maximum_distance = INFINITY;
 
@@ -97,10 +106,91 @@ HitTesterReset(
     hit_tester->closest_hit->hit.distance = INFINITY;
 
     hit_tester->world_ray = world_ray;
+    hit_tester->model_ray_matrix = NULL;
     hit_tester->minimum_distance = minimum_distance;
     hit_tester->maximum_distance = maximum_distance;
 }
 
+static
+inline
+void
+HitTesterSetTime(
+    _Inout_ struct _HIT_TESTER *hit_tester,
+    _In_ float_t time
+    )
+{
+    assert(hit_tester != NULL);
+    assert(isfinite(time));
+
+    hit_tester->time = time;
+}
+
+_Check_return_
+static
+inline
+ISTATUS
+HitTesterFinalizeClosestHit(
+    _Inout_ struct _HIT_TESTER *hit_tester
+    )
+{
+    assert(hit_tester != NULL);
+
+    if (hit_tester->closest_hit->finalize_routine == NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    PCDEFERRED_HIT_CONTEXT closest_hit =
+        (PCDEFERRED_HIT_CONTEXT)(const void *)hit_tester->closest_hit;
+
+    PFULL_HIT_CONTEXT hit_context;
+    PDYNAMIC_ALLOCATION allocation_handle;
+    void *additional_data;
+    bool success = DynamicMemoryAllocatorAllocate(&hit_tester->hit_allocator.allocator,
+                                                  &allocation_handle,
+                                                  sizeof(FULL_HIT_CONTEXT),
+                                                  alignof(FULL_HIT_CONTEXT),
+                                                  (void **)&hit_context,
+                                                  closest_hit->finalize_data_size,
+                                                  closest_hit->finalize_data_alignment,
+                                                  &additional_data);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    ISTATUS status =
+        closest_hit->finalize_routine(closest_hit->data,
+                                      closest_hit->primitive,
+                                      closest_hit->coordinates,
+                                      additional_data,
+                                      closest_hit->finalize_data_size);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    hit_context->hit.next = NULL;
+    hit_context->hit.distance = closest_hit->hit.distance;
+    hit_context->allocation_handle = allocation_handle;
+    hit_context->finalize_routine = NULL;
+    hit_context->model_to_world = closest_hit->model_to_world;
+    hit_context->premultiplied = closest_hit->premultiplied;
+    hit_context->context.data = closest_hit->data;
+    hit_context->context.distance = closest_hit->hit.distance;
+    hit_context->context.front_face = closest_hit->front_face;
+    hit_context->context.back_face = closest_hit->back_face;
+    hit_context->context.additional_data = additional_data;
+    hit_context->context.additional_data_size = closest_hit->finalize_data_size;
+    hit_context->model_hit_point_valid = false;
+
+    hit_tester->closest_hit = hit_context;
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 inline
 void
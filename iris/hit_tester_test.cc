@@ -546,6 +546,135 @@ TEST(HitTesterTest, HitTesterTestTransformedGeometry)
     MatrixRelease(model_to_world);
 }
 
+TEST(HitTesterTest, HitTesterTestTransformedGeometryAfterReset)
+{
+    HIT_TESTER tester;
+    ASSERT_TRUE(HitTesterInitialize(&tester));
+
+    PMATRIX model_to_world;
+    ISTATUS status = MatrixAllocateTranslation((float_t) 1.0,
+                                               (float_t) 2.0,
+                                               (float_t) 3.0,
+                                               &model_to_world);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    bool triggered = false;
+    ValidationParams params;
+    params.minimum_distance = 0.0;
+    params.maximum_distance = INFINITY;
+    params.data = &params;
+    params.status_to_return = ISTATUS_NO_INTERSECTION;
+    params.triggered = &triggered;
+
+    for (int i = 0; i < 2; i++)
+    {
+        POINT3 origin = PointCreate((float_t) 1.0 + (float_t) i,
+                                    (float_t) 2.0,
+                                    (float_t) 3.0);
+        VECTOR3 direction = VectorCreate((float_t) 4.0,
+                                         (float_t) 5.0,
+                                         (float_t) 6.0);
+        RAY ray = RayCreate(origin, direction);
+        params.ray = RayCreate(PointCreate((float_t) i,
+                                           (float_t) 0.0,
+                                           (float_t) 0.0),
+                               direction);
+
+        HitTesterReset(&tester, ray, (float_t)0.0, INFINITY);
+
+        for (int j = 0; j < 2; j++)
+        {
+            triggered = false;
+            status = HitTesterTestTransformedGeometry(&tester,
+                                                      CheckGeometryContext,
+                                                      &params,
+                                                      nullptr,
+                                                      model_to_world);
+            EXPECT_EQ(ISTATUS_SUCCESS, status);
+            EXPECT_TRUE(triggered);
+        }
+    }
+
+    HitTesterDestroy(&tester);
+    MatrixRelease(model_to_world);
+}
+
+TEST(HitTesterTest, HitTesterTestInterpolatedGeometry)
+{
+    HIT_TESTER tester;
+    ASSERT_TRUE(HitTesterInitialize(&tester));
+
+    float_t time;
+    EXPECT_EQ(ISTATUS_SUCCESS, HitTesterGetTime(&tester, &time));
+    EXPECT_EQ((float_t) 0.0, time);
+
+    HitTesterSetTime(&tester, (float_t) 0.25);
+    EXPECT_EQ(ISTATUS_SUCCESS, HitTesterGetTime(&tester, &time));
+    EXPECT_EQ((float_t) 0.25, time);
+
+    PMATRIX model_to_world0;
+    ISTATUS status = MatrixAllocateTranslation((float_t) 1.0,
+                                               (float_t) 2.0,
+                                               (float_t) 3.0,
+                                               &model_to_world0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PMATRIX model_to_world1;
+    status = MatrixAllocateTranslation((float_t) 3.0,
+                                       (float_t) 2.0,
+                                       (float_t) 1.0,
+                                       &model_to_world1);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    POINT3 origin = PointCreate((float_t) 1.0, (float_t) 2.0, (float_t) 3.0);
+    VECTOR3 direction = VectorCreate((float_t) 4.0,
+                                     (float_t) 5.0,
+                                     (float_t) 6.0);
+    RAY ray = RayCreate(origin, direction);
+
+    bool triggered = false;
+    ValidationParams params;
+    params.ray = RayCreate(PointCreate((float_t) -1.0,
+                                       (float_t) 0.0,
+                                       (float_t) 1.0),
+                           direction);
+    params.minimum_distance = 0.0;
+    params.maximum_distance = INFINITY;
+    params.data = &params;
+    params.status_to_return = ISTATUS_NO_INTERSECTION;
+    params.triggered = &triggered;
+
+    HitTesterReset(&tester, ray, (float_t)0.0, INFINITY);
+    status = HitTesterTestInterpolatedGeometry(&tester,
+                                               CheckGeometryContext,
+                                               &params,
+                                               nullptr,
+                                               model_to_world0,
+                                               model_to_world1,
+                                               (float_t) 0.5);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_TRUE(triggered);
+
+    triggered = false;
+    params.ray = RayCreate(PointCreate((float_t) -2.0,
+                                       (float_t) 0.0,
+                                       (float_t) 2.0),
+                           direction);
+    status = HitTesterTestInterpolatedGeometry(&tester,
+                                               CheckGeometryContext,
+                                               &params,
+                                               nullptr,
+                                               model_to_world0,
+                                               model_to_world1,
+                                               (float_t) 1.0);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_TRUE(triggered);
+
+    HitTesterDestroy(&tester);
+    MatrixRelease(model_to_world0);
+    MatrixRelease(model_to_world1);
+}
+
 ISTATUS
 AllocateHitAtDistanceCheckMaximumDistance(
     _In_opt_ const void *data, 
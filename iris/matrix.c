@@ -36,6 +36,46 @@ struct _INVERTIBLE_MATRIX {
 // Static Functions
 //
 
+static
+inline
+bool
+Float4x4IsAffine(
+    _In_ const float_t m[4][4]
+    )
+{
+    return m[3][0] == (float_t)0.0 &&
+           m[3][1] == (float_t)0.0 &&
+           m[3][2] == (float_t)0.0 &&
+           m[3][3] == (float_t)1.0;
+}
+
+static
+void
+InvertibleMatrixInitializeAffine(
+    _Inout_ PINVERTIBLE_MATRIX matrix
+    )
+{
+    assert(matrix != NULL);
+
+    matrix->matrix.affine = Float4x4IsAffine(matrix->matrix.m);
+
+    //
+    // The inverse of an affine matrix is affine. Snap away any rounding error
+    // left in the bottom row of the computed inverse so that it can use the
+    // affine multiply routines as well.
+    //
+
+    if (matrix->matrix.affine)
+    {
+        matrix->inverse.m[3][0] = (float_t)0.0;
+        matrix->inverse.m[3][1] = (float_t)0.0;
+        matrix->inverse.m[3][2] = (float_t)0.0;
+        matrix->inverse.m[3][3] = (float_t)1.0;
+    }
+
+    matrix->inverse.affine = Float4x4IsAffine(matrix->inverse.m);
+}
+
 static
 ISTATUS
 Float4x4InverseInitialize(
@@ -268,6 +308,8 @@ InvertibleMatrixInitialize(
     matrix->matrix.inverse = &matrix->inverse;
     matrix->matrix.invertible_matrix = matrix;
 
+    InvertibleMatrixInitializeAffine(matrix);
+
     matrix->reference_count = 1;
 
     return ISTATUS_SUCCESS;
@@ -385,6 +427,8 @@ InvertibleMatrixInitializeFromValues(
     matrix->inverse.inverse = &matrix->matrix;
     matrix->inverse.invertible_matrix = matrix;
 
+    InvertibleMatrixInitializeAffine(matrix);
+
     matrix->reference_count = 1;
 }
 
@@ -482,6 +526,72 @@ MatrixAllocateFromValues(
     return ISTATUS_SUCCESS;
 }
 
+//
+// Extern Functions
+//
+
+bool
+MatrixInitializeInterpolated(
+    _In_opt_ const struct _MATRIX *matrix0,
+    _In_opt_ const struct _MATRIX *matrix1,
+    _In_ float_t weight,
+    _Out_ struct _MATRIX *matrix,
+    _Out_ struct _MATRIX *inverse
+    )
+{
+    assert(isfinite(weight));
+    assert(matrix != NULL);
+    assert(inverse != NULL);
+
+    float_t contents0[4][4];
+    ISTATUS status = MatrixReadContents(matrix0, contents0);
+    assert(status == ISTATUS_SUCCESS);
+
+    float_t contents1[4][4];
+    status = MatrixReadContents(matrix1, contents1);
+    assert(status == ISTATUS_SUCCESS);
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            matrix->m[i][j] = fma(weight,
+                                  contents1[i][j] - contents0[i][j],
+                                  contents0[i][j]);
+        }
+    }
+
+    status = Float4x4InverseInitialize(
+        matrix->m[0][0], matrix->m[0][1], matrix->m[0][2], matrix->m[0][3],
+        matrix->m[1][0], matrix->m[1][1], matrix->m[1][2], matrix->m[1][3],
+        matrix->m[2][0], matrix->m[2][1], matrix->m[2][2], matrix->m[2][3],
+        matrix->m[3][0], matrix->m[3][1], matrix->m[3][2], matrix->m[3][3],
+        inverse->m);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    matrix->inverse = inverse;
+    matrix->invertible_matrix = NULL;
+    matrix->affine = Float4x4IsAffine(matrix->m);
+
+    if (matrix->affine)
+    {
+        inverse->m[3][0] = (float_t)0.0;
+        inverse->m[3][1] = (float_t)0.0;
+        inverse->m[3][2] = (float_t)0.0;
+        inverse->m[3][3] = (float_t)1.0;
+    }
+
+    inverse->inverse = matrix;
+    inverse->invertible_matrix = NULL;
+    inverse->affine = Float4x4IsAffine(inverse->m);
+
+    return true;
+}
+
 //
 // Public Functions
 //
@@ -1244,6 +1354,19 @@ MatrixReadContents(
     return ISTATUS_SUCCESS;
 }
 
+bool
+MatrixIsTransient(
+    _In_opt_ PCMATRIX matrix
+    )
+{
+    if (matrix == NULL)
+    {
+        return false;
+    }
+
+    return matrix->invertible_matrix == NULL;
+}
+
 void
 MatrixRetain(
     _In_opt_ PMATRIX matrix
@@ -15,6 +15,8 @@ Abstract:
 #ifndef _IRIS_MATRIX_
 #define _IRIS_MATRIX_
 
+#include <stdbool.h>
+
 #if __cplusplus 
 #include <math.h>
 #else
@@ -127,6 +129,17 @@ MatrixReadContents(
     _Out_writes_(4) float_t contents[4][4]
     );
 
+//
+// Returns true if matrix is only valid for the duration of the callback which
+// provided it, as is the case for transformations interpolated during hit
+// testing. Transient matrices must not be retained or stored.
+//
+
+bool
+MatrixIsTransient(
+    _In_opt_ PCMATRIX matrix
+    );
+
 void
 MatrixRetain(
     _In_opt_ PMATRIX matrix
@@ -15,6 +15,7 @@ Abstract:
 #ifndef _IRIS_MATRIX_INTERNAL_
 #define _IRIS_MATRIX_INTERNAL_
 
+#include <stdbool.h>
 #include <tgmath.h>
 
 //
@@ -28,6 +29,30 @@ struct _MATRIX {
     float_t m[4][4];
     struct _MATRIX *inverse;
     PINVERTIBLE_MATRIX invertible_matrix;
+    bool affine;
 };
 
+//
+// Extern Functions
+//
+
+//
+// Initializes matrix to the component-wise interpolation of matrix0 and
+// matrix1 and inverse to its inverse. The results are not reference counted
+// and must not be retained or released. Returns false if the interpolated
+// matrix is not invertible.
+//
+
+_Check_return_
+_Success_(return != 0)
+extern
+bool
+MatrixInitializeInterpolated(
+    _In_opt_ const struct _MATRIX *matrix0,
+    _In_opt_ const struct _MATRIX *matrix1,
+    _In_ float_t weight,
+    _Out_ struct _MATRIX *matrix,
+    _Out_ struct _MATRIX *inverse
+    );
+
 #endif // _IRIS_MATRIX_INTERNAL_
\ No newline at end of file
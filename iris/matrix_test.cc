@@ -730,4 +730,21 @@ TEST(MatrixTest, MatrixReadContents)
     EXPECT_EQ((float_t) 14.0, contents[3][1]);
     EXPECT_EQ((float_t) 15.0, contents[3][2]);
     EXPECT_EQ((float_t) 1.0, contents[3][3]);
+}
+
+TEST(MatrixTest, MatrixIsTransient)
+{
+    EXPECT_FALSE(MatrixIsTransient(nullptr));
+
+    PMATRIX matrix;
+    ISTATUS status = MatrixAllocateTranslation((float_t) 1.0,
+                                               (float_t) 2.0,
+                                               (float_t) 3.0,
+                                               &matrix);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    EXPECT_FALSE(MatrixIsTransient(matrix));
+    EXPECT_FALSE(MatrixIsTransient(MatrixGetConstantInverse(matrix)));
+
+    MatrixRelease(matrix);
 }
\ No newline at end of file
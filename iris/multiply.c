@@ -14,6 +14,8 @@ Abstract:
 
 #include "iris/multiply.h"
 
+#include <string.h>
+
 #include "iris/multiply_internal.h"
 
 VECTOR3
@@ -126,4 +128,202 @@ RayMatrixInverseMultiply(
     }
 
     return RayMatrixInverseMultiplyInline(matrix, ray);
+}
+
+ISTATUS
+VectorMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const VECTOR3 vectors[],
+    _In_ size_t count,
+    _Out_writes_(count) VECTOR3 results[]
+    )
+{
+    if (vectors == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, vectors, sizeof(VECTOR3) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    VectorMatrixMultiplyBatchInline(matrix, vectors, count, results);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+VectorMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const VECTOR3 vectors[],
+    _In_ size_t count,
+    _Out_writes_(count) VECTOR3 results[]
+    )
+{
+    if (vectors == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, vectors, sizeof(VECTOR3) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    VectorMatrixMultiplyBatchInline(matrix->inverse, vectors, count, results);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+PointMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) POINT3 results[]
+    )
+{
+    if (points == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, points, sizeof(POINT3) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    PointMatrixMultiplyBatchInline(matrix, points, count, results);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+PointMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) POINT3 results[]
+    )
+{
+    if (points == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, points, sizeof(POINT3) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    PointMatrixMultiplyBatchInline(matrix->inverse, points, count, results);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+RayMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const RAY rays[],
+    _In_ size_t count,
+    _Out_writes_(count) RAY results[]
+    )
+{
+    if (rays == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, rays, sizeof(RAY) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    RayMatrixMultiplyBatchInline(matrix, rays, count, results);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+RayMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const RAY rays[],
+    _In_ size_t count,
+    _Out_writes_(count) RAY results[]
+    )
+{
+    if (rays == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (results == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (matrix == NULL)
+    {
+        if (count != 0)
+        {
+            memmove(results, rays, sizeof(RAY) * count);
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    RayMatrixMultiplyBatchInline(matrix->inverse, rays, count, results);
+
+    return ISTATUS_SUCCESS;
 }
\ No newline at end of file
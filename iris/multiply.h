@@ -15,6 +15,7 @@ Abstract:
 #ifndef _IRIS_MULTIPLY_
 #define _IRIS_MULTIPLY_
 
+#include "common/status.h"
 #include "iris/matrix.h"
 #include "iris/ray.h"
 
@@ -66,4 +67,52 @@ RayMatrixInverseMultiply(
     _In_ RAY ray
     );
 
+ISTATUS
+VectorMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const VECTOR3 vectors[],
+    _In_ size_t count,
+    _Out_writes_(count) VECTOR3 results[]
+    );
+
+ISTATUS
+VectorMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const VECTOR3 vectors[],
+    _In_ size_t count,
+    _Out_writes_(count) VECTOR3 results[]
+    );
+
+ISTATUS
+PointMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) POINT3 results[]
+    );
+
+ISTATUS
+PointMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) POINT3 results[]
+    );
+
+ISTATUS
+RayMatrixMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const RAY rays[],
+    _In_ size_t count,
+    _Out_writes_(count) RAY results[]
+    );
+
+ISTATUS
+RayMatrixInverseMultiplyBatch(
+    _In_opt_ PCMATRIX matrix,
+    _In_reads_(count) const RAY rays[],
+    _In_ size_t count,
+    _Out_writes_(count) RAY results[]
+    );
+
 #endif // _IRIS_MULTIPLY_
\ No newline at end of file
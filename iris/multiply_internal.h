@@ -143,6 +143,11 @@ PointMatrixMultiplyInline(
                 matrix->m[2][2] * point.z +
                 matrix->m[2][3];
 
+    if (matrix->affine)
+    {
+        return PointCreate(x, y, z);
+    }
+
     float_t w = matrix->m[3][0] * point.x +
                 matrix->m[3][1] * point.y +
                 matrix->m[3][2] * point.z +
@@ -194,4 +199,140 @@ RayMatrixInverseMultiplyInline(
     return RayMatrixMultiplyInline(matrix->inverse, ray);
 }
 
+static
+inline
+void
+VectorMatrixMultiplyBatchInline(
+    _In_ const struct _MATRIX *matrix,
+    _In_reads_(count) const VECTOR3 vectors[],
+    _In_ size_t count,
+    _Out_writes_(count) VECTOR3 results[]
+    )
+{
+    assert(matrix != NULL);
+    assert(vectors != NULL || count == 0);
+    assert(results != NULL || count == 0);
+
+    float_t m00 = matrix->m[0][0];
+    float_t m01 = matrix->m[0][1];
+    float_t m02 = matrix->m[0][2];
+    float_t m10 = matrix->m[1][0];
+    float_t m11 = matrix->m[1][1];
+    float_t m12 = matrix->m[1][2];
+    float_t m20 = matrix->m[2][0];
+    float_t m21 = matrix->m[2][1];
+    float_t m22 = matrix->m[2][2];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        VECTOR3 vector = vectors[i];
+        float_t x = m00 * vector.x + m01 * vector.y + m02 * vector.z;
+        float_t y = m10 * vector.x + m11 * vector.y + m12 * vector.z;
+        float_t z = m20 * vector.x + m21 * vector.y + m22 * vector.z;
+        results[i] = VectorCreate(x, y, z);
+    }
+}
+
+static
+inline
+void
+PointMatrixMultiplyBatchInline(
+    _In_ const struct _MATRIX *matrix,
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) POINT3 results[]
+    )
+{
+    assert(matrix != NULL);
+    assert(points != NULL || count == 0);
+    assert(results != NULL || count == 0);
+
+    if (!matrix->affine)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = PointMatrixMultiplyInline(matrix, points[i]);
+        }
+
+        return;
+    }
+
+    float_t m00 = matrix->m[0][0];
+    float_t m01 = matrix->m[0][1];
+    float_t m02 = matrix->m[0][2];
+    float_t m03 = matrix->m[0][3];
+    float_t m10 = matrix->m[1][0];
+    float_t m11 = matrix->m[1][1];
+    float_t m12 = matrix->m[1][2];
+    float_t m13 = matrix->m[1][3];
+    float_t m20 = matrix->m[2][0];
+    float_t m21 = matrix->m[2][1];
+    float_t m22 = matrix->m[2][2];
+    float_t m23 = matrix->m[2][3];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        POINT3 point = points[i];
+        float_t x = m00 * point.x + m01 * point.y + m02 * point.z + m03;
+        float_t y = m10 * point.x + m11 * point.y + m12 * point.z + m13;
+        float_t z = m20 * point.x + m21 * point.y + m22 * point.z + m23;
+        results[i] = PointCreate(x, y, z);
+    }
+}
+
+static
+inline
+void
+RayMatrixMultiplyBatchInline(
+    _In_ const struct _MATRIX *matrix,
+    _In_reads_(count) const RAY rays[],
+    _In_ size_t count,
+    _Out_writes_(count) RAY results[]
+    )
+{
+    assert(matrix != NULL);
+    assert(rays != NULL || count == 0);
+    assert(results != NULL || count == 0);
+
+    if (!matrix->affine)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = RayMatrixMultiplyInline(matrix, rays[i]);
+        }
+
+        return;
+    }
+
+    float_t m00 = matrix->m[0][0];
+    float_t m01 = matrix->m[0][1];
+    float_t m02 = matrix->m[0][2];
+    float_t m03 = matrix->m[0][3];
+    float_t m10 = matrix->m[1][0];
+    float_t m11 = matrix->m[1][1];
+    float_t m12 = matrix->m[1][2];
+    float_t m13 = matrix->m[1][3];
+    float_t m20 = matrix->m[2][0];
+    float_t m21 = matrix->m[2][1];
+    float_t m22 = matrix->m[2][2];
+    float_t m23 = matrix->m[2][3];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        POINT3 origin = rays[i].origin;
+        VECTOR3 direction = rays[i].direction;
+
+        float_t ox = m00 * origin.x + m01 * origin.y + m02 * origin.z + m03;
+        float_t oy = m10 * origin.x + m11 * origin.y + m12 * origin.z + m13;
+        float_t oz = m20 * origin.x + m21 * origin.y + m22 * origin.z + m23;
+
+        float_t dx = m00 * direction.x + m01 * direction.y + m02 * direction.z;
+        float_t dy = m10 * direction.x + m11 * direction.y + m12 * direction.z;
+        float_t dz = m20 * direction.x + m21 * direction.y + m22 * direction.z;
+
+        results[i] = RayCreate(PointCreate(ox, oy, oz),
+                               VectorCreate(dx, dy, dz));
+    }
+}
+
 #endif // _IRIS_MULTIPLY_INTERNAL_
\ No newline at end of file
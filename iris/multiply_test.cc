@@ -255,5 +255,144 @@ TEST(MultiplyTest, RayMatrixInverseMultiply)
     RAY expected = RayMatrixMultiply(inverse, ray);
 
     EXPECT_EQ(expected, actual);
+    MatrixRelease(m0);
+}
+
+TEST(MultiplyTest, PointMatrixMultiplyBatchErrors)
+{
+    POINT3 points[1];
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01,
+              PointMatrixMultiplyBatch(nullptr, nullptr, 1, points));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_03,
+              PointMatrixMultiplyBatch(nullptr, points, 1, nullptr));
+    EXPECT_EQ(ISTATUS_SUCCESS,
+              PointMatrixMultiplyBatch(nullptr, nullptr, 0, nullptr));
+}
+
+TEST(MultiplyTest, PointMatrixMultiplyBatchNull)
+{
+    POINT3 points[] = {
+        PointCreate((float_t) 4.0, (float_t) 3.0, (float_t) 2.0),
+        PointCreate((float_t) 1.0, (float_t) 2.0, (float_t) 3.0)
+    };
+
+    POINT3 results[2];
+    ISTATUS status = PointMatrixMultiplyBatch(nullptr, points, 2, results);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    EXPECT_EQ(points[0], results[0]);
+    EXPECT_EQ(points[1], results[1]);
+}
+
+TEST(MultiplyTest, PointMatrixMultiplyBatch)
+{
+    PMATRIX projective;
+    ISTATUS status = MatrixAllocate(
+        (float_t) 1.0, (float_t) 2.0, (float_t) 3.0, (float_t) 4.0,
+        (float_t) 5.0, (float_t) 1.0, (float_t) 7.0, (float_t) 8.0,
+        (float_t) 9.0, (float_t) 10.0, (float_t) 1.0, (float_t) 12.0,
+        (float_t) 13.0, (float_t) 14.0, (float_t) 15.0, (float_t) 1.0,
+        &projective);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PMATRIX affine;
+    status = MatrixAllocate(
+        (float_t) 1.0, (float_t) 2.0, (float_t) 3.0, (float_t) 4.0,
+        (float_t) 5.0, (float_t) 1.0, (float_t) 7.0, (float_t) 8.0,
+        (float_t) 9.0, (float_t) 10.0, (float_t) 1.0, (float_t) 12.0,
+        (float_t) 0.0, (float_t) 0.0, (float_t) 0.0, (float_t) 1.0,
+        &affine);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    POINT3 points[] = {
+        PointCreate((float_t) 4.0, (float_t) 3.0, (float_t) 2.0),
+        PointCreate((float_t) 1.0, (float_t) 2.0, (float_t) 3.0),
+        PointCreate((float_t) -1.0, (float_t) 0.5, (float_t) 7.0)
+    };
+
+    PMATRIX matrices[] = { projective, affine };
+    for (PMATRIX matrix : matrices)
+    {
+        POINT3 results[3];
+        status = PointMatrixMultiplyBatch(matrix, points, 3, results);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(PointMatrixMultiply(matrix, points[i]), results[i]);
+        }
+
+        status = PointMatrixInverseMultiplyBatch(matrix, points, 3, results);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(PointMatrixInverseMultiply(matrix, points[i]),
+                      results[i]);
+        }
+    }
+
+    MatrixRelease(projective);
+    MatrixRelease(affine);
+}
+
+TEST(MultiplyTest, VectorMatrixMultiplyBatch)
+{
+    PMATRIX m0;
+    ISTATUS status = MatrixAllocate(
+        (float_t) 1.0, (float_t) 2.0, (float_t) 3.0, (float_t) 4.0,
+        (float_t) 5.0, (float_t) 1.0, (float_t) 7.0, (float_t) 8.0,
+        (float_t) 9.0, (float_t) 10.0, (float_t) 1.0, (float_t) 12.0,
+        (float_t) 0.0, (float_t) 0.0, (float_t) 0.0, (float_t) 1.0,
+        &m0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    VECTOR3 vectors[] = {
+        VectorCreate((float_t) 4.0, (float_t) 3.0, (float_t) 2.0),
+        VectorCreate((float_t) 1.0, (float_t) 2.0, (float_t) 3.0)
+    };
+
+    VECTOR3 results[2];
+    status = VectorMatrixMultiplyBatch(m0, vectors, 2, results);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(VectorMatrixMultiply(m0, vectors[0]), results[0]);
+    EXPECT_EQ(VectorMatrixMultiply(m0, vectors[1]), results[1]);
+
+    status = VectorMatrixInverseMultiplyBatch(m0, vectors, 2, results);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(VectorMatrixInverseMultiply(m0, vectors[0]), results[0]);
+    EXPECT_EQ(VectorMatrixInverseMultiply(m0, vectors[1]), results[1]);
+
+    MatrixRelease(m0);
+}
+
+TEST(MultiplyTest, RayMatrixMultiplyBatch)
+{
+    PMATRIX m0;
+    ISTATUS status = MatrixAllocateTranslation(
+        (float_t) 1.0, (float_t) 2.0, (float_t) 3.0, &m0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    RAY rays[] = {
+        RayCreate(PointCreate((float_t) 4.0, (float_t) 3.0, (float_t) 2.0),
+                  VectorCreate((float_t) 1.0, (float_t) 0.0, (float_t) 0.0)),
+        RayCreate(PointCreate((float_t) 1.0, (float_t) 2.0, (float_t) 3.0),
+                  VectorCreate((float_t) 0.0, (float_t) 1.0, (float_t) 1.0))
+    };
+
+    RAY results[2];
+    status = RayMatrixMultiplyBatch(m0, rays, 2, results);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(RayMatrixMultiply(m0, rays[0]), results[0]);
+    EXPECT_EQ(RayMatrixMultiply(m0, rays[1]), results[1]);
+
+    RAY expected0 = RayMatrixInverseMultiply(m0, rays[0]);
+    RAY expected1 = RayMatrixInverseMultiply(m0, rays[1]);
+
+    status = RayMatrixInverseMultiplyBatch(m0, rays, 2, rays);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(expected0, rays[0]);
+    EXPECT_EQ(expected1, rays[1]);
+
     MatrixRelease(m0);
 }
\ No newline at end of file
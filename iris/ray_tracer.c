@@ -203,6 +203,27 @@ RayTracerAllocate(
     return ISTATUS_SUCCESS;
 }
 
+ISTATUS
+RayTracerSetTime(
+    _Inout_ PRAY_TRACER ray_tracer,
+    _In_ float_t time
+    )
+{
+    if (ray_tracer == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(time))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    HitTesterSetTime(&ray_tracer->hit_tester, time);
+
+    return ISTATUS_SUCCESS;
+}
+
 ISTATUS
 RayTracerTraceClosestHit(
     _Inout_ PRAY_TRACER ray_tracer,
@@ -229,12 +250,21 @@ RayTracerTraceClosestHit(
         return status;
     }
 
-    PCFULL_HIT_CONTEXT closest = ray_tracer->hit_tester.closest_hit;
-    if (closest->hit.distance != INFINITY)
+    if (ray_tracer->hit_tester.closest_hit->hit.distance == INFINITY)
     {
-        status = process_hit_routine(process_hit_context, &closest->context);
+        return ISTATUS_SUCCESS;
     }
 
+    status = HitTesterFinalizeClosestHit(&ray_tracer->hit_tester);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    PCFULL_HIT_CONTEXT closest = ray_tracer->hit_tester.closest_hit;
+    status = process_hit_routine(process_hit_context, &closest->context);
+
     return status;
 }
 
@@ -264,15 +294,24 @@ RayTracerTraceClosestHitWithCoordinates(
         return status;
     }
 
-    PCFULL_HIT_CONTEXT closest = ray_tracer->hit_tester.closest_hit;
-    if (closest->hit.distance != INFINITY)
+    if (ray_tracer->hit_tester.closest_hit->hit.distance == INFINITY)
     {
-        status = RayTracerProcessHitWithContext(ray,
-                                                closest,
-                                                process_hit_routine,
-                                                process_hit_context);
+        return ISTATUS_SUCCESS;
     }
 
+    status = HitTesterFinalizeClosestHit(&ray_tracer->hit_tester);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    PCFULL_HIT_CONTEXT closest = ray_tracer->hit_tester.closest_hit;
+    status = RayTracerProcessHitWithContext(ray,
+                                            closest,
+                                            process_hit_routine,
+                                            process_hit_context);
+
     return status;
 }
 
@@ -61,6 +61,12 @@ RayTracerAllocate(
     _Out_ PRAY_TRACER *ray_tracer
     );
 
+ISTATUS
+RayTracerSetTime(
+    _Inout_ PRAY_TRACER ray_tracer,
+    _In_ float_t time
+    );
+
 ISTATUS
 RayTracerTraceClosestHit(
     _Inout_ PRAY_TRACER ray_tracer,
@@ -741,4 +741,202 @@ TEST(RayTracerTest, RayTracerTraceClosestHitWithCoordinates)
 
     RayTracerFree(ray_tracer);
     FreeGeometryData(&geometry_data);
+}
+
+static
+ISTATUS
+FinalizeDeferredHitRoutine(
+    _In_opt_ const void *data,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    )
+{
+    auto finalized = static_cast<size_t*>(const_cast<void*>(data));
+    *finalized += 1;
+
+    EXPECT_EQ(3u * sizeof(float_t), additional_data_size);
+    float_t *values = static_cast<float_t*>(additional_data);
+    values[0] = (float_t)primitive;
+    values[1] = coordinates[0];
+    values[2] = coordinates[1];
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+AllocateDeferredHitRoutine(
+    _In_opt_ const void *data,
+    _In_ PCRAY ray,
+    _In_ float_t minimum_distance,
+    _In_ float_t maximum_distance,
+    _Inout_ PHIT_ALLOCATOR hit_allocator,
+    _Out_ PHIT *hits
+    )
+{
+    PHIT next = nullptr;
+    for (uint32_t i = 3; i > 0; i--)
+    {
+        ISTATUS status = HitAllocatorAllocateDeferred(hit_allocator,
+                                                      next,
+                                                      (float_t)i,
+                                                      i,
+                                                      i,
+                                                      i + 10,
+                                                      (float_t)i * (float_t)0.25,
+                                                      (float_t)i * (float_t)0.125,
+                                                      FinalizeDeferredHitRoutine,
+                                                      3 * sizeof(float_t),
+                                                      alignof(float_t),
+                                                      &next);
+        EXPECT_EQ(ISTATUS_SUCCESS, status);
+    }
+
+    *hits = next;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TraceSceneRoutineDeferred(
+    _In_opt_ const void *context,
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    ISTATUS status = HitTesterTestWorldGeometry(hit_tester,
+                                                AllocateDeferredHitRoutine,
+                                                nullptr,
+                                                context);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+ProcessDeferredHitRoutine(
+    _Inout_opt_ void *context,
+    _In_ PCHIT_CONTEXT hit_context
+    )
+{
+    auto hits_processed = static_cast<size_t*>(context);
+    *hits_processed += 1;
+
+    EXPECT_EQ((float_t)2.0, hit_context->distance);
+    EXPECT_EQ(2u, hit_context->front_face);
+    EXPECT_EQ(2u, hit_context->back_face);
+    EXPECT_EQ(3u * sizeof(float_t), hit_context->additional_data_size);
+
+    const float_t *values =
+        static_cast<const float_t*>(hit_context->additional_data);
+    EXPECT_EQ((float_t)12.0, values[0]);
+    EXPECT_EQ((float_t)0.5, values[1]);
+    EXPECT_EQ((float_t)0.25, values[2]);
+
+    return ISTATUS_SUCCESS;
+}
+
+TEST(RayTracerTest, RayTracerTraceClosestHitDeferred)
+{
+    PRAY_TRACER ray_tracer;
+    EXPECT_EQ(ISTATUS_SUCCESS, RayTracerAllocate(&ray_tracer));
+
+    RAY ray = CreateWorldRay();
+
+    size_t finalized = 0;
+    size_t hits_processed = 0;
+    ISTATUS status = RayTracerTraceClosestHit(ray_tracer,
+                                              ray,
+                                              (float_t)1.5,
+                                              INFINITY,
+                                              TraceSceneRoutineDeferred,
+                                              &finalized,
+                                              ProcessDeferredHitRoutine,
+                                              &hits_processed);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(1u, finalized);
+    EXPECT_EQ(1u, hits_processed);
+
+    RayTracerFree(ray_tracer);
+}
+
+struct DeferredTransformedData {
+    size_t finalized;
+    PMATRIX matrix;
+};
+
+static
+ISTATUS
+TraceSceneRoutineDeferredTransformed(
+    _In_opt_ const void *context,
+    _Inout_ PHIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    auto data = static_cast<const DeferredTransformedData*>(context);
+    ISTATUS status = HitTesterTestGeometry(hit_tester,
+                                           AllocateDeferredHitRoutine,
+                                           nullptr,
+                                           &data->finalized,
+                                           data->matrix,
+                                           false);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+ProcessDeferredHitWithCoordinatesRoutine(
+    _Inout_opt_ void *context,
+    _In_ PCHIT_CONTEXT hit_context,
+    _In_ PCMATRIX model_to_world,
+    _In_ POINT3 model_hit_point,
+    _In_ POINT3 world_hit_point
+    )
+{
+    auto data = static_cast<DeferredTransformedData*>(context);
+    EXPECT_EQ(data->matrix, model_to_world);
+
+    size_t hits_processed = 0;
+    ISTATUS status = ProcessDeferredHitRoutine(&hits_processed, hit_context);
+    EXPECT_EQ(1u, hits_processed);
+
+    EXPECT_EQ(PointCreate((float_t)11.0, (float_t)7.0, (float_t)3.0),
+              model_hit_point);
+    EXPECT_EQ(PointCreate((float_t)12.0, (float_t)9.0, (float_t)6.0),
+              world_hit_point);
+
+    return status;
+}
+
+TEST(RayTracerTest, RayTracerTraceClosestHitWithCoordinatesDeferred)
+{
+    PRAY_TRACER ray_tracer;
+    EXPECT_EQ(ISTATUS_SUCCESS, RayTracerAllocate(&ray_tracer));
+
+    DeferredTransformedData data;
+    data.finalized = 0;
+    ASSERT_EQ(ISTATUS_SUCCESS,
+              MatrixAllocateTranslation(1.0, 2.0, 3.0, &data.matrix));
+
+    RAY ray = CreateWorldRay();
+
+    ISTATUS status =
+        RayTracerTraceClosestHitWithCoordinates(
+            ray_tracer,
+            ray,
+            (float_t)1.5,
+            INFINITY,
+            TraceSceneRoutineDeferredTransformed,
+            &data,
+            ProcessDeferredHitWithCoordinatesRoutine,
+            &data);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(1u, data.finalized);
+
+    RayTracerFree(ray_tracer);
+    MatrixRelease(data.matrix);
 }
\ No newline at end of file
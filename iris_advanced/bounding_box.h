@@ -126,6 +126,26 @@ BoundingBoxIntersection(
     return BoundingBoxCreate(corner0, corner1);
 }
 
+static
+inline
+BOUNDING_BOX
+BoundingBoxInterpolate(
+    _In_ BOUNDING_BOX box0,
+    _In_ BOUNDING_BOX box1,
+    _In_ float_t weight
+    )
+{
+    assert((float_t)0.0 <= weight && weight <= (float_t)1.0);
+
+    VECTOR3 delta0 = PointSubtract(box1.corners[0], box0.corners[0]);
+    POINT3 corner0 = PointVectorAddScaled(box0.corners[0], delta0, weight);
+
+    VECTOR3 delta1 = PointSubtract(box1.corners[1], box0.corners[1]);
+    POINT3 corner1 = PointVectorAddScaled(box0.corners[1], delta1, weight);
+
+    return BoundingBoxCreate(corner0, corner1);
+}
+
 static
 inline
 BOUNDING_BOX
@@ -134,16 +154,21 @@ BoundingBoxTransform(
     _In_ BOUNDING_BOX box
     )
 {
-    POINT3 transformed = PointMatrixMultiply(matrix, box.corners[0]);
-    BOUNDING_BOX result = BoundingBoxCreate(transformed, transformed);
+    POINT3 corners[8];
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        corners[i] = PointCreate(box.corners[(i >> 0) & 1u].x,
+                                 box.corners[(i >> 1) & 1u].y,
+                                 box.corners[(i >> 2) & 1u].z);
+    }
+
+    ISTATUS status = PointMatrixMultiplyBatch(matrix, corners, 8, corners);
+    assert(status == ISTATUS_SUCCESS);
 
+    BOUNDING_BOX result = BoundingBoxCreate(corners[0], corners[0]);
     for (uint32_t i = 1; i < 8; i++)
     {
-        POINT3 corner = PointCreate(box.corners[(i >> 0) & 1u].x,
-                                    box.corners[(i >> 1) & 1u].y,
-                                    box.corners[(i >> 2) & 1u].z);
-        transformed = PointMatrixMultiply(matrix, corner);
-        result = BoundingBoxEnvelop(result, transformed);
+        result = BoundingBoxEnvelop(result, corners[i]);
     }
 
     return result;
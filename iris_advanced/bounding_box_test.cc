@@ -192,6 +192,30 @@ TEST(BoundingBoxTest, BoundingBoxIntersection)
     EXPECT_EQ(box2.corners[1], point1);
 }
 
+TEST(BoundingBoxTest, BoundingBoxInterpolate)
+{
+    POINT3 point0 = PointCreate((float_t) -1.0, (float_t) -1.0, (float_t) -1.0);
+    POINT3 point1 = PointCreate((float_t) 0.0, (float_t) 0.0, (float_t) 0.0);
+    BOUNDING_BOX box0 = BoundingBoxCreate(point0, point1);
+
+    POINT3 point2 = PointCreate((float_t) 1.0, (float_t) 3.0, (float_t) 1.0);
+    BOUNDING_BOX box1 = BoundingBoxCreate(point1, point2);
+
+    BOUNDING_BOX box2 = BoundingBoxInterpolate(box0, box1, (float_t) 0.0);
+    EXPECT_EQ(box2.corners[0], point0);
+    EXPECT_EQ(box2.corners[1], point1);
+
+    box2 = BoundingBoxInterpolate(box0, box1, (float_t) 1.0);
+    EXPECT_EQ(box2.corners[0], point1);
+    EXPECT_EQ(box2.corners[1], point2);
+
+    box2 = BoundingBoxInterpolate(box0, box1, (float_t) 0.5);
+    EXPECT_EQ(box2.corners[0],
+              PointCreate((float_t) -0.5, (float_t) -0.5, (float_t) -0.5));
+    EXPECT_EQ(box2.corners[1],
+              PointCreate((float_t) 0.5, (float_t) 1.5, (float_t) 0.5));
+}
+
 TEST(BoundingBoxTest, BoundingBoxTransform)
 {
     POINT3 point0 = PointCreate((float_t) 0.0, (float_t) 0.0, (float_t) 0.0);
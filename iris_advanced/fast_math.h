@@ -0,0 +1,302 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    fast_math.h
+
+Abstract:
+
+    Polynomial approximations of the transcendental functions used by
+    sampling and texture mapping code. The routines are built from selects
+    rather than branches and do not set errno. FastSinCos vectorizes as is.
+    The others vectorize when the compiler may speculate floating point
+    operations, e.g. with -fno-trapping-math, and FastAcos additionally
+    needs -fno-math-errno for its sqrt.
+
+    The approximations are accurate to about single precision regardless of
+    the width of float_t. The maximum errors measured against double
+    precision libm are:
+
+        FastSinCos    absolute error below 1e-7 for |theta| <= 8192
+        FastAtan2     absolute error below 3e-7 radians
+        FastAcos      absolute error below 3.5e-7 radians for |x| <= 1
+        FastExp       relative error below 1e-7
+        FastLog       error below 1e-7 * max(1, |log(x)|)
+
+    FastAtan2 returns 0 if both arguments are 0. FastExp clamps its argument
+    to [-87, 88]. FastLog requires a positive, finite, normal argument.
+
+    Rendering code calls the Shading variants, which use the approximations
+    if IRIS_ADVANCED_FAST_MATH is defined to a non-zero value when building
+    and the libm functions otherwise.
+
+--*/
+
+#ifndef _IRIS_ADVANCED_FAST_MATH_
+#define _IRIS_ADVANCED_FAST_MATH_
+
+#include <string.h>
+
+#include "iris_advanced/math.h"
+
+//
+// Defines
+//
+
+#ifndef IRIS_ADVANCED_FAST_MATH
+#define IRIS_ADVANCED_FAST_MATH 0
+#endif // IRIS_ADVANCED_FAST_MATH
+
+//
+// Static Functions
+//
+
+static
+inline
+float_t
+FastAsinPolynomial(
+    _In_ float_t x
+    )
+{
+    float_t z = x * x;
+    float_t p = (float_t)4.2163199048e-2;
+    p = p * z + (float_t)2.4181311049e-2;
+    p = p * z + (float_t)4.5470025998e-2;
+    p = p * z + (float_t)7.4953002686e-2;
+    p = p * z + (float_t)1.6666752422e-1;
+    return p * z * x + x;
+}
+
+static
+inline
+float_t
+FastAtanPolynomial(
+    _In_ float_t x
+    )
+{
+    float_t z = x * x;
+    float_t p = (float_t)8.05374449538e-2;
+    p = p * z - (float_t)1.38776856032e-1;
+    p = p * z + (float_t)1.99777106478e-1;
+    p = p * z - (float_t)3.33329491539e-1;
+    return p * z * x + x;
+}
+
+//
+// Functions
+//
+
+static
+inline
+void
+FastSinCos(
+    _In_ float_t theta,
+    _Out_ float_t *s,
+    _Out_ float_t *c
+    )
+{
+    assert(s != NULL);
+    assert(c != NULL);
+
+    float_t scaled = theta * (float_t)0.63661977236758134308;
+    int32_t quadrant = (int32_t)(scaled + copysign((float_t)0.5, scaled));
+    float_t k = (float_t)quadrant;
+
+    float_t r = theta - k * (float_t)1.5703125;
+    r -= k * (float_t)4.837512969970703125e-4;
+    r -= k * (float_t)7.54978995489188216e-8;
+
+    float_t z = r * r;
+
+    float_t sin_r = (float_t)-1.9515295891e-4;
+    sin_r = sin_r * z + (float_t)8.3321608736e-3;
+    sin_r = sin_r * z - (float_t)1.6666654611e-1;
+    sin_r = sin_r * z * r + r;
+
+    float_t cos_r = (float_t)2.443315711809948e-5;
+    cos_r = cos_r * z - (float_t)1.388731625493765e-3;
+    cos_r = cos_r * z + (float_t)4.166664568298827e-2;
+    cos_r = cos_r * z * z - (float_t)0.5 * z + (float_t)1.0;
+
+    float_t sin_theta = (quadrant & 1) ? cos_r : sin_r;
+    float_t cos_theta = (quadrant & 1) ? sin_r : cos_r;
+
+    *s = (quadrant & 2) ? -sin_theta : sin_theta;
+    *c = ((quadrant + 1) & 2) ? -cos_theta : cos_theta;
+}
+
+static
+inline
+float_t
+FastAtan2(
+    _In_ float_t y,
+    _In_ float_t x
+    )
+{
+    float_t abs_x = fabs(x);
+    float_t abs_y = fabs(y);
+    float_t numerator = IMin(abs_x, abs_y);
+    float_t denominator = IMax(abs_x, abs_y);
+
+    denominator = (denominator == (float_t)0.0) ? (float_t)1.0 : denominator;
+    float_t a = numerator / denominator;
+
+    bool reduce = a > (float_t)0.41421356237309504880;
+    float_t shifted = (a - (float_t)1.0) / (a + (float_t)1.0);
+    float_t reduced = reduce ? shifted : a;
+    float_t result = FastAtanPolynomial(reduced);
+    result += reduce ? (float_t)0.78539816339744830962 : (float_t)0.0;
+
+    result = (abs_y > abs_x) ?
+        (float_t)1.57079632679489661923 - result : result;
+    result = (x < (float_t)0.0) ?
+        (float_t)3.14159265358979323846 - result : result;
+
+    return copysign(result, y);
+}
+
+static
+inline
+float_t
+FastAcos(
+    _In_ float_t x
+    )
+{
+    float_t abs_x = fabs(x);
+    bool reduce = abs_x > (float_t)0.5;
+
+    float_t half_complement = ((float_t)1.0 - abs_x) * (float_t)0.5;
+    float_t t = reduce ? sqrt(half_complement) : abs_x;
+    float_t asin_t = FastAsinPolynomial(t);
+
+    float_t result = reduce ?
+        (float_t)2.0 * asin_t :
+        (float_t)1.57079632679489661923 - asin_t;
+
+    return (x < (float_t)0.0) ?
+        (float_t)3.14159265358979323846 - result : result;
+}
+
+static
+inline
+float_t
+FastExp(
+    _In_ float_t x
+    )
+{
+    x = IMax(IMin(x, (float_t)88.0), (float_t)-87.0);
+
+    float_t scaled = x * (float_t)1.44269504088896341;
+    int32_t exponent = (int32_t)(scaled + (float_t)128.5) - 128;
+    float_t k = (float_t)exponent;
+
+    float_t r = x - k * (float_t)0.693359375;
+    r += k * (float_t)2.12194440e-4;
+
+    float_t p = (float_t)1.9875691500e-4;
+    p = p * r + (float_t)1.3981999507e-3;
+    p = p * r + (float_t)8.3334519073e-3;
+    p = p * r + (float_t)4.1665795894e-2;
+    p = p * r + (float_t)1.6666665459e-1;
+    p = p * r + (float_t)5.0000001201e-1;
+    p = p * r * r + r + (float_t)1.0;
+
+    uint32_t scale_bits = (uint32_t)(exponent + 127) << 23;
+
+    float scale;
+    memcpy(&scale, &scale_bits, sizeof(float));
+
+    return p * (float_t)scale;
+}
+
+static
+inline
+float_t
+FastLog(
+    _In_ float_t x
+    )
+{
+    float value = (float)x;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 126;
+    bits = (bits & 0x807FFFFFu) | 0x3F000000u;
+
+    float mantissa;
+    memcpy(&mantissa, &bits, sizeof(float));
+
+    float_t m = (float_t)mantissa;
+    bool reduce = m < (float_t)0.70710678118654752440;
+    m = reduce ? m + m : m;
+
+    float_t e = (float_t)(reduce ? exponent - 1 : exponent);
+    float_t f = m - (float_t)1.0;
+    float_t z = f * f;
+
+    float_t p = (float_t)7.0376836292e-2;
+    p = p * f - (float_t)1.1514610310e-1;
+    p = p * f + (float_t)1.1676998740e-1;
+    p = p * f - (float_t)1.2420140846e-1;
+    p = p * f + (float_t)1.4249322787e-1;
+    p = p * f - (float_t)1.6668057665e-1;
+    p = p * f + (float_t)2.0000714765e-1;
+    p = p * f - (float_t)2.4999993993e-1;
+    p = p * f + (float_t)3.3333331174e-1;
+    p = p * f * z;
+
+    p -= e * (float_t)2.12194440e-4;
+    p -= (float_t)0.5 * z;
+
+    return f + p + e * (float_t)0.693359375;
+}
+
+static
+inline
+void
+ShadingSinCos(
+    _In_ float_t theta,
+    _Out_ float_t *s,
+    _Out_ float_t *c
+    )
+{
+#if IRIS_ADVANCED_FAST_MATH
+    FastSinCos(theta, s, c);
+#else
+    SinCos(theta, s, c);
+#endif // IRIS_ADVANCED_FAST_MATH
+}
+
+static
+inline
+float_t
+ShadingAtan2(
+    _In_ float_t y,
+    _In_ float_t x
+    )
+{
+#if IRIS_ADVANCED_FAST_MATH
+    return FastAtan2(y, x);
+#else
+    return atan2(y, x);
+#endif // IRIS_ADVANCED_FAST_MATH
+}
+
+static
+inline
+float_t
+ShadingAcos(
+    _In_ float_t x
+    )
+{
+#if IRIS_ADVANCED_FAST_MATH
+    return FastAcos(x);
+#else
+    return acos(x);
+#endif // IRIS_ADVANCED_FAST_MATH
+}
+
+#endif // _IRIS_ADVANCED_FAST_MATH_
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    fast_math_test.cc
+
+Abstract:
+
+    Unit tests for fast_math.h
+
+--*/
+
+extern "C" {
+#include "iris_advanced/fast_math.h"
+}
+
+#include <cmath>
+
+#include "googletest/include/gtest/gtest.h"
+
+TEST(FastMathTest, FastSinCos)
+{
+    for (int i = 0; i <= 1000000; i++)
+    {
+        float_t theta = (float_t)(-8192.0 + 16384.0 * i / 1000000.0);
+
+        float_t s, c;
+        FastSinCos(theta, &s, &c);
+        EXPECT_NEAR(std::sin((double)theta), (double)s, 1e-7);
+        EXPECT_NEAR(std::cos((double)theta), (double)c, 1e-7);
+    }
+
+    float_t s, c;
+    FastSinCos((float_t)0.0, &s, &c);
+    EXPECT_EQ((float_t)0.0, s);
+    EXPECT_EQ((float_t)1.0, c);
+}
+
+TEST(FastMathTest, FastAtan2)
+{
+    for (int i = 0; i < 1000000; i++)
+    {
+        double angle = 2.0 * M_PI * i / 1000000.0;
+        double length = 1.0 + i % 7;
+        float_t y = (float_t)(std::sin(angle) * length);
+        float_t x = (float_t)(std::cos(angle) * length);
+
+        EXPECT_NEAR(std::atan2((double)y, (double)x),
+                    (double)FastAtan2(y, x),
+                    3e-7);
+    }
+
+    EXPECT_EQ((float_t)0.0, FastAtan2((float_t)0.0, (float_t)0.0));
+    EXPECT_EQ((float_t)0.0, FastAtan2((float_t)0.0, (float_t)1.0));
+    EXPECT_NEAR(M_PI, (double)FastAtan2((float_t)0.0, (float_t)-1.0), 3e-7);
+    EXPECT_NEAR(M_PI_2, (double)FastAtan2((float_t)1.0, (float_t)0.0), 3e-7);
+    EXPECT_NEAR(-M_PI_2, (double)FastAtan2((float_t)-1.0, (float_t)0.0), 3e-7);
+}
+
+TEST(FastMathTest, FastAcos)
+{
+    for (int i = 0; i <= 1000000; i++)
+    {
+        float_t x = (float_t)(-1.0 + 2.0 * i / 1000000.0);
+        EXPECT_NEAR(std::acos((double)x), (double)FastAcos(x), 3.5e-7);
+    }
+
+    EXPECT_EQ((float_t)0.0, FastAcos((float_t)1.0));
+    EXPECT_NEAR(M_PI, (double)FastAcos((float_t)-1.0), 3.5e-7);
+}
+
+TEST(FastMathTest, FastExp)
+{
+    for (int i = 0; i <= 1000000; i++)
+    {
+        float_t x = (float_t)(-87.0 + 175.0 * i / 1000000.0);
+        double expected = std::exp((double)x);
+        EXPECT_NEAR(expected, (double)FastExp(x), expected * 1e-7);
+    }
+
+    EXPECT_EQ((float_t)1.0, FastExp((float_t)0.0));
+    EXPECT_TRUE(std::isfinite(FastExp((float_t)1000.0)));
+    EXPECT_LE((float_t)0.0, FastExp((float_t)-1000.0));
+}
+
+TEST(FastMathTest, FastLog)
+{
+    for (int i = 0; i <= 1000000; i++)
+    {
+        float_t x = (float_t)std::pow(2.0, -125.0 + 250.0 * i / 1000000.0);
+        double expected = std::log((double)x);
+        double tolerance = 1e-7 * std::fmax(1.0, std::fabs(expected));
+        EXPECT_NEAR(expected, (double)FastLog(x), tolerance);
+    }
+
+    EXPECT_EQ((float_t)0.0, FastLog((float_t)1.0));
+}
+
+TEST(FastMathTest, ShadingRoutines)
+{
+    float_t s, c;
+    ShadingSinCos((float_t)1.0, &s, &c);
+    EXPECT_NEAR(std::sin(1.0), (double)s, 1e-7);
+    EXPECT_NEAR(std::cos(1.0), (double)c, 1e-7);
+
+    EXPECT_NEAR(std::atan2(1.0, -2.0),
+                (double)ShadingAtan2((float_t)1.0, (float_t)-2.0),
+                3e-7);
+
+    EXPECT_NEAR(std::acos(0.25), (double)ShadingAcos((float_t)0.25), 3.5e-7);
+}
\ No newline at end of file
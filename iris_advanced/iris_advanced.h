@@ -23,6 +23,7 @@ extern "C" {
 
 #include "iris_advanced/bounding_box.h"
 #include "iris_advanced/color.h"
+#include "iris_advanced/fast_math.h"
 #include "iris_advanced/intersection.h"
 #include "iris_advanced/math.h"
 #include "iris_advanced/random.h"
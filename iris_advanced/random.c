@@ -138,6 +138,71 @@ RandomGenerateFloat(
     return status;
 }
 
+ISTATUS
+RandomGenerateFloats(
+    _In_ PRANDOM rng,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(minimum))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (!isfinite(maximum))
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (minimum > maximum)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_00;
+    }
+
+    if (results == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    ISTATUS status;
+    if (rng->vtable->generate_floats_routine != NULL)
+    {
+        status = rng->vtable->generate_floats_routine(rng->data,
+                                                      minimum,
+                                                      maximum,
+                                                      count,
+                                                      results);
+    }
+    else
+    {
+        status = ISTATUS_SUCCESS;
+        for (size_t i = 0; i < count && status == ISTATUS_SUCCESS; i++)
+        {
+            status = rng->vtable->generate_float_routine(rng->data,
+                                                         minimum,
+                                                         maximum,
+                                                         results + i);
+        }
+    }
+
+    // Should these be made into something stronger than assertions?
+    for (size_t i = 0; status == ISTATUS_SUCCESS && i < count; i++)
+    {
+        assert(minimum <= results[i]);
+        assert(results[i] <= maximum);
+    }
+
+    return status;
+}
+
 ISTATUS
 RandomGenerateIndex(
     _In_ PRANDOM rng,
@@ -191,6 +256,40 @@ RandomReplicate(
     return status;
 }
 
+ISTATUS
+RandomGetContext(
+    _In_ PRANDOM rng,
+    _In_ PCRANDOM_VTABLE vtable,
+    _Outptr_result_maybenull_ void **context
+    )
+{
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (vtable == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (context == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (rng->vtable == vtable)
+    {
+        *context = rng->data;
+    }
+    else
+    {
+        *context = NULL;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 void
 RandomFree(
     _In_opt_ _Post_invalid_ PRANDOM rng
@@ -34,6 +34,16 @@ ISTATUS
     _Out_range_(minimum, maximum) float_t *result
     );
 
+typedef
+ISTATUS
+(*PGENERATE_FLOATS_ROUTINE)(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    );
+
 typedef
 ISTATUS
 (*PGENERATE_INDEX_ROUTINE)(
@@ -54,6 +64,7 @@ typedef struct _RANDOM_VTABLE {
     PGENERATE_INDEX_ROUTINE generate_index_routine;
     PRANDOM_REPLICATE_ROUTINE replicate_routine;
     PFREE_ROUTINE free_routine;
+    PGENERATE_FLOATS_ROUTINE generate_floats_routine;
 } RANDOM_VTABLE, *PRANDOM_VTABLE;
 
 typedef const RANDOM_VTABLE *PCRANDOM_VTABLE;
@@ -79,6 +90,15 @@ RandomGenerateFloat(
     _Out_range_(minimum, maximum) float_t *result
     );
 
+ISTATUS
+RandomGenerateFloats(
+    _In_ PRANDOM rng,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    );
+
 ISTATUS
 RandomGenerateIndex(
     _In_ PRANDOM rng,
@@ -92,6 +112,13 @@ RandomReplicate(
     _Out_ PRANDOM *replica
     );
 
+ISTATUS
+RandomGetContext(
+    _In_ PRANDOM rng,
+    _In_ PCRANDOM_VTABLE vtable,
+    _Outptr_result_maybenull_ void **context
+    );
+
 void
 RandomFree(
     _In_opt_ _Post_invalid_ PRANDOM rng
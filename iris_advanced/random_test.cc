@@ -70,7 +70,7 @@ TEST(RandomTest, RandomAllocateErrors)
 
 TEST(RandomTest, RandomGenerateFloatErrors)
 {
-    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr };
+    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr, nullptr };
     PRANDOM rng;
 
     ISTATUS status = RandomAllocate(&vtable, 
@@ -138,9 +138,60 @@ TEST(RandomTest, RandomGenerateFloatErrors)
     RandomFree(rng);
 }
 
+TEST(RandomTest, RandomGenerateFloatsErrors)
+{
+    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    PRANDOM rng;
+
+    ISTATUS status = RandomAllocate(&vtable, 
+                                    nullptr,
+                                    0,
+                                    0,
+                                    &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t results[2];
+    status = RandomGenerateFloats(nullptr,
+                                  (float_t)0.0,
+                                  (float_t)1.0,
+                                  2,
+                                  results);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00, status);
+
+    status = RandomGenerateFloats(rng,
+                                  (float_t)-INFINITY,
+                                  (float_t)1.0,
+                                  2,
+                                  results);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01, status);
+
+    status = RandomGenerateFloats(rng,
+                                  (float_t)0.0,
+                                  std::numeric_limits<float_t>::quiet_NaN(),
+                                  2,
+                                  results);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02, status);
+
+    status = RandomGenerateFloats(rng,
+                                  (float_t)1.0,
+                                  (float_t)0.0,
+                                  2,
+                                  results);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_COMBINATION_00, status);
+
+    status = RandomGenerateFloats(rng,
+                                  (float_t)0.0,
+                                  (float_t)1.0,
+                                  2,
+                                  nullptr);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_04, status);
+
+    RandomFree(rng);
+}
+
 TEST(RandomTest, RandomGenerateIndexErrors)
 {
-    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr };
+    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr, nullptr };
     PRANDOM rng;
 
     ISTATUS status = RandomAllocate(&vtable, 
@@ -214,7 +265,8 @@ TestGenerateFloat(
     RANDOM_VTABLE vtable = { TestGenerateFloatCallback,
                              nullptr,
                              nullptr,
-                             TestGenerateFloatFreeCallback };
+                             TestGenerateFloatFreeCallback,
+                             nullptr };
     FloatContext context = { return_status,
                              minimum,
                              maximum,
@@ -253,6 +305,125 @@ TEST(RandomTest, RandomGenerateFloat)
     TestGenerateFloat(0.0, 1.0, 0.75, ISTATUS_INVALID_ARGUMENT_31);
 }
 
+ISTATUS
+TestGenerateFloatsFallbackCallback(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _Out_range_(minimum, maximum) float_t *result
+    )
+{
+    size_t *calls = static_cast<size_t*>(context);
+    *calls += 1;
+    *result = minimum + (maximum - minimum) / (float_t)(*calls + 1);
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+TestGenerateFloatsCallback(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    size_t *calls = static_cast<size_t*>(context);
+    *calls += count;
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i] = minimum + (maximum - minimum) / (float_t)(i + 2);
+    }
+    return ISTATUS_SUCCESS;
+}
+
+TEST(RandomTest, RandomGenerateFloats)
+{
+    size_t calls = 0;
+    RANDOM_VTABLE vtable = { TestGenerateFloatsFallbackCallback,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             nullptr };
+    PRANDOM rng;
+
+    ISTATUS status = RandomAllocate(&vtable,
+                                    &calls,
+                                    sizeof(calls),
+                                    alignof(size_t),
+                                    &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t results[3];
+    status = RandomGenerateFloats(rng,
+                                  (float_t)0.0,
+                                  (float_t)1.0,
+                                  3,
+                                  results);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ((float_t)0.5, results[0]);
+    EXPECT_EQ((float_t)1.0 / (float_t)3.0, results[1]);
+    EXPECT_EQ((float_t)0.25, results[2]);
+
+    RandomFree(rng);
+
+    vtable.generate_floats_routine = TestGenerateFloatsCallback;
+
+    status = RandomAllocate(&vtable,
+                            &calls,
+                            sizeof(calls),
+                            alignof(size_t),
+                            &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = RandomGenerateFloats(rng,
+                                  (float_t)1.0,
+                                  (float_t)2.0,
+                                  2,
+                                  results);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ((float_t)1.5, results[0]);
+    EXPECT_EQ((float_t)1.0 + (float_t)1.0 / (float_t)3.0, results[1]);
+
+    RandomFree(rng);
+}
+
+TEST(RandomTest, RandomGetContext)
+{
+    RANDOM_VTABLE vtable = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    RANDOM_VTABLE other_vtable = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    size_t data = 42;
+    PRANDOM rng;
+
+    ISTATUS status = RandomAllocate(&vtable,
+                                    &data,
+                                    sizeof(data),
+                                    alignof(size_t),
+                                    &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    void *context;
+    status = RandomGetContext(nullptr, &vtable, &context);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00, status);
+
+    status = RandomGetContext(rng, nullptr, &context);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01, status);
+
+    status = RandomGetContext(rng, &vtable, nullptr);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02, status);
+
+    status = RandomGetContext(rng, &other_vtable, &context);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(nullptr, context);
+
+    status = RandomGetContext(rng, &vtable, &context);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    ASSERT_NE(nullptr, context);
+    EXPECT_EQ(42u, *static_cast<size_t*>(context));
+
+    RandomFree(rng);
+}
+
 struct IndexContext {
     ISTATUS return_status;
     size_t upper_bound;
@@ -300,7 +471,8 @@ TestGenerateIndex(
     RANDOM_VTABLE vtable = { nullptr,
                              TestGenerateIndexCallback,
                              nullptr,
-                             TestGenerateIndexFreeCallback };
+                             TestGenerateIndexFreeCallback,
+                             nullptr };
     IndexContext context = { return_status,
                              upper_bound,
                              return_value,
@@ -380,7 +552,8 @@ TestReplicate(
     RANDOM_VTABLE vtable = { nullptr,
                              nullptr,
                              TestReplicateCallback,
-                             TestReplicateFreeCallback };
+                             TestReplicateFreeCallback,
+                             nullptr };
     ReplicateContext context = { return_status,
                                  return_value,
                                  &replicate_encountered,
@@ -25,6 +25,7 @@ typedef struct _RAY_DIFFERENTIAL {
     RAY ray;
     RAY rx;
     RAY ry;
+    float_t time;
     bool has_differentials;
 } RAY_DIFFERENTIAL, *PRAY_DIFFERENTIAL;
 
@@ -51,6 +52,7 @@ RayDifferentialCreate(
     result.ray = ray;
     result.rx = rx;
     result.ry = ry;
+    result.time = (float_t)0.0;
     result.has_differentials = true;
 
     return result;
@@ -69,11 +71,27 @@ RayDifferentialCreateWithoutDifferentials(
     result.ray = ray;
     result.rx = ray;
     result.ry = ray;
+    result.time = (float_t)0.0;
     result.has_differentials = false;
 
     return result;
 }
 
+static
+inline
+RAY_DIFFERENTIAL
+RayDifferentialSetTime(
+    _In_ RAY_DIFFERENTIAL ray_differential,
+    _In_ float_t time
+    )
+{
+    assert(isfinite(time));
+
+    ray_differential.time = time;
+
+    return ray_differential;
+}
+
 static
 inline
 bool
@@ -83,7 +101,8 @@ RayDifferentialValidate(
 {
     bool result = RayValidate(ray_differential.ray) &&
                   RayValidate(ray_differential.rx) &&
-                  RayValidate(ray_differential.ry);
+                  RayValidate(ray_differential.ry) &&
+                  isfinite(ray_differential.time);
 
     return result;
 }
@@ -104,6 +123,7 @@ RayDifferentialMatrixMultiply(
         result.ray = transformed;
         result.rx = RayMatrixMultiply(matrix, ray_differential.rx);
         result.ry = RayMatrixMultiply(matrix, ray_differential.ry);
+        result.time = ray_differential.time;
         result.has_differentials = true;
 
         return result;
@@ -111,6 +131,7 @@ RayDifferentialMatrixMultiply(
 
     RAY_DIFFERENTIAL result =
         RayDifferentialCreateWithoutDifferentials(transformed);
+    result.time = ray_differential.time;
 
     return result;
 }
@@ -131,6 +152,7 @@ RayDifferentialMatrixInverseMultiply(
         result.ray = transformed;
         result.rx = RayMatrixInverseMultiply(matrix, ray_differential.rx);
         result.ry = RayMatrixInverseMultiply(matrix, ray_differential.ry);
+        result.time = ray_differential.time;
         result.has_differentials = true;
 
         return result;
@@ -138,6 +160,7 @@ RayDifferentialMatrixInverseMultiply(
 
     RAY_DIFFERENTIAL result =
         RayDifferentialCreateWithoutDifferentials(transformed);
+    result.time = ray_differential.time;
 
     return result;
 }
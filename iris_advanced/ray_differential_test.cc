@@ -37,6 +37,7 @@ TEST(RayDifferentialTest, RayDifferentialTestCreate)
     EXPECT_EQ(ray0, differential.ray);
     EXPECT_EQ(ray1, differential.rx);
     EXPECT_EQ(ray2, differential.ry);
+    EXPECT_EQ((float_t)0.0, differential.time);
     EXPECT_TRUE(differential.has_differentials);
 }
 
@@ -54,6 +55,33 @@ TEST(RayDifferentialTest, RayDifferentialTestCreateWithoutDifferentials)
     EXPECT_FALSE(differential.has_differentials);
 }
 
+TEST(RayDifferentialTest, RayDifferentialTestSetTime)
+{
+    POINT3 point0 = PointCreate(1.0f, 2.0f, 3.0f);
+    VECTOR3 vector0 = VectorCreate(9.0f, 10.0f, 11.0f);
+    RAY ray0 = RayCreate(point0, vector0);
+
+    PMATRIX matrix;
+    ISTATUS status = MatrixAllocateScalar(2.0f, 2.0f, 2.0f, &matrix);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    RAY_DIFFERENTIAL differential = RayDifferentialCreate(ray0, ray0, ray0);
+    differential = RayDifferentialSetTime(differential, 0.5f);
+    EXPECT_EQ((float_t)0.5, differential.time);
+
+    differential = RayDifferentialMatrixMultiply(matrix, differential);
+    EXPECT_EQ((float_t)0.5, differential.time);
+
+    differential.has_differentials = false;
+    differential = RayDifferentialMatrixInverseMultiply(matrix, differential);
+    EXPECT_EQ((float_t)0.5, differential.time);
+
+    differential = RayDifferentialNormalize(differential);
+    EXPECT_EQ((float_t)0.5, differential.time);
+
+    MatrixRelease(matrix);
+}
+
 TEST(RayDifferentialTest, RayDifferentialTestValidate)
 {
     POINT3 point = PointCreate(1.0f, 2.0f, 3.0f);
@@ -74,6 +102,10 @@ TEST(RayDifferentialTest, RayDifferentialTestValidate)
 
     differential.ry.origin.x = INFINITY;
     EXPECT_FALSE(RayDifferentialValidate(differential));
+    differential.ry.origin.x = 0.0f;
+
+    differential.time = INFINITY;
+    EXPECT_FALSE(RayDifferentialValidate(differential));
 }
 
 TEST(RayDifferentialTest, RayDifferentialTestMultiply)
@@ -0,0 +1,148 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    halton_enumerator_internal.h
+
+Abstract:
+
+    Maps pixels and sample numbers to Halton sequence indices and scales the
+    first two dimensions of the points found back to the unit square. Shared
+    by the Halton sequence implementations.
+
+--*/
+
+#ifndef _IRIS_ADVANCED_TOOLKIT_HALTON_ENUMERATOR_INTERNAL_
+#define _IRIS_ADVANCED_TOOLKIT_HALTON_ENUMERATOR_INTERNAL_
+
+#include "iris_advanced/iris_advanced.h"
+#include "third_party/gruenschloss/halton/halton_enum.h"
+
+//
+// Types
+//
+
+typedef struct _HALTON_ENUMERATOR {
+    Halton_enum enumerator;
+    unsigned num_columns;
+    unsigned num_rows;
+    unsigned column;
+    unsigned row;
+    unsigned base_index;
+    float_t scale_factor[2];
+} HALTON_ENUMERATOR, *PHALTON_ENUMERATOR;
+
+typedef const HALTON_ENUMERATOR *PCHALTON_ENUMERATOR;
+
+//
+// Functions
+//
+
+static
+inline
+void
+HaltonEnumeratorInitialize(
+    _Out_ PHALTON_ENUMERATOR enumerator
+    )
+{
+    assert(enumerator != NULL);
+
+    enumerator->enumerator = halton_enum(1, 1);
+    enumerator->num_columns = 1;
+    enumerator->num_rows = 1;
+    enumerator->column = 0;
+    enumerator->row = 0;
+    enumerator->base_index = 0;
+    enumerator->scale_factor[0] = enumerator->enumerator.m_scale_x;
+    enumerator->scale_factor[1] = enumerator->enumerator.m_scale_y;
+}
+
+static
+inline
+ISTATUS
+HaltonEnumeratorComputeIndex(
+    _Inout_ PHALTON_ENUMERATOR enumerator,
+    _In_ size_t column,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows,
+    _In_ uint32_t sample,
+    _Out_ uint64_t *index
+    )
+{
+    assert(enumerator != NULL);
+    assert(index != NULL);
+
+    if (UINT32_MAX < num_columns)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (UINT32_MAX < num_rows)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    bool recompute;
+    if (enumerator->num_columns != num_columns ||
+        enumerator->num_rows != num_rows)
+    {
+        enumerator->enumerator = halton_enum(num_columns, num_rows);
+        enumerator->num_columns = num_columns;
+        enumerator->num_rows = num_rows;
+        enumerator->scale_factor[0] =
+            enumerator->enumerator.m_scale_x / (float_t)num_columns;
+        enumerator->scale_factor[1] =
+            enumerator->enumerator.m_scale_y / (float_t)num_rows;
+        recompute = true;
+    }
+    else
+    {
+        recompute = false;
+    }
+
+    if (enumerator->column != column ||
+        enumerator->row != row ||
+        recompute)
+    {
+        enumerator->base_index = get_index(&enumerator->enumerator,
+                                           0,
+                                           column,
+                                           row);
+        enumerator->column = column;
+        enumerator->row = row;
+
+        *index = enumerator->base_index;
+    }
+    else
+    {
+        *index = enumerator->base_index +
+                 sample * enumerator->enumerator.m_increment;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+inline
+float_t
+HaltonEnumeratorScale(
+    _In_ PCHALTON_ENUMERATOR enumerator,
+    _In_ size_t dimension,
+    _In_ float_t value
+    )
+{
+    assert(enumerator != NULL);
+
+    if (dimension < 2)
+    {
+        value *= enumerator->scale_factor[dimension];
+        value = IMin(IMax(value, (float_t)0.0), (float_t)1.0);
+    }
+
+    return value;
+}
+
+#endif // _IRIS_ADVANCED_TOOLKIT_HALTON_ENUMERATOR_INTERNAL_
\ No newline at end of file
@@ -16,8 +16,8 @@ Abstract:
 #include <stdatomic.h>
 #include <stdlib.h>
 
+#include "iris_advanced_toolkit/halton_enumerator_internal.h"
 #include "iris_advanced_toolkit/halton_sequence.h"
-#include "third_party/gruenschloss/halton/halton_enum.h"
 #include "third_party/gruenschloss/halton/halton_sampler.h"
 
 //
@@ -31,15 +31,9 @@ typedef struct _SHARED_HALTON_DATA {
 
 typedef struct _HALTON_SEQUENCE {
     PSHARED_HALTON_DATA halton_data;
-    Halton_enum enumerator;
-    unsigned num_columns;
-    unsigned num_rows;
-    unsigned column;
-    unsigned row;
-    unsigned base_index;
+    HALTON_ENUMERATOR enumerator;
     unsigned index;
     unsigned dimension;
-    float_t scale_factor[2];
 } HALTON_SEQUENCE, *PHALTON_SEQUENCE;
 
 //
@@ -59,56 +53,17 @@ HaltonSequenceComputeIndex(
     _Out_ uint64_t *index
     )
 {
-    if (UINT32_MAX < num_columns)
-    {
-        return ISTATUS_INVALID_ARGUMENT_02;
-    }
-
-    if (UINT32_MAX < num_rows)
-    {
-        return ISTATUS_INVALID_ARGUMENT_04;
-    }
-
     PHALTON_SEQUENCE halton_sequence = (PHALTON_SEQUENCE)context;
 
-    bool recompute;
-    if (halton_sequence->num_columns != num_columns ||
-        halton_sequence->num_rows != num_rows)
-    {
-        halton_sequence->enumerator = halton_enum(num_columns, num_rows);
-        halton_sequence->num_columns = num_columns;
-        halton_sequence->num_rows = num_rows;
-        halton_sequence->scale_factor[0] =
-            halton_sequence->enumerator.m_scale_x / (float_t)num_columns;
-        halton_sequence->scale_factor[1] =
-            halton_sequence->enumerator.m_scale_y / (float_t)num_rows;
-        recompute = true;
-    }
-    else
-    {
-        recompute = false;
-    }
+    ISTATUS status = HaltonEnumeratorComputeIndex(&halton_sequence->enumerator,
+                                                  column,
+                                                  num_columns,
+                                                  row,
+                                                  num_rows,
+                                                  sample,
+                                                  index);
 
-    if (halton_sequence->column != column ||
-        halton_sequence->row != row ||
-        recompute)
-    {
-        halton_sequence->base_index = get_index(&halton_sequence->enumerator,
-                                                0,
-                                                column,
-                                                row);
-        halton_sequence->column = column;
-        halton_sequence->row = row;
-
-        *index = halton_sequence->base_index;
-    }
-    else
-    {
-        *index = halton_sequence->base_index +
-                 sample * halton_sequence->enumerator.m_increment;
-    }
-
-    return ISTATUS_SUCCESS;
+    return status;
 }
 
 static
@@ -151,14 +106,11 @@ HaltonSequenceNextFloat(
         return ISTATUS_OUT_OF_ENTROPY;
     }
 
-    if (halton_sequence->dimension < 2)
-    {
-        as_float *= halton_sequence->scale_factor[halton_sequence->dimension];
-        as_float = IMin(IMax(as_float, (float_t)0.0), (float_t)1.0);
-    }
+    *value = HaltonEnumeratorScale(&halton_sequence->enumerator,
+                                   halton_sequence->dimension,
+                                   as_float);
 
     halton_sequence->dimension += 1;
-    *value = as_float;
 
     return ISTATUS_SUCCESS;
 }
@@ -183,14 +135,11 @@ HaltonSequenceNextDouble(
         return ISTATUS_OUT_OF_ENTROPY;
     }
 
-    if (halton_sequence->dimension < 2)
-    {
-        as_float *= halton_sequence->scale_factor[halton_sequence->dimension];
-        as_float = IMin(IMax(as_float, (float_t)0.0), (float_t)1.0);
-    }
+    *value = HaltonEnumeratorScale(&halton_sequence->enumerator,
+                                   halton_sequence->dimension,
+                                   as_float);
 
     halton_sequence->dimension += 1;
-    *value = as_float;
 
     return ISTATUS_SUCCESS;
 }
@@ -227,7 +176,9 @@ static const LOW_DISCREPANCY_SEQUENCE_VTABLE halton_sequence_vtable = {
     HaltonSequenceNextFloat,
     HaltonSequenceNextDouble,
     HaltonSequenceDuplicate,
-    HaltonSequenceFree
+    HaltonSequenceFree,
+    NULL,
+    NULL
 };
 
 //
@@ -286,11 +237,7 @@ HaltonSequenceAllocate(
 
     HALTON_SEQUENCE halton_sequence;
     halton_sequence.halton_data = halton_data;
-    halton_sequence.num_columns = 1;
-    halton_sequence.num_rows = 1;
-    halton_sequence.column = 0;
-    halton_sequence.row = 0;
-    halton_sequence.base_index = 0;
+    HaltonEnumeratorInitialize(&halton_sequence.enumerator);
     halton_sequence.index = 0;
     halton_sequence.dimension = 0;
 
@@ -246,6 +246,88 @@ LowDiscrepancySequenceNextDouble(
     return status;
 }
 
+ISTATUS
+LowDiscrepancySequenceNextFloats(
+    _In_ PLOW_DISCREPANCY_SEQUENCE sequence,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    )
+{
+    if (sequence == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (values == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (sequence->vtable->next_floats_routine != NULL)
+    {
+        ISTATUS status =
+            sequence->vtable->next_floats_routine(sequence->data,
+                                                  num_values,
+                                                  values);
+
+        return status;
+    }
+
+    for (size_t i = 0; i < num_values; i++)
+    {
+        ISTATUS status = sequence->vtable->next_float_routine(sequence->data,
+                                                              values + i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+LowDiscrepancySequenceNextDoubles(
+    _In_ PLOW_DISCREPANCY_SEQUENCE sequence,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    )
+{
+    if (sequence == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (values == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (sequence->vtable->next_doubles_routine != NULL)
+    {
+        ISTATUS status =
+            sequence->vtable->next_doubles_routine(sequence->data,
+                                                   num_values,
+                                                   values);
+
+        return status;
+    }
+
+    for (size_t i = 0; i < num_values; i++)
+    {
+        ISTATUS status =
+            sequence->vtable->next_double_routine(sequence->data, values + i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 ISTATUS
 LowDiscrepancySequenceDuplicate(
     _In_ PCLOW_DISCREPANCY_SEQUENCE sequence,
@@ -72,6 +72,20 @@ LowDiscrepancySequenceNextDouble(
     _Out_ double_t *value
     );
 
+ISTATUS
+LowDiscrepancySequenceNextFloats(
+    _In_ PLOW_DISCREPANCY_SEQUENCE sequence,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    );
+
+ISTATUS
+LowDiscrepancySequenceNextDoubles(
+    _In_ PLOW_DISCREPANCY_SEQUENCE sequence,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    );
+
 ISTATUS
 LowDiscrepancySequenceDuplicate(
     _In_ PCLOW_DISCREPANCY_SEQUENCE sequence,
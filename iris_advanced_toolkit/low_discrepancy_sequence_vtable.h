@@ -65,6 +65,22 @@ ISTATUS
     _Out_ double_t *value
     );
 
+typedef
+ISTATUS
+(*PLOW_DISCREPANCY_SEQUENCE_NEXT_FLOATS_ROUTINE)(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    );
+
+typedef
+ISTATUS
+(*PLOW_DISCREPANCY_SEQUENCE_NEXT_DOUBLES_ROUTINE)(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    );
+
 typedef
 ISTATUS
 (*PLOW_DISCREPANCY_SEQUENCE_DUPLICATE_ROUTINE)(
@@ -80,6 +96,8 @@ typedef struct _LOW_DISCREPANCY_SEQUENCE_VTABLE {
     PLOW_DISCREPANCY_SEQUENCE_NEXT_DOUBLE_ROUTINE next_double_routine;
     PLOW_DISCREPANCY_SEQUENCE_DUPLICATE_ROUTINE duplicate_routine;
     PFREE_ROUTINE free_routine;
+    PLOW_DISCREPANCY_SEQUENCE_NEXT_FLOATS_ROUTINE next_floats_routine;
+    PLOW_DISCREPANCY_SEQUENCE_NEXT_DOUBLES_ROUTINE next_doubles_routine;
 } LOW_DISCREPANCY_SEQUENCE_VTABLE, *PLOW_DISCREPANCY_SEQUENCE_VTABLE;
 
 typedef const LOW_DISCREPANCY_SEQUENCE_VTABLE *PCLOW_DISCREPANCY_SEQUENCE_VTABLE;
@@ -0,0 +1,533 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    matrix_cache.c
+
+Abstract:
+
+    Interns matrices by their contents so that numerically identical
+    transforms share a single matrix and inverse. Identity transforms are
+    interned as NULL.
+
+--*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/safe_math.h"
+#include "iris_advanced_toolkit/matrix_cache.h"
+#include "third_party/smhasher/MurmurHash2.h"
+#include "third_party/smhasher/MurmurHash3.h"
+
+//
+// Defines
+//
+
+#define INITIAL_LIST_SIZE 16
+#define LIST_GROWTH_FACTOR 2
+#define HASH_SEED 0
+
+//
+// Types
+//
+
+typedef struct _MATRIX_LIST_ENTRY {
+    float_t contents[4][4];
+    PMATRIX matrix;
+} MATRIX_LIST_ENTRY, *PMATRIX_LIST_ENTRY;
+
+typedef const MATRIX_LIST_ENTRY *PCMATRIX_LIST_ENTRY;
+
+struct _MATRIX_CACHE {
+    _Field_size_full_(list_capacity) PMATRIX_LIST_ENTRY list;
+    size_t list_capacity;
+    size_t list_usable_capacity;
+    size_t list_size;
+};
+
+//
+// Static Functions
+//
+
+static
+inline
+size_t
+MatrixCacheComputeUsableCapacity(
+    _In_ size_t capacity
+    )
+{
+    assert(capacity >= 4);
+
+    return capacity - capacity / 4;
+}
+
+static
+inline
+void
+MatrixCacheNormalizeContents(
+    _In_ const float_t contents[4][4],
+    _Out_ float_t normalized[4][4]
+    )
+{
+    //
+    // Adding zero maps negative zero to positive zero so that contents which
+    // compare equal also have the same representation.
+    //
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            normalized[i][j] = contents[i][j] + (float_t)0.0;
+        }
+    }
+}
+
+static
+inline
+bool
+MatrixCacheIsIdentity(
+    _In_ const float_t contents[4][4]
+    )
+{
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            float_t expected = (i == j) ? (float_t)1.0 : (float_t)0.0;
+            if (contents[i][j] != expected)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static
+inline
+size_t
+MatrixCacheProbeStart(
+    _In_ size_t list_capacity,
+    _In_ const float_t contents[4][4]
+    )
+{
+    size_t hash;
+    if (sizeof(size_t) == 4)
+    {
+        MurmurHash3_x86_32(contents, sizeof(float_t) * 16, HASH_SEED, &hash);
+    }
+    else if (sizeof(size_t) == 8)
+    {
+        hash = MurmurHash64A(contents, sizeof(float_t) * 16, HASH_SEED);
+    }
+    else
+    {
+        assert(false);
+        hash = 0;
+    }
+
+    return hash % list_capacity;
+}
+
+static
+inline
+bool
+MatrixCacheFindEntry(
+    _In_ PCMATRIX_CACHE matrix_cache,
+    _In_ const float_t contents[4][4],
+    _Out_ PMATRIX_LIST_ENTRY *entry
+    )
+{
+    size_t index = MatrixCacheProbeStart(matrix_cache->list_capacity,
+                                         contents);
+    for (;;)
+    {
+        if (matrix_cache->list[index].matrix == NULL)
+        {
+            *entry = matrix_cache->list + index;
+            return false;
+        }
+
+        if (memcmp(matrix_cache->list[index].contents,
+                   contents,
+                   sizeof(float_t) * 16) == 0)
+        {
+            *entry = matrix_cache->list + index;
+            return true;
+        }
+
+        index += 1;
+
+        if (index == matrix_cache->list_capacity)
+        {
+            index = 0;
+        }
+    }
+
+    assert(false);
+    return false;
+}
+
+static
+inline
+void
+MatrixCacheInsert(
+    _Inout_updates_(list_size) PMATRIX_LIST_ENTRY list,
+    _In_ size_t list_size,
+    _In_ PCMATRIX_LIST_ENTRY entry
+    )
+{
+    size_t index = MatrixCacheProbeStart(list_size, entry->contents);
+    for (;;)
+    {
+        if (list[index].matrix == NULL)
+        {
+            list[index] = *entry;
+            return;
+        }
+
+        index += 1;
+
+        if (index == list_size)
+        {
+            index = 0;
+        }
+    }
+}
+
+static
+ISTATUS
+MatrixCacheGrowHashTable(
+    _Inout_ PMATRIX_CACHE matrix_cache
+    )
+{
+    size_t new_capacity;
+    bool success = CheckedMultiplySizeT(matrix_cache->list_capacity,
+                                        LIST_GROWTH_FACTOR,
+                                        &new_capacity);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PMATRIX_LIST_ENTRY new_list =
+        (PMATRIX_LIST_ENTRY)calloc(new_capacity, sizeof(MATRIX_LIST_ENTRY));
+
+    if (new_list == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    for (size_t i = 0; i < matrix_cache->list_capacity; i++)
+    {
+        if (matrix_cache->list[i].matrix == NULL)
+        {
+            continue;
+        }
+
+        MatrixCacheInsert(new_list, new_capacity, matrix_cache->list + i);
+    }
+
+    free(matrix_cache->list);
+
+    matrix_cache->list = new_list;
+    matrix_cache->list_capacity = new_capacity;
+    matrix_cache->list_usable_capacity =
+        MatrixCacheComputeUsableCapacity(new_capacity);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+MatrixCacheAdd(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _Inout_ PMATRIX_LIST_ENTRY entry,
+    _In_ const float_t contents[4][4],
+    _In_ PMATRIX matrix
+    )
+{
+    assert(matrix_cache != NULL);
+    assert(entry != NULL);
+    assert(entry->matrix == NULL);
+    assert(matrix != NULL);
+
+    memcpy(entry->contents, contents, sizeof(float_t) * 16);
+    entry->matrix = matrix;
+    matrix_cache->list_size += 1;
+
+    MatrixRetain(matrix);
+
+    if (matrix_cache->list_size == matrix_cache->list_usable_capacity)
+    {
+        ISTATUS status = MatrixCacheGrowHashTable(matrix_cache);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+//
+// Functions
+//
+
+ISTATUS
+MatrixCacheAllocate(
+    _Out_ PMATRIX_CACHE *matrix_cache
+    )
+{
+    if (matrix_cache == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    PMATRIX_CACHE result = (PMATRIX_CACHE)malloc(sizeof(MATRIX_CACHE));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->list =
+        (PMATRIX_LIST_ENTRY)calloc(INITIAL_LIST_SIZE, sizeof(MATRIX_LIST_ENTRY));
+
+    if (result->list == NULL)
+    {
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->list_capacity = INITIAL_LIST_SIZE;
+    result->list_usable_capacity =
+        MatrixCacheComputeUsableCapacity(INITIAL_LIST_SIZE);
+    result->list_size = 0;
+
+    *matrix_cache = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+MatrixCacheIntern(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_opt_ PMATRIX matrix,
+    _Out_ PMATRIX *interned
+    )
+{
+    if (matrix_cache == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (interned == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    float_t contents[4][4];
+    ISTATUS status = MatrixReadContents(matrix, contents);
+    assert(status == ISTATUS_SUCCESS);
+
+    if (MatrixCacheIsIdentity(contents))
+    {
+        *interned = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    float_t normalized[4][4];
+    MatrixCacheNormalizeContents(contents, normalized);
+
+    PMATRIX_LIST_ENTRY entry;
+    bool found = MatrixCacheFindEntry(matrix_cache, normalized, &entry);
+
+    if (found)
+    {
+        MatrixRetain(entry->matrix);
+        *interned = entry->matrix;
+        return ISTATUS_SUCCESS;
+    }
+
+    status = MatrixCacheAdd(matrix_cache, entry, normalized, matrix);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    MatrixRetain(matrix);
+    *interned = matrix;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+MatrixCacheAllocateFromContents(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_ const float_t contents[4][4],
+    _Out_ PMATRIX *matrix
+    )
+{
+    if (matrix_cache == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (contents == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (matrix == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (MatrixCacheIsIdentity(contents))
+    {
+        *matrix = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    float_t normalized[4][4];
+    MatrixCacheNormalizeContents(contents, normalized);
+
+    PMATRIX_LIST_ENTRY entry;
+    bool found = MatrixCacheFindEntry(matrix_cache, normalized, &entry);
+
+    if (found)
+    {
+        MatrixRetain(entry->matrix);
+        *matrix = entry->matrix;
+        return ISTATUS_SUCCESS;
+    }
+
+    PMATRIX result;
+    ISTATUS status = MatrixAllocate(
+        normalized[0][0], normalized[0][1], normalized[0][2], normalized[0][3],
+        normalized[1][0], normalized[1][1], normalized[1][2], normalized[1][3],
+        normalized[2][0], normalized[2][1], normalized[2][2], normalized[2][3],
+        normalized[3][0], normalized[3][1], normalized[3][2], normalized[3][3],
+        &result);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = MatrixCacheAdd(matrix_cache, entry, normalized, result);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        MatrixRelease(result);
+        return status;
+    }
+
+    *matrix = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+MatrixCacheAllocateProduct(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_opt_ PMATRIX multiplicand0,
+    _In_opt_ PMATRIX multiplicand1,
+    _Out_ PMATRIX *product
+    )
+{
+    if (matrix_cache == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (product == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    float_t contents0[4][4];
+    ISTATUS status = MatrixReadContents(multiplicand0, contents0);
+    assert(status == ISTATUS_SUCCESS);
+
+    float_t contents1[4][4];
+    status = MatrixReadContents(multiplicand1, contents1);
+    assert(status == ISTATUS_SUCCESS);
+
+    //
+    // Summed in the same order as MatrixAllocateProduct so that a cache hit
+    // returns the same contents that allocating the product would have.
+    //
+
+    float_t contents[4][4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            contents[i][j] = contents0[i][0] * contents1[0][j] +
+                             contents0[i][1] * contents1[1][j] +
+                             contents0[i][2] * contents1[2][j] +
+                             contents0[i][3] * contents1[3][j];
+        }
+    }
+
+    if (MatrixCacheIsIdentity(contents))
+    {
+        *product = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    float_t normalized[4][4];
+    MatrixCacheNormalizeContents(contents, normalized);
+
+    PMATRIX_LIST_ENTRY entry;
+    bool found = MatrixCacheFindEntry(matrix_cache, normalized, &entry);
+
+    if (found)
+    {
+        MatrixRetain(entry->matrix);
+        *product = entry->matrix;
+        return ISTATUS_SUCCESS;
+    }
+
+    PMATRIX result;
+    status = MatrixAllocateProduct(multiplicand0, multiplicand1, &result);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = MatrixCacheIntern(matrix_cache, result, product);
+    MatrixRelease(result);
+
+    return status;
+}
+
+void
+MatrixCacheFree(
+    _In_opt_ _Post_invalid_ PMATRIX_CACHE matrix_cache
+    )
+{
+    if (matrix_cache == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < matrix_cache->list_capacity; i++)
+    {
+        MatrixRelease(matrix_cache->list[i].matrix);
+    }
+
+    free(matrix_cache->list);
+    free(matrix_cache);
+}
@@ -0,0 +1,73 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    matrix_cache.h
+
+Abstract:
+
+    Interns matrices by their contents so that numerically identical
+    transforms share a single matrix and inverse. Identity transforms are
+    interned as NULL.
+
+--*/
+
+#ifndef _IRIS_ADVANCED_TOOLKIT_MATRIX_CACHE_
+#define _IRIS_ADVANCED_TOOLKIT_MATRIX_CACHE_
+
+#include "iris_advanced/iris_advanced.h"
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//
+// Types
+//
+
+typedef struct _MATRIX_CACHE MATRIX_CACHE, *PMATRIX_CACHE;
+typedef const MATRIX_CACHE *PCMATRIX_CACHE;
+
+//
+// Functions
+//
+
+ISTATUS
+MatrixCacheAllocate(
+    _Out_ PMATRIX_CACHE *matrix_cache
+    );
+
+ISTATUS
+MatrixCacheIntern(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_opt_ PMATRIX matrix,
+    _Out_ PMATRIX *interned
+    );
+
+ISTATUS
+MatrixCacheAllocateFromContents(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_ const float_t contents[4][4],
+    _Out_ PMATRIX *matrix
+    );
+
+ISTATUS
+MatrixCacheAllocateProduct(
+    _Inout_ PMATRIX_CACHE matrix_cache,
+    _In_opt_ PMATRIX multiplicand0,
+    _In_opt_ PMATRIX multiplicand1,
+    _Out_ PMATRIX *product
+    );
+
+void
+MatrixCacheFree(
+    _In_opt_ _Post_invalid_ PMATRIX_CACHE matrix_cache
+    );
+
+#if __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _IRIS_ADVANCED_TOOLKIT_MATRIX_CACHE_
@@ -0,0 +1,374 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    owen_scrambled_sobol_sequence.c
+
+Abstract:
+
+    Implements a hash based Owen scrambled Sobol sequence.
+
+    Dimensions are consumed in pairs. Each pair uses the first two Sobol
+    dimensions, with the sample index shuffled and the resulting values
+    scrambled by nested uniform permutations seeded from a hash of the
+    pixel, the pair, and the sequence seed. This follows Burley, "Practical
+    Hash-based Owen Scrambling" (JCGT 2020).
+
+--*/
+
+#include <stdalign.h>
+
+#include "iris_advanced_toolkit/owen_scrambled_sobol_sequence.h"
+#include "third_party/gruenschloss/single/sobol.h"
+#include "third_party/smhasher/MurmurHash3.h"
+
+//
+// Types
+//
+
+typedef struct _OWEN_SCRAMBLED_SOBOL_SEQUENCE {
+    uint64_t index;
+    uint32_t seed;
+    uint32_t num_columns;
+    uint32_t num_rows;
+    unsigned dimension;
+} OWEN_SCRAMBLED_SOBOL_SEQUENCE, *POWEN_SCRAMBLED_SOBOL_SEQUENCE;
+
+//
+// Static Inline Functions
+//
+
+static
+inline
+uint32_t
+ReverseBits(
+    _In_ uint32_t value
+    )
+{
+    value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+    value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+    value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+    value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+    return (value >> 16) | (value << 16);
+}
+
+static
+inline
+uint32_t
+NestedUniformScramble(
+    _In_ uint32_t value,
+    _In_ uint32_t seed
+    )
+{
+    value = ReverseBits(value);
+
+    value += seed;
+    value ^= value * 0x6C50B47Cu;
+    value ^= value * 0xB82F1E52u;
+    value ^= value * 0xC7AFE638u;
+    value ^= value * 0x8D22F6E6u;
+
+    return ReverseBits(value);
+}
+
+static
+inline
+uint32_t
+OwenScrambledSobolSample(
+    _In_ uint32_t seed,
+    _In_ uint32_t pixel,
+    _In_ uint32_t sample,
+    _In_ unsigned dimension
+    )
+{
+    uint32_t key[2] = { pixel, dimension >> 1 };
+    uint32_t hashes[4];
+    MurmurHash3_x86_128(key, sizeof(key), seed, hashes);
+
+    uint32_t shuffled_sample = NestedUniformScramble(sample, hashes[0]);
+
+    const unsigned *matrix =
+        sobol_single_matrices + (dimension & 1) * SOBOL_SINGLE_SIZE;
+
+    uint32_t value = 0;
+    for (size_t column = 0;
+         shuffled_sample;
+         shuffled_sample >>= 1, column += 1)
+    {
+        if (shuffled_sample & 1)
+        {
+            value ^= matrix[column];
+        }
+    }
+
+    return NestedUniformScramble(value, hashes[1 + (dimension & 1)]);
+}
+
+static
+inline
+double_t
+OwenScrambledSobolSequenceNext(
+    _Inout_ POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence
+    )
+{
+    uint32_t pixel = (uint32_t)(sobol_sequence->index >> 32);
+    uint32_t sample = (uint32_t)sobol_sequence->index;
+
+    uint32_t bits = OwenScrambledSobolSample(sobol_sequence->seed,
+                                             pixel,
+                                             sample,
+                                             sobol_sequence->dimension);
+
+    double_t value = (double_t)bits * (1.0 / (1ULL << 32));
+
+    if (sobol_sequence->dimension == 0)
+    {
+        uint32_t column = pixel % sobol_sequence->num_columns;
+        value = ((double_t)column + value) /
+                (double_t)sobol_sequence->num_columns;
+    }
+    else if (sobol_sequence->dimension == 1)
+    {
+        uint32_t row = pixel / sobol_sequence->num_columns;
+        value = ((double_t)row + value) / (double_t)sobol_sequence->num_rows;
+    }
+
+    sobol_sequence->dimension += 1;
+
+    return value;
+}
+
+//
+// Static Functions
+//
+
+static
+ISTATUS
+OwenScrambledSobolSequencePermute(
+    _Inout_ void *context,
+    _In_ PRANDOM rng
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    size_t seed;
+    ISTATUS status = RandomGenerateIndex(rng, UINT32_MAX, &seed);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    sobol_sequence->seed = (uint32_t)seed;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceComputeIndex(
+    _In_ void *context,
+    _In_ size_t column,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows,
+    _In_ uint32_t sample,
+    _In_ uint32_t num_samples,
+    _Out_ uint64_t *index
+    )
+{
+    if (UINT32_MAX < num_columns)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (UINT32_MAX < num_rows)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if ((uint64_t)UINT32_MAX < (uint64_t)num_columns * (uint64_t)num_rows - 1)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_00;
+    }
+
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    //
+    // Only the image dimensions are recorded here. They are needed to map
+    // the first two dimensions into the pixel and do not depend on which
+    // pixel or sample is being computed.
+    //
+
+    sobol_sequence->num_columns = (uint32_t)num_columns;
+    sobol_sequence->num_rows = (uint32_t)num_rows;
+
+    uint64_t pixel = (uint64_t)row * (uint64_t)num_columns + (uint64_t)column;
+    *index = (pixel << 32) | (uint64_t)sample;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceStart(
+    _In_ void *context,
+    _In_ uint64_t index
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    sobol_sequence->index = index;
+    sobol_sequence->dimension = 0;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceNextFloat(
+    _In_ void *context,
+    _Out_ float_t *value
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    *value = (float_t)OwenScrambledSobolSequenceNext(sobol_sequence);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceNextDouble(
+    _In_ void *context,
+    _Out_ double_t *value
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    *value = OwenScrambledSobolSequenceNext(sobol_sequence);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceNextFloats(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    for (size_t i = 0; i < num_values; i++)
+    {
+        values[i] = (float_t)OwenScrambledSobolSequenceNext(sobol_sequence);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceNextDoubles(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    )
+{
+    POWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence =
+        (POWEN_SCRAMBLED_SOBOL_SEQUENCE)context;
+
+    for (size_t i = 0; i < num_values; i++)
+    {
+        values[i] = OwenScrambledSobolSequenceNext(sobol_sequence);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+OwenScrambledSobolSequenceDuplicate(
+    _In_ const void *context,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *duplicate
+    );
+
+//
+// Static Data
+//
+
+static const LOW_DISCREPANCY_SEQUENCE_VTABLE owen_scrambled_sobol_sequence_vtable = {
+    OwenScrambledSobolSequencePermute,
+    OwenScrambledSobolSequenceComputeIndex,
+    OwenScrambledSobolSequenceStart,
+    OwenScrambledSobolSequenceNextFloat,
+    OwenScrambledSobolSequenceNextDouble,
+    OwenScrambledSobolSequenceDuplicate,
+    NULL,
+    OwenScrambledSobolSequenceNextFloats,
+    OwenScrambledSobolSequenceNextDoubles
+};
+
+//
+// Static Functions
+//
+
+static
+ISTATUS
+OwenScrambledSobolSequenceDuplicate(
+    _In_ const void *context,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *duplicate
+    )
+{
+    ISTATUS status =
+        LowDiscrepancySequenceAllocate(&owen_scrambled_sobol_sequence_vtable,
+                                       context,
+                                       sizeof(OWEN_SCRAMBLED_SOBOL_SEQUENCE),
+                                       alignof(OWEN_SCRAMBLED_SOBOL_SEQUENCE),
+                                       duplicate);
+
+    return status;
+}
+
+//
+// Functions
+//
+
+ISTATUS
+OwenScrambledSobolSequenceAllocate(
+    _In_ uint32_t seed,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *sequence
+    )
+{
+    if (sequence == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    OWEN_SCRAMBLED_SOBOL_SEQUENCE sobol_sequence;
+    sobol_sequence.index = 0;
+    sobol_sequence.seed = seed;
+    sobol_sequence.num_columns = 1;
+    sobol_sequence.num_rows = 1;
+    sobol_sequence.dimension = 0;
+
+    ISTATUS status =
+        LowDiscrepancySequenceAllocate(&owen_scrambled_sobol_sequence_vtable,
+                                       &sobol_sequence,
+                                       sizeof(OWEN_SCRAMBLED_SOBOL_SEQUENCE),
+                                       alignof(OWEN_SCRAMBLED_SOBOL_SEQUENCE),
+                                       sequence);
+
+    return status;
+}
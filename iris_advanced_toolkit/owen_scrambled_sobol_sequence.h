@@ -0,0 +1,40 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    owen_scrambled_sobol_sequence.h
+
+Abstract:
+
+    Creates a hash based Owen scrambled Sobol sequence. The value of each
+    dimension is a pure function of the pixel, sample index, dimension, and
+    seed so the sequence does not carry any per-pixel state.
+
+--*/
+
+#ifndef _IRIS_ADVANCED_TOOLKIT_OWEN_SCRAMBLED_SOBOL_SEQUENCE_
+#define _IRIS_ADVANCED_TOOLKIT_OWEN_SCRAMBLED_SOBOL_SEQUENCE_
+
+#include "iris_advanced_toolkit/low_discrepancy_sequence.h"
+
+#if __cplusplus 
+extern "C" {
+#endif // __cplusplus
+
+//
+// Functions
+//
+
+ISTATUS
+OwenScrambledSobolSequenceAllocate(
+    _In_ uint32_t seed,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *sequence
+    );
+
+#if __cplusplus 
+}
+#endif // __cplusplus
+
+#endif // _IRIS_ADVANCED_TOOLKIT_OWEN_SCRAMBLED_SOBOL_SEQUENCE_
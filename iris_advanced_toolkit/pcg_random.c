@@ -15,7 +15,6 @@ Abstract:
 #include <stdalign.h>
 
 #include "iris_advanced_toolkit/pcg_random.h"
-#include "pcg_basic.h"
 
 //
 // Types
@@ -40,17 +39,32 @@ PermutedCongruentialRandomGenerateFloat(
 {
     PPCG_RANDOM pcg_random = (PPCG_RANDOM)context;
 
-    union {
-        uint32_t as_int;
-        float as_float;
-    } int_to_float;
+    *result = PermutedCongruentialRandomStateGenerateFloat(&pcg_random->state,
+                                                           minimum,
+                                                           maximum);
 
-    int_to_float.as_int = pcg32_random_r(&pcg_random->state);
-    int_to_float.as_int &= 0x7FFFFF;
-    int_to_float.as_int |= 0x3F800000;
-    int_to_float.as_float -= 1.0f;
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+PermutedCongruentialRandomGenerateFloats(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    PPCG_RANDOM pcg_random = (PPCG_RANDOM)context;
 
-    *result = minimum + (maximum - minimum) * (float_t)int_to_float.as_float;
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i] =
+            PermutedCongruentialRandomStateGenerateFloat(&pcg_random->state,
+                                                         minimum,
+                                                         maximum);
+    }
 
     return ISTATUS_SUCCESS;
 }
@@ -108,7 +122,8 @@ static const RANDOM_VTABLE pcg_vtable = {
     PermutedCongruentialRandomGenerateFloat,
     PermutedCongruentialRandomGenerateIndex,
     PermutedCongruentialRandomReplicate,
-    NULL
+    NULL,
+    PermutedCongruentialRandomGenerateFloats
 };
 
 //
@@ -137,4 +152,39 @@ PermutedCongruentialRandomAllocate(
                                     rng);
 
     return status;
+}
+
+ISTATUS
+PermutedCongruentialRandomGetState(
+    _In_ PRANDOM rng,
+    _Outptr_result_maybenull_ pcg32_random_t **state
+    )
+{
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (state == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    void *context;
+    ISTATUS status = RandomGetContext(rng, &pcg_vtable, &context);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (context == NULL)
+    {
+        *state = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    *state = &((PPCG_RANDOM)context)->state;
+
+    return ISTATUS_SUCCESS;
 }
\ No newline at end of file
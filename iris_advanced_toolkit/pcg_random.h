@@ -16,11 +16,66 @@ Abstract:
 #define _IRIS_ADVANCED_TOOLKIT_PCG_RANDOM_
 
 #include "iris_advanced/iris_advanced.h"
+#include "pcg_basic.h"
 
 #if __cplusplus 
 extern "C" {
 #endif // __cplusplus
 
+//
+// Inline Functions
+//
+// These perform the same steps as pcg32_random_r and may be used directly on
+// the state returned by PermutedCongruentialRandomGetState to avoid
+// dispatching through the RANDOM vtable. Results are identical to those
+// returned by RandomGenerateFloat on the same generator.
+//
+
+static
+inline
+uint32_t
+PermutedCongruentialRandomStateNext(
+    _Inout_ pcg32_random_t *state
+    )
+{
+    assert(state != NULL);
+
+    uint64_t old_state = state->state;
+    state->state = old_state * 6364136223846793005ULL + state->inc;
+
+    uint32_t xorshifted = (uint32_t)(((old_state >> 18u) ^ old_state) >> 27u);
+    uint32_t rotation = (uint32_t)(old_state >> 59u);
+
+    return (xorshifted >> rotation) | (xorshifted << ((-rotation) & 31));
+}
+
+static
+inline
+float_t
+PermutedCongruentialRandomStateGenerateFloat(
+    _Inout_ pcg32_random_t *state,
+    _In_ float_t minimum,
+    _In_ float_t maximum
+    )
+{
+    assert(state != NULL);
+    assert(isfinite(minimum));
+    assert(isfinite(maximum));
+    assert(minimum <= maximum);
+
+    union {
+        uint32_t as_int;
+        float as_float;
+    } int_to_float;
+
+    int_to_float.as_int = PermutedCongruentialRandomStateNext(state);
+    int_to_float.as_int &= 0x7FFFFF;
+    int_to_float.as_int |= 0x3F800000;
+    int_to_float.as_float -= 1.0f;
+
+    return minimum + (maximum - minimum) * (float_t)int_to_float.as_float;
+}
+
 //
 // Functions
 //
@@ -32,6 +87,12 @@ PermutedCongruentialRandomAllocate(
     _Out_ PRANDOM *rng
     );
 
+ISTATUS
+PermutedCongruentialRandomGetState(
+    _In_ PRANDOM rng,
+    _Outptr_result_maybenull_ pcg32_random_t **state
+    );
+
 #if __cplusplus 
 }
 #endif // __cplusplus
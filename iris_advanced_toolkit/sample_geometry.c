@@ -91,7 +91,7 @@ SampleHemisphereWithCosineWeighting(
     float_t radius = sqrt(radius_squared);
 
     float_t sin_theta, cos_theta;
-    SinCos(theta, &sin_theta, &cos_theta);
+    ShadingSinCos(theta, &sin_theta, &cos_theta);
 
     float_t x = radius * cos_theta;
     float_t y = radius * sin_theta;
@@ -146,7 +146,7 @@ SampleHemisphereUniformly(
     float_t radius = sqrt((float_t)1.0 - z * z);
 
     float_t sin_theta, cos_theta;
-    SinCos(theta, &sin_theta, &cos_theta);
+    ShadingSinCos(theta, &sin_theta, &cos_theta);
 
     float_t x = radius * cos_theta;
     float_t y = radius * sin_theta;
@@ -198,7 +198,7 @@ SampleSphereUniformly(
     float_t r = sqrt(IMax((float_t)0.0, radius * radius - z * z));
 
     float_t sin_phi, cos_phi;
-    SinCos(phi, &sin_phi, &cos_phi);
+    ShadingSinCos(phi, &sin_phi, &cos_phi);
 
     float_t x = r * cos_phi;
     float_t y = r * sin_phi;
@@ -19,6 +19,12 @@ Abstract:
 #include "third_party/gruenschloss/single/sobol.h"
 #include "third_party/pbrt-v3/sobolmatrices.h"
 
+//
+// Defines
+//
+
+#define SOBOL_CACHED_DIMENSIONS 32
+
 //
 // Types
 //
@@ -31,6 +37,10 @@ typedef struct _SOBOL_SEQUENCE {
     unsigned num_columns;
     unsigned num_rows;
     unsigned dimension;
+    unsigned long long single_indices[SOBOL_CACHED_DIMENSIONS];
+    unsigned single_values[SOBOL_CACHED_DIMENSIONS];
+    unsigned long long double_indices[SOBOL_CACHED_DIMENSIONS];
+    unsigned long long double_values[SOBOL_CACHED_DIMENSIONS];
 } SOBOL_SEQUENCE, *PSOBOL_SEQUENCE;
 
 //
@@ -142,6 +152,161 @@ SobolSequenceIndex(
     return sample_index_base ^ transformed_image_sample_index;
 }
 
+//
+// The first SOBOL_CACHED_DIMENSIONS dimensions of the sequence remember the
+// last index they were evaluated at. Since the generator matrices are linear
+// over GF(2), moving from one index to another only requires XORing in the
+// matrix columns for the bits that differ between the two indices. When
+// indices are visited in Gray-code order this is a single XOR per dimension.
+//
+
+static
+inline
+unsigned
+SobolSequenceSingleValue(
+    _Inout_ PSOBOL_SEQUENCE sobol_sequence,
+    _In_ unsigned dimension
+    )
+{
+    assert(dimension < SOBOL_SINGLE_NUM_DIMENSIONS);
+
+    unsigned long long bits = sobol_sequence->index;
+    unsigned value = SOBOL_SINGLE_DEFAULT_SCRAMBLE;
+
+    if (dimension < SOBOL_CACHED_DIMENSIONS)
+    {
+        unsigned long long delta =
+            bits ^ sobol_sequence->single_indices[dimension];
+
+        if (delta < bits)
+        {
+            bits = delta;
+            value = sobol_sequence->single_values[dimension];
+        }
+    }
+
+    const unsigned *matrix =
+        sobol_single_matrices + dimension * SOBOL_SINGLE_SIZE;
+    for (size_t column = 0; bits; bits >>= 1, column += 1)
+    {
+        if (bits & 1)
+        {
+            value ^= matrix[column];
+        }
+    }
+
+    if (dimension < SOBOL_CACHED_DIMENSIONS)
+    {
+        sobol_sequence->single_indices[dimension] = sobol_sequence->index;
+        sobol_sequence->single_values[dimension] = value;
+    }
+
+    return value;
+}
+
+static
+inline
+unsigned long long
+SobolSequenceDoubleValue(
+    _Inout_ PSOBOL_SEQUENCE sobol_sequence,
+    _In_ unsigned dimension
+    )
+{
+    assert(dimension < SOBOL_DOUBLE_NUM_DIMENSIONS);
+
+    unsigned long long bits = sobol_sequence->index;
+    unsigned long long value =
+        SOBOL_DOUBLE_DEFAULT_SCRAMBLE & ~-(1ULL << SOBOL_DOUBLE_SIZE);
+
+    if (dimension < SOBOL_CACHED_DIMENSIONS)
+    {
+        unsigned long long delta =
+            bits ^ sobol_sequence->double_indices[dimension];
+
+        if (delta < bits)
+        {
+            bits = delta;
+            value = sobol_sequence->double_values[dimension];
+        }
+    }
+
+    const unsigned long long *matrix =
+        sobol_double_matrices + dimension * SOBOL_DOUBLE_SIZE;
+    for (size_t column = 0; bits; bits >>= 1, column += 1)
+    {
+        if (bits & 1)
+        {
+            value ^= matrix[column];
+        }
+    }
+
+    if (dimension < SOBOL_CACHED_DIMENSIONS)
+    {
+        sobol_sequence->double_indices[dimension] = sobol_sequence->index;
+        sobol_sequence->double_values[dimension] = value;
+    }
+
+    return value;
+}
+
+static
+inline
+double_t
+SobolSequenceNextDoubleInline(
+    _Inout_ PSOBOL_SEQUENCE sobol_sequence
+    )
+{
+    assert(sobol_sequence->dimension < SOBOL_DOUBLE_NUM_DIMENSIONS);
+
+    unsigned long long bits =
+        SobolSequenceDoubleValue(sobol_sequence, sobol_sequence->dimension);
+    double_t value = bits * (1.0 / (1ULL << SOBOL_DOUBLE_SIZE));
+
+    sobol_sequence->dimension += 1;
+
+    if (sobol_sequence->dimension == 1)
+    {
+        value *= sobol_sequence->to_first_dimension;
+    }
+    else if (sobol_sequence->dimension == 2)
+    {
+        value *= sobol_sequence->to_second_dimension;
+    }
+
+    return value;
+}
+
+static
+inline
+float_t
+SobolSequenceNextFloatInline(
+    _Inout_ PSOBOL_SEQUENCE sobol_sequence
+    )
+{
+#if FLT_EVAL_METHOD == 0
+    assert(sobol_sequence->dimension < SOBOL_SINGLE_NUM_DIMENSIONS);
+
+    unsigned bits =
+        SobolSequenceSingleValue(sobol_sequence, sobol_sequence->dimension);
+    float_t value = bits * (1.f / (1ULL << 32));
+
+    sobol_sequence->dimension += 1;
+
+    if (sobol_sequence->dimension == 1)
+    {
+        value *= sobol_sequence->to_first_dimension;
+    }
+    else if (sobol_sequence->dimension == 2)
+    {
+        value *= sobol_sequence->to_second_dimension;
+    }
+
+    return value;
+#else
+    return (float_t)SobolSequenceNextDoubleInline(sobol_sequence);
+#endif
+}
+
 //
 // Static Functions
 //
@@ -220,32 +385,13 @@ SobolSequenceNextFloat(
     )
 {
     PSOBOL_SEQUENCE sobol_sequence = (PSOBOL_SEQUENCE)context;
- 
-#if FLT_EVAL_METHOD == 0
-    *value = sobol_single_sample(sobol_sequence->index,
-                                 sobol_sequence->dimension,
-                                 SOBOL_SINGLE_DEFAULT_SCRAMBLE);
-#else
-    *value = sobol_double_sample(sobol_sequence->index,
-                                 sobol_sequence->dimension,
-                                 SOBOL_DOUBLE_DEFAULT_SCRAMBLE);
-#endif
 
-    sobol_sequence->dimension += 1;
-
-    if (sobol_sequence->dimension > 2)
+    if (SOBOL_SINGLE_NUM_DIMENSIONS <= sobol_sequence->dimension)
     {
-        return ISTATUS_SUCCESS;
+        return ISTATUS_OUT_OF_ENTROPY;
     }
 
-    if (sobol_sequence->dimension == 1)
-    {
-        *value *= sobol_sequence->to_first_dimension;
-    }
-    else if (sobol_sequence->dimension == 2)
-    {
-        *value *= sobol_sequence->to_second_dimension;
-    }
+    *value = SobolSequenceNextFloatInline(sobol_sequence);
 
     return ISTATUS_SUCCESS;
 }
@@ -259,24 +405,57 @@ SobolSequenceNextDouble(
 {
     PSOBOL_SEQUENCE sobol_sequence = (PSOBOL_SEQUENCE)context;
 
-    *value = sobol_double_sample(sobol_sequence->index,
-                                 sobol_sequence->dimension,
-                                 SOBOL_DOUBLE_DEFAULT_SCRAMBLE);
+    if (SOBOL_DOUBLE_NUM_DIMENSIONS <= sobol_sequence->dimension)
+    {
+        return ISTATUS_OUT_OF_ENTROPY;
+    }
 
-    sobol_sequence->dimension += 1;
+    *value = SobolSequenceNextDoubleInline(sobol_sequence);
 
-    if (sobol_sequence->dimension > 2)
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+SobolSequenceNextFloats(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    )
+{
+    PSOBOL_SEQUENCE sobol_sequence = (PSOBOL_SEQUENCE)context;
+
+    if (SOBOL_SINGLE_NUM_DIMENSIONS - sobol_sequence->dimension < num_values)
     {
-        return ISTATUS_SUCCESS;
+        return ISTATUS_OUT_OF_ENTROPY;
     }
 
-    if (sobol_sequence->dimension == 1)
+    for (size_t i = 0; i < num_values; i++)
     {
-        *value *= sobol_sequence->to_first_dimension;
+        values[i] = SobolSequenceNextFloatInline(sobol_sequence);
     }
-    else if (sobol_sequence->dimension == 2)
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+SobolSequenceNextDoubles(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    )
+{
+    PSOBOL_SEQUENCE sobol_sequence = (PSOBOL_SEQUENCE)context;
+
+    if (SOBOL_DOUBLE_NUM_DIMENSIONS - sobol_sequence->dimension < num_values)
+    {
+        return ISTATUS_OUT_OF_ENTROPY;
+    }
+
+    for (size_t i = 0; i < num_values; i++)
     {
-        *value *= sobol_sequence->to_second_dimension;
+        values[i] = SobolSequenceNextDoubleInline(sobol_sequence);
     }
 
     return ISTATUS_SUCCESS;
@@ -300,7 +479,9 @@ static const LOW_DISCREPANCY_SEQUENCE_VTABLE sobol_sequence_vtable = {
     SobolSequenceNextFloat,
     SobolSequenceNextDouble,
     SobolSequenceDuplicate,
-    NULL
+    NULL,
+    SobolSequenceNextFloats,
+    SobolSequenceNextDoubles
 };
 
 //
@@ -346,6 +527,15 @@ SobolSequenceAllocate(
     sobol_sequence.index = 0;
     sobol_sequence.dimension = 0;
 
+    for (size_t i = 0; i < SOBOL_CACHED_DIMENSIONS; i++)
+    {
+        sobol_sequence.single_indices[i] = 0;
+        sobol_sequence.single_values[i] = SOBOL_SINGLE_DEFAULT_SCRAMBLE;
+        sobol_sequence.double_indices[i] = 0;
+        sobol_sequence.double_values[i] =
+            SOBOL_DOUBLE_DEFAULT_SCRAMBLE & ~-(1ULL << SOBOL_DOUBLE_SIZE);
+    }
+
     ISTATUS status = LowDiscrepancySequenceAllocate(&sobol_sequence_vtable,
                                                     &sobol_sequence,
                                                     sizeof(SOBOL_SEQUENCE),
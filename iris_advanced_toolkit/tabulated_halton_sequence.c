@@ -0,0 +1,612 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    tabulated_halton_sequence.c
+
+Abstract:
+
+    Implements a Halton sequence which evaluates its radical inverses from
+    precomputed Faure digit permutation tables. The points generated are
+    identical to those of the Halton sequence in halton_sequence.c; however,
+    every dimension is evaluated by the same loop over a per-dimension table
+    instead of by a dedicated routine for each prime base.
+
+    Consecutive dimensions are evaluated together in groups of lanes with no
+    data dependencies between them so that batched requests can be
+    vectorized.
+
+    The tables are built once, on first allocation, and are shared by every
+    sequence for the lifetime of the process.
+
+--*/
+
+#include <stdalign.h>
+#include <threads.h>
+
+#include "iris_advanced_toolkit/halton_enumerator_internal.h"
+#include "iris_advanced_toolkit/tabulated_halton_sequence.h"
+
+//
+// Defines
+//
+
+#define HALTON_NUM_DIMENSIONS 256
+#define HALTON_MAX_TABLE_SIZE 500
+#define HALTON_NUM_PERMUTATIONS 193329
+#define HALTON_LANES 8
+
+//
+// Types
+//
+
+typedef struct _HALTON_TABLES {
+    uint16_t permutations[HALTON_NUM_PERMUTATIONS];
+    uint32_t offsets[HALTON_NUM_DIMENSIONS];
+    uint32_t sizes[HALTON_NUM_DIMENSIONS];
+    uint32_t num_chunks[HALTON_NUM_DIMENSIONS];
+    uint32_t multipliers[HALTON_NUM_DIMENSIONS];
+    float scales[HALTON_NUM_DIMENSIONS];
+} HALTON_TABLES, *PHALTON_TABLES;
+
+typedef const HALTON_TABLES *PCHALTON_TABLES;
+
+typedef struct _TABULATED_HALTON_SEQUENCE {
+    PCHALTON_TABLES halton_tables;
+    HALTON_ENUMERATOR enumerator;
+    unsigned index;
+    unsigned dimension;
+} TABULATED_HALTON_SEQUENCE, *PTABULATED_HALTON_SEQUENCE;
+
+//
+// Static Variables
+//
+
+static HALTON_TABLES halton_tables;
+static once_flag halton_tables_once = ONCE_FLAG_INIT;
+
+//
+// Static Functions
+//
+
+//
+// The Faure permutation of a base is derived from the permutation of the
+// previous base if the base is odd or from the permutation of half the base
+// if it is even. Only a few levels of recursion are needed to reach one of
+// the identity permutations of bases one through three.
+//
+
+static
+uint32_t
+FaurePermutation(
+    _In_ uint32_t base,
+    _In_ uint32_t digit
+    )
+{
+    assert(digit < base);
+
+    if (base <= 3)
+    {
+        return digit;
+    }
+
+    uint32_t half = base / 2;
+    if (base & 1)
+    {
+        if (digit == half)
+        {
+            return half;
+        }
+
+        uint32_t permuted =
+            FaurePermutation(base - 1, digit - (half < digit));
+
+        return permuted + (half <= permuted);
+    }
+
+    if (digit < half)
+    {
+        return 2 * FaurePermutation(half, digit);
+    }
+
+    return 2 * FaurePermutation(half, digit - half) + 1;
+}
+
+static
+void
+HaltonTablesInitialize(
+    void
+    )
+{
+    PHALTON_TABLES tables = &halton_tables;
+
+    //
+    // Dimension zero is base two and is evaluated with a bit reversal instead
+    // of with a table.
+    //
+
+    tables->offsets[0] = 0;
+    tables->sizes[0] = 0;
+    tables->num_chunks[0] = 0;
+    tables->multipliers[0] = 0;
+    tables->scales[0] = 0.0f;
+
+    uint32_t bases[HALTON_NUM_DIMENSIONS];
+    bases[0] = 2;
+
+    size_t num_permutations = 0;
+    uint32_t candidate = 3;
+    for (size_t dimension = 1; dimension < HALTON_NUM_DIMENSIONS; dimension++)
+    {
+        bool is_prime;
+        do
+        {
+            is_prime = true;
+            for (size_t i = 0; i < dimension; i++)
+            {
+                if (candidate % bases[i] == 0)
+                {
+                    is_prime = false;
+                    break;
+                }
+            }
+
+            candidate += 2;
+        } while (!is_prime);
+
+        uint32_t base = candidate - 2;
+        bases[dimension] = base;
+
+        //
+        // Each table entry covers as many digits as fit in a table of at most
+        // HALTON_MAX_TABLE_SIZE entries and the table is applied as many times
+        // as fit in 32 bits.
+        //
+
+        uint32_t size = base;
+        while (size * base <= HALTON_MAX_TABLE_SIZE)
+        {
+            size *= base;
+        }
+
+        uint64_t range = size;
+        uint32_t num_chunks = 1;
+        while (range * size <= UINT32_MAX)
+        {
+            range *= size;
+            num_chunks += 1;
+        }
+
+        tables->offsets[dimension] = num_permutations;
+        tables->sizes[dimension] = size;
+        tables->num_chunks[dimension] = num_chunks;
+        tables->multipliers[dimension] = (uint32_t)(UINT32_MAX / size + 1);
+        tables->scales[dimension] = (float)(0x1.fffffcp-1 / (double)range);
+
+        num_permutations += size;
+    }
+
+    assert(num_permutations == HALTON_NUM_PERMUTATIONS);
+
+    //
+    // Each table maps a group of digits to the permuted digits in reverse
+    // order, which allows a radical inverse to be evaluated one table lookup
+    // per group of digits instead of one per digit.
+    //
+
+    for (size_t dimension = 1; dimension < HALTON_NUM_DIMENSIONS; dimension++)
+    {
+        uint32_t base = bases[dimension];
+        uint16_t *permutation =
+            tables->permutations + tables->offsets[dimension];
+
+        for (uint32_t i = 0; i < tables->sizes[dimension]; i++)
+        {
+            uint32_t digits = i;
+            uint32_t inverted = 0;
+            for (uint32_t j = 1; j < tables->sizes[dimension]; j *= base)
+            {
+                inverted = inverted * base +
+                           FaurePermutation(base, digits % base);
+                digits /= base;
+            }
+
+            permutation[i] = inverted;
+        }
+    }
+}
+
+static
+inline
+float
+TabulatedHaltonSequenceBaseTwo(
+    _In_ uint32_t index
+    )
+{
+    index = ((index >> 1) & 0x55555555u) | ((index & 0x55555555u) << 1);
+    index = ((index >> 2) & 0x33333333u) | ((index & 0x33333333u) << 2);
+    index = ((index >> 4) & 0x0F0F0F0Fu) | ((index & 0x0F0F0F0Fu) << 4);
+    index = ((index >> 8) & 0x00FF00FFu) | ((index & 0x00FF00FFu) << 8);
+    index = (index >> 16) | (index << 16);
+
+    return (float)(index >> 9) * 0x1p-23f;
+}
+
+static
+inline
+void
+TabulatedHaltonSequenceEvaluateLanes(
+    _In_ PCHALTON_TABLES tables,
+    _In_ uint32_t index,
+    _In_ size_t first_dimension,
+    _In_range_(1, HALTON_LANES) size_t num_lanes,
+    _Out_writes_(num_lanes) float *values
+    )
+{
+    assert(first_dimension != 0);
+    assert(first_dimension + num_lanes <= HALTON_NUM_DIMENSIONS);
+    assert(num_lanes <= HALTON_LANES);
+
+    const uint32_t *sizes = tables->sizes + first_dimension;
+    const uint32_t *offsets = tables->offsets + first_dimension;
+    const uint32_t *num_chunks = tables->num_chunks + first_dimension;
+    const uint32_t *multipliers = tables->multipliers + first_dimension;
+
+    uint32_t remaining[HALTON_LANES];
+    uint32_t results[HALTON_LANES];
+    uint32_t max_chunks = 0;
+    for (size_t lane = 0; lane < num_lanes; lane++)
+    {
+        remaining[lane] = index;
+        results[lane] = 0;
+        if (max_chunks < num_chunks[lane])
+        {
+            max_chunks = num_chunks[lane];
+        }
+    }
+
+    for (uint32_t chunk = 0; chunk < max_chunks; chunk++)
+    {
+        for (size_t lane = 0; lane < num_lanes; lane++)
+        {
+            //
+            // The quotient computed from the multiplier is at most one greater
+            // than the exact quotient, in which case the digit wraps around
+            // and is corrected for below.
+            //
+
+            uint64_t product = (uint64_t)remaining[lane] * multipliers[lane];
+            uint32_t quotient = (uint32_t)(product >> 32);
+            uint32_t digit = remaining[lane] - quotient * sizes[lane];
+
+            uint32_t borrow = (sizes[lane] <= digit);
+            quotient -= borrow;
+            digit += borrow * sizes[lane];
+
+            uint32_t permuted = tables->permutations[offsets[lane] + digit];
+            uint32_t next = results[lane] * sizes[lane] + permuted;
+
+            results[lane] = (chunk < num_chunks[lane]) ? next : results[lane];
+            remaining[lane] = quotient;
+        }
+    }
+
+    const float *scales = tables->scales + first_dimension;
+    for (size_t lane = 0; lane < num_lanes; lane++)
+    {
+        values[lane] = (float)results[lane] * scales[lane];
+    }
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceNextValues(
+    _Inout_ PTABULATED_HALTON_SEQUENCE halton_sequence,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float *values
+    )
+{
+    size_t dimension = halton_sequence->dimension;
+
+    if (HALTON_NUM_DIMENSIONS - dimension < num_values)
+    {
+        return ISTATUS_OUT_OF_ENTROPY;
+    }
+
+    size_t i = 0;
+    if (dimension == 0 && num_values != 0)
+    {
+        values[0] = TabulatedHaltonSequenceBaseTwo(halton_sequence->index);
+        i = 1;
+    }
+
+    while (i < num_values)
+    {
+        size_t num_lanes = num_values - i;
+        if (HALTON_LANES < num_lanes)
+        {
+            num_lanes = HALTON_LANES;
+        }
+
+        TabulatedHaltonSequenceEvaluateLanes(halton_sequence->halton_tables,
+                                             halton_sequence->index,
+                                             dimension + i,
+                                             num_lanes,
+                                             values + i);
+
+        i += num_lanes;
+    }
+
+    for (i = 0; dimension + i < 2 && i < num_values; i++)
+    {
+        values[i] = HaltonEnumeratorScale(&halton_sequence->enumerator,
+                                          dimension + i,
+                                          values[i]);
+    }
+
+    halton_sequence->dimension += num_values;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceComputeIndex(
+    _In_ void *context,
+    _In_ size_t column,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows,
+    _In_ uint32_t sample,
+    _In_ uint32_t num_samples,
+    _Out_ uint64_t *index
+    )
+{
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    ISTATUS status = HaltonEnumeratorComputeIndex(&halton_sequence->enumerator,
+                                                  column,
+                                                  num_columns,
+                                                  row,
+                                                  num_rows,
+                                                  sample,
+                                                  index);
+
+    return status;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceStart(
+    _In_ void *context,
+    _In_ uint64_t index
+    )
+{
+    if (UINT32_MAX < index)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    halton_sequence->index = index;
+    halton_sequence->dimension = 0;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceNextFloat(
+    _In_ void *context,
+    _Out_ float_t *value
+    )
+{
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    float as_float;
+    ISTATUS status = TabulatedHaltonSequenceNextValues(halton_sequence,
+                                                       1,
+                                                       &as_float);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *value = as_float;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceNextDouble(
+    _In_ void *context,
+    _Out_ double_t *value
+    )
+{
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    float as_float;
+    ISTATUS status = TabulatedHaltonSequenceNextValues(halton_sequence,
+                                                       1,
+                                                       &as_float);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *value = as_float;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceNextFloats(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) float_t *values
+    )
+{
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    if (HALTON_NUM_DIMENSIONS - halton_sequence->dimension < num_values)
+    {
+        return ISTATUS_OUT_OF_ENTROPY;
+    }
+
+    float as_floats[HALTON_LANES];
+    for (size_t i = 0; i < num_values; i += HALTON_LANES)
+    {
+        size_t num_lanes = num_values - i;
+        if (HALTON_LANES < num_lanes)
+        {
+            num_lanes = HALTON_LANES;
+        }
+
+        ISTATUS status = TabulatedHaltonSequenceNextValues(halton_sequence,
+                                                           num_lanes,
+                                                           as_floats);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        for (size_t j = 0; j < num_lanes; j++)
+        {
+            values[i + j] = as_floats[j];
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceNextDoubles(
+    _In_ void *context,
+    _In_ size_t num_values,
+    _Out_writes_(num_values) double_t *values
+    )
+{
+    PTABULATED_HALTON_SEQUENCE halton_sequence =
+        (PTABULATED_HALTON_SEQUENCE)context;
+
+    if (HALTON_NUM_DIMENSIONS - halton_sequence->dimension < num_values)
+    {
+        return ISTATUS_OUT_OF_ENTROPY;
+    }
+
+    float as_floats[HALTON_LANES];
+    for (size_t i = 0; i < num_values; i += HALTON_LANES)
+    {
+        size_t num_lanes = num_values - i;
+        if (HALTON_LANES < num_lanes)
+        {
+            num_lanes = HALTON_LANES;
+        }
+
+        ISTATUS status = TabulatedHaltonSequenceNextValues(halton_sequence,
+                                                           num_lanes,
+                                                           as_floats);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        for (size_t j = 0; j < num_lanes; j++)
+        {
+            values[i + j] = as_floats[j];
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+TabulatedHaltonSequenceDuplicate(
+    _In_ const void *context,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *duplicate
+    );
+
+//
+// Static Data
+//
+
+static const LOW_DISCREPANCY_SEQUENCE_VTABLE tabulated_halton_sequence_vtable = {
+    NULL,
+    TabulatedHaltonSequenceComputeIndex,
+    TabulatedHaltonSequenceStart,
+    TabulatedHaltonSequenceNextFloat,
+    TabulatedHaltonSequenceNextDouble,
+    TabulatedHaltonSequenceDuplicate,
+    NULL,
+    TabulatedHaltonSequenceNextFloats,
+    TabulatedHaltonSequenceNextDoubles
+};
+
+//
+// Static Functions
+//
+
+static
+ISTATUS
+TabulatedHaltonSequenceDuplicate(
+    _In_ const void *context,
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *duplicate
+    )
+{
+    ISTATUS status =
+        LowDiscrepancySequenceAllocate(&tabulated_halton_sequence_vtable,
+                                       context,
+                                       sizeof(TABULATED_HALTON_SEQUENCE),
+                                       alignof(TABULATED_HALTON_SEQUENCE),
+                                       duplicate);
+
+    return status;
+}
+
+//
+// Functions
+//
+
+ISTATUS
+TabulatedHaltonSequenceAllocate(
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *sequence
+    )
+{
+    if (sequence == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    call_once(&halton_tables_once, HaltonTablesInitialize);
+
+    TABULATED_HALTON_SEQUENCE halton_sequence;
+    halton_sequence.halton_tables = &halton_tables;
+    HaltonEnumeratorInitialize(&halton_sequence.enumerator);
+    halton_sequence.index = 0;
+    halton_sequence.dimension = 0;
+
+    ISTATUS status =
+        LowDiscrepancySequenceAllocate(&tabulated_halton_sequence_vtable,
+                                       &halton_sequence,
+                                       sizeof(TABULATED_HALTON_SEQUENCE),
+                                       alignof(TABULATED_HALTON_SEQUENCE),
+                                       sequence);
+
+    return status;
+}
\ No newline at end of file
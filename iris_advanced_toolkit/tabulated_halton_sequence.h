@@ -0,0 +1,38 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    tabulated_halton_sequence.h
+
+Abstract:
+
+    Creates a Halton sequence evaluated from precomputed digit permutation
+    tables.
+
+--*/
+
+#ifndef _IRIS_ADVANCED_TOOLKIT_TABULATED_HALTON_SEQUENCE_
+#define _IRIS_ADVANCED_TOOLKIT_TABULATED_HALTON_SEQUENCE_
+
+#include "iris_advanced_toolkit/low_discrepancy_sequence.h"
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//
+// Functions
+//
+
+ISTATUS
+TabulatedHaltonSequenceAllocate(
+    _Out_ PLOW_DISCREPANCY_SEQUENCE *sequence
+    );
+
+#if __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _IRIS_ADVANCED_TOOLKIT_TABULATED_HALTON_SEQUENCE_
\ No newline at end of file
@@ -153,6 +153,8 @@ CameraAllocate(
     (*camera)->lens_delta_u = lens_max_u - lens_min_u;
     (*camera)->lens_min_v = lens_min_v;
     (*camera)->lens_delta_v = lens_max_v - lens_max_v;
+    (*camera)->shutter_open = (float_t)0.0;
+    (*camera)->shutter_delta = (float_t)0.0;
 
     if (data_size != 0)
     {
@@ -162,6 +164,39 @@ CameraAllocate(
     return ISTATUS_SUCCESS;
 }
 
+ISTATUS
+CameraSetShutter(
+    _Inout_ PCAMERA camera,
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close
+    )
+{
+    if (camera == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(shutter_open))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (!isfinite(shutter_close))
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (shutter_close < shutter_open)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_00;
+    }
+
+    camera->shutter_open = shutter_open;
+    camera->shutter_delta = shutter_close - shutter_open;
+
+    return ISTATUS_SUCCESS;
+}
+
 void
 CameraFree(
     _In_opt_ _Post_invalid_ PCAMERA camera
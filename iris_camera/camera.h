@@ -11,6 +11,9 @@ Abstract:
     Generates the ray to be traced from UV coordinates on the image and
     lens. The generated ray is not guaranteed to be normalized.
 
+    If the shutter is open for a nonzero interval, each sample is assigned a
+    time uniformly distributed over the interval.
+
 --*/
 
 #ifndef _IRIS_CAMERA_CAMERA_
@@ -46,6 +49,13 @@ CameraAllocate(
     _Out_ PCAMERA *camera
     );
 
+ISTATUS
+CameraSetShutter(
+    _Inout_ PCAMERA camera,
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close
+    );
+
 void
 CameraFree(
     _In_opt_ _Post_invalid_ PCAMERA camera
@@ -32,6 +32,8 @@ struct _CAMERA {
     float_t lens_delta_u;
     float_t lens_min_v;
     float_t lens_delta_v;
+    float_t shutter_open;
+    float_t shutter_delta;
 };
 
 //
@@ -49,6 +51,7 @@ CameraGenerateRayDifferential(
     _In_ float_t lens_v,
     _In_ float_t dimage_u_dx,
     _In_ float_t dimage_v_dy,
+    _In_ float_t time,
     _Out_ PRAY_DIFFERENTIAL ray_differential
     )
 {
@@ -59,6 +62,7 @@ CameraGenerateRayDifferential(
     assert((float_t)0.0 <= lens_v && lens_v <= (float_t)1.0);
     assert(isfinite(dimage_u_dx));
     assert(isfinite(dimage_v_dy));
+    assert(isfinite(time));
     assert(ray_differential != NULL);
 
     image_u = fma(image_u, camera->image_delta_u, camera->image_min_u);
@@ -111,6 +115,7 @@ CameraGenerateRayDifferential(
     }
 
     *ray_differential = RayDifferentialCreate(ray, rx, ry);
+    *ray_differential = RayDifferentialSetTime(*ray_differential, time);
 
     return ISTATUS_SUCCESS;
 }
@@ -137,6 +137,39 @@ ImageSamplerNext(
     return status;
 }
 
+static
+inline
+bool
+ImageSamplerHasDimensions(
+    _In_ const struct _IMAGE_SAMPLER *image_sampler
+    )
+{
+    assert(image_sampler != NULL);
+
+    return image_sampler->vtable->dimensions_routine != NULL;
+}
+
+static
+inline
+ISTATUS
+ImageSamplerDimensions(
+    _In_ struct _IMAGE_SAMPLER *image_sampler,
+    _In_ size_t num_dimensions,
+    _Out_writes_(num_dimensions) float_t *dimensions
+    )
+{
+    assert(image_sampler != NULL);
+    assert(image_sampler->vtable->dimensions_routine != NULL);
+    assert(dimensions != NULL);
+
+    ISTATUS status =
+        image_sampler->vtable->dimensions_routine(image_sampler->data,
+                                                  num_dimensions,
+                                                  dimensions);
+
+    return status;
+}
+
 static
 inline
 ISTATUS
@@ -63,6 +63,14 @@ ISTATUS
     _Out_opt_ float_t *lens_v
     );
 
+typedef
+ISTATUS
+(*PIMAGE_SAMPLER_DIMENSIONS_ROUTINE)(
+    _In_ void *context,
+    _In_ size_t num_dimensions,
+    _Out_writes_(num_dimensions) float_t *dimensions
+    );
+
 typedef
 ISTATUS
 (*PIMAGE_SAMPLER_DUPLICATE_ROUTINE)(
@@ -75,6 +83,7 @@ typedef struct _IMAGE_SAMPLER_VTABLE {
     PIMAGE_SAMPLER_RANDOM_ROUTINE random_routine;
     PIMAGE_SAMPLER_START_ROUTINE start_routine;
     PIMAGE_SAMPLER_NEXT_ROUTINE next_routine;
+    PIMAGE_SAMPLER_DIMENSIONS_ROUTINE dimensions_routine;
     PIMAGE_SAMPLER_DUPLICATE_ROUTINE duplicate_routine;
     PFREE_ROUTINE free_routine;
 } IMAGE_SAMPLER_VTABLE, *PIMAGE_SAMPLER_VTABLE;
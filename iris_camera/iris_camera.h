@@ -25,6 +25,7 @@ extern "C" {
 #include "iris_camera/framebuffer.h"
 #include "iris_camera/image_sampler.h"
 #include "iris_camera/render.h"
+#include "iris_camera/sample_dimensions.h"
 #include "iris_camera/sample_tracer.h"
 
 #if __cplusplus 
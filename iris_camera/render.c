@@ -23,6 +23,7 @@ Abstract:
 #include "iris_camera/image_sampler_internal.h"
 #include "iris_camera/progress_reporter_internal.h"
 #include "iris_camera/render.h"
+#include "iris_camera/sample_dimensions_random.h"
 #include "iris_camera/sample_tracer_internal.h"
 
 //
@@ -30,6 +31,7 @@ Abstract:
 //
 
 #define CHUNK_SIZE 32
+#define BATCH_SIZE 256
 
 //
 // Types
@@ -39,7 +41,11 @@ typedef struct _RENDER_THREAD_LOCAL_STATE {
     PSAMPLE_TRACER sample_tracer;
     PIMAGE_SAMPLER image_sampler;
     PRANDOM image_sampler_rng;
+    PRANDOM dimensions_rng;
     PPROGRESS_REPORTER progress_reporter;
+    _Field_size_opt_(BATCH_SIZE) PRAY_DIFFERENTIAL batch_rays;
+    _Field_size_opt_(BATCH_SIZE) PCOLOR3 batch_colors;
+    _Field_size_opt_(BATCH_SIZE) size_t *batch_pixels;
     ISTATUS status;
 } RENDER_THREAD_LOCAL_STATE, *PRENDER_THREAD_LOCAL_STATE;
 
@@ -77,16 +83,63 @@ IrisCameraFreeThreadState(
     assert(num_threads != 0);
     assert(thread_state != NULL);
 
+    RandomFree(thread_state[0].local.dimensions_rng);
+
+    for (size_t i = 0; i < num_threads; i++)
+    {
+        free(thread_state[i].local.batch_rays);
+        free(thread_state[i].local.batch_colors);
+        free(thread_state[i].local.batch_pixels);
+    }
+
     for (size_t i = 1; i < num_threads; i++)
     {
         SampleTracerFree(thread_state[i].local.sample_tracer);
         ImageSamplerFree(thread_state[i].local.image_sampler);
+        RandomFree(thread_state[i].local.dimensions_rng);
         RandomFree(thread_state[i].local.image_sampler_rng);
     }
 
     free(thread_state);
 }
 
+static
+ISTATUS
+IrisCameraAllocateBatchBuffers(
+    _Inout_ PRENDER_THREAD_LOCAL_STATE local_state
+    )
+{
+    assert(local_state != NULL);
+
+    //
+    // Samplers which own their random number generator expect it to stay in
+    // step with the samples they produce, so only samples drawn from the
+    // per-chunk generators are deferred into batches.
+    //
+
+    if (!SampleTracerSupportsBatches(local_state->sample_tracer) ||
+        local_state->image_sampler_rng != NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    local_state->batch_rays =
+        (PRAY_DIFFERENTIAL)calloc(BATCH_SIZE, sizeof(RAY_DIFFERENTIAL));
+    local_state->batch_colors =
+        (PCOLOR3)calloc(BATCH_SIZE, sizeof(COLOR3));
+    local_state->batch_pixels =
+        (size_t*)calloc(BATCH_SIZE, sizeof(size_t));
+
+    if (local_state->batch_rays == NULL ||
+        local_state->batch_colors == NULL ||
+        local_state->batch_pixels == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 ISTATUS
 IrisCameraAllocateThreadState(
@@ -125,6 +178,27 @@ IrisCameraAllocateThreadState(
     result[0].local.image_sampler_rng = rng;
     result[0].local.progress_reporter = progress_reporter;
 
+    if (rng != NULL && ImageSamplerHasDimensions(image_sampler))
+    {
+        status = SampleDimensionsRandomAllocate(
+            rng,
+            &result[0].local.dimensions_rng);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            IrisCameraFreeThreadState(num_threads, result);
+            return status;
+        }
+    }
+
+    status = IrisCameraAllocateBatchBuffers(&result[0].local);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        IrisCameraFreeThreadState(num_threads, result);
+        return status;
+    }
+
     for (size_t i = 1; i < num_threads; i++)
     {
         result[i].shared = shared_state;
@@ -157,6 +231,28 @@ IrisCameraAllocateThreadState(
             return status;
         }
 
+        if (result[i].local.image_sampler_rng != NULL &&
+            ImageSamplerHasDimensions(result[i].local.image_sampler))
+        {
+            status = SampleDimensionsRandomAllocate(
+                result[i].local.image_sampler_rng,
+                &result[i].local.dimensions_rng);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                IrisCameraFreeThreadState(num_threads, result);
+                return status;
+            }
+        }
+
+        status = IrisCameraAllocateBatchBuffers(&result[i].local);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            IrisCameraFreeThreadState(num_threads, result);
+            return status;
+        }
+
         result[i].local.status = ISTATUS_SUCCESS;
     }
 
@@ -167,36 +263,17 @@ IrisCameraAllocateThreadState(
 
 static
 ISTATUS
-IrisCameraRenderPixel(
+IrisCameraGenerateSample(
     _Inout_ PRENDER_THREAD_CONTEXT context,
     _Inout_ PIMAGE_SAMPLER image_sampler,
     _Inout_ PRANDOM rng,
-    _In_ size_t column,
-    _In_ size_t num_columns,
-    _In_ size_t row,
-    _In_ size_t num_rows
+    _Out_ PRAY_DIFFERENTIAL world_ray_differential
     )
 {
     assert(context != NULL);
     assert(image_sampler != NULL);
     assert(rng != NULL);
-    assert(num_columns != 0);
-    assert(column < num_columns);
-    assert(num_rows != 0);
-    assert(row < num_rows);
-
-    uint32_t num_samples;
-    ISTATUS status = ImageSamplerStart(image_sampler,
-                                       column,
-                                       num_columns,
-                                       num_rows - row - 1,
-                                       num_rows,
-                                       &num_samples);
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
+    assert(world_ray_differential != NULL);
 
     float_t lens_u = context->shared->camera->lens_min_u;
     float_t lens_v = context->shared->camera->lens_min_v;
@@ -221,53 +298,158 @@ IrisCameraRenderPixel(
         lens_v_ptr = NULL;
     }
 
-    COLOR3 pixel_color = ColorCreateBlack();
-    for (uint32_t index = 0; index < num_samples; index++)
+    //
+    // The image sampler is given the RNG wrapped by the sample dimensions
+    // RNG, if any, so that it never reads the values the previous sample
+    // left over in its last slot.
+    //
+
+    PRANDOM image_sampler_rng;
+    if (context->local.dimensions_rng != NULL)
     {
-        bool cancelled = atomic_load_explicit(&context->shared->cancelled,
-                                              memory_order_relaxed);
+        image_sampler_rng = context->local.image_sampler_rng;
+    }
+    else
+    {
+        image_sampler_rng = rng;
+    }
 
-        if (cancelled)
+    float_t pixel_u, pixel_v, dpixel_u, dpixel_v;
+    ISTATUS status = ImageSamplerNext(image_sampler,
+                                      image_sampler_rng,
+                                      &pixel_u,
+                                      &pixel_v,
+                                      &dpixel_u,
+                                      &dpixel_v,
+                                      lens_u_ptr,
+                                      lens_v_ptr);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (context->local.dimensions_rng != NULL)
+    {
+        status = SampleDimensionsRandomPrepare(context->local.dimensions_rng,
+                                               image_sampler);
+
+        if (status != ISTATUS_SUCCESS)
         {
-            return ISTATUS_SUCCESS;
+            return status;
+        }
+    }
+
+    float_t time = context->shared->camera->shutter_open;
+    if (context->shared->camera->shutter_delta != (float_t)0.0)
+    {
+        if (context->local.dimensions_rng != NULL)
+        {
+            status =
+                SampleDimensionsRandomSelectTime(context->local.dimensions_rng);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
         }
 
-        float_t pixel_u, pixel_v, dpixel_u, dpixel_v;
-        status = ImageSamplerNext(image_sampler,
-                                  rng,
-                                  &pixel_u,
-                                  &pixel_v,
-                                  &dpixel_u,
-                                  &dpixel_v,
-                                  lens_u_ptr,
-                                  lens_v_ptr);
+        float_t shutter_u;
+        status = RandomGenerateFloat(rng,
+                                     (float_t)0.0,
+                                     (float_t)1.0,
+                                     &shutter_u);
 
         if (status != ISTATUS_SUCCESS)
         {
             return status;
         }
 
-        RAY_DIFFERENTIAL camera_ray_differential;
-        status = CameraGenerateRayDifferential(context->shared->camera,
-                                               pixel_u,
-                                               pixel_v,
-                                               lens_u,
-                                               lens_v,
-                                               dpixel_u,
-                                               dpixel_v,
-                                               &camera_ray_differential);
+        time = fma(shutter_u,
+                   context->shared->camera->shutter_delta,
+                   context->shared->camera->shutter_open);
+    }
+
+    RAY_DIFFERENTIAL camera_ray_differential;
+    status = CameraGenerateRayDifferential(context->shared->camera,
+                                           pixel_u,
+                                           pixel_v,
+                                           lens_u,
+                                           lens_v,
+                                           dpixel_u,
+                                           dpixel_v,
+                                           time,
+                                           &camera_ray_differential);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *world_ray_differential =
+        RayDifferentialMatrixMultiply(context->shared->camera_to_world,
+                                      camera_ray_differential);
+    *world_ray_differential =
+        RayDifferentialNormalize(*world_ray_differential);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+IrisCameraRenderPixel(
+    _Inout_ PRENDER_THREAD_CONTEXT context,
+    _Inout_ PIMAGE_SAMPLER image_sampler,
+    _Inout_ PRANDOM rng,
+    _In_ size_t column,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows
+    )
+{
+    assert(context != NULL);
+    assert(image_sampler != NULL);
+    assert(rng != NULL);
+    assert(num_columns != 0);
+    assert(column < num_columns);
+    assert(num_rows != 0);
+    assert(row < num_rows);
+
+    uint32_t num_samples;
+    ISTATUS status = ImageSamplerStart(image_sampler,
+                                       column,
+                                       num_columns,
+                                       num_rows - row - 1,
+                                       num_rows,
+                                       &num_samples);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    COLOR3 pixel_color = ColorCreateBlack();
+    for (uint32_t index = 0; index < num_samples; index++)
+    {
+        bool cancelled = atomic_load_explicit(&context->shared->cancelled,
+                                              memory_order_relaxed);
+
+        if (cancelled)
+        {
+            return ISTATUS_SUCCESS;
+        }
+
+        RAY_DIFFERENTIAL world_ray_differential;
+        status = IrisCameraGenerateSample(context,
+                                          image_sampler,
+                                          rng,
+                                          &world_ray_differential);
 
         if (status != ISTATUS_SUCCESS)
         {
             return status;
         }
 
-        RAY_DIFFERENTIAL world_ray_differential =
-            RayDifferentialMatrixMultiply(context->shared->camera_to_world,
-                                          camera_ray_differential);
-        world_ray_differential =
-            RayDifferentialNormalize(world_ray_differential);
-
         COLOR3 sample_color;
         status = SampleTracerTrace(context->local.sample_tracer,
                                    &world_ray_differential,
@@ -299,6 +481,212 @@ IrisCameraRenderPixel(
     return ISTATUS_SUCCESS;
 }
 
+static
+ISTATUS
+IrisCameraTraceBatch(
+    _Inout_ PRENDER_THREAD_CONTEXT context,
+    _Inout_ PRANDOM rng,
+    _In_ size_t num_rays,
+    _Inout_updates_(CHUNK_SIZE) COLOR3 pixel_colors[CHUNK_SIZE]
+    )
+{
+    assert(context != NULL);
+    assert(rng != NULL);
+    assert(num_rays <= BATCH_SIZE);
+    assert(pixel_colors != NULL);
+
+    if (num_rays == 0)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = SampleTracerTraceBatch(context->local.sample_tracer,
+                                            context->local.batch_rays,
+                                            num_rays,
+                                            rng,
+                                            context->shared->epsilon,
+                                            context->local.batch_colors);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t i = 0; i < num_rays; i++)
+    {
+        size_t pixel = context->local.batch_pixels[i];
+        COLOR3 sample_color = context->local.batch_colors[i];
+        pixel_colors[pixel] = ColorAdd(pixel_colors[pixel],
+                                       sample_color,
+                                       sample_color.color_space);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+IrisCameraRenderChunkBatched(
+    _Inout_ PRENDER_THREAD_CONTEXT context,
+    _Inout_ PIMAGE_SAMPLER image_sampler,
+    _Inout_ PRANDOM rng,
+    _In_ size_t column_base,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows
+    )
+{
+    assert(context != NULL);
+    assert(image_sampler != NULL);
+    assert(rng != NULL);
+    assert(num_columns != 0);
+    assert(column_base < num_columns);
+    assert(num_rows != 0);
+    assert(row < num_rows);
+
+    size_t chunk_columns = num_columns - column_base;
+    if (CHUNK_SIZE < chunk_columns)
+    {
+        chunk_columns = CHUNK_SIZE;
+    }
+
+    COLOR3 pixel_colors[CHUNK_SIZE];
+    uint32_t pixel_samples[CHUNK_SIZE];
+    size_t num_rays = 0;
+
+    for (size_t pixel = 0; pixel < chunk_columns; pixel++)
+    {
+        ISTATUS status = ImageSamplerStart(image_sampler,
+                                           column_base + pixel,
+                                           num_columns,
+                                           num_rows - row - 1,
+                                           num_rows,
+                                           pixel_samples + pixel);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        pixel_colors[pixel] = ColorCreateBlack();
+
+        for (uint32_t index = 0; index < pixel_samples[pixel]; index++)
+        {
+            bool cancelled = atomic_load_explicit(&context->shared->cancelled,
+                                                  memory_order_relaxed);
+
+            if (cancelled)
+            {
+                return ISTATUS_SUCCESS;
+            }
+
+            status = IrisCameraGenerateSample(context,
+                                              image_sampler,
+                                              rng,
+                                              context->local.batch_rays + num_rays);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            context->local.batch_pixels[num_rays] = pixel;
+            num_rays += 1;
+
+            if (num_rays == BATCH_SIZE)
+            {
+                status = IrisCameraTraceBatch(context,
+                                              rng,
+                                              num_rays,
+                                              pixel_colors);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                num_rays = 0;
+            }
+        }
+    }
+
+    ISTATUS status = IrisCameraTraceBatch(context,
+                                          rng,
+                                          num_rays,
+                                          pixel_colors);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t pixel = 0; pixel < chunk_columns; pixel++)
+    {
+        COLOR3 pixel_color = pixel_colors[pixel];
+
+        if (pixel_samples[pixel] != 0)
+        {
+            float sample_weight = 1.0f / (float)pixel_samples[pixel];
+            pixel_color = ColorScale(pixel_color, sample_weight);
+        }
+
+        FramebufferSetPixel(context->shared->framebuffer,
+                            column_base + pixel,
+                            row,
+                            pixel_color);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+IrisCameraRenderChunk(
+    _Inout_ PRENDER_THREAD_CONTEXT context,
+    _Inout_ PIMAGE_SAMPLER image_sampler,
+    _Inout_ PRANDOM rng,
+    _In_ size_t column_base,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows
+    )
+{
+    assert(context != NULL);
+
+    if (context->local.batch_rays != NULL)
+    {
+        ISTATUS status = IrisCameraRenderChunkBatched(context,
+                                                      image_sampler,
+                                                      rng,
+                                                      column_base,
+                                                      num_columns,
+                                                      row,
+                                                      num_rows);
+
+        return status;
+    }
+
+    for (size_t column = column_base;
+         column < column_base + CHUNK_SIZE && column < num_columns;
+         column++)
+    {
+        ISTATUS status = IrisCameraRenderPixel(context,
+                                               image_sampler,
+                                               rng,
+                                               column,
+                                               num_columns,
+                                               row,
+                                               num_rows);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 int
 IrisCameraRenderThread(
@@ -342,7 +730,11 @@ IrisCameraRenderThread(
         }
 
         PRANDOM rng;
-        if (thread_context->local.image_sampler_rng != NULL)
+        if (thread_context->local.dimensions_rng != NULL)
+        {
+            rng = thread_context->local.dimensions_rng;
+        }
+        else if (thread_context->local.image_sampler_rng != NULL)
         {
             rng = thread_context->local.image_sampler_rng;
         }
@@ -354,31 +746,27 @@ IrisCameraRenderThread(
         size_t row = chunk % num_rows;
         size_t column_chunk = chunk / num_rows;
         size_t column_base = column_chunk * CHUNK_SIZE;
-        for (size_t column = column_base;
-             column < column_base + CHUNK_SIZE && column < num_columns;
-             column++)
-        {
-            ISTATUS status = IrisCameraRenderPixel(thread_context,
-                                                   thread_context->local.image_sampler,
-                                                   rng,
-                                                   column,
-                                                   num_columns,
-                                                   row,
-                                                   num_rows);
 
-            if (status != ISTATUS_SUCCESS)
-            {
-                atomic_store(&thread_context->shared->cancelled, true);
-                thread_context->local.status = status;
-                return 0;
-            }
+        ISTATUS status = IrisCameraRenderChunk(thread_context,
+                                               thread_context->local.image_sampler,
+                                               rng,
+                                               column_base,
+                                               num_columns,
+                                               row,
+                                               num_rows);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            atomic_store(&thread_context->shared->cancelled, true);
+            thread_context->local.status = status;
+            return 0;
         }
 
         if (progress_reporter != NULL)
         {
-            ISTATUS status = ProgressReporterReport(progress_reporter,
-                                                    num_pixels,
-                                                    chunk * pixels_per_chunk);
+            status = ProgressReporterReport(progress_reporter,
+                                            num_pixels,
+                                            chunk * pixels_per_chunk);
 
             if (status != ISTATUS_SUCCESS)
             {
@@ -11,6 +11,12 @@ Abstract:
     Renders an image using the camera, pixel sampler, and sampler, rng, and
     framebuffer specified.
 
+    When the sample tracer supports batches, the samples of each chunk of
+    pixels are traced together in batches. Image samplers which provide their
+    own random number generator, such as the low discrepancy image sampler,
+    must stay in step with the samples they produce and so are always traced
+    one sample at a time.
+
 --*/
 
 #ifndef _IRIS_CAMERA_RENDER_
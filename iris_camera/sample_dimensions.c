@@ -0,0 +1,371 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    sample_dimensions.c
+
+Abstract:
+
+    Reserves fixed dimensions of each image sample for the decisions made at
+    each bounce of a path.
+
+--*/
+
+#include <stdalign.h>
+
+#include "iris_camera/sample_dimensions_random.h"
+
+//
+// Types
+//
+
+typedef struct _SAMPLE_DIMENSIONS_RANDOM {
+    PRANDOM rng;
+    bool owned;
+    bool prepared;
+    size_t next;
+    size_t end;
+    float_t dimensions[SAMPLE_DIMENSIONS_PER_SAMPLE];
+} SAMPLE_DIMENSIONS_RANDOM, *PSAMPLE_DIMENSIONS_RANDOM;
+
+//
+// Static Variables
+//
+
+static const size_t sample_dimensions_slot_offsets[] = {
+    0,
+    SAMPLE_DIMENSIONS_BSDF,
+    SAMPLE_DIMENSIONS_BSDF + SAMPLE_DIMENSIONS_LIGHT_SELECTION
+};
+
+static const size_t sample_dimensions_slot_sizes[] = {
+    SAMPLE_DIMENSIONS_BSDF,
+    SAMPLE_DIMENSIONS_LIGHT_SELECTION,
+    SAMPLE_DIMENSIONS_LIGHT_POSITION
+};
+
+//
+// Static Functions
+//
+
+static
+ISTATUS
+SampleDimensionsRandomGenerateFloat(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _Out_range_(minimum, maximum) float_t *result
+    )
+{
+    PSAMPLE_DIMENSIONS_RANDOM random = (PSAMPLE_DIMENSIONS_RANDOM)context;
+
+    if (random->next == random->end)
+    {
+        ISTATUS status = RandomGenerateFloat(random->rng,
+                                             minimum,
+                                             maximum,
+                                             result);
+
+        return status;
+    }
+
+    float_t value = random->dimensions[random->next++];
+
+    value *= (maximum - minimum);
+    value += minimum;
+
+    *result = IMin(IMax(minimum, value), maximum);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+SampleDimensionsRandomGenerateFloats(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    PSAMPLE_DIMENSIONS_RANDOM random = (PSAMPLE_DIMENSIONS_RANDOM)context;
+
+    size_t i = 0;
+    for (; i < count && random->next != random->end; i++)
+    {
+        float_t value = random->dimensions[random->next++];
+
+        value *= (maximum - minimum);
+        value += minimum;
+
+        results[i] = IMin(IMax(minimum, value), maximum);
+    }
+
+    if (i == count)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = RandomGenerateFloats(random->rng,
+                                          minimum,
+                                          maximum,
+                                          count - i,
+                                          results + i);
+
+    return status;
+}
+
+static
+ISTATUS
+SampleDimensionsRandomGenerateIndex(
+    _In_ void *context,
+    _In_ size_t upper_bound,
+    _Out_range_(0, upper_bound - 1) size_t *result
+    )
+{
+    PSAMPLE_DIMENSIONS_RANDOM random = (PSAMPLE_DIMENSIONS_RANDOM)context;
+
+    if (random->next == random->end)
+    {
+        ISTATUS status = RandomGenerateIndex(random->rng,
+                                             upper_bound,
+                                             result);
+
+        return status;
+    }
+
+    float_t value = random->dimensions[random->next++];
+
+    *result = (size_t)(value * (float_t)upper_bound);
+    if (upper_bound <= *result)
+    {
+        *result = upper_bound - 1;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+SampleDimensionsRandomReplicate(
+    _In_opt_ void *context,
+    _Out_ PRANDOM *replica
+    );
+
+static
+void
+SampleDimensionsRandomFree(
+    _In_opt_ _Post_invalid_ void *context
+    )
+{
+    PSAMPLE_DIMENSIONS_RANDOM random = (PSAMPLE_DIMENSIONS_RANDOM)context;
+
+    if (random->owned)
+    {
+        RandomFree(random->rng);
+    }
+}
+
+//
+// Static Variables
+//
+
+static const RANDOM_VTABLE sample_dimensions_random_vtable = {
+    SampleDimensionsRandomGenerateFloat,
+    SampleDimensionsRandomGenerateIndex,
+    SampleDimensionsRandomReplicate,
+    SampleDimensionsRandomFree,
+    SampleDimensionsRandomGenerateFloats
+};
+
+//
+// Static Functions
+//
+
+static
+ISTATUS
+SampleDimensionsRandomReplicate(
+    _In_opt_ void *context,
+    _Out_ PRANDOM *replica
+    )
+{
+    PSAMPLE_DIMENSIONS_RANDOM random = (PSAMPLE_DIMENSIONS_RANDOM)context;
+
+    SAMPLE_DIMENSIONS_RANDOM next;
+    ISTATUS status = RandomReplicate(random->rng, &next.rng);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    next.owned = true;
+    next.prepared = false;
+    next.next = 0;
+    next.end = 0;
+
+    status = RandomAllocate(&sample_dimensions_random_vtable,
+                            &next,
+                            sizeof(SAMPLE_DIMENSIONS_RANDOM),
+                            alignof(SAMPLE_DIMENSIONS_RANDOM),
+                            replica);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        RandomFree(next.rng);
+    }
+
+    return status;
+}
+
+//
+// Functions
+//
+
+ISTATUS
+SampleDimensionsRandomAllocate(
+    _In_ PRANDOM rng,
+    _Out_ PRANDOM *dimensions_rng
+    )
+{
+    assert(rng != NULL);
+    assert(dimensions_rng != NULL);
+
+    SAMPLE_DIMENSIONS_RANDOM random;
+    random.rng = rng;
+    random.owned = false;
+    random.prepared = false;
+    random.next = 0;
+    random.end = 0;
+
+    ISTATUS status = RandomAllocate(&sample_dimensions_random_vtable,
+                                    &random,
+                                    sizeof(SAMPLE_DIMENSIONS_RANDOM),
+                                    alignof(SAMPLE_DIMENSIONS_RANDOM),
+                                    dimensions_rng);
+
+    return status;
+}
+
+ISTATUS
+SampleDimensionsRandomPrepare(
+    _Inout_ PRANDOM dimensions_rng,
+    _Inout_ struct _IMAGE_SAMPLER *image_sampler
+    )
+{
+    assert(dimensions_rng != NULL);
+    assert(image_sampler != NULL);
+
+    PSAMPLE_DIMENSIONS_RANDOM random;
+    ISTATUS status = RandomGetContext(dimensions_rng,
+                                      &sample_dimensions_random_vtable,
+                                      (void **)&random);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    assert(random != NULL);
+
+    random->prepared = false;
+    random->next = 0;
+    random->end = 0;
+
+    status = ImageSamplerDimensions(image_sampler,
+                                    SAMPLE_DIMENSIONS_PER_SAMPLE,
+                                    random->dimensions);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    random->prepared = true;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+SampleDimensionsRandomSelectTime(
+    _Inout_ PRANDOM dimensions_rng
+    )
+{
+    assert(dimensions_rng != NULL);
+
+    PSAMPLE_DIMENSIONS_RANDOM random;
+    ISTATUS status = RandomGetContext(dimensions_rng,
+                                      &sample_dimensions_random_vtable,
+                                      (void **)&random);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    assert(random != NULL);
+
+    if (!random->prepared)
+    {
+        random->next = 0;
+        random->end = 0;
+        return ISTATUS_SUCCESS;
+    }
+
+    random->next =
+        SAMPLE_DIMENSIONS_MAX_BOUNCES * SAMPLE_DIMENSIONS_PER_BOUNCE;
+    random->end = random->next + SAMPLE_DIMENSIONS_TIME;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+SampleDimensionsSelect(
+    _Inout_ PRANDOM rng,
+    _In_ size_t bounce,
+    _In_ SAMPLE_DIMENSION_SLOT slot
+    )
+{
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (slot != SAMPLE_DIMENSION_SLOT_BSDF &&
+        slot != SAMPLE_DIMENSION_SLOT_LIGHT_SELECTION &&
+        slot != SAMPLE_DIMENSION_SLOT_LIGHT_POSITION)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    PSAMPLE_DIMENSIONS_RANDOM random;
+    ISTATUS status = RandomGetContext(rng,
+                                      &sample_dimensions_random_vtable,
+                                      (void **)&random);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (random == NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    if (!random->prepared || SAMPLE_DIMENSIONS_MAX_BOUNCES <= bounce)
+    {
+        random->next = 0;
+        random->end = 0;
+        return ISTATUS_SUCCESS;
+    }
+
+    random->next = bounce * SAMPLE_DIMENSIONS_PER_BOUNCE +
+                   sample_dimensions_slot_offsets[slot];
+    random->end = random->next + sample_dimensions_slot_sizes[slot];
+
+    return ISTATUS_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    sample_dimensions.h
+
+Abstract:
+
+    Reserves fixed dimensions of each image sample for the decisions made at
+    each bounce of a path.
+
+    When the image sampler supports it, every bounce of a sample owns a slot
+    for BSDF sampling, light selection, and light position sampling. Each slot
+    is sized to the values its consumer draws: three for BSDF sampling (a lobe
+    selection and a 2D direction), one for light selection, and five for light
+    position sampling (a 2D light sample followed by the lobe selection and 2D
+    direction of the BSDF sample used for multiple importance sampling).
+
+    Selecting a slot causes the values generated by the sample's RNG to be read
+    from the dimensions precomputed for that slot. Values left over by a
+    consumer which draws fewer than its slot holds are read by the draws which
+    follow until the next slot is selected, and draws past the end of a slot
+    fall back to the RNG. Selecting a slot of a bounce at or past
+    SAMPLE_DIMENSIONS_MAX_BOUNCES causes every value to fall back to the RNG.
+    All values for RNGs which do not support sample dimensions are generated
+    normally.
+
+    After the slots of its bounces, each sample reserves one dimension for
+    the time at which its camera ray is traced, which the renderer reads
+    itself.
+
+--*/
+
+#ifndef _IRIS_CAMERA_SAMPLE_DIMENSIONS_
+#define _IRIS_CAMERA_SAMPLE_DIMENSIONS_
+
+#include "iris_advanced/iris_advanced.h"
+
+//
+// Defines
+//
+
+#define SAMPLE_DIMENSIONS_MAX_BOUNCES 8
+#define SAMPLE_DIMENSIONS_BSDF 3
+#define SAMPLE_DIMENSIONS_LIGHT_SELECTION 1
+#define SAMPLE_DIMENSIONS_LIGHT_POSITION 5
+#define SAMPLE_DIMENSIONS_PER_BOUNCE \
+    (SAMPLE_DIMENSIONS_BSDF + SAMPLE_DIMENSIONS_LIGHT_SELECTION + \
+     SAMPLE_DIMENSIONS_LIGHT_POSITION)
+#define SAMPLE_DIMENSIONS_TIME 1
+
+#define SAMPLE_DIMENSIONS_PER_SAMPLE \
+    (SAMPLE_DIMENSIONS_MAX_BOUNCES * SAMPLE_DIMENSIONS_PER_BOUNCE + \
+     SAMPLE_DIMENSIONS_TIME)
+
+//
+// Types
+//
+
+typedef enum _SAMPLE_DIMENSION_SLOT {
+    SAMPLE_DIMENSION_SLOT_BSDF = 0,
+    SAMPLE_DIMENSION_SLOT_LIGHT_SELECTION = 1,
+    SAMPLE_DIMENSION_SLOT_LIGHT_POSITION = 2
+} SAMPLE_DIMENSION_SLOT;
+
+//
+// Functions
+//
+
+ISTATUS
+SampleDimensionsSelect(
+    _Inout_ PRANDOM rng,
+    _In_ size_t bounce,
+    _In_ SAMPLE_DIMENSION_SLOT slot
+    );
+
+#endif // _IRIS_CAMERA_SAMPLE_DIMENSIONS_
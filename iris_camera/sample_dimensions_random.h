@@ -0,0 +1,43 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    sample_dimensions_random.h
+
+Abstract:
+
+    The RNG used by the renderer to serve the dimensions of an image sample
+    which are reserved by SampleDimensionsSelect.
+
+--*/
+
+#ifndef _IRIS_CAMERA_SAMPLE_DIMENSIONS_RANDOM_
+#define _IRIS_CAMERA_SAMPLE_DIMENSIONS_RANDOM_
+
+#include "iris_camera/image_sampler_internal.h"
+#include "iris_camera/sample_dimensions.h"
+
+//
+// Functions
+//
+
+ISTATUS
+SampleDimensionsRandomAllocate(
+    _In_ PRANDOM rng,
+    _Out_ PRANDOM *dimensions_rng
+    );
+
+ISTATUS
+SampleDimensionsRandomPrepare(
+    _Inout_ PRANDOM dimensions_rng,
+    _Inout_ struct _IMAGE_SAMPLER *image_sampler
+    );
+
+ISTATUS
+SampleDimensionsRandomSelectTime(
+    _Inout_ PRANDOM dimensions_rng
+    );
+
+#endif // _IRIS_CAMERA_SAMPLE_DIMENSIONS_RANDOM_
@@ -0,0 +1,548 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    sample_dimensions_test.cc
+
+Abstract:
+
+    Unit tests for sample_dimensions.c
+
+--*/
+
+extern "C" {
+#include "iris_camera/image_sampler.h"
+#include "iris_camera/render.h"
+#include "iris_camera/sample_dimensions_random.h"
+}
+
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+//
+// The fallback RNG always generates three quarters of its range while the
+// precomputed dimensions all lie in the lower half of the unit interval, so
+// every value can be traced back to where it was read from.
+//
+
+static
+ISTATUS
+FallbackGenerateFloat(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _Out_range_(minimum, maximum) float_t *result
+    )
+{
+    *result = minimum + (maximum - minimum) * (float_t)0.75;
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+FallbackGenerateFloats(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i] = minimum + (maximum - minimum) * (float_t)0.75;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+FallbackGenerateIndex(
+    _In_ void *context,
+    _In_ size_t upper_bound,
+    _Out_range_(0, upper_bound - 1) size_t *result
+    )
+{
+    *result = upper_bound - 1;
+    return ISTATUS_SUCCESS;
+}
+
+static const RANDOM_VTABLE fallback_vtable = {
+    FallbackGenerateFloat,
+    FallbackGenerateIndex,
+    nullptr,
+    nullptr,
+    FallbackGenerateFloats
+};
+
+static
+float_t
+DimensionValue(
+    _In_ size_t dimension
+    )
+{
+    return (float_t)dimension / (float_t)(2 * SAMPLE_DIMENSIONS_PER_SAMPLE);
+}
+
+static
+ISTATUS
+TestSamplerDimensions(
+    _In_ void *context,
+    _In_ size_t num_dimensions,
+    _Out_writes_(num_dimensions) float_t *dimensions
+    )
+{
+    for (size_t i = 0; i < num_dimensions; i++)
+    {
+        dimensions[i] = DimensionValue(i);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static const IMAGE_SAMPLER_VTABLE test_sampler_vtable = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    TestSamplerDimensions,
+    nullptr,
+    nullptr
+};
+
+static
+void
+AllocateTestRandom(
+    _Out_ PRANDOM *fallback,
+    _Out_ PRANDOM *dimensions_rng
+    )
+{
+    ISTATUS status = RandomAllocate(&fallback_vtable,
+                                    nullptr,
+                                    0,
+                                    0,
+                                    fallback);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = SampleDimensionsRandomAllocate(*fallback, dimensions_rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PIMAGE_SAMPLER image_sampler;
+    status = ImageSamplerAllocate(&test_sampler_vtable,
+                                  nullptr,
+                                  0,
+                                  0,
+                                  &image_sampler);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = SampleDimensionsRandomPrepare(*dimensions_rng, image_sampler);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    ImageSamplerFree(image_sampler);
+}
+
+TEST(SampleDimensionsTest, SelectErrors)
+{
+    ISTATUS status = SampleDimensionsSelect(nullptr,
+                                            0,
+                                            SAMPLE_DIMENSION_SLOT_BSDF);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00, status);
+
+    PRANDOM fallback;
+    status = RandomAllocate(&fallback_vtable, nullptr, 0, 0, &fallback);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = SampleDimensionsSelect(fallback,
+                                    0,
+                                    (SAMPLE_DIMENSION_SLOT)3);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02, status);
+
+    RandomFree(fallback);
+}
+
+TEST(SampleDimensionsTest, SelectUnsupportedRandom)
+{
+    PRANDOM fallback;
+    ISTATUS status = RandomAllocate(&fallback_vtable,
+                                    nullptr,
+                                    0,
+                                    0,
+                                    &fallback);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = SampleDimensionsSelect(fallback, 0, SAMPLE_DIMENSION_SLOT_BSDF);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t value;
+    status = RandomGenerateFloat(fallback, 0.0, 1.0, &value);
+    EXPECT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ((float_t)0.75, value);
+
+    RandomFree(fallback);
+}
+
+TEST(SampleDimensionsTest, SlotsSizedToConsumers)
+{
+    PRANDOM fallback, rng;
+    AllocateTestRandom(&fallback, &rng);
+
+    for (size_t bounce = 0; bounce < SAMPLE_DIMENSIONS_MAX_BOUNCES; bounce++)
+    {
+        size_t base = bounce * SAMPLE_DIMENSIONS_PER_BOUNCE;
+
+        ISTATUS status =
+            SampleDimensionsSelect(rng,
+                                   bounce,
+                                   SAMPLE_DIMENSION_SLOT_LIGHT_SELECTION);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        size_t index;
+        status = RandomGenerateIndex(rng, 1000, &index);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+        size_t dimension = base + SAMPLE_DIMENSIONS_BSDF;
+        EXPECT_EQ((size_t)(DimensionValue(dimension) * (float_t)1000.0),
+                  index);
+
+        status = RandomGenerateIndex(rng, 1000, &index);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+        EXPECT_EQ(999u, index);
+
+        status = SampleDimensionsSelect(rng,
+                                        bounce,
+                                        SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        float_t values[SAMPLE_DIMENSIONS_LIGHT_POSITION + 1];
+        status = RandomGenerateFloats(rng,
+                                      0.0,
+                                      1.0,
+                                      SAMPLE_DIMENSIONS_LIGHT_POSITION + 1,
+                                      values);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        dimension = base + SAMPLE_DIMENSIONS_BSDF +
+                    SAMPLE_DIMENSIONS_LIGHT_SELECTION;
+        for (size_t i = 0; i < SAMPLE_DIMENSIONS_LIGHT_POSITION; i++)
+        {
+            EXPECT_EQ(DimensionValue(dimension + i), values[i]);
+        }
+
+        EXPECT_EQ((float_t)0.75, values[SAMPLE_DIMENSIONS_LIGHT_POSITION]);
+
+        status = SampleDimensionsSelect(rng,
+                                        bounce,
+                                        SAMPLE_DIMENSION_SLOT_BSDF);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        for (size_t i = 0; i < SAMPLE_DIMENSIONS_BSDF; i++)
+        {
+            float_t value;
+            status = RandomGenerateFloat(rng, 0.0, 1.0, &value);
+            ASSERT_EQ(ISTATUS_SUCCESS, status);
+            EXPECT_EQ(DimensionValue(base + i), value);
+        }
+
+        float_t value;
+        status = RandomGenerateFloat(rng, 0.0, 1.0, &value);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+        EXPECT_EQ((float_t)0.75, value);
+    }
+
+    RandomFree(rng);
+    RandomFree(fallback);
+}
+
+TEST(SampleDimensionsTest, LeftoverValuesReadUntilNextSelect)
+{
+    PRANDOM fallback, rng;
+    AllocateTestRandom(&fallback, &rng);
+
+    ISTATUS status = SampleDimensionsSelect(rng,
+                                            1,
+                                            SAMPLE_DIMENSION_SLOT_BSDF);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t values[2];
+    status = RandomGenerateFloats(rng, 0.0, 1.0, 2, values);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    size_t base = SAMPLE_DIMENSIONS_PER_BOUNCE;
+    EXPECT_EQ(DimensionValue(base), values[0]);
+    EXPECT_EQ(DimensionValue(base + 1), values[1]);
+
+    float_t value;
+    status = RandomGenerateFloat(rng, 0.0, 1.0, &value);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(DimensionValue(base + 2), value);
+
+    status = SampleDimensionsSelect(rng,
+                                    1,
+                                    SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = SampleDimensionsSelect(rng,
+                                    SAMPLE_DIMENSIONS_MAX_BOUNCES,
+                                    SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = RandomGenerateFloat(rng, 0.0, 1.0, &value);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ((float_t)0.75, value);
+
+    RandomFree(rng);
+    RandomFree(fallback);
+}
+//
+// Renders a single pixel with an image sampler which reserves a stratum of
+// the shutter interval for each of its samples in the time dimension, while
+// every other dimension lies in the lower half of the unit interval. The
+// sample tracer leaves values over in the slot it selects, which must not be
+// read as the time of the sample which follows.
+//
+
+#define RENDER_NUM_SAMPLES 16
+
+static
+float_t
+TimeValue(
+    _In_ size_t sample
+    )
+{
+    return ((float_t)sample + (float_t)0.5) / (float_t)RENDER_NUM_SAMPLES;
+}
+
+static
+ISTATUS
+RenderSamplerRandom(
+    _In_ void *context,
+    _Out_ PRANDOM *rng
+    )
+{
+    ISTATUS status = RandomAllocate(&fallback_vtable, nullptr, 0, 0, rng);
+    return status;
+}
+
+static
+ISTATUS
+RenderSamplerStart(
+    _In_ void *context,
+    _In_ size_t column,
+    _In_ size_t num_columns,
+    _In_ size_t row,
+    _In_ size_t num_rows,
+    _Out_ uint32_t *num_samples
+    )
+{
+    *num_samples = RENDER_NUM_SAMPLES;
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+RenderSamplerNext(
+    _In_ void *context,
+    _Inout_ PRANDOM rng,
+    _Out_ float_t *pixel_u,
+    _Out_ float_t *pixel_v,
+    _Out_ float_t *dpixel_u,
+    _Out_ float_t *dpixel_v,
+    _Out_opt_ float_t *lens_u,
+    _Out_opt_ float_t *lens_v
+    )
+{
+    *pixel_u = (float_t)0.5;
+    *pixel_v = (float_t)0.5;
+    *dpixel_u = (float_t)0.0;
+    *dpixel_v = (float_t)0.0;
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+RenderSamplerDimensions(
+    _In_ void *context,
+    _In_ size_t num_dimensions,
+    _Out_writes_(num_dimensions) float_t *dimensions
+    )
+{
+    size_t *sample = (size_t*)context;
+
+    for (size_t i = 0; i < num_dimensions; i++)
+    {
+        dimensions[i] = DimensionValue(i);
+    }
+
+    size_t time_dimension =
+        SAMPLE_DIMENSIONS_MAX_BOUNCES * SAMPLE_DIMENSIONS_PER_BOUNCE;
+    dimensions[time_dimension] = TimeValue(*sample);
+    *sample += 1;
+
+    return ISTATUS_SUCCESS;
+}
+
+static const IMAGE_SAMPLER_VTABLE render_sampler_vtable = {
+    nullptr,
+    RenderSamplerRandom,
+    RenderSamplerStart,
+    RenderSamplerNext,
+    RenderSamplerDimensions,
+    nullptr,
+    nullptr
+};
+
+static
+ISTATUS
+RenderRandomReplicate(
+    _In_opt_ void *context,
+    _Out_ PRANDOM *replica
+    )
+{
+    ISTATUS status = RandomAllocate(&fallback_vtable, nullptr, 0, 0, replica);
+    return status;
+}
+
+static const RANDOM_VTABLE render_random_vtable = {
+    FallbackGenerateFloat,
+    FallbackGenerateIndex,
+    RenderRandomReplicate,
+    nullptr,
+    FallbackGenerateFloats
+};
+
+static
+ISTATUS
+RenderCameraGenerateRay(
+    _In_ const void *context,
+    _In_ float_t image_u,
+    _In_ float_t image_v,
+    _In_ float_t lens_u,
+    _In_ float_t lens_v,
+    _Out_ PRAY ray
+    )
+{
+    *ray = RayCreate(PointCreate((float_t)0.0, (float_t)0.0, (float_t)0.0),
+                     VectorCreate((float_t)0.0, (float_t)0.0, (float_t)1.0));
+    return ISTATUS_SUCCESS;
+}
+
+static const CAMERA_VTABLE render_camera_vtable = {
+    RenderCameraGenerateRay,
+    nullptr
+};
+
+static
+ISTATUS
+RenderTracerTrace(
+    _In_opt_ void *context,
+    _In_ PCRAY_DIFFERENTIAL ray_differential,
+    _In_ PRANDOM rng,
+    _In_ float_t epsilon,
+    _Out_ PCOLOR3 color
+    )
+{
+    std::vector<float_t> *times = *(std::vector<float_t>**)context;
+    times->push_back(ray_differential->time);
+
+    ISTATUS status = SampleDimensionsSelect(rng,
+                                            0,
+                                            SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    float_t value;
+    status = RandomGenerateFloat(rng, 0.0, 1.0, &value);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *color = ColorCreateBlack();
+
+    return ISTATUS_SUCCESS;
+}
+
+static const SAMPLE_TRACER_VTABLE render_tracer_vtable = {
+    RenderTracerTrace,
+    nullptr,
+    nullptr,
+    nullptr
+};
+
+TEST(SampleDimensionsTest, RenderReadsTimeFromItsDimension)
+{
+    PCAMERA camera;
+    ISTATUS status = CameraAllocate(&render_camera_vtable,
+                                    (float_t)0.0,
+                                    (float_t)1.0,
+                                    (float_t)0.0,
+                                    (float_t)1.0,
+                                    (float_t)0.0,
+                                    (float_t)0.0,
+                                    (float_t)0.0,
+                                    (float_t)0.0,
+                                    nullptr,
+                                    0,
+                                    0,
+                                    &camera);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = CameraSetShutter(camera, (float_t)0.0, (float_t)1.0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    size_t sample = 0;
+    PIMAGE_SAMPLER image_sampler;
+    status = ImageSamplerAllocate(&render_sampler_vtable,
+                                  &sample,
+                                  sizeof(size_t),
+                                  alignof(size_t),
+                                  &image_sampler);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    std::vector<float_t> times;
+    std::vector<float_t> *times_pointer = &times;
+    PSAMPLE_TRACER sample_tracer;
+    status = SampleTracerAllocate(&render_tracer_vtable,
+                                  &times_pointer,
+                                  sizeof(std::vector<float_t>*),
+                                  alignof(std::vector<float_t>*),
+                                  &sample_tracer);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PRANDOM rng;
+    status = RandomAllocate(&render_random_vtable, nullptr, 0, 0, &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PFRAMEBUFFER framebuffer;
+    status = FramebufferAllocate(1, 1, &framebuffer);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = IrisCameraRenderSingleThreaded(camera,
+                                            nullptr,
+                                            image_sampler,
+                                            sample_tracer,
+                                            rng,
+                                            framebuffer,
+                                            nullptr,
+                                            (float_t)0.0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    ASSERT_EQ((size_t)RENDER_NUM_SAMPLES, times.size());
+    for (size_t i = 0; i < RENDER_NUM_SAMPLES; i++)
+    {
+        EXPECT_EQ(TimeValue(i), times[i]);
+    }
+
+    CameraFree(camera);
+    ImageSamplerFree(image_sampler);
+    SampleTracerFree(sample_tracer);
+    RandomFree(rng);
+    FramebufferFree(framebuffer);
+}
@@ -58,6 +58,49 @@ SampleTracerTrace(
     return status;
 }
 
+static
+inline
+bool
+SampleTracerSupportsBatches(
+    _In_ const struct _SAMPLE_TRACER *tracer
+    )
+{
+    assert(tracer != NULL);
+
+    return tracer->vtable->trace_batch_routine != NULL;
+}
+
+static
+inline
+ISTATUS
+SampleTracerTraceBatch(
+    _In_ struct _SAMPLE_TRACER *tracer,
+    _In_reads_(num_rays) PCRAY_DIFFERENTIAL ray_differentials,
+    _In_ size_t num_rays,
+    _In_ PRANDOM rng,
+    _In_ float_t epsilon,
+    _Out_writes_(num_rays) PCOLOR3 colors
+    )
+{
+    assert(tracer != NULL);
+    assert(tracer->vtable->trace_batch_routine != NULL);
+    assert(ray_differentials != NULL);
+    assert(num_rays != 0);
+    assert(rng != NULL);
+    assert(isfinite(epsilon));
+    assert((float_t)0.0 <= epsilon);
+    assert(colors != NULL);
+
+    ISTATUS status = tracer->vtable->trace_batch_routine(tracer->data,
+                                                         ray_differentials,
+                                                         num_rays,
+                                                         rng,
+                                                         epsilon,
+                                                         colors);
+
+    return status;
+}
+
 static
 inline
 ISTATUS
@@ -35,6 +35,17 @@ ISTATUS
     _Out_ PCOLOR3 color
     );
 
+typedef
+ISTATUS
+(*PSAMPLE_TRACER_TRACE_BATCH_ROUTINE)(
+    _In_opt_ void *context,
+    _In_reads_(num_rays) PCRAY_DIFFERENTIAL ray_differentials,
+    _In_ size_t num_rays,
+    _In_ PRANDOM rng,
+    _In_ float_t epsilon,
+    _Out_writes_(num_rays) PCOLOR3 colors
+    );
+
 typedef
 ISTATUS
 (*PSAMPLE_TRACER_DUPLICATE)(
@@ -46,6 +57,7 @@ typedef struct _SAMPLE_TRACER_VTABLE {
     PSAMPLE_TRACER_TRACE_ROUTINE trace_routine;
     PSAMPLE_TRACER_DUPLICATE duplicate_routine;
     PFREE_ROUTINE free_routine;
+    PSAMPLE_TRACER_TRACE_BATCH_ROUTINE trace_batch_routine;
 } SAMPLE_TRACER_VTABLE, *PSAMPLE_TRACER_VTABLE;
 
 typedef const SAMPLE_TRACER_VTABLE *PCSAMPLE_TRACER_VTABLE;
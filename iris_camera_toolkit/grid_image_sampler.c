@@ -14,6 +14,7 @@ Abstract:
 
 #include <stdalign.h>
 
+#include "iris_advanced_toolkit/pcg_random.h"
 #include "iris_camera_toolkit/grid_image_sampler.h"
 
 //
@@ -49,6 +50,35 @@ typedef const GRID_IMAGE_SAMPLER *PCGRID_IMAGE_SAMPLER;
 // Static Functions
 //
 
+//
+// The renderer hands the sampler a PCG generator unless the sampler owns its
+// own, so the jitter is drawn from its state inline when it is one. The
+// values are the same as those returned through the RNG.
+//
+
+static
+inline
+ISTATUS
+GridImageSamplerGenerateFloat(
+    _Inout_opt_ pcg32_random_t *pcg_state,
+    _Inout_ PRANDOM rng,
+    _In_ float_t maximum,
+    _Out_range_(0.0, maximum) float_t *result
+    )
+{
+    if (pcg_state != NULL)
+    {
+        *result = PermutedCongruentialRandomStateGenerateFloat(pcg_state,
+                                                               (float_t)0.0,
+                                                               maximum);
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = RandomGenerateFloat(rng, (float_t)0.0, maximum, result);
+
+    return status;
+}
+
 static
 ISTATUS
 GridImageSamplerStart(
@@ -106,22 +136,35 @@ GridImageSamplerNext(
 {
     PGRID_IMAGE_SAMPLER image_sampler = (PGRID_IMAGE_SAMPLER)context;
 
+    pcg32_random_t *pcg_state = NULL;
+    if (image_sampler->jitter_pixel_samples ||
+        image_sampler->jitter_lens_samples)
+    {
+        ISTATUS status = PermutedCongruentialRandomGetState(rng, &pcg_state);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
     if (image_sampler->jitter_pixel_samples)
     {
-        ISTATUS status = RandomGenerateFloat(rng,
-                                             (float_t)0.0,
-                                             image_sampler->subpixel_u_width,
-                                             pixel_u);
+        ISTATUS status =
+            GridImageSamplerGenerateFloat(pcg_state,
+                                          rng,
+                                          image_sampler->subpixel_u_width,
+                                          pixel_u);
 
         if (status != ISTATUS_SUCCESS)
         {
             return status;
         }
 
-        status = RandomGenerateFloat(rng,
-                                     (float_t)0.0,
-                                     image_sampler->subpixel_v_width,
-                                     pixel_v);
+        status = GridImageSamplerGenerateFloat(pcg_state,
+                                               rng,
+                                               image_sampler->subpixel_v_width,
+                                               pixel_v);
 
         if (status != ISTATUS_SUCCESS)
         {
@@ -149,10 +192,11 @@ GridImageSamplerNext(
     {
         if (image_sampler->jitter_lens_samples)
         {
-            ISTATUS status = RandomGenerateFloat(rng,
-                                                (float_t)0.0,
-                                                image_sampler->sublens_u_width,
-                                                lens_u);
+            ISTATUS status =
+                GridImageSamplerGenerateFloat(pcg_state,
+                                              rng,
+                                              image_sampler->sublens_u_width,
+                                              lens_u);
 
             if (status != ISTATUS_SUCCESS)
             {
@@ -172,10 +216,11 @@ GridImageSamplerNext(
     {
         if (image_sampler->jitter_lens_samples)
         {
-            ISTATUS status = RandomGenerateFloat(rng,
-                                                (float_t)0.0,
-                                                image_sampler->sublens_v_width,
-                                                lens_v);
+            ISTATUS status =
+                GridImageSamplerGenerateFloat(pcg_state,
+                                              rng,
+                                              image_sampler->sublens_v_width,
+                                              lens_v);
 
             if (status != ISTATUS_SUCCESS)
             {
@@ -250,6 +295,7 @@ static const IMAGE_SAMPLER_VTABLE grid_image_sampler_vtable = {
     NULL,
     GridImageSamplerStart,
     GridImageSamplerNext,
+    NULL,
     GridImageSamplerDuplicate,
     NULL
 };
@@ -59,6 +59,36 @@ LowDiscrepancyRandomGenerateFloat(
     return ISTATUS_SUCCESS;
 }
 
+static
+ISTATUS
+LowDiscrepancyRandomGenerateFloats(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    PLOW_DISCREPANCY_RANDOM random = (PLOW_DISCREPANCY_RANDOM)context;
+
+    ISTATUS status = LowDiscrepancySequenceNextFloats(random->sequence,
+                                                      count,
+                                                      results);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i] *= (maximum - minimum);
+        results[i] += minimum;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 ISTATUS
 LowDiscrepancyRandomGenerateIndex(
@@ -128,7 +158,8 @@ static const RANDOM_VTABLE low_discrepancy_vtable = {
     LowDiscrepancyRandomGenerateFloat,
     LowDiscrepancyRandomGenerateIndex,
     LowDiscrepancyRandomReplicate,
-    LowDiscrepancyRandomFree
+    LowDiscrepancyRandomFree,
+    LowDiscrepancyRandomGenerateFloats
 };
 
 //
@@ -292,50 +323,53 @@ LowDiscrepancyImageSamplerNext(
         return status;
     }
 
-    double_t pixel_u_as_double;
-    status = LowDiscrepancySequenceNextDouble(image_sampler->sequence,
-                                              &pixel_u_as_double);
+    double_t pixel_uv[2];
+    status = LowDiscrepancySequenceNextDoubles(image_sampler->sequence,
+                                               2,
+                                               pixel_uv);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    *pixel_u = (float_t)pixel_u_as_double;
+    *pixel_u = (float_t)pixel_uv[0];
+    *pixel_v = (float_t)pixel_uv[1];
 
-    double_t pixel_v_as_double;
-    status = LowDiscrepancySequenceNextDouble(image_sampler->sequence,
-                                              &pixel_v_as_double);
+    *dpixel_u = image_sampler->dpixel_u;
+    *dpixel_v = image_sampler->dpixel_v;
 
-    if (status != ISTATUS_SUCCESS)
+    size_t num_lens_values = 0;
+    if (lens_u != NULL)
     {
-        return status;
+        num_lens_values += 1;
     }
 
-    *pixel_v = (float_t)pixel_v_as_double;
-
-    *dpixel_u = image_sampler->dpixel_u;
-    *dpixel_v = image_sampler->dpixel_v;
+    if (lens_v != NULL)
+    {
+        num_lens_values += 1;
+    }
 
-    if (lens_u != NULL)
+    if (num_lens_values != 0)
     {
-        status = LowDiscrepancySequenceNextFloat(image_sampler->sequence,
-                                                 lens_u);
+        float_t lens_uv[2];
+        status = LowDiscrepancySequenceNextFloats(image_sampler->sequence,
+                                                  num_lens_values,
+                                                  lens_uv);
 
         if (status != ISTATUS_SUCCESS)
         {
             return status;
         }
-    }
 
-    if (lens_v != NULL)
-    {
-        status = LowDiscrepancySequenceNextFloat(image_sampler->sequence,
-                                                 lens_v);
+        if (lens_u != NULL)
+        {
+            *lens_u = lens_uv[0];
+        }
 
-        if (status != ISTATUS_SUCCESS)
+        if (lens_v != NULL)
         {
-            return status;
+            *lens_v = lens_uv[num_lens_values - 1];
         }
     }
 
@@ -344,6 +378,23 @@ LowDiscrepancyImageSamplerNext(
     return ISTATUS_SUCCESS;
 }
 
+static
+ISTATUS
+LowDiscrepancyImageSamplerDimensions(
+    _In_ void *context,
+    _In_ size_t num_dimensions,
+    _Out_writes_(num_dimensions) float_t *dimensions
+    )
+{
+    PLOW_DISCREPANCY_IMAGE_SAMPLER image_sampler = (PLOW_DISCREPANCY_IMAGE_SAMPLER)context;
+
+    ISTATUS status = LowDiscrepancySequenceNextFloats(image_sampler->sequence,
+                                                      num_dimensions,
+                                                      dimensions);
+
+    return status;
+}
+
 static
 ISTATUS
 LowDiscrepancyImageSamplerDuplicate(
@@ -395,6 +446,7 @@ static const IMAGE_SAMPLER_VTABLE low_discrepancy_image_sampler_vtable = {
     LowDiscrepancyImageSamplerRandom,
     LowDiscrepancyImageSamplerStart,
     LowDiscrepancyImageSamplerNext,
+    LowDiscrepancyImageSamplerDimensions,
     LowDiscrepancyImageSamplerDuplicate,
     LowDiscrepancyImageSamplerFree
 };
@@ -59,7 +59,7 @@ ThinLensCameraGenerateRay(
     float_t radius = sqrt(radius_squared);
 
     float_t sin_theta, cos_theta;
-    SinCos(theta, &sin_theta, &cos_theta);
+    ShadingSinCos(theta, &sin_theta, &cos_theta);
 
     float_t lens_u = radius * cos_theta;
     float_t lens_v = radius * sin_theta;
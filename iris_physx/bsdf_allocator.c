@@ -68,21 +68,30 @@ BsdfAllocatorAllocate(
     }
 
     PBSDF bsdf_allocation;
-    void *data_allocation;
-    bool success = DynamicMemoryAllocatorAllocate(&allocator->allocator,
-                                                  NULL,
-                                                  sizeof(BSDF),
-                                                  alignof(BSDF),
-                                                  (void **)&bsdf_allocation,
-                                                  data_size,
-                                                  data_alignment,
-                                                  &data_allocation);
+    bool success = ArenaAllocatorAllocate(allocator->arena,
+                                          sizeof(BSDF),
+                                          alignof(BSDF),
+                                          (void **)&bsdf_allocation);
 
     if (!success)
     {
         return ISTATUS_ALLOCATION_FAILED;
     }
 
+    void *data_allocation = NULL;
+    if (data_size != 0)
+    {
+        success = ArenaAllocatorAllocate(allocator->arena,
+                                         data_size,
+                                         data_alignment,
+                                         &data_allocation);
+
+        if (!success)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+    }
+
     BsdfInitialize(vtable,
                    data_allocation,
                    bsdf_allocation);
@@ -15,7 +15,7 @@ Abstract:
 #ifndef _IRIS_PHYSX_BSDF_ALLOCATOR_INTERNAL_
 #define _IRIS_PHYSX_BSDF_ALLOCATOR_INTERNAL_
 
-#include "common/dynamic_allocator.h"
+#include "common/arena_allocator.h"
 #include "iris_physx/bsdf_internal.h"
 
 //
@@ -23,7 +23,7 @@ Abstract:
 //
 
 struct _BSDF_ALLOCATOR {
-    DYNAMIC_MEMORY_ALLOCATOR allocator;
+    PARENA_ALLOCATOR arena;
 };
 
 //
@@ -34,36 +34,14 @@ static
 inline
 void
 BsdfAllocatorInitialize(
-    _Out_ struct _BSDF_ALLOCATOR *allocator
+    _Out_ struct _BSDF_ALLOCATOR *allocator,
+    _In_ PARENA_ALLOCATOR arena
     )
 {
     assert(allocator != NULL);
+    assert(arena != NULL);
 
-    DynamicMemoryAllocatorInitialize(&allocator->allocator);
-}
-
-static
-inline
-void
-BsdfAllocatorClear(
-    _Inout_ struct _BSDF_ALLOCATOR *allocator
-    )
-{
-    assert(allocator != NULL);
-
-    DynamicMemoryAllocatorFreeAll(&allocator->allocator);
-}
-
-static
-inline
-void
-BsdfAllocatorDestroy(
-    _Inout_ struct _BSDF_ALLOCATOR *allocator
-    )
-{
-    assert(allocator != NULL);
-
-    DynamicMemoryAllocatorDestroy(&allocator->allocator);
+    allocator->arena = arena;
 }
 
 #endif // _IRIS_PHYSX_BSDF_ALLOCATOR_INTERNAL_
\ No newline at end of file
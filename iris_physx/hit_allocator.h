@@ -11,6 +11,10 @@ Abstract:
     Allocator for hits during Iris Physx intersection tests. See documentation
     in "iris/hit_allocator.h" for further detail.
 
+    Deferred hits are finalized by the finalize_hit_routine of the shape which
+    allocated them. ShapeHitAllocatorFinalizeHit is defined alongside the
+    shape interface in shape.c.
+
 --*/
 
 #ifndef _IRIS_PHYSX_HIT_ALLOCATOR_
@@ -29,6 +33,15 @@ typedef const SHAPE_HIT_ALLOCATOR *PCSHAPE_HIT_ALLOCATOR;
 // Functions
 //
 
+ISTATUS
+ShapeHitAllocatorFinalizeHit(
+    _In_opt_ const void *data,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    );
+
 static
 inline
 ISTATUS
@@ -87,4 +100,37 @@ ShapeHitAllocatorAllocateWithHitPoint(
     return status;
 }
 
+static
+inline
+ISTATUS
+ShapeHitAllocatorAllocateDeferred(
+    _Inout_ PSHAPE_HIT_ALLOCATOR allocator,
+    _In_opt_ PHIT next,
+    _In_ float_t distance,
+    _In_ uint32_t front_face,
+    _In_ uint32_t back_face,
+    _In_ uint32_t primitive,
+    _In_ float_t u,
+    _In_ float_t v,
+    _In_ size_t additional_data_size,
+    _In_ size_t additional_data_alignment,
+    _Out_ PHIT *hit
+    )
+{
+    ISTATUS status = HitAllocatorAllocateDeferred(allocator,
+                                                  next,
+                                                  distance,
+                                                  front_face,
+                                                  back_face,
+                                                  primitive,
+                                                  u,
+                                                  v,
+                                                  ShapeHitAllocatorFinalizeHit,
+                                                  additional_data_size,
+                                                  additional_data_alignment,
+                                                  hit);
+
+    return status;
+}
+
 #endif // _IRIS_HIT_ALLOCATOR_
\ No newline at end of file
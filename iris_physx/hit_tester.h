@@ -41,6 +41,17 @@ ShapeHitTesterFarthestHitAllowed(
     return HitTesterFarthestHitAllowed(hit_tester, distance);
 }
 
+static
+inline
+ISTATUS
+ShapeHitTesterGetTime(
+    _In_ PCSHAPE_HIT_TESTER hit_tester,
+    _Out_ float_t *time
+    )
+{
+    return HitTesterGetTime(hit_tester, time);
+}
+
 static
 inline
 ISTATUS
@@ -231,6 +242,39 @@ ShapeHitTesterTestTransformedShapeWithLimit(
     return status;
 }
 
+static
+inline
+ISTATUS
+ShapeHitTesterTestInterpolatedShapeWithLimit(
+    _Inout_ PSHAPE_HIT_TESTER hit_tester,
+    _In_ PCSHAPE shape,
+    _In_opt_ PCMATRIX model_to_world0,
+    _In_opt_ PCMATRIX model_to_world1,
+    _In_ float_t weight,
+    _Out_opt_ float_t *farthest_hit_allowed
+    )
+{
+    if (shape == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    PHIT_TESTER_TEST_GEOMETRY_ROUTINE test_routine =
+        (PHIT_TESTER_TEST_GEOMETRY_ROUTINE)((const void ***)shape)[0][0];
+    const void *context = (const void*)((const void **)shape + 2);
+    ISTATUS status =
+        HitTesterTestInterpolatedGeometryWithLimit(hit_tester,
+                                                   test_routine,
+                                                   context,
+                                                   shape,
+                                                   model_to_world0,
+                                                   model_to_world1,
+                                                   weight,
+                                                   farthest_hit_allowed);
+
+    return status;
+}
+
 static
 inline
 ISTATUS
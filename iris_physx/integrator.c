@@ -14,6 +14,7 @@ Abstract:
 
 #include <string.h>
 
+#include "common/alloc.h"
 #include "iris_physx/bsdf_allocator.h"
 #include "iris_physx/bsdf_allocator_internal.h"
 #include "iris_physx/color_integrator_internal.h"
@@ -37,6 +38,8 @@ struct _INTEGRATOR {
     PSCENE scene;
     PLIGHT_SAMPLER light_sampler;
     PCOLOR_INTEGRATOR color_integrator;
+    _Field_size_(batch_capacity) PCSPECTRUM *batch_spectra;
+    size_t batch_capacity;
     void *data;
 };
 
@@ -92,12 +95,14 @@ IntegratorIntegrateInternal(
                             scene->vtable->trace_routine,
                             scene->data,
                             epsilon,
+                            ray_differential->time,
                             scene->environment);
 
     VisibilityTesterConfigure(&integrator->visibility_tester,
                               scene->vtable->trace_routine,
                               scene->data,
-                              epsilon);
+                              epsilon,
+                              ray_differential->time);
 
     LightSampleListClear(&integrator->light_sample_list);
 
@@ -216,6 +221,8 @@ IntegratorAllocate(
     result->scene = NULL;
     result->light_sampler = NULL;
     result->color_integrator = NULL;
+    result->batch_spectra = NULL;
+    result->batch_capacity = 0;
 
     *integrator = result;
 
@@ -291,6 +298,195 @@ IntegratorIntegrate(
     return status;
 }
 
+bool
+IntegratorSupportsBatches(
+    _In_opt_ PCINTEGRATOR integrator
+    )
+{
+    if (integrator == NULL)
+    {
+        return false;
+    }
+
+    return integrator->vtable->integrate_batch_routine != NULL;
+}
+
+ISTATUS
+IntegratorIntegrateBatch(
+    _Inout_ PINTEGRATOR integrator,
+    _Inout_ PRANDOM rng,
+    _In_reads_(num_rays) const RAY_DIFFERENTIAL ray_differentials[],
+    _In_ size_t num_rays,
+    _In_ float_t epsilon,
+    _Out_writes_(num_rays) COLOR3 colors[]
+    )
+{
+    if (integrator == NULL ||
+        integrator->scene == NULL ||
+        integrator->light_sampler == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (ray_differentials == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (isinf(epsilon) || isless(epsilon, (float_t)0.0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (colors == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (num_rays == 0)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    if (integrator->vtable->integrate_batch_routine == NULL)
+    {
+        for (size_t i = 0; i < num_rays; i++)
+        {
+            ISTATUS status = IntegratorIntegrate(integrator,
+                                                 rng,
+                                                 ray_differentials[i],
+                                                 epsilon,
+                                                 colors + i);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+
+        return ISTATUS_SUCCESS;
+    }
+
+    for (size_t i = 0; i < num_rays; i++)
+    {
+        if (!RayDifferentialValidate(ray_differentials[i]))
+        {
+            return ISTATUS_INVALID_ARGUMENT_02;
+        }
+    }
+
+    if (integrator->batch_capacity < num_rays)
+    {
+        PCSPECTRUM *batch_spectra = (PCSPECTRUM*)realloc(
+            (void*)integrator->batch_spectra,
+            num_rays * sizeof(PCSPECTRUM));
+
+        if (batch_spectra == NULL)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        integrator->batch_spectra = batch_spectra;
+        integrator->batch_capacity = num_rays;
+    }
+
+    PCSCENE scene = integrator->scene;
+
+    //
+    // The stores backing the returned spectra are only cleared once per
+    // batch, so every path in the batch may keep its results live until the
+    // batch completes. Paths are free to set their own time before tracing.
+    //
+
+    ShapeRayTracerConfigure(&integrator->shape_ray_tracer,
+                            scene->vtable->trace_routine,
+                            scene->data,
+                            epsilon,
+                            ray_differentials[0].time,
+                            scene->environment);
+
+    VisibilityTesterConfigure(&integrator->visibility_tester,
+                              scene->vtable->trace_routine,
+                              scene->data,
+                              epsilon,
+                              ray_differentials[0].time);
+
+    LightSampleListClear(&integrator->light_sample_list);
+
+    PSPECTRUM_COMPOSITOR spectrum_compositor =
+        ShapeRayTracerGetSpectrumCompositor(&integrator->shape_ray_tracer);
+
+    PREFLECTOR_COMPOSITOR reflector_compositor =
+        ShapeRayTracerGetReflectorCompositor(&integrator->shape_ray_tracer);
+
+    ISTATUS status = integrator->vtable->integrate_batch_routine(
+        integrator->data,
+        ray_differentials,
+        num_rays,
+        integrator->light_sampler,
+        &integrator->light_sample_list,
+        &integrator->shape_ray_tracer,
+        &integrator->visibility_tester,
+        spectrum_compositor,
+        reflector_compositor,
+        rng,
+        integrator->batch_spectra);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t i = 0; i < num_rays; i++)
+    {
+        status = ColorIntegratorComputeSpectrumColorStatic(
+            integrator->color_integrator,
+            integrator->batch_spectra[i],
+            colors + i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+IntegratorGetShadingMemoryUsage(
+    _In_ PCINTEGRATOR integrator,
+    _Out_ size_t *high_water_mark,
+    _Out_ size_t *capacity
+    )
+{
+    if (integrator == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (high_water_mark == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (capacity == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    *high_water_mark =
+        ArenaAllocatorGetHighWaterMark(&integrator->shape_ray_tracer.arena);
+    *capacity = ArenaAllocatorGetCapacity(&integrator->shape_ray_tracer.arena);
+
+    return ISTATUS_SUCCESS;
+}
+
 ISTATUS
 IntegratorDuplicate(
     _In_ PINTEGRATOR integrator,
@@ -346,6 +542,7 @@ IntegratorFree(
     ShapeRayTracerDestroy(&integrator->shape_ray_tracer);
     LightSampleListDestroy(&integrator->light_sample_list);
     VisibilityTesterDestroy(&integrator->visibility_tester);
+    free((void*)integrator->batch_spectra);
 
     if (integrator->vtable->free_routine != NULL)
     {
@@ -10,6 +10,11 @@ Abstract:
 
     Manages the state needed to integrate over a ray.
 
+    Transient objects such as composited spectra and reflectors, BSDFs and
+    texture coordinates are carved from an arena owned by the integrator which
+    is reset before each sample. IntegratorGetShadingMemoryUsage reports the
+    most memory the arena has had in use at once along with its capacity.
+
 --*/
 
 #ifndef _IRIS_PHYSX_INTEGRATOR_
@@ -50,6 +55,28 @@ IntegratorIntegrate(
     _Out_ PCOLOR3 color
     );
 
+bool
+IntegratorSupportsBatches(
+    _In_opt_ PCINTEGRATOR integrator
+    );
+
+ISTATUS
+IntegratorIntegrateBatch(
+    _Inout_ PINTEGRATOR integrator,
+    _Inout_ PRANDOM rng,
+    _In_reads_(num_rays) const RAY_DIFFERENTIAL ray_differentials[],
+    _In_ size_t num_rays,
+    _In_ float_t epsilon,
+    _Out_writes_(num_rays) COLOR3 colors[]
+    );
+
+ISTATUS
+IntegratorGetShadingMemoryUsage(
+    _In_ PCINTEGRATOR integrator,
+    _Out_ size_t *high_water_mark,
+    _Out_ size_t *capacity
+    );
+
 ISTATUS
 IntegratorDuplicate(
     _In_ PINTEGRATOR integrator,
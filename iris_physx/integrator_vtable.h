@@ -45,6 +45,22 @@ ISTATUS
     _Out_ PCSPECTRUM *spectrum
     );
 
+typedef
+ISTATUS
+(*PINTEGRATOR_INTEGRATE_BATCH_ROUTINE)(
+    _In_opt_ const void *context,
+    _In_reads_(num_rays) PCRAY_DIFFERENTIAL ray_differentials,
+    _In_ size_t num_rays,
+    _In_ PCLIGHT_SAMPLER light_sampler,
+    _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng,
+    _Out_writes_(num_rays) PCSPECTRUM *spectra
+    );
+
 typedef
 ISTATUS
 (*PINTEGRATOR_DUPLICATE_ROUTINE)(
@@ -56,6 +72,7 @@ typedef struct _INTEGRATOR_VTABLE {
     PINTEGRATOR_INTEGRATE_ROUTINE integrate_routine;
     PINTEGRATOR_DUPLICATE_ROUTINE duplicate_routine;
     PFREE_ROUTINE free_routine;
+    PINTEGRATOR_INTEGRATE_BATCH_ROUTINE integrate_batch_routine;
 } INTEGRATOR_VTABLE, *PINTEGRATOR_VTABLE;
 
 typedef const INTEGRATOR_VTABLE *PCINTEGRATOR_VTABLE;
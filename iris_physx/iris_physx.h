@@ -39,6 +39,7 @@ extern "C" {
 #include "iris_physx/reflector.h"
 #include "iris_physx/reflector_compositor.h"
 #include "iris_physx/scene.h"
+#include "iris_physx/shading_attributes.h"
 #include "iris_physx/shape.h"
 #include "iris_physx/spectrum.h"
 #include "iris_physx/spectrum_compositor.h"
@@ -17,8 +17,10 @@ Abstract:
 #include <string.h>
 
 #include "common/alloc.h"
+#include "iris_physx/bsdf_allocator_internal.h"
 #include "iris_physx/material.h"
 #include "iris_physx/material_internal.h"
+#include "iris_physx/reflector_compositor_internal.h"
 
 //
 // Functions
@@ -62,10 +64,11 @@ MaterialAllocate(
         return ISTATUS_INVALID_ARGUMENT_04;
     }
 
+    PMATERIAL result;
     void *data_allocation;
     bool success = AlignedAllocWithHeader(sizeof(MATERIAL),
                                           alignof(MATERIAL),
-                                          (void **)material,
+                                          (void **)&result,
                                           data_size,
                                           data_alignment,
                                           &data_allocation);
@@ -75,15 +78,58 @@ MaterialAllocate(
         return ISTATUS_ALLOCATION_FAILED;
     }
 
-    (*material)->vtable = vtable;
-    (*material)->data = data_allocation;
-    (*material)->reference_count = 1;
+    result->vtable = vtable;
+    result->data = data_allocation;
+    result->constant_bsdf = NULL;
+    result->constant = false;
+    result->attributes = SHADING_ATTRIBUTES_ALL;
+    result->reference_count = 1;
+    ArenaAllocatorInitialize(&result->arena);
 
     if (data_size != 0)
     {
         memcpy(data_allocation, data, data_size);
     }
 
+    if (vtable->prepare_routine != NULL)
+    {
+        BSDF_ALLOCATOR bsdf_allocator;
+        BsdfAllocatorInitialize(&bsdf_allocator, &result->arena);
+
+        REFLECTOR_COMPOSITOR reflector_compositor;
+        ReflectorCompositorInitialize(&reflector_compositor, &result->arena);
+
+        ISTATUS status = vtable->prepare_routine(result->data,
+                                                 &bsdf_allocator,
+                                                 &reflector_compositor,
+                                                 &result->constant_bsdf,
+                                                 &result->constant);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            ArenaAllocatorDestroy(&result->arena);
+            free(result);
+            return status;
+        }
+
+        if (!result->constant)
+        {
+            result->constant_bsdf = NULL;
+            ArenaAllocatorDestroy(&result->arena);
+        }
+    }
+
+    if (result->constant)
+    {
+        result->attributes = SHADING_ATTRIBUTES_NONE;
+    }
+    else if (vtable->get_attributes_routine != NULL)
+    {
+        result->attributes = vtable->get_attributes_routine(result->data);
+    }
+
+    *material = result;
+
     return ISTATUS_SUCCESS;
 }
 
@@ -134,6 +180,43 @@ MaterialSample(
     return status;
 }
 
+bool
+MaterialGetConstantBsdf(
+    _In_opt_ PCMATERIAL material,
+    _Out_ PCBSDF *bsdf
+    )
+{
+    assert(bsdf != NULL);
+
+    if (material == NULL)
+    {
+        *bsdf = NULL;
+        return true;
+    }
+
+    if (!material->constant)
+    {
+        return false;
+    }
+
+    *bsdf = material->constant_bsdf;
+
+    return true;
+}
+
+SHADING_ATTRIBUTES
+MaterialGetAttributes(
+    _In_opt_ PCMATERIAL material
+    )
+{
+    if (material == NULL)
+    {
+        return SHADING_ATTRIBUTES_NONE;
+    }
+
+    return material->attributes;
+}
+
 void
 MaterialRetain(
     _In_opt_ PMATERIAL material
@@ -163,7 +246,8 @@ MaterialRelease(
         {
             material->vtable->free_routine(material->data);
         }
-    
+
+        ArenaAllocatorDestroy(&material->arena);
         free(material);
     }
 }
\ No newline at end of file
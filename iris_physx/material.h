@@ -12,6 +12,15 @@ Abstract:
     lambertian falloff from the parameters generated during a successful 
     intersection.
 
+    If a material's BSDF does not depend on the intersection, the optional
+    prepare routine may build it once when the material is allocated and set
+    constant to true. The BSDF is allocated from storage owned by the material
+    and is returned for every hit without calling the sample routine.
+
+    The optional get attributes routine reports which shading attributes the
+    sample routine reads. It is called once when the material is allocated.
+    If it is missing, every attribute is computed for the material.
+
 --*/
 
 #ifndef _IRIS_PHYSX_MATERIAL_
@@ -50,6 +59,17 @@ MaterialSample(
     _Out_ PCBSDF *bsdf
     );
 
+bool
+MaterialGetConstantBsdf(
+    _In_opt_ PCMATERIAL material,
+    _Out_ PCBSDF *bsdf
+    );
+
+SHADING_ATTRIBUTES
+MaterialGetAttributes(
+    _In_opt_ PCMATERIAL material
+    );
+
 void
 MaterialRetain(
     _In_opt_ PMATERIAL material
@@ -18,6 +18,7 @@ Abstract:
 #include <assert.h>
 #include <stdatomic.h>
 
+#include "common/arena_allocator.h"
 #include "iris_physx/material_vtable.h"
 
 //
@@ -27,6 +28,10 @@ Abstract:
 struct _MATERIAL {
     PCMATERIAL_VTABLE vtable;
     void *data;
+    PCBSDF constant_bsdf;
+    bool constant;
+    SHADING_ATTRIBUTES attributes;
+    ARENA_ALLOCATOR arena;
     atomic_uintmax_t reference_count;
 };
 
@@ -53,6 +58,12 @@ MaterialSampleInternal(
     assert(reflector_compositor != NULL);
     assert(bsdf != NULL);
 
+    if (material->constant)
+    {
+        *bsdf = material->constant_bsdf;
+        return ISTATUS_SUCCESS;
+    }
+
     ISTATUS status = material->vtable->sample_routine(material->data,
                                                       intersection,
                                                       additional_data,
@@ -17,6 +17,7 @@ Abstract:
 
 #include "iris_physx/bsdf_allocator.h"
 #include "iris_physx/reflector_compositor.h"
+#include "iris_physx/shading_attributes.h"
 
 //
 // Types
@@ -34,9 +35,27 @@ ISTATUS
     _Out_ PCBSDF *bsdf
     );
 
+typedef
+ISTATUS
+(*PMATERIAL_PREPARE_ROUTINE)(
+    _In_ const void *context,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Inout_ PREFLECTOR_COMPOSITOR reflector_compositor,
+    _Out_ PCBSDF *bsdf,
+    _Out_ bool *constant
+    );
+
+typedef
+SHADING_ATTRIBUTES
+(*PMATERIAL_GET_ATTRIBUTES_ROUTINE)(
+    _In_ const void *context
+    );
+
 typedef struct _MATERIAL_VTABLE {
     PMATERIAL_SAMPLE_ROUTINE sample_routine;
     PFREE_ROUTINE free_routine;
+    PMATERIAL_PREPARE_ROUTINE prepare_routine;
+    PMATERIAL_GET_ATTRIBUTES_ROUTINE get_attributes_routine;
 } MATERIAL_VTABLE, *PMATERIAL_VTABLE;
 
 typedef const MATERIAL_VTABLE *PCMATERIAL_VTABLE;
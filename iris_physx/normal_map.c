@@ -76,6 +76,7 @@ NormalMapAllocate(
 
     (*normal_map)->vtable = vtable;
     (*normal_map)->data = data_allocation;
+    (*normal_map)->attributes = SHADING_ATTRIBUTES_ALL;
     (*normal_map)->reference_count = 1;
 
     if (data_size != 0)
@@ -83,9 +84,28 @@ NormalMapAllocate(
         memcpy(data_allocation, data, data_size);
     }
 
+    if (vtable->get_attributes_routine != NULL)
+    {
+        (*normal_map)->attributes =
+            vtable->get_attributes_routine(data_allocation);
+    }
+
     return ISTATUS_SUCCESS;
 }
 
+SHADING_ATTRIBUTES
+NormalMapGetAttributes(
+    _In_opt_ PCNORMAL_MAP normal_map
+    )
+{
+    if (normal_map == NULL)
+    {
+        return SHADING_ATTRIBUTES_NONE;
+    }
+
+    return normal_map->attributes;
+}
+
 void
 NormalMapRetain(
     _In_opt_ PNORMAL_MAP normal_map
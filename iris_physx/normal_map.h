@@ -10,6 +10,10 @@ Abstract:
 
     Interface for an object that computes the normals used for shading.
 
+    The optional get attributes routine reports which shading attributes the
+    compute routine reads. It is called once when the normal map is allocated.
+    If it is missing, every attribute is computed for the normal map.
+
 --*/
 
 #ifndef _IRIS_PHYSX_NORMAL_MAP_
@@ -39,6 +43,11 @@ NormalMapAllocate(
     _Out_ PNORMAL_MAP *normal_map
     );
 
+SHADING_ATTRIBUTES
+NormalMapGetAttributes(
+    _In_opt_ PCNORMAL_MAP normal_map
+    );
+
 void
 NormalMapRetain(
     _In_opt_ PNORMAL_MAP normal_map
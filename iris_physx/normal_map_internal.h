@@ -26,6 +26,7 @@ Abstract:
 struct _NORMAL_MAP {
     PCNORMAL_MAP_VTABLE vtable;
     void *data;
+    SHADING_ATTRIBUTES attributes;
     atomic_uintmax_t reference_count;
 };
 
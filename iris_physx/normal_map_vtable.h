@@ -17,6 +17,7 @@ Abstract:
 
 #include "common/free_routine.h"
 #include "iris_advanced/iris_advanced.h"
+#include "iris_physx/shading_attributes.h"
 
 //
 // Types
@@ -40,9 +41,16 @@ ISTATUS
     _Out_ PNORMAL_COORDINATE_SPACE coordinate_space
     );
 
+typedef
+SHADING_ATTRIBUTES
+(*PNORMAL_MAP_GET_ATTRIBUTES_ROUTINE)(
+    _In_ const void *context
+    );
+
 typedef struct _NORMAL_MAP_VTABLE {
     PNORMAL_MAP_COMPUTE_ROUTINE compute_routine;
     PFREE_ROUTINE free_routine;
+    PNORMAL_MAP_GET_ATTRIBUTES_ROUTINE get_attributes_routine;
 } NORMAL_MAP_VTABLE, *PNORMAL_MAP_VTABLE;
 
 typedef const NORMAL_MAP_VTABLE *PCNORMAL_MAP_VTABLE;
@@ -12,6 +12,11 @@ Abstract:
 
 --*/
 
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/safe_math.h"
 #include "iris_physx/emissive_material_internal.h"
 #include "iris_physx/environmental_light_internal.h"
 #include "iris_physx/material_internal.h"
@@ -33,146 +38,193 @@ typedef struct _SHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT {
     VECTOR3 surface_normal;
     VECTOR3 shading_normal;
     bool triggered;
+    bool deferred;
 } SHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT, *PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT;
 
+struct _SHAPE_RAY_TRACER_HIT_RECORD {
+    PCMATERIAL material;
+    PCSHAPE shape;
+    PCMATRIX model_to_world;
+    POINT3 model_hit_point;
+    POINT3 world_hit_point;
+    size_t additional_data_offset;
+    size_t additional_data_size;
+    size_t ray_index;
+    uint32_t front_face;
+};
+
+typedef struct _SHAPE_RAY_TRACER_HIT_RECORD SHAPE_RAY_TRACER_HIT_RECORD;
+typedef SHAPE_RAY_TRACER_HIT_RECORD *PSHAPE_RAY_TRACER_HIT_RECORD;
+typedef const SHAPE_RAY_TRACER_HIT_RECORD *PCSHAPE_RAY_TRACER_HIT_RECORD;
+
+//
+// Defines
+//
+
+#define HIT_DATA_ALIGNMENT 16
+
 //
 // Static Functions
 //
 
-ISTATUS 
-ShapeRayTracerProcessHit(
-    _Inout_opt_ void *context, 
+static
+ISTATUS
+ShapeRayTracerComputeEmission(
+    _In_ PCSHAPE shape,
     _In_ PCHIT_CONTEXT hit_context,
-    _In_ PCMATRIX model_to_world,
     _In_ POINT3 model_hit_point,
-    _In_ POINT3 world_hit_point
+    _Inout_ PCSPECTRUM *light
     )
 {
-    PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT process_context = 
-        (PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT)context;
+    if (shape->vtable->get_emissive_material_routine == NULL ||
+        shape->vtable->sample_face_routine == NULL ||
+        shape->vtable->compute_pdf_by_solid_angle_routine == NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
 
-    PSHAPE shape = (PSHAPE)hit_context->data;
+    PCEMISSIVE_MATERIAL emissive_material;
+    ISTATUS status = ShapeGetEmissiveMaterial(shape,
+                                              hit_context->front_face,
+                                              &emissive_material);
 
-    process_context->triggered = true;
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
 
-    if (shape->vtable->get_emissive_material_routine != NULL &&
-        shape->vtable->sample_face_routine != NULL &&
-        shape->vtable->compute_pdf_by_solid_angle_routine != NULL)
+    if (emissive_material == NULL)
     {
-        PCEMISSIVE_MATERIAL emissive_material;
-        ISTATUS status = ShapeGetEmissiveMaterial(shape,
-                                                  hit_context->front_face,
-                                                  &emissive_material);
+        return ISTATUS_SUCCESS;
+    }
 
-        if (status != ISTATUS_SUCCESS)
-        {
-            return status;
-        }
+    status = EmissiveMaterialSample(emissive_material,
+                                    model_hit_point,
+                                    hit_context->additional_data,
+                                    light);
 
-        if (emissive_material != NULL)
-        {
-            status = EmissiveMaterialSample(emissive_material,
-                                            model_hit_point,
-                                            hit_context->additional_data,
-                                            &process_context->light);
+    return status;
+}
 
-            if (status != ISTATUS_SUCCESS)
-            {
-                return status;
-            }
-        }
+static
+inline
+VECTOR3
+ShapeRayTracerNormalToWorld(
+    _In_opt_ PCMATRIX model_to_world,
+    _In_ VECTOR3 model_normal
+    )
+{
+    if (model_to_world == NULL)
+    {
+        // TODO: Decide if it is safe to assume this is pre-normalized
+        return model_normal;
     }
 
-    process_context->hit_point = world_hit_point;
+    VECTOR3 world_normal =
+        VectorMatrixInverseTransposedMultiply(model_to_world, model_normal);
 
-    PCMATERIAL material;
-    ISTATUS status = ShapeGetMaterial(shape,
-                                      hit_context->front_face,
-                                      &material);
+    return VectorNormalize(world_normal, NULL, NULL);
+}
+
+static
+ISTATUS
+ShapeRayTracerShadeHit(
+    _Inout_ PSHAPE_RAY_TRACER shape_ray_tracer,
+    _In_ PCRAY_DIFFERENTIAL ray_differential,
+    _In_ PCSHAPE shape,
+    _In_ PCMATERIAL material,
+    _In_opt_ PCMATRIX model_to_world,
+    _In_ POINT3 model_hit_point,
+    _In_ POINT3 world_hit_point,
+    _In_ uint32_t front_face,
+    _In_opt_ const void *additional_data,
+    _Out_ PCBSDF *bsdf,
+    _Out_ PVECTOR3 surface_normal,
+    _Out_ PVECTOR3 shading_normal
+    )
+{
+    VECTOR3 model_surface_normal;
+    ISTATUS status = ShapeComputeNormal(shape,
+                                        model_hit_point,
+                                        front_face,
+                                        &model_surface_normal);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    if (material == NULL)
-    {
-        return ISTATUS_SUCCESS;
-    }
+    *surface_normal =
+        ShapeRayTracerNormalToWorld(model_to_world, model_surface_normal);
 
-    VECTOR3 model_surface_normal;
-    status = ShapeComputeNormal(shape,
-                                model_hit_point,
-                                hit_context->front_face,
-                                &model_surface_normal);
+    PCNORMAL_MAP normal_map;
+    status = ShapeGetNormalMap(shape, front_face, &normal_map);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    // TODO: Make this a function in multiply
-    if (model_to_world != NULL)
-    {
-        VECTOR3 world_surface_normal;
-        world_surface_normal =
-            VectorMatrixInverseTransposedMultiply(model_to_world,
-                                                  model_surface_normal);
-        process_context->surface_normal = VectorNormalize(world_surface_normal,
-                                                          NULL,
-                                                          NULL);
-    }
-    else
+    //
+    // Only compute the attributes that the material or normal map will read.
+    //
+
+    SHADING_ATTRIBUTES attributes =
+        material->attributes | NormalMapGetAttributes(normal_map);
+
+    RAY_DIFFERENTIAL intersection_ray = *ray_differential;
+    if (!(attributes & SHADING_ATTRIBUTE_DERIVATIVES))
     {
-        // TODO: Decide if it is safe to assume this is pre-normalized
-        process_context->surface_normal = model_surface_normal;
+        intersection_ray =
+            RayDifferentialCreateWithoutDifferentials(ray_differential->ray);
     }
 
     INTERSECTION intersection =
-        IntersectionCreate(*process_context->ray_differential,
+        IntersectionCreate(intersection_ray,
                            model_to_world,
                            model_hit_point,
                            world_hit_point,
-                           process_context->surface_normal);
-
-    void *texture_coordinates;
-    status = ShapeComputeTextureCoordinates(shape,
-                                            &intersection,
-                                            model_to_world,
-                                            hit_context->front_face,
-                                            hit_context->additional_data,
-                                            &process_context->shape_ray_tracer->texture_coordinate_allocator,
-                                            &texture_coordinates);
+                           *surface_normal);
 
-    if (status != ISTATUS_SUCCESS)
+    void *texture_coordinates = NULL;
+    if (attributes & SHADING_ATTRIBUTE_TEXTURE_COORDINATES)
     {
-        return status;
+        status = ShapeComputeTextureCoordinates(shape,
+                                                &intersection,
+                                                model_to_world,
+                                                front_face,
+                                                additional_data,
+                                                &shape_ray_tracer->texture_coordinate_allocator,
+                                                &texture_coordinates);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
     }
 
     status =
         MaterialSampleInternal(material,
                                &intersection,
-                               hit_context->additional_data,
+                               additional_data,
                                texture_coordinates,
-                               &process_context->shape_ray_tracer->bsdf_allocator,
-                               &process_context->shape_ray_tracer->reflector_compositor,
-                               &process_context->bsdf);
+                               &shape_ray_tracer->bsdf_allocator,
+                               &shape_ray_tracer->reflector_compositor,
+                               bsdf);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    VECTOR3 shading_normal;
     NORMAL_COORDINATE_SPACE coordinate_space;
-    status = ShapeComputeShadingNormal(shape,
+    status = ShapeComputeShadingNormal(normal_map,
                                        &intersection,
                                        model_surface_normal,
-                                       process_context->surface_normal,
-                                       hit_context->front_face,
-                                       hit_context->additional_data,
+                                       *surface_normal,
+                                       additional_data,
                                        texture_coordinates,
-                                       &shading_normal,
+                                       shading_normal,
                                        &coordinate_space);
 
     if (status != ISTATUS_SUCCESS)
@@ -180,21 +232,284 @@ ShapeRayTracerProcessHit(
         return status;
     }
 
-    // TODO: Make this a function in multiply
-    if (coordinate_space == NORMAL_MODEL_COORDINATE_SPACE &&
-        model_to_world != NULL)
+    //
+    // The integrator always reads both normals, so unlike the attributes
+    // above they are computed for every hit.
+    //
+
+    if (coordinate_space == NORMAL_MODEL_COORDINATE_SPACE)
+    {
+        *shading_normal =
+            ShapeRayTracerNormalToWorld(model_to_world, *shading_normal);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS 
+ShapeRayTracerProcessHit(
+    _Inout_opt_ void *context, 
+    _In_ PCHIT_CONTEXT hit_context,
+    _In_ PCMATRIX model_to_world,
+    _In_ POINT3 model_hit_point,
+    _In_ POINT3 world_hit_point
+    )
+{
+    PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT process_context = 
+        (PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT)context;
+
+    PSHAPE shape = (PSHAPE)hit_context->data;
+
+    process_context->triggered = true;
+
+    ISTATUS status = ShapeRayTracerComputeEmission(shape,
+                                                   hit_context,
+                                                   model_hit_point,
+                                                   &process_context->light);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    process_context->hit_point = world_hit_point;
+
+    PCMATERIAL material;
+    status = ShapeGetMaterial(shape,
+                              hit_context->front_face,
+                              &material);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (material == NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    status = ShapeRayTracerShadeHit(process_context->shape_ray_tracer,
+                                    process_context->ray_differential,
+                                    shape,
+                                    material,
+                                    model_to_world,
+                                    model_hit_point,
+                                    world_hit_point,
+                                    hit_context->front_face,
+                                    hit_context->additional_data,
+                                    &process_context->bsdf,
+                                    &process_context->surface_normal,
+                                    &process_context->shading_normal);
+
+    return status;
+}
+
+static
+ISTATUS 
+ShapeRayTracerRecordHit(
+    _Inout_opt_ void *context, 
+    _In_ PCHIT_CONTEXT hit_context,
+    _In_ PCMATRIX model_to_world,
+    _In_ POINT3 model_hit_point,
+    _In_ POINT3 world_hit_point
+    )
+{
+    PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT process_context = 
+        (PSHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT)context;
+
+    PSHAPE_RAY_TRACER shape_ray_tracer = process_context->shape_ray_tracer;
+    PSHAPE shape = (PSHAPE)hit_context->data;
+
+    process_context->triggered = true;
+
+    ISTATUS status = ShapeRayTracerComputeEmission(shape,
+                                                   hit_context,
+                                                   model_hit_point,
+                                                   &process_context->light);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    process_context->hit_point = world_hit_point;
+
+    PCMATERIAL material;
+    status = ShapeGetMaterial(shape,
+                              hit_context->front_face,
+                              &material);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (material == NULL)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    //
+    // Interpolated transforms do not outlive the trace, so hits against them
+    // are shaded immediately instead of being deferred.
+    //
+
+    if (MatrixIsTransient(model_to_world))
+    {
+        status = ShapeRayTracerShadeHit(shape_ray_tracer,
+                                        process_context->ray_differential,
+                                        shape,
+                                        material,
+                                        model_to_world,
+                                        model_hit_point,
+                                        world_hit_point,
+                                        hit_context->front_face,
+                                        hit_context->additional_data,
+                                        &process_context->bsdf,
+                                        &process_context->surface_normal,
+                                        &process_context->shading_normal);
+
+        return status;
+    }
+
+    if (shape_ray_tracer->num_hit_records ==
+        shape_ray_tracer->hit_records_capacity)
+    {
+        size_t new_capacity = 16;
+        if (shape_ray_tracer->hit_records_capacity != 0)
+        {
+            bool success =
+                CheckedMultiplySizeT(shape_ray_tracer->hit_records_capacity,
+                                     2,
+                                     &new_capacity);
+
+            if (!success)
+            {
+                return ISTATUS_ALLOCATION_FAILED;
+            }
+        }
+
+        size_t new_size;
+        bool success = CheckedMultiplySizeT(new_capacity,
+                                       sizeof(SHAPE_RAY_TRACER_HIT_RECORD),
+                                       &new_size);
+
+        if (!success)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        void *new_records = realloc(shape_ray_tracer->hit_records, new_size);
+
+        if (new_records == NULL)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        shape_ray_tracer->hit_records =
+            (PSHAPE_RAY_TRACER_HIT_RECORD)new_records;
+        shape_ray_tracer->hit_records_capacity = new_capacity;
+    }
+
+    size_t data_offset = shape_ray_tracer->hit_data_size;
+    size_t padded_size = hit_context->additional_data_size;
+    if (padded_size % HIT_DATA_ALIGNMENT != 0)
     {
-        shading_normal = VectorMatrixInverseTransposedMultiply(model_to_world,
-                                                               shading_normal);
-        shading_normal = VectorNormalize(shading_normal, NULL, NULL);
+        padded_size += HIT_DATA_ALIGNMENT - padded_size % HIT_DATA_ALIGNMENT;
     }
 
-    // TODO: Decide if it is safe to assume this is pre-normalized
-    process_context->shading_normal = shading_normal;
+    size_t new_data_size;
+    bool success = CheckedAddSizeT(data_offset, padded_size, &new_data_size);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    if (shape_ray_tracer->hit_data_capacity < new_data_size)
+    {
+        size_t new_capacity;
+        success = CheckedMultiplySizeT(new_data_size, 2, &new_capacity);
+
+        if (!success)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        void *new_data = realloc(shape_ray_tracer->hit_data, new_capacity);
+
+        if (new_data == NULL)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        shape_ray_tracer->hit_data = new_data;
+        shape_ray_tracer->hit_data_capacity = new_capacity;
+    }
+
+    if (hit_context->additional_data_size != 0)
+    {
+        memcpy((char*)shape_ray_tracer->hit_data + data_offset,
+               hit_context->additional_data,
+               hit_context->additional_data_size);
+    }
+
+    shape_ray_tracer->hit_data_size = new_data_size;
+
+    PSHAPE_RAY_TRACER_HIT_RECORD record =
+        shape_ray_tracer->hit_records + shape_ray_tracer->num_hit_records;
+    record->material = material;
+    record->shape = shape;
+    record->model_to_world = model_to_world;
+    record->model_hit_point = model_hit_point;
+    record->world_hit_point = world_hit_point;
+    record->additional_data_offset = data_offset;
+    record->additional_data_size = hit_context->additional_data_size;
+    record->front_face = hit_context->front_face;
+
+    shape_ray_tracer->num_hit_records += 1;
+    process_context->deferred = true;
 
     return ISTATUS_SUCCESS;
 }
 
+static
+int
+ShapeRayTracerCompareHitRecords(
+    _In_ const void *left,
+    _In_ const void *right
+    )
+{
+    PCSHAPE_RAY_TRACER_HIT_RECORD left_record =
+        (PCSHAPE_RAY_TRACER_HIT_RECORD)left;
+    PCSHAPE_RAY_TRACER_HIT_RECORD right_record =
+        (PCSHAPE_RAY_TRACER_HIT_RECORD)right;
+
+    uintptr_t left_key = (uintptr_t)left_record->material;
+    uintptr_t right_key = (uintptr_t)right_record->material;
+
+    if (left_key != right_key)
+    {
+        return (left_key < right_key) ? -1 : 1;
+    }
+
+    left_key = (uintptr_t)left_record->shape;
+    right_key = (uintptr_t)right_record->shape;
+
+    if (left_key != right_key)
+    {
+        return (left_key < right_key) ? -1 : 1;
+    }
+
+    if (left_record->ray_index != right_record->ray_index)
+    {
+        return (left_record->ray_index < right_record->ray_index) ? -1 : 1;
+    }
+
+    return 0;
+}
+
 //
 // Functions
 //
@@ -251,6 +566,7 @@ ShapeRayTracerTrace(
     context.light = NULL;
     context.bsdf = NULL;
     context.triggered = false;
+    context.deferred = false;
 
     ISTATUS status =
         RayTracerTraceClosestHitWithCoordinates(ray_tracer->ray_tracer,
@@ -291,4 +607,195 @@ ShapeRayTracerTrace(
     *shading_normal = context.shading_normal;
 
     return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+ShapeRayTracerTraceDeferred(
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _In_ const RAY_DIFFERENTIAL ray_differentials[],
+    _In_reads_opt_(num_rays) const size_t indices[],
+    _In_ size_t num_rays,
+    _Inout_ PCSPECTRUM lights[],
+    _Inout_ PCBSDF bsdfs[],
+    _Inout_ POINT3 hit_points[],
+    _Inout_ VECTOR3 surface_normals[],
+    _Inout_ VECTOR3 shading_normals[]
+    )
+{
+    if (ray_tracer == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (ray_differentials == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (lights == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (bsdfs == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (hit_points == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_06;
+    }
+
+    if (surface_normals == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_07;
+    }
+
+    if (shading_normals == NULL && num_rays != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_08;
+    }
+
+    ray_tracer->num_hit_records = 0;
+    ray_tracer->hit_data_size = 0;
+
+    for (size_t i = 0; i < num_rays; i++)
+    {
+        size_t ray_index = (indices != NULL) ? indices[i] : i;
+        PCRAY_DIFFERENTIAL ray_differential = ray_differentials + ray_index;
+
+        if (!RayDifferentialValidate(*ray_differential))
+        {
+            return ISTATUS_INVALID_ARGUMENT_01;
+        }
+
+        ISTATUS status = RayTracerSetTime(ray_tracer->ray_tracer,
+                                          ray_differential->time);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        SHAPE_RAY_TRACER_PROCESS_HIT_CONTEXT context;
+        context.ray_differential = ray_differential;
+        context.shape_ray_tracer = ray_tracer;
+        context.light = NULL;
+        context.bsdf = NULL;
+        context.triggered = false;
+        context.deferred = false;
+
+        status =
+            RayTracerTraceClosestHitWithCoordinates(ray_tracer->ray_tracer,
+                                                    ray_differential->ray,
+                                                    ray_tracer->minimum_distance,
+                                                    INFINITY,
+                                                    ray_tracer->trace_routine,
+                                                    ray_tracer->trace_context,
+                                                    ShapeRayTracerRecordHit,
+                                                    &context);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        if (!context.triggered && ray_tracer->environment != NULL)
+        {
+            status = EnvironmentalLightComputeEmissiveInternal(
+                ray_tracer->environment,
+                ray_differential->ray.direction,
+                &ray_tracer->spectrum_compositor,
+                lights + ray_index);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            bsdfs[ray_index] = NULL;
+            continue;
+        }
+
+        if (context.deferred)
+        {
+            ray_tracer->hit_records[ray_tracer->num_hit_records - 1].ray_index =
+                ray_index;
+        }
+
+        lights[ray_index] = context.light;
+        bsdfs[ray_index] = context.bsdf;
+        hit_points[ray_index] = context.hit_point;
+        surface_normals[ray_index] = context.surface_normal;
+        shading_normals[ray_index] = context.shading_normal;
+    }
+
+    //
+    // Shade the deferred hits grouped by material and then by shape so that
+    // each material's code and textures stay warm across its hits.
+    //
+
+    qsort(ray_tracer->hit_records,
+          ray_tracer->num_hit_records,
+          sizeof(SHAPE_RAY_TRACER_HIT_RECORD),
+          ShapeRayTracerCompareHitRecords);
+
+    for (size_t i = 0; i < ray_tracer->num_hit_records; i++)
+    {
+        PCSHAPE_RAY_TRACER_HIT_RECORD record = ray_tracer->hit_records + i;
+
+        const void *additional_data;
+        if (record->additional_data_size != 0)
+        {
+            additional_data = (const char*)ray_tracer->hit_data +
+                              record->additional_data_offset;
+        }
+        else
+        {
+            additional_data = NULL;
+        }
+
+        size_t ray_index = record->ray_index;
+        ISTATUS status = ShapeRayTracerShadeHit(ray_tracer,
+                                                ray_differentials + ray_index,
+                                                record->shape,
+                                                record->material,
+                                                record->model_to_world,
+                                                record->model_hit_point,
+                                                record->world_hit_point,
+                                                record->front_face,
+                                                additional_data,
+                                                bsdfs + ray_index,
+                                                surface_normals + ray_index,
+                                                shading_normals + ray_index);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+ShapeRayTracerSetTime(
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _In_ float_t time
+    )
+{
+    if (ray_tracer == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(time))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    ISTATUS status = RayTracerSetTime(ray_tracer->ray_tracer, time);
+
+    return status;
 }
\ No newline at end of file
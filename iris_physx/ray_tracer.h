@@ -17,6 +17,12 @@ Abstract:
     Any returned pointers are guaranteed to live at least as long as the ray
     tracer.
 
+    ShapeRayTracerTraceDeferred traces a batch of rays, each at its own time,
+    and defers material evaluation until every ray has been intersected. The
+    deferred hits are then shaded grouped by material. If indices is not
+    NULL, the rays traced and the outputs written are those at the listed
+    indices; otherwise the first num_rays entries are used.
+
 --*/
 
 #ifndef _IRIS_PHYSX_RAY_TRACER_
@@ -47,4 +53,23 @@ ShapeRayTracerTrace(
     _Out_ PVECTOR3 shading_normal
     );
 
+ISTATUS
+ShapeRayTracerTraceDeferred(
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _In_ const RAY_DIFFERENTIAL ray_differentials[],
+    _In_reads_opt_(num_rays) const size_t indices[],
+    _In_ size_t num_rays,
+    _Inout_ PCSPECTRUM lights[],
+    _Inout_ PCBSDF bsdfs[],
+    _Inout_ POINT3 hit_points[],
+    _Inout_ VECTOR3 surface_normals[],
+    _Inout_ VECTOR3 shading_normals[]
+    );
+
+ISTATUS
+ShapeRayTracerSetTime(
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _In_ float_t time
+    );
+
 #endif // _IRIS_PHYSX_RAY_TRACER_
\ No newline at end of file
@@ -15,6 +15,7 @@ Abstract:
 #ifndef _IRIS_PHYSX_RAY_TRACER_INTERNAL_
 #define _IRIS_PHYSX_RAY_TRACER_INTERNAL_
 
+#include "common/arena_allocator.h"
 #include "iris_physx/bsdf_allocator.h"
 #include "iris_physx/bsdf_allocator_internal.h"
 #include "iris_physx/environmental_light.h"
@@ -35,10 +36,17 @@ struct _SHAPE_RAY_TRACER {
     const void *trace_context;
     float_t minimum_distance;
     PCENVIRONMENTAL_LIGHT environment;
+    ARENA_ALLOCATOR arena;
     SPECTRUM_COMPOSITOR spectrum_compositor;
     REFLECTOR_COMPOSITOR reflector_compositor;
     BSDF_ALLOCATOR bsdf_allocator;
     TEXTURE_COORDINATE_ALLOCATOR texture_coordinate_allocator;
+    _Field_size_(hit_records_capacity) struct _SHAPE_RAY_TRACER_HIT_RECORD *hit_records;
+    size_t hit_records_capacity;
+    size_t num_hit_records;
+    _Field_size_bytes_(hit_data_capacity) void *hit_data;
+    size_t hit_data_capacity;
+    size_t hit_data_size;
 };
 
 //
@@ -67,28 +75,23 @@ ShapeRayTracerInitialize(
     shape_ray_tracer->trace_context = NULL;
     shape_ray_tracer->minimum_distance = (float_t)0.0;
 
-    bool success =
-        SpectrumCompositorInitialize(&shape_ray_tracer->spectrum_compositor);
-
-    if (!success)
-    {
-        RayTracerFree(shape_ray_tracer->ray_tracer);
-        return false;
-    }
-
-    success =
-        ReflectorCompositorInitialize(&shape_ray_tracer->reflector_compositor);
-
-    if (!success)
-    {
-        SpectrumCompositorDestroy(&shape_ray_tracer->spectrum_compositor);
-        RayTracerFree(shape_ray_tracer->ray_tracer);
-        return false;
-    }
-
-    BsdfAllocatorInitialize(&shape_ray_tracer->bsdf_allocator);
+    ArenaAllocatorInitialize(&shape_ray_tracer->arena);
+    SpectrumCompositorInitialize(&shape_ray_tracer->spectrum_compositor,
+                                 &shape_ray_tracer->arena);
+    ReflectorCompositorInitialize(&shape_ray_tracer->reflector_compositor,
+                                  &shape_ray_tracer->arena);
+    BsdfAllocatorInitialize(&shape_ray_tracer->bsdf_allocator,
+                            &shape_ray_tracer->arena);
     TextureCoordinateAllocatorInitialize(
-        &shape_ray_tracer->texture_coordinate_allocator);
+        &shape_ray_tracer->texture_coordinate_allocator,
+        &shape_ray_tracer->arena);
+
+    shape_ray_tracer->hit_records = NULL;
+    shape_ray_tracer->hit_records_capacity = 0;
+    shape_ray_tracer->num_hit_records = 0;
+    shape_ray_tracer->hit_data = NULL;
+    shape_ray_tracer->hit_data_capacity = 0;
+    shape_ray_tracer->hit_data_size = 0;
 
     return true;
 }
@@ -101,23 +104,24 @@ ShapeRayTracerConfigure(
     _In_ PRAY_TRACER_TRACE_ROUTINE trace_routine,
     _In_opt_ const void *trace_context,
     _In_ float_t minimum_distance,
+    _In_ float_t time,
     _In_opt_ PCENVIRONMENTAL_LIGHT environment
     )
 {
     assert(shape_ray_tracer != NULL);
     assert(trace_routine != NULL);
     assert(isfinite(minimum_distance) && minimum_distance >= (float_t)0.0);
+    assert(isfinite(time));
+
+    ISTATUS status = RayTracerSetTime(shape_ray_tracer->ray_tracer, time);
+    assert(status == ISTATUS_SUCCESS);
 
     shape_ray_tracer->trace_routine = trace_routine;
     shape_ray_tracer->trace_context = trace_context;
     shape_ray_tracer->minimum_distance = minimum_distance;
     shape_ray_tracer->environment = environment;
 
-    SpectrumCompositorClear(&shape_ray_tracer->spectrum_compositor);
-    ReflectorCompositorClear(&shape_ray_tracer->reflector_compositor);
-    BsdfAllocatorClear(&shape_ray_tracer->bsdf_allocator);
-    TextureCoordinateAllocatorClear(
-        &shape_ray_tracer->texture_coordinate_allocator);
+    ArenaAllocatorFreeAll(&shape_ray_tracer->arena);
 }
 
 static
@@ -154,11 +158,9 @@ ShapeRayTracerDestroy(
     assert(shape_ray_tracer != NULL);
 
     RayTracerFree(shape_ray_tracer->ray_tracer);
-    SpectrumCompositorDestroy(&shape_ray_tracer->spectrum_compositor);
-    ReflectorCompositorDestroy(&shape_ray_tracer->reflector_compositor);
-    BsdfAllocatorDestroy(&shape_ray_tracer->bsdf_allocator);
-    TextureCoordinateAllocatorDestroy(
-        &shape_ray_tracer->texture_coordinate_allocator);
+    ArenaAllocatorDestroy(&shape_ray_tracer->arena);
+    free(shape_ray_tracer->hit_records);
+    free(shape_ray_tracer->hit_data);
 }
 
 #endif // _IRIS_PHYSX_RAY_TRACER_INTERNAL_
\ No newline at end of file
@@ -260,8 +260,10 @@ AttenuatedReflectorAllocate(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->attenuated_reflector_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(ATTENUATED_REFLECTOR),
+                                          alignof(ATTENUATED_REFLECTOR),
+                                          &allocation);
 
     if (!success)
     {
@@ -396,8 +398,10 @@ ReflectorCompositorAttenuatedAddReflectors(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->attenuated_sum_reflector_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(ATTENUATED_SUM_REFLECTOR),
+                                          alignof(ATTENUATED_SUM_REFLECTOR),
+                                          &allocation);
 
     if (!success)
     {
@@ -480,8 +484,10 @@ ReflectorCompositorMultiplyReflectors(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->product_reflector_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(PRODUCT_REFLECTOR),
+                                          alignof(PRODUCT_REFLECTOR),
+                                          &allocation);
 
     if (!success)
     {
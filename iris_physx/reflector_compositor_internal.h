@@ -15,7 +15,7 @@ Abstract:
 #ifndef _IRIS_PHYSX_REFLECTOR_COMPOSITOR_INTERNAL_
 #define _IRIS_PHYSX_REFLECTOR_COMPOSITOR_INTERNAL_
 
-#include "common/static_allocator.h"
+#include "common/arena_allocator.h"
 #include "iris_physx/reflector_internal.h"
 
 //
@@ -48,83 +48,25 @@ typedef struct _PRODUCT_REFLECTOR {
 typedef const PRODUCT_REFLECTOR *PCPRODUCT_REFLECTOR;
 
 struct _REFLECTOR_COMPOSITOR {
-    STATIC_MEMORY_ALLOCATOR attenuated_sum_reflector_allocator;
-    STATIC_MEMORY_ALLOCATOR attenuated_reflector_allocator;
-    STATIC_MEMORY_ALLOCATOR product_reflector_allocator;
+    PARENA_ALLOCATOR arena;
 };
 
 //
 // Functions
 //
 
-_Check_return_
-_Success_(return != 0)
-static
-inline
-bool
-ReflectorCompositorInitialize(
-    _Out_ struct _REFLECTOR_COMPOSITOR *compositor
-    )
-{
-    assert(compositor != NULL);
-
-    bool success = StaticMemoryAllocatorInitialize(
-        &compositor->attenuated_sum_reflector_allocator,
-        sizeof(ATTENUATED_SUM_REFLECTOR));
-    if (!success)
-    {
-        return false;
-    }
-
-    success = StaticMemoryAllocatorInitialize(
-        &compositor->attenuated_reflector_allocator,
-        sizeof(ATTENUATED_REFLECTOR));
-    if (!success)
-    {
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_sum_reflector_allocator);
-    }
-
-    success = StaticMemoryAllocatorInitialize(
-        &compositor->product_reflector_allocator,
-        sizeof(PRODUCT_REFLECTOR));
-    if (!success)
-    {
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_sum_reflector_allocator);
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_reflector_allocator);
-    }
-
-    return success;
-}
-
 static
 inline
 void
-ReflectorCompositorClear(
-    _Inout_ struct _REFLECTOR_COMPOSITOR *compositor
-    )
-{
-    assert(compositor != NULL);
-
-    StaticMemoryAllocatorFreeAll(&compositor->attenuated_sum_reflector_allocator);
-    StaticMemoryAllocatorFreeAll(&compositor->attenuated_reflector_allocator);
-    StaticMemoryAllocatorFreeAll(&compositor->product_reflector_allocator);
-}
-
-static
-inline
-void
-ReflectorCompositorDestroy(
-    _Inout_ struct _REFLECTOR_COMPOSITOR *compositor
+ReflectorCompositorInitialize(
+    _Out_ struct _REFLECTOR_COMPOSITOR *compositor,
+    _In_ PARENA_ALLOCATOR arena
     )
 {
     assert(compositor != NULL);
+    assert(arena != NULL);
 
-    StaticMemoryAllocatorDestroy(&compositor->attenuated_sum_reflector_allocator);
-    StaticMemoryAllocatorDestroy(&compositor->attenuated_reflector_allocator);
-    StaticMemoryAllocatorDestroy(&compositor->product_reflector_allocator);
+    compositor->arena = arena;
 }
 
 #endif // _IRIS_PHYSX_REFLECTOR_COMPOSITOR_INTERNAL_
\ No newline at end of file
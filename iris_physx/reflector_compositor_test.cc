@@ -195,6 +195,7 @@ CutoffReflectorRoutine(
 
 const REFLECTOR_VTABLE cutoff_vtable = {
     CutoffReflectorRoutine,
+    NULL,
     NULL
 };
 
@@ -240,6 +241,7 @@ AttenuatingReflectorRoutine(
 
 const REFLECTOR_VTABLE attenuating_ref_vtable = {
     AttenuatingReflectorRoutine,
+    NULL,
     NULL
 };
 
@@ -16,27 +16,37 @@ Abstract:
 #include "iris_physx/reflector_compositor_internal.h"
 #include "iris_physx/reflector_compositor_test_util.h"
 
+//
+// Types
+//
+
+typedef struct _REFLECTOR_COMPOSITOR_WITH_ARENA {
+    REFLECTOR_COMPOSITOR compositor;
+    ARENA_ALLOCATOR arena;
+} REFLECTOR_COMPOSITOR_WITH_ARENA, *PREFLECTOR_COMPOSITOR_WITH_ARENA;
+
+//
+// Functions
+//
+
 _Ret_maybenull_
 PREFLECTOR_COMPOSITOR
 ReflectorCompositorCreate(
     void
     )
 {
-    PREFLECTOR_COMPOSITOR allocator = 
-        (PREFLECTOR_COMPOSITOR) malloc(sizeof(REFLECTOR_COMPOSITOR));
+    PREFLECTOR_COMPOSITOR_WITH_ARENA allocator =
+        (PREFLECTOR_COMPOSITOR_WITH_ARENA)malloc(
+            sizeof(REFLECTOR_COMPOSITOR_WITH_ARENA));
     if (allocator == NULL)
     {
         return NULL;
     }
 
-    bool success = ReflectorCompositorInitialize(allocator);
-    if (!success)
-    {
-        free(allocator);
-        return NULL;
-    }
+    ArenaAllocatorInitialize(&allocator->arena);
+    ReflectorCompositorInitialize(&allocator->compositor, &allocator->arena);
 
-    return allocator;
+    return &allocator->compositor;
 }
 
 void
@@ -49,6 +59,9 @@ ReflectorCompositorFree(
         return;
     }
 
-    ReflectorCompositorDestroy(allocator);
-    free(allocator);
+    PREFLECTOR_COMPOSITOR_WITH_ARENA allocation =
+        (PREFLECTOR_COMPOSITOR_WITH_ARENA)allocator;
+
+    ArenaAllocatorDestroy(&allocation->arena);
+    free(allocation);
 }
\ No newline at end of file
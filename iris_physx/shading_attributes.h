@@ -0,0 +1,47 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    shading_attributes.h
+
+Abstract:
+
+    The optional attributes of a hit which a material or normal map may
+    depend on. The ray tracer only computes the attributes requested by the
+    material and normal map of the surface that was hit. The hit points and
+    the geometry normal are always available.
+
+    SHADING_ATTRIBUTE_TEXTURE_COORDINATES requests that the texture coordinate
+    map of the shape is evaluated. If it is not requested, NULL is passed in
+    place of the texture coordinates.
+
+    SHADING_ATTRIBUTE_DERIVATIVES requests the screen space derivatives of the
+    hit point and, if texture coordinates are also requested, of the texture
+    coordinates. If it is not requested, the intersection is computed as if
+    the ray had no differentials.
+
+--*/
+
+#ifndef _IRIS_PHYSX_SHADING_ATTRIBUTES_
+#define _IRIS_PHYSX_SHADING_ATTRIBUTES_
+
+#include <stdint.h>
+
+//
+// Defines
+//
+
+#define SHADING_ATTRIBUTES_NONE               0x0u
+#define SHADING_ATTRIBUTE_TEXTURE_COORDINATES 0x1u
+#define SHADING_ATTRIBUTE_DERIVATIVES         0x2u
+#define SHADING_ATTRIBUTES_ALL                0x3u
+
+//
+// Types
+//
+
+typedef uint32_t SHADING_ATTRIBUTES;
+
+#endif // _IRIS_PHYSX_SHADING_ATTRIBUTES_
\ No newline at end of file
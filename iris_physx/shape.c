@@ -97,6 +97,33 @@ ShapeAllocate(
     return ISTATUS_SUCCESS;
 }
 
+ISTATUS
+ShapeHitAllocatorFinalizeHit(
+    _In_opt_ const void *data,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    )
+{
+    assert(coordinates != NULL);
+    assert(additional_data != NULL);
+
+    PCSHAPE shape = (PCSHAPE)data;
+    assert(shape != NULL);
+    assert(shape->vtable->finalize_hit_routine != NULL);
+
+    const void *context = ShapeGetData(shape);
+    ISTATUS status =
+        shape->vtable->finalize_hit_routine(context,
+                                            primitive,
+                                            coordinates,
+                                            additional_data,
+                                            additional_data_size);
+
+    return status;
+}
+
 ISTATUS 
 ShapeComputeBounds(
     _In_ PCSHAPE shape,
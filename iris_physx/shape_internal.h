@@ -132,36 +132,42 @@ ShapeComputeTextureCoordinates(
 static
 inline
 ISTATUS
-ShapeComputeShadingNormal(
+ShapeGetNormalMap(
     _In_ PCSHAPE shape,
+    _In_ uint32_t face_hit,
+    _Outptr_result_maybenull_ PCNORMAL_MAP *normal_map
+    )
+{
+    assert(shape != NULL);
+    assert(normal_map != NULL);
+
+    const void* data = ShapeGetData(shape);
+    ISTATUS status = shape->vtable->get_normal_map_routine(data,
+                                                           face_hit,
+                                                           normal_map);
+
+    return status;
+}
+
+static
+inline
+ISTATUS
+ShapeComputeShadingNormal(
+    _In_opt_ PCNORMAL_MAP normal_map,
     _In_ PCINTERSECTION intersection,
     _In_ VECTOR3 model_geometry_normal,
     _In_ VECTOR3 world_geometry_normal,
-    _In_ uint32_t face_hit,
     _In_ const void *additional_data,
     _In_ const void *texture_coordinates,
     _Out_ PVECTOR3 shading_normal,
     _Out_ PNORMAL_COORDINATE_SPACE coordinate_space
     )
 {
-    assert(shape != NULL);
     assert(intersection != NULL);
     assert(VectorValidate(model_geometry_normal));
     assert(VectorValidate(world_geometry_normal));
     assert(shading_normal != NULL);
 
-    const void* data = ShapeGetData(shape);
-
-    PCNORMAL_MAP normal_map;
-    ISTATUS status = shape->vtable->get_normal_map_routine(data,
-                                                           face_hit,
-                                                           &normal_map);
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
     if (normal_map == NULL)
     {
         *shading_normal = world_geometry_normal;
@@ -169,14 +175,14 @@ ShapeComputeShadingNormal(
         return ISTATUS_SUCCESS;
     }
 
-    status = NormalMapCompute(normal_map,
-                              intersection,
-                              model_geometry_normal,
-                              world_geometry_normal,
-                              additional_data,
-                              texture_coordinates,
-                              shading_normal,
-                              coordinate_space);
+    ISTATUS status = NormalMapCompute(normal_map,
+                                      intersection,
+                                      model_geometry_normal,
+                                      world_geometry_normal,
+                                      additional_data,
+                                      texture_coordinates,
+                                      shading_normal,
+                                      coordinate_space);
 
     return status;
 }
@@ -37,6 +37,16 @@ ISTATUS
     _Out_ PHIT *hit
     );
 
+typedef
+ISTATUS
+(*PSHAPE_FINALIZE_HIT_ROUTINE)(
+    _In_ const void *context,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    );
+
 typedef
 ISTATUS
 (*PSHAPE_COMPUTE_BOUNDS_ROUTINE)(
@@ -116,6 +126,7 @@ typedef struct _SHAPE_VTABLE {
     PSHAPE_SAMPLE_FACE sample_face_routine;
     PSHAPE_COMPUTE_PDF_BY_SOLID_ANGLE compute_pdf_by_solid_angle_routine;
     PFREE_ROUTINE free_routine;
+    PSHAPE_FINALIZE_HIT_ROUTINE finalize_hit_routine;
 } SHAPE_VTABLE, *PSHAPE_VTABLE;
 
 typedef const SHAPE_VTABLE *PCSHAPE_VTABLE;
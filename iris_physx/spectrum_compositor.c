@@ -212,8 +212,10 @@ AttenuatedSpectrumAllocate(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->attenuated_spectrum_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(ATTENUATED_SPECTRUM),
+                                          alignof(ATTENUATED_SPECTRUM),
+                                          &allocation);
 
     if (!success)
     {
@@ -259,8 +261,10 @@ AttenuatedReflectionSpectrumAllocate(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->attenuated_reflection_spectrum_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(ATTENUATED_REFLECTION_SPECTRUM),
+                                          alignof(ATTENUATED_REFLECTION_SPECTRUM),
+                                          &allocation);
 
     if (!success)
     {
@@ -318,9 +322,10 @@ SpectrumCompositorAddSpectra(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->sum_spectrum_allocator,
-        &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(SUM_SPECTRUM),
+                                          alignof(SUM_SPECTRUM),
+                                          &allocation);
 
     if (!success)
     {
@@ -463,8 +468,10 @@ SpectrumCompositorAttenuatedAddSpectra(
     }
 
     void *allocation;
-    bool success = StaticMemoryAllocatorAllocate(
-        &compositor->attenuated_sum_spectrum_allocator, &allocation);
+    bool success = ArenaAllocatorAllocate(compositor->arena,
+                                          sizeof(ATTENUATED_SUM_SPECTRUM),
+                                          alignof(ATTENUATED_SUM_SPECTRUM),
+                                          &allocation);
 
     if (!success)
     {
@@ -15,7 +15,7 @@ Abstract:
 #ifndef _IRIS_PHYSX_SPECTRUM_COMPOSITOR_INTERNAL_
 #define _IRIS_PHYSX_SPECTRUM_COMPOSITOR_INTERNAL_
 
-#include "common/static_allocator.h"
+#include "common/arena_allocator.h"
 #include "iris_physx/reflector.h"
 #include "iris_physx/spectrum_internal.h"
 
@@ -58,104 +58,25 @@ typedef struct _ATTENUATED_REFLECTION_SPECTRUM {
 typedef const ATTENUATED_REFLECTION_SPECTRUM *PCATTENUATED_REFLECTION_SPECTRUM;
 
 struct _SPECTRUM_COMPOSITOR {
-    STATIC_MEMORY_ALLOCATOR attenuated_reflection_spectrum_allocator;
-    STATIC_MEMORY_ALLOCATOR attenuated_spectrum_allocator;
-    STATIC_MEMORY_ALLOCATOR attenuated_sum_spectrum_allocator;
-    STATIC_MEMORY_ALLOCATOR sum_spectrum_allocator;
+    PARENA_ALLOCATOR arena;
 };
 
 //
 // Functions
 //
 
-_Check_return_
-_Success_(return != 0)
-static
-inline
-bool
-SpectrumCompositorInitialize(
-    _Out_ struct _SPECTRUM_COMPOSITOR *compositor
-    )
-{
-    assert(compositor != NULL);
-
-    bool success = StaticMemoryAllocatorInitialize(
-        &compositor->attenuated_reflection_spectrum_allocator,
-        sizeof(ATTENUATED_REFLECTION_SPECTRUM));
-    if (!success)
-    {
-        return false;
-    }
-
-    success = StaticMemoryAllocatorInitialize(
-        &compositor->attenuated_spectrum_allocator,
-        sizeof(ATTENUATED_SPECTRUM));
-    if (!success)
-    {
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_reflection_spectrum_allocator);
-        return false;
-    }
-
-    success = StaticMemoryAllocatorInitialize(
-        &compositor->attenuated_sum_spectrum_allocator,
-        sizeof(ATTENUATED_SUM_SPECTRUM));
-    if (!success)
-    {
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_reflection_spectrum_allocator);
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_spectrum_allocator);
-        return false;
-    }
-
-    success = StaticMemoryAllocatorInitialize(
-        &compositor->sum_spectrum_allocator,
-        sizeof(SUM_SPECTRUM));
-    if (!success)
-    {
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_reflection_spectrum_allocator);
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_spectrum_allocator);
-        StaticMemoryAllocatorDestroy(
-            &compositor->attenuated_sum_spectrum_allocator);
-        return false;
-    }
-
-    return true;
-}
-
 static
 inline
 void
-SpectrumCompositorClear(
-    _Inout_ struct _SPECTRUM_COMPOSITOR *compositor
-    )
-{
-    assert(compositor != NULL);
-
-    StaticMemoryAllocatorFreeAll(
-        &compositor->attenuated_reflection_spectrum_allocator);
-    StaticMemoryAllocatorFreeAll(&compositor->attenuated_spectrum_allocator);
-    StaticMemoryAllocatorFreeAll(&compositor->attenuated_sum_spectrum_allocator);
-    StaticMemoryAllocatorFreeAll(&compositor->sum_spectrum_allocator);
-}
-
-static
-inline
-void
-SpectrumCompositorDestroy(
-    _Inout_ struct _SPECTRUM_COMPOSITOR *compositor
+SpectrumCompositorInitialize(
+    _Out_ struct _SPECTRUM_COMPOSITOR *compositor,
+    _In_ PARENA_ALLOCATOR arena
     )
 {
     assert(compositor != NULL);
+    assert(arena != NULL);
 
-    StaticMemoryAllocatorDestroy(
-        &compositor->attenuated_reflection_spectrum_allocator);
-    StaticMemoryAllocatorDestroy(&compositor->attenuated_spectrum_allocator);
-    StaticMemoryAllocatorDestroy(&compositor->attenuated_sum_spectrum_allocator);
-    StaticMemoryAllocatorDestroy(&compositor->sum_spectrum_allocator);
+    compositor->arena = arena;
 }
 
 #endif // _IRIS_PHYSX_SPECTRUM_COMPOSITOR_INTERNAL_
\ No newline at end of file
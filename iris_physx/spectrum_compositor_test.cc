@@ -346,6 +346,7 @@ AttenuatingReflectorRoutine(
 
 const REFLECTOR_VTABLE attenuating_ref_vtable = {
     AttenuatingReflectorRoutine,
+    NULL,
     NULL
 };
 
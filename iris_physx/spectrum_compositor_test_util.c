@@ -16,27 +16,37 @@ Abstract:
 #include "iris_physx/spectrum_compositor_internal.h"
 #include "iris_physx/spectrum_compositor_test_util.h"
 
+//
+// Types
+//
+
+typedef struct _SPECTRUM_COMPOSITOR_WITH_ARENA {
+    SPECTRUM_COMPOSITOR compositor;
+    ARENA_ALLOCATOR arena;
+} SPECTRUM_COMPOSITOR_WITH_ARENA, *PSPECTRUM_COMPOSITOR_WITH_ARENA;
+
+//
+// Functions
+//
+
 _Ret_maybenull_
 PSPECTRUM_COMPOSITOR
 SpectrumCompositorAllocate(
     void
     )
 {
-    PSPECTRUM_COMPOSITOR compositor = 
-        (PSPECTRUM_COMPOSITOR) malloc(sizeof(SPECTRUM_COMPOSITOR));
+    PSPECTRUM_COMPOSITOR_WITH_ARENA compositor =
+        (PSPECTRUM_COMPOSITOR_WITH_ARENA)malloc(
+            sizeof(SPECTRUM_COMPOSITOR_WITH_ARENA));
     if (compositor == NULL)
     {
         return NULL;
     }
 
-    bool success = SpectrumCompositorInitialize(compositor);
-    if (!success)
-    {
-        free(compositor);
-        return NULL;
-    }
+    ArenaAllocatorInitialize(&compositor->arena);
+    SpectrumCompositorInitialize(&compositor->compositor, &compositor->arena);
 
-    return compositor;
+    return &compositor->compositor;
 }
 
 void
@@ -49,6 +59,9 @@ SpectrumCompositorFree(
         return;
     }
 
-    SpectrumCompositorDestroy(compositor);
-    free(compositor);
+    PSPECTRUM_COMPOSITOR_WITH_ARENA allocation =
+        (PSPECTRUM_COMPOSITOR_WITH_ARENA)compositor;
+
+    ArenaAllocatorDestroy(&allocation->arena);
+    free(allocation);
 }
\ No newline at end of file
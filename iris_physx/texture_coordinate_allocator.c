@@ -53,15 +53,10 @@ TextureCoordinateAllocatorAllocate(
         return ISTATUS_INVALID_ARGUMENT_COMBINATION_02;
     }
 
-    void *data;
-    bool success = DynamicMemoryAllocatorAllocate(&allocator->allocator,
-                                                  NULL,
-                                                  size,
-                                                  alignment,
-                                                  allocation,
-                                                  0,
-                                                  0,
-                                                  &data);
+    bool success = ArenaAllocatorAllocate(allocator->arena,
+                                          size,
+                                          alignment,
+                                          allocation);
 
     if (!success)
     {
@@ -15,14 +15,14 @@ Abstract:
 #ifndef _IRIS_PHYSX_TEXTURE_COORDINATE_ALLOCATOR_INTERNAL_
 #define _IRIS_PHYSX_TEXTURE_COORDINATE_ALLOCATOR_INTERNAL_
 
-#include "common/dynamic_allocator.h"
+#include "common/arena_allocator.h"
 
 //
 // Types
 //
 
 struct _TEXTURE_COORDINATE_ALLOCATOR {
-    DYNAMIC_MEMORY_ALLOCATOR allocator;
+    PARENA_ALLOCATOR arena;
 };
 
 //
@@ -33,36 +33,14 @@ static
 inline
 void
 TextureCoordinateAllocatorInitialize(
-    _Out_ struct _TEXTURE_COORDINATE_ALLOCATOR *allocator
+    _Out_ struct _TEXTURE_COORDINATE_ALLOCATOR *allocator,
+    _In_ PARENA_ALLOCATOR arena
     )
 {
     assert(allocator != NULL);
+    assert(arena != NULL);
 
-    DynamicMemoryAllocatorInitialize(&allocator->allocator);
-}
-
-static
-inline
-void
-TextureCoordinateAllocatorClear(
-    _Out_ struct _TEXTURE_COORDINATE_ALLOCATOR *allocator
-    )
-{
-    assert(allocator != NULL);
-
-    DynamicMemoryAllocatorFreeAll(&allocator->allocator);
-}
-
-static
-inline
-void
-TextureCoordinateAllocatorDestroy(
-    _Inout_ struct _TEXTURE_COORDINATE_ALLOCATOR *allocator
-    )
-{
-    assert(allocator != NULL);
-
-    DynamicMemoryAllocatorDestroy(&allocator->allocator);
+    allocator->arena = arena;
 }
 
 #endif // _IRIS_PHYSX_TEXTURE_COORDINATE_ALLOCATOR_INTERNAL_
\ No newline at end of file
@@ -98,5 +98,26 @@ VisibilityTesterTestAnyDistance(
                                                            ray,
                                                            visible);
 
+    return status;
+}
+
+ISTATUS
+VisibilityTesterSetTime(
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _In_ float_t time
+    )
+{
+    if (visibility_tester == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(time))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    ISTATUS status = RayTracerSetTime(visibility_tester->ray_tracer, time);
+
     return status;
 }
\ No newline at end of file
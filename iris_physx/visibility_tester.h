@@ -45,4 +45,10 @@ VisibilityTesterTestAnyDistance(
     _Out_ bool *visible
     );
 
+ISTATUS
+VisibilityTesterSetTime(
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _In_ float_t time
+    );
+
 #endif // _IRIS_PHYSX_VISIBILITY_TESTER_
@@ -75,12 +75,17 @@ VisibilityTesterConfigure(
     _Inout_ struct _VISIBILITY_TESTER *visibility_tester,
     _In_ PRAY_TRACER_TRACE_ROUTINE trace_routine,
     _In_opt_ const void *trace_context,
-    _In_ float_t epsilon
+    _In_ float_t epsilon,
+    _In_ float_t time
     )
 {
     assert(visibility_tester != NULL);
     assert(trace_routine != NULL);
     assert(isfinite(epsilon) && epsilon >= (float_t)0.0);
+    assert(isfinite(time));
+
+    ISTATUS status = RayTracerSetTime(visibility_tester->ray_tracer, time);
+    assert(status == ISTATUS_SUCCESS);
 
     visibility_tester->trace_routine = trace_routine;
     visibility_tester->trace_context = trace_context;
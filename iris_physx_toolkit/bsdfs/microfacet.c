@@ -267,16 +267,12 @@ MicrofacetReflectionBsdfSample(
         return ISTATUS_SUCCESS;
     }
 
-    float_t u;
-    ISTATUS status = RandomGenerateFloat(rng, (float_t)0.0, (float_t)1.0, &u);
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
-    float_t v;
-    status = RandomGenerateFloat(rng, (float_t)0.0, (float_t)1.0, &v);
+    float_t uv[2];
+    ISTATUS status = RandomGenerateFloats(rng,
+                                          (float_t)0.0,
+                                          (float_t)1.0,
+                                          2,
+                                          uv);
 
     if (status != ISTATUS_SUCCESS)
     {
@@ -294,8 +290,8 @@ MicrofacetReflectionBsdfSample(
     VECTOR3 local_half_angle =
         MicrofacetSample(&microfacet_bsdf->microfacet_distribution,
                          local_incoming,
-                         u,
-                         v);
+                         uv[0],
+                         uv[1]);
 
     VECTOR3 half_angle = MicrofacetBsdfToModel(local_half_angle,
                                                shading_normal,
@@ -39,7 +39,7 @@ TrowbridgeReitzSample11(
     {
         float_t r = sqrt(u / ((float_t)1.0 - u));
         float_t phi = iris_two_pi * v;
-        SinCos(phi, slope_y, slope_x);
+        ShadingSinCos(phi, slope_y, slope_x);
         *slope_x *= r;
         *slope_y *= r;
         return;
@@ -39,26 +39,18 @@ typedef const BUMP_MAP *PCBUMP_MAP;
 
 static
 ISTATUS
-BumpMapComputeWithTextureCoordinates(
-    _In_ const void *context,
+BumpMapSampleWithFiniteDifferences(
+    _In_ PCBUMP_MAP bump_map,
     _In_ PCINTERSECTION intersection,
-    _In_ VECTOR3 model_geometry_normal,
-    _In_ VECTOR3 world_geometry_normal,
-    _In_ const void *additional_data,
-    _In_ const void *texture_coordinates,
-    _Out_ PVECTOR3 shading_normal,
-    _Out_ PNORMAL_COORDINATE_SPACE coordinate_space
+    _In_ PCUV_TEXTURE_COORDINATE uv_coordinates,
+    _Out_writes_(2) float_t gradient[2]
     )
 {
-    PCBUMP_MAP bump_map = (PBUMP_MAP)context;
-    PCUV_TEXTURE_COORDINATE uv_coordinates =
-        (PCUV_TEXTURE_COORDINATE)texture_coordinates;
-
     float_t displacement;
     ISTATUS status = FloatTextureSample(bump_map->texture,
                                         intersection,
                                         NULL,
-                                        texture_coordinates,
+                                        uv_coordinates,
                                         &displacement);
 
     if (status != ISTATUS_SUCCESS)
@@ -125,13 +117,64 @@ BumpMapComputeWithTextureCoordinates(
         return status;
     }
 
-    displacement_u = (displacement_u - displacement) / du;
+    gradient[0] = (displacement_u - displacement) / du;
+    gradient[1] = (displacement_v - displacement) / dv;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+BumpMapComputeWithTextureCoordinates(
+    _In_ const void *context,
+    _In_ PCINTERSECTION intersection,
+    _In_ VECTOR3 model_geometry_normal,
+    _In_ VECTOR3 world_geometry_normal,
+    _In_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ PVECTOR3 shading_normal,
+    _Out_ PNORMAL_COORDINATE_SPACE coordinate_space
+    )
+{
+    PCBUMP_MAP bump_map = (PBUMP_MAP)context;
+    PCUV_TEXTURE_COORDINATE uv_coordinates =
+        (PCUV_TEXTURE_COORDINATE)texture_coordinates;
+
+    //
+    // Textures which can return their gradient directly are evaluated once
+    // instead of three times for finite differences.
+    //
+
+    ISTATUS status;
+    float_t gradient[2];
+    if (FloatTextureHasGradient(bump_map->texture))
+    {
+        float_t displacement;
+        status = FloatTextureSampleWithGradient(bump_map->texture,
+                                                intersection,
+                                                NULL,
+                                                texture_coordinates,
+                                                &displacement,
+                                                gradient);
+    }
+    else
+    {
+        status = BumpMapSampleWithFiniteDifferences(bump_map,
+                                                    intersection,
+                                                    uv_coordinates,
+                                                    gradient);
+    }
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
     VECTOR3 dp_du = VectorAdd(uv_coordinates->dmodel_hit_point_du,
-                              VectorScale(model_geometry_normal, displacement_u));
+                              VectorScale(model_geometry_normal, gradient[0]));
 
-    displacement_v = (displacement_v - displacement) / dv;
     VECTOR3 dp_dv = VectorAdd(uv_coordinates->dmodel_hit_point_dv,
-                              VectorScale(model_geometry_normal, displacement_v));
+                              VectorScale(model_geometry_normal, gradient[1]));
 
     *shading_normal = VectorCrossProduct(dp_du, dp_dv);
     *shading_normal = VectorNormalize(*shading_normal, NULL, NULL);
@@ -287,6 +330,19 @@ BumpMapCompute(
     return status;
 }
 
+static
+SHADING_ATTRIBUTES
+BumpMapGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCBUMP_MAP bump_map = (PCBUMP_MAP)context;
+
+    return SHADING_ATTRIBUTE_TEXTURE_COORDINATES |
+           SHADING_ATTRIBUTE_DERIVATIVES |
+           FloatTextureGetAttributes(bump_map->texture);
+}
+
 static
 void
 BumpMapFree(
@@ -304,7 +360,8 @@ BumpMapFree(
 
 static const NORMAL_MAP_VTABLE bump_map_vtable = {
     BumpMapCompute,
-    BumpMapFree
+    BumpMapFree,
+    BumpMapGetAttributes
 };
 
 //
@@ -31,6 +31,15 @@ typedef const CONSTANT_FLOAT_TEXTURE *PCCONSTANT_FLOAT_TEXTURE;
 // Static Functions
 //
 
+static
+SHADING_ATTRIBUTES
+ConstantTextureGetAttributes(
+    _In_ const void *context
+    )
+{
+    return SHADING_ATTRIBUTES_NONE;
+}
+
 static
 ISTATUS
 ConstantFloatTextureSample(
@@ -48,13 +57,50 @@ ConstantFloatTextureSample(
     return ISTATUS_SUCCESS;
 }
 
+static
+ISTATUS
+ConstantFloatTextureSampleWithGradient(
+    _In_ const void *context,
+    _In_ PCINTERSECTION intersection,
+    _In_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    PCONSTANT_FLOAT_TEXTURE texture = (PCONSTANT_FLOAT_TEXTURE)context;
+
+    *value = texture->value;
+    gradient[0] = (float_t)0.0;
+    gradient[1] = (float_t)0.0;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+bool
+ConstantFloatTextureGetConstant(
+    _In_ const void *context,
+    _Out_ float_t *value
+    )
+{
+    PCCONSTANT_FLOAT_TEXTURE texture = (PCCONSTANT_FLOAT_TEXTURE)context;
+
+    *value = texture->value;
+
+    return true;
+}
+
 //
 // Static Variables
 //
 
 static const FLOAT_TEXTURE_VTABLE constant_float_texture_vtable = {
     ConstantFloatTextureSample,
-    NULL
+    NULL,
+    ConstantFloatTextureGetConstant,
+    ConstantTextureGetAttributes,
+    ConstantFloatTextureSampleWithGradient
 };
 
 //
@@ -128,6 +174,21 @@ ConstantReflectorTextureSample(
     return ISTATUS_SUCCESS;
 }
 
+static
+bool
+ConstantReflectorTextureGetConstant(
+    _In_ const void *context,
+    _Out_ PCREFLECTOR *reflector
+    )
+{
+    PCCONSTANT_REFLECTOR_TEXTURE texture =
+        (PCCONSTANT_REFLECTOR_TEXTURE)context;
+
+    *reflector = texture->reflector;
+
+    return true;
+}
+
 static
 void
 ConstantReflectorTextureFree(
@@ -144,7 +205,9 @@ ConstantReflectorTextureFree(
 
 static const REFLECTOR_TEXTURE_VTABLE constant_reflector_texture_vtable = {
     ConstantReflectorTextureSample,
-    ConstantReflectorTextureFree
+    ConstantReflectorTextureFree,
+    ConstantReflectorTextureGetConstant,
+    ConstantTextureGetAttributes
 };
 
 //
@@ -15,6 +15,7 @@ Abstract:
 #include "common/alloc.h"
 #include "iris_physx_toolkit/float_texture.h"
 
+#include <assert.h>
 #include <stdalign.h>
 #include <stdatomic.h>
 #include <string.h>
@@ -130,6 +131,120 @@ FloatTextureSample(
     return status;
 }
 
+bool
+FloatTextureHasGradient(
+    _In_opt_ PCFLOAT_TEXTURE texture
+    )
+{
+    if (texture == NULL)
+    {
+        return true;
+    }
+
+    return texture->vtable->sample_with_gradient_routine != NULL;
+}
+
+ISTATUS
+FloatTextureSampleWithGradient(
+    _In_opt_ PCFLOAT_TEXTURE texture,
+    _In_ PCINTERSECTION intersection,
+    _In_opt_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    if (texture != NULL &&
+        texture->vtable->sample_with_gradient_routine == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (intersection == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (texture_coordinates == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (value == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (gradient == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (texture == NULL)
+    {
+        *value = (float_t)0.0;
+        gradient[0] = (float_t)0.0;
+        gradient[1] = (float_t)0.0;
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status =
+        texture->vtable->sample_with_gradient_routine(texture->data,
+                                                      intersection,
+                                                      additional_data,
+                                                      texture_coordinates,
+                                                      value,
+                                                      gradient);
+
+    return status;
+}
+
+bool
+FloatTextureGetConstant(
+    _In_opt_ PCFLOAT_TEXTURE texture,
+    _Out_ float_t *value
+    )
+{
+    assert(value != NULL);
+
+    if (texture == NULL)
+    {
+        *value = (float_t)0.0;
+        return true;
+    }
+
+    if (texture->vtable->get_constant_routine == NULL)
+    {
+        return false;
+    }
+
+    bool constant = texture->vtable->get_constant_routine(texture->data,
+                                                          value);
+
+    return constant;
+}
+
+SHADING_ATTRIBUTES
+FloatTextureGetAttributes(
+    _In_opt_ PCFLOAT_TEXTURE texture
+    )
+{
+    if (texture == NULL)
+    {
+        return SHADING_ATTRIBUTES_NONE;
+    }
+
+    if (texture->vtable->get_attributes_routine == NULL)
+    {
+        return SHADING_ATTRIBUTES_ALL;
+    }
+
+    SHADING_ATTRIBUTES attributes =
+        texture->vtable->get_attributes_routine(texture->data);
+
+    return attributes;
+}
+
 void
 FloatTextureRetain(
     _In_opt_ PFLOAT_TEXTURE texture
@@ -10,6 +10,20 @@ Abstract:
 
     Interface representing a texture of floats.
 
+    FloatTextureGetConstant returns true and the texture's value if the
+    texture is known to have the same value everywhere. A NULL texture is
+    constant zero.
+
+    FloatTextureGetAttributes returns the shading attributes the texture reads
+    when it is sampled. A texture without a get attributes routine is assumed
+    to read every attribute.
+
+    FloatTextureSampleWithGradient returns the value of the texture together
+    with its partial derivatives with respect to the u and v coordinates of a
+    UV_TEXTURE_COORDINATE in a single evaluation. It is only supported by
+    textures for which FloatTextureHasGradient returns true. A NULL texture
+    is constant zero and has a zero gradient.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_FLOAT_TEXTURE_
@@ -50,6 +64,32 @@ FloatTextureSample(
     _Out_ float_t *value
     );
 
+bool
+FloatTextureHasGradient(
+    _In_opt_ PCFLOAT_TEXTURE texture
+    );
+
+ISTATUS
+FloatTextureSampleWithGradient(
+    _In_opt_ PCFLOAT_TEXTURE texture,
+    _In_ PCINTERSECTION intersection,
+    _In_opt_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    );
+
+bool
+FloatTextureGetConstant(
+    _In_opt_ PCFLOAT_TEXTURE texture,
+    _Out_ float_t *value
+    );
+
+SHADING_ATTRIBUTES
+FloatTextureGetAttributes(
+    _In_opt_ PCFLOAT_TEXTURE texture
+    );
+
 void
 FloatTextureRetain(
     _In_opt_ PFLOAT_TEXTURE texture
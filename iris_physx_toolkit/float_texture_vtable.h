@@ -35,9 +35,36 @@ ISTATUS
     _Out_ float_t *value
     );
 
+typedef
+bool
+(*PFLOAT_TEXTURE_GET_CONSTANT_ROUTINE)(
+    _In_ const void *context,
+    _Out_ float_t *value
+    );
+
+typedef
+SHADING_ATTRIBUTES
+(*PFLOAT_TEXTURE_GET_ATTRIBUTES_ROUTINE)(
+    _In_ const void *context
+    );
+
+typedef
+ISTATUS
+(*PFLOAT_TEXTURE_SAMPLE_WITH_GRADIENT_ROUTINE)(
+    _In_ const void *context,
+    _In_ PCINTERSECTION intersection,
+    _In_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    );
+
 typedef struct _FLOAT_TEXTURE_VTABLE {
     PFLOAT_TEXTURE_SAMPLE_ROUTINE sample_routine;
     PFREE_ROUTINE free_routine;
+    PFLOAT_TEXTURE_GET_CONSTANT_ROUTINE get_constant_routine;
+    PFLOAT_TEXTURE_GET_ATTRIBUTES_ROUTINE get_attributes_routine;
+    PFLOAT_TEXTURE_SAMPLE_WITH_GRADIENT_ROUTINE sample_with_gradient_routine;
 } FLOAT_TEXTURE_VTABLE, *PFLOAT_TEXTURE_VTABLE;
 
 typedef const FLOAT_TEXTURE_VTABLE *PCFLOAT_TEXTURE_VTABLE;
@@ -75,6 +75,67 @@ ImageFloatTextureSample(
     return status;
 }
 
+static
+ISTATUS
+ImageFloatTextureSampleWithGradient(
+    _In_ const void *context,
+    _In_ PCINTERSECTION intersection,
+    _In_ const void *additional_data,
+    _In_ const void *texture_coordinates,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    PFLOAT_IMAGE_TEXTURE texture = (PFLOAT_IMAGE_TEXTURE)context;
+    PCUV_TEXTURE_COORDINATE uv = (PCUV_TEXTURE_COORDINATE)texture_coordinates;
+
+    float_t u = texture->u_offset + uv->uv[0] * texture->u_scalar;
+    float_t v = texture->v_offset + uv->uv[1] * texture->v_scalar;
+
+    ISTATUS status;
+    if (uv->has_derivatives)
+    {
+        status =
+            FloatMipmapFilteredLookupWithGradient(texture->mipmap,
+                                                  u,
+                                                  v,
+                                                  uv->du_dx * texture->u_scalar,
+                                                  uv->du_dy * texture->u_scalar,
+                                                  uv->dv_dx * texture->v_scalar,
+                                                  uv->dv_dy * texture->v_scalar,
+                                                  value,
+                                                  gradient);
+    }
+    else
+    {
+        status = FloatMipmapLookupWithGradient(texture->mipmap,
+                                               u,
+                                               v,
+                                               value,
+                                               gradient);
+    }
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    gradient[0] *= texture->u_scalar;
+    gradient[1] *= texture->v_scalar;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+SHADING_ATTRIBUTES
+ImageFloatTextureGetAttributes(
+    _In_ const void *context
+    )
+{
+    return SHADING_ATTRIBUTE_TEXTURE_COORDINATES |
+           SHADING_ATTRIBUTE_DERIVATIVES;
+}
+
 static
 void
 ImageFloatTextureFree(
@@ -91,7 +152,10 @@ ImageFloatTextureFree(
 
 static const FLOAT_TEXTURE_VTABLE float_image_texture_vtable = {
     ImageFloatTextureSample,
-    ImageFloatTextureFree
+    ImageFloatTextureFree,
+    NULL,
+    ImageFloatTextureGetAttributes,
+    ImageFloatTextureSampleWithGradient
 };
 
 //
@@ -214,6 +278,16 @@ ImageReflectorTextureSample(
     return status;
 }
 
+static
+SHADING_ATTRIBUTES
+ImageReflectorTextureGetAttributes(
+    _In_ const void *context
+    )
+{
+    return SHADING_ATTRIBUTE_TEXTURE_COORDINATES |
+           SHADING_ATTRIBUTE_DERIVATIVES;
+}
+
 static
 void
 ImageReflectorTextureFree(
@@ -230,7 +304,9 @@ ImageReflectorTextureFree(
 
 static const REFLECTOR_TEXTURE_VTABLE reflector_image_texture_vtable = {
     ImageReflectorTextureSample,
-    ImageReflectorTextureFree
+    ImageReflectorTextureFree,
+    NULL,
+    ImageReflectorTextureGetAttributes
 };
 
 //
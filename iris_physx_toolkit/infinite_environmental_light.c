@@ -83,9 +83,9 @@ DirectionToUV(
 
     float_t cos_theta =
         IMin(IMax(direction.z, (float_t)-1.0), (float_t)1.0);
-    float_t theta = acos(cos_theta);
+    float_t theta = ShadingAcos(cos_theta);
 
-    float_t phi = atan2(direction.y, direction.x);
+    float_t phi = ShadingAtan2(direction.y, direction.x);
     if (phi < (float_t)0.0) {
         phi += iris_two_pi;
     }
@@ -108,17 +108,20 @@ InfiniteEnvironmentalLightSample(
 {
     PCINFINITE_LIGHT infinite_light = (PCINFINITE_LIGHT)context;
 
-    float_t u;
-    ISTATUS status = RandomGenerateFloat(rng,
-                                         (float_t)0.0,
-                                         (float_t)1.0,
-                                         &u);
+    float_t uv[2];
+    ISTATUS status = RandomGenerateFloats(rng,
+                                          (float_t)0.0,
+                                          (float_t)1.0,
+                                          2,
+                                          uv);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
+    float_t u = uv[0];
+
     const float_t *found = bsearch(&u,
                                    infinite_light->cdf,
                                    infinite_light->num_texels,
@@ -130,18 +133,8 @@ InfiniteEnvironmentalLightSample(
     u = (u - *found) / infinite_light->pdf[index];
     u = infinite_light->texel_base_u[index] + u * infinite_light->texel_width_u;
 
-    float_t v;
-    status = RandomGenerateFloat(rng,
-                                 (float_t)0.0,
-                                 (float_t)1.0,
-                                 &v);
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
-    v = infinite_light->texel_base_v[index] + v * infinite_light->texel_width_v;
+    float_t v = infinite_light->texel_base_v[index] +
+                uv[1] * infinite_light->texel_width_v;
 
     status = SpectrumMipmapLookup(infinite_light->mipmap,
                                   u,
@@ -158,10 +151,10 @@ InfiniteEnvironmentalLightSample(
     float_t theta = v * iris_pi;
 
     float_t sin_phi, cos_phi;
-    SinCos(phi, &sin_phi, &cos_phi);
+    ShadingSinCos(phi, &sin_phi, &cos_phi);
 
     float_t sin_theta, cos_theta;
-    SinCos(theta, &sin_theta, &cos_theta);
+    ShadingSinCos(theta, &sin_theta, &cos_theta);
 
     VECTOR3 model_to_light = VectorCreate(cos_phi * sin_theta,
                                           sin_phi * sin_theta,
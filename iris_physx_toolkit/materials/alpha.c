@@ -81,6 +81,55 @@ AlphaMaterialSample(
     return status;
 }
 
+static
+ISTATUS
+AlphaMaterialPrepare(
+    _In_ const void *context,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Inout_ PREFLECTOR_COMPOSITOR reflector_compositor,
+    _Out_ PCBSDF *bsdf,
+    _Out_ bool *constant
+    )
+{
+    PCALPHA_MATERIAL alpha_material = (PCALPHA_MATERIAL)context;
+
+    PCBSDF base_bsdf;
+    float_t alpha;
+    if (!MaterialGetConstantBsdf(alpha_material->base, &base_bsdf) ||
+        !FloatTextureGetConstant(alpha_material->alpha, &alpha))
+    {
+        *constant = false;
+        return ISTATUS_SUCCESS;
+    }
+
+    alpha = IMax((float_t)0.0, IMin(alpha, (float_t)1.0));
+    ISTATUS status = AlphaBsdfAllocateWithAllocator(bsdf_allocator,
+                                                    base_bsdf,
+                                                    alpha,
+                                                    bsdf);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *constant = true;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+SHADING_ATTRIBUTES
+AlphaMaterialGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCALPHA_MATERIAL alpha_material = (PCALPHA_MATERIAL)context;
+
+    return MaterialGetAttributes(alpha_material->base) |
+           FloatTextureGetAttributes(alpha_material->alpha);
+}
+
 static
 void
 AlphaMaterialFree(
@@ -99,7 +148,9 @@ AlphaMaterialFree(
 
 static const MATERIAL_VTABLE alpha_material_vtable = {
     AlphaMaterialSample,
-    AlphaMaterialFree
+    AlphaMaterialFree,
+    AlphaMaterialPrepare,
+    AlphaMaterialGetAttributes
 };
 
 //
@@ -49,6 +49,15 @@ ConstantMaterialSample(
     return ISTATUS_SUCCESS;
 }
 
+static
+SHADING_ATTRIBUTES
+ConstantMaterialGetAttributes(
+    _In_ const void *context
+    )
+{
+    return SHADING_ATTRIBUTES_NONE;
+}
+
 static
 void
 ConstantMaterialFree(
@@ -66,7 +75,9 @@ ConstantMaterialFree(
 
 static const MATERIAL_VTABLE constant_material_vtable = {
     ConstantMaterialSample,
-    ConstantMaterialFree
+    ConstantMaterialFree,
+    NULL,
+    ConstantMaterialGetAttributes
 };
 
 //
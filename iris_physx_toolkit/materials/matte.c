@@ -33,6 +33,33 @@ typedef const MATTE_MATERIAL *PCMATTE_MATERIAL;
 // Static Functions
 //
 
+static
+ISTATUS
+MatteMaterialAllocateBsdf(
+    _In_opt_ PCREFLECTOR reflector,
+    _In_ float_t sigma,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Out_ PCBSDF *bsdf
+    )
+{
+    ISTATUS status;
+    if (sigma == (float_t)0.0)
+    {
+        status = LambertianBsdfAllocateWithAllocator(bsdf_allocator,
+                                                     reflector,
+                                                     bsdf);
+    }
+    else
+    {
+        status = OrenNayarBsdfAllocateWithAllocator(bsdf_allocator,
+                                                    reflector,
+                                                    sigma,
+                                                    bsdf);
+    }
+
+    return status;
+}
+
 static
 ISTATUS
 MatteMaterialSample(
@@ -72,21 +99,60 @@ MatteMaterialSample(
         return status;
     }
 
-    if (sigma == (float_t)0.0)
+    status = MatteMaterialAllocateBsdf(reflector,
+                                       sigma,
+                                       bsdf_allocator,
+                                       bsdf);
+
+    return status;
+}
+
+static
+ISTATUS
+MatteMaterialPrepare(
+    _In_ const void *context,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Inout_ PREFLECTOR_COMPOSITOR reflector_compositor,
+    _Out_ PCBSDF *bsdf,
+    _Out_ bool *constant
+    )
+{
+    PCMATTE_MATERIAL matte_material = (PCMATTE_MATERIAL)context;
+
+    PCREFLECTOR reflector;
+    float_t sigma;
+    if (!ReflectorTextureGetConstant(matte_material->diffuse, &reflector) ||
+        !FloatTextureGetConstant(matte_material->sigma, &sigma))
     {
-        status = LambertianBsdfAllocateWithAllocator(bsdf_allocator,
-                                                     reflector,
-                                                     bsdf);
+        *constant = false;
+        return ISTATUS_SUCCESS;
     }
-    else
+
+    ISTATUS status = MatteMaterialAllocateBsdf(reflector,
+                                               sigma,
+                                               bsdf_allocator,
+                                               bsdf);
+
+    if (status != ISTATUS_SUCCESS)
     {
-        status = OrenNayarBsdfAllocateWithAllocator(bsdf_allocator,
-                                                    reflector,
-                                                    sigma,
-                                                    bsdf);
+        return status;
     }
 
-    return status;
+    *constant = true;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+SHADING_ATTRIBUTES
+MatteMaterialGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCMATTE_MATERIAL matte_material = (PCMATTE_MATERIAL)context;
+
+    return ReflectorTextureGetAttributes(matte_material->diffuse) |
+           FloatTextureGetAttributes(matte_material->sigma);
 }
 
 static
@@ -107,7 +173,9 @@ MatteMaterialFree(
 
 static const MATERIAL_VTABLE matte_material_vtable = {
     MatteMaterialSample,
-    MatteMaterialFree
+    MatteMaterialFree,
+    MatteMaterialPrepare,
+    MatteMaterialGetAttributes
 };
 
 //
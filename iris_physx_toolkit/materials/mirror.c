@@ -65,6 +65,50 @@ MirrorMaterialSample(
     return status;
 }
 
+static
+ISTATUS
+MirrorMaterialPrepare(
+    _In_ const void *context,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Inout_ PREFLECTOR_COMPOSITOR reflector_compositor,
+    _Out_ PCBSDF *bsdf,
+    _Out_ bool *constant
+    )
+{
+    PCMIRROR_MATERIAL mirror_material = (PCMIRROR_MATERIAL)context;
+
+    PCREFLECTOR reflector;
+    if (!ReflectorTextureGetConstant(mirror_material->reflectance, &reflector))
+    {
+        *constant = false;
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = MirrorBsdfAllocateWithAllocator(bsdf_allocator,
+                                                     reflector,
+                                                     bsdf);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    *constant = true;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+SHADING_ATTRIBUTES
+MirrorMaterialGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCMIRROR_MATERIAL mirror_material = (PCMIRROR_MATERIAL)context;
+
+    return ReflectorTextureGetAttributes(mirror_material->reflectance);
+}
+
 static
 void
 MirrorMaterialFree(
@@ -82,7 +126,9 @@ MirrorMaterialFree(
 
 static const MATERIAL_VTABLE mirror_material_vtable = {
     MirrorMaterialSample,
-    MirrorMaterialFree
+    MirrorMaterialFree,
+    MirrorMaterialPrepare,
+    MirrorMaterialGetAttributes
 };
 
 //
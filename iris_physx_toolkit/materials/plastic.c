@@ -38,6 +38,67 @@ typedef const PLASTIC_MATERIAL *PCPLASTIC_MATERIAL;
 // Static Functions
 //
 
+static
+ISTATUS
+PlasticMaterialAllocateBsdf(
+    _In_opt_ PCREFLECTOR diffuse,
+    _In_opt_ PCREFLECTOR specular,
+    _In_ float_t roughness,
+    _In_ bool remap_roughness,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Out_ PCBSDF *bsdf
+    )
+{
+    PCBSDF bsdfs[2];
+    ISTATUS status = LambertianBsdfAllocateWithAllocator(bsdf_allocator,
+                                                         diffuse,
+                                                         &bsdfs[0]);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    FRESNEL fresnel;
+    status = FresnelDielectricInitialize((float_t)1.5, (float_t)1.0, &fresnel);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (remap_roughness)
+    {
+        roughness = TrowbridgeReitzRoughnessToAlpha(roughness);
+    }
+
+    MICROFACET_DISTRIBUTION distribution;
+    status = TrowbridgeReitzInitialize(roughness, roughness, &distribution);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = MicrofacetReflectionBsdfAllocateWithAllocator(bsdf_allocator,
+                                                           specular,
+                                                           &distribution,
+                                                           &fresnel,
+                                                           &bsdfs[1]);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = AggregateBsdfAllocateWithAllocator(bsdf_allocator,
+                                                bsdfs,
+                                                2,
+                                                bsdf);
+
+    return status;
+}
+
 static
 ISTATUS
 PlasticMaterialSample(
@@ -90,54 +151,67 @@ PlasticMaterialSample(
         return status;
     }
 
-    PCBSDF bsdfs[2];
-    status = LambertianBsdfAllocateWithAllocator(bsdf_allocator,
-                                                 diffuse,
-                                                 &bsdfs[0]);
+    status = PlasticMaterialAllocateBsdf(diffuse,
+                                         specular,
+                                         roughness,
+                                         plastic_material->remap_roughness,
+                                         bsdf_allocator,
+                                         bsdf);
 
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
-    FRESNEL fresnel;
-    status = FresnelDielectricInitialize((float_t)1.5, (float_t)1.0, &fresnel);
+    return status;
+}
 
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
+static
+ISTATUS
+PlasticMaterialPrepare(
+    _In_ const void *context,
+    _Inout_ PBSDF_ALLOCATOR bsdf_allocator,
+    _Inout_ PREFLECTOR_COMPOSITOR reflector_compositor,
+    _Out_ PCBSDF *bsdf,
+    _Out_ bool *constant
+    )
+{
+    PCPLASTIC_MATERIAL plastic_material = (PCPLASTIC_MATERIAL)context;
 
-    if (plastic_material->remap_roughness)
+    PCREFLECTOR diffuse, specular;
+    float_t roughness;
+    if (!ReflectorTextureGetConstant(plastic_material->diffuse, &diffuse) ||
+        !ReflectorTextureGetConstant(plastic_material->specular, &specular) ||
+        !FloatTextureGetConstant(plastic_material->roughness, &roughness))
     {
-        roughness = TrowbridgeReitzRoughnessToAlpha(roughness);
+        *constant = false;
+        return ISTATUS_SUCCESS;
     }
 
-    MICROFACET_DISTRIBUTION distribution;
-    status = TrowbridgeReitzInitialize(roughness, roughness, &distribution);
+    ISTATUS status =
+        PlasticMaterialAllocateBsdf(diffuse,
+                                    specular,
+                                    roughness,
+                                    plastic_material->remap_roughness,
+                                    bsdf_allocator,
+                                    bsdf);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    status = MicrofacetReflectionBsdfAllocateWithAllocator(bsdf_allocator,
-                                                           specular,
-                                                           &distribution,
-                                                           &fresnel,
-                                                           &bsdfs[1]);
+    *constant = true;
 
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
+    return ISTATUS_SUCCESS;
+}
 
-    status = AggregateBsdfAllocateWithAllocator(bsdf_allocator,
-                                                bsdfs,
-                                                2,
-                                                bsdf);
+static
+SHADING_ATTRIBUTES
+PlasticMaterialGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCPLASTIC_MATERIAL plastic_material = (PCPLASTIC_MATERIAL)context;
 
-    return status;
+    return ReflectorTextureGetAttributes(plastic_material->diffuse) |
+           ReflectorTextureGetAttributes(plastic_material->specular) |
+           FloatTextureGetAttributes(plastic_material->roughness);
 }
 
 static
@@ -159,7 +233,9 @@ PlasticMaterialFree(
 
 static const MATERIAL_VTABLE plastic_material_vtable = {
     PlasticMaterialSample,
-    PlasticMaterialFree
+    PlasticMaterialFree,
+    PlasticMaterialPrepare,
+    PlasticMaterialGetAttributes
 };
 
 //
@@ -2805,6 +2805,136 @@ FloatMipmapLookupTextureFilteringEwa(
     *value = ((float_t)1.0 - delta) * v0 + delta * v1;
 }
 
+static
+void
+FloatMipmapLookupWithTriangleFilterAndGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ size_t level,
+    _In_ float_t s,
+    _In_ float_t t,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    if (mipmap->num_levels <= level)
+    {
+        level = mipmap->num_levels - 1;
+    }
+
+    float_t scaled_s = s * mipmap->levels[level].width_fp;
+    float_t scaled_t = t * mipmap->levels[level].height_fp;
+
+    float_t scaled_s0 = floor(scaled_s - (float_t)0.5) + (float_t)0.5;
+    float_t scaled_t0 = floor(scaled_t - (float_t)0.5) + (float_t)0.5;
+
+    float_t s0 = scaled_s0 * mipmap->levels[level].texel_width;
+    float_t t0 = scaled_t0 * mipmap->levels[level].texel_height;
+
+    float_t ds = scaled_s - scaled_s0;
+    float_t dt = scaled_t - scaled_t0;
+
+    ds = IMax((float_t)0.0, IMin(ds, (float_t)1.0));
+    dt = IMax((float_t)0.0, IMin(dt, (float_t)1.0));
+
+    float_t one_minus_ds = (float_t)1.0 - ds;
+    float_t one_minus_dt = (float_t)1.0 - dt;
+
+    float_t s1 = s0 + mipmap->levels[level].texel_width;
+    float_t t1 = t0 + mipmap->levels[level].texel_height;
+
+    float_t v00 = FloatMipmapLookupTexel(mipmap, level, s0, t0);
+    float_t v01 = FloatMipmapLookupTexel(mipmap, level, s0, t1);
+    float_t v10 = FloatMipmapLookupTexel(mipmap, level, s1, t0);
+    float_t v11 = FloatMipmapLookupTexel(mipmap, level, s1, t1);
+
+    *value = (one_minus_ds * one_minus_dt * v00) +
+             (one_minus_ds * dt * v01) +
+             (ds * one_minus_dt * v10) +
+             (ds * dt * v11);
+
+    gradient[0] = mipmap->levels[level].width_fp *
+        (one_minus_dt * (v10 - v00) + dt * (v11 - v01));
+    gradient[1] = mipmap->levels[level].height_fp *
+        (one_minus_ds * (v01 - v00) + ds * (v11 - v10));
+}
+
+static
+void
+FloatMipmapLookupTextureFilteringTrilinearWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _In_ float_t dsdx,
+    _In_ float_t dsdy,
+    _In_ float_t dtdx,
+    _In_ float_t dtdy,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    dsdx = fabs(dsdx);
+    dsdy = fabs(dsdy);
+    dtdx = fabs(dtdx);
+    dtdy = fabs(dtdy);
+
+    float_t max = IMax(dsdx, IMax(dsdy, IMax(dtdx, dtdy)));
+    float_t level =
+        mipmap->last_level_index_fp + FloatTLog2(IMax(max, (float_t)1e-8));
+
+    if (level < (float_t)0.0)
+    {
+        FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                       0,
+                                                       s,
+                                                       t,
+                                                       value,
+                                                       gradient);
+    }
+    else if (level >= mipmap->last_level_index_fp)
+    {
+        FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                       mipmap->num_levels - 1,
+                                                       s,
+                                                       t,
+                                                       value,
+                                                       gradient);
+    }
+    else
+    {
+#if FLT_EVAL_METHOD	== 0
+        float delta, level0;
+        delta = modff(level, &level0);
+#elif FLT_EVAL_METHOD == 1
+        double delta, level0;
+        delta = modf(level, &level0);
+#elif FLT_EVAL_METHOD == 2
+        long double delta, level0;
+        delta = modfl(level, &level0);
+#endif
+
+        float_t value0, gradient0[2];
+        FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                       (size_t)level0,
+                                                       s,
+                                                       t,
+                                                       &value0,
+                                                       gradient0);
+
+        float_t value1, gradient1[2];
+        FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                       (size_t)level0 + 1,
+                                                       s,
+                                                       t,
+                                                       &value1,
+                                                       gradient1);
+
+        float_t one_minus_delta = (float_t)1.0 - delta;
+        *value = delta * value0 + one_minus_delta * value1;
+        gradient[0] = delta * gradient0[0] + one_minus_delta * gradient1[0];
+        gradient[1] = delta * gradient0[1] + one_minus_delta * gradient1[1];
+    }
+}
+
 //
 // Float Mipmap Functions
 //
@@ -3151,6 +3281,157 @@ FloatMipmapFilteredLookup(
     return ISTATUS_SUCCESS;
 }
 
+ISTATUS
+FloatMipmapLookupWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    if (mipmap == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(s))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (!isfinite(t))
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (value == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (gradient == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                   0,
+                                                   s,
+                                                   t,
+                                                   value,
+                                                   gradient);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+FloatMipmapFilteredLookupWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _In_ float_t dsdx,
+    _In_ float_t dsdy,
+    _In_ float_t dtdx,
+    _In_ float_t dtdy,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    if (mipmap == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isfinite(s))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (!isfinite(t))
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (!isfinite(dsdx))
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (!isfinite(dsdy))
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (!isfinite(dtdx))
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (!isfinite(dtdy))
+    {
+        return ISTATUS_INVALID_ARGUMENT_06;
+    }
+
+    if (value == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_07;
+    }
+
+    if (gradient == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_08;
+    }
+
+    if (mipmap->texture_filtering == TEXTURE_FILTERING_ALGORITHM_NONE)
+    {
+        FloatMipmapLookupWithTriangleFilterAndGradient(mipmap,
+                                                       0,
+                                                       s,
+                                                       t,
+                                                       value,
+                                                       gradient);
+    }
+    else if (mipmap->texture_filtering == TEXTURE_FILTERING_ALGORITHM_TRILINEAR)
+    {
+        FloatMipmapLookupTextureFilteringTrilinearWithGradient(mipmap,
+                                                               s,
+                                                               t,
+                                                               dsdx,
+                                                               dsdy,
+                                                               dtdx,
+                                                               dtdy,
+                                                               value,
+                                                               gradient);
+    }
+    else
+    {
+        assert(mipmap->texture_filtering == TEXTURE_FILTERING_ALGORITHM_EWA);
+
+        float_t unused;
+        FloatMipmapLookupTextureFilteringTrilinearWithGradient(mipmap,
+                                                               s,
+                                                               t,
+                                                               dsdx,
+                                                               dsdy,
+                                                               dtdx,
+                                                               dtdy,
+                                                               &unused,
+                                                               gradient);
+
+        FloatMipmapLookupTextureFilteringEwa(mipmap,
+                                             s,
+                                             t,
+                                             dsdx,
+                                             dsdy,
+                                             dtdx,
+                                             dtdy,
+                                             value);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
 ISTATUS
 FloatMipmapGetDimensions(
     _In_ PCFLOAT_MIPMAP mipmap,
@@ -10,6 +10,16 @@ Abstract:
 
     Creates a mipmap.
 
+    The float mipmap can also return the gradient of its value with respect
+    to s and t. The gradient lookups always reconstruct bilinearly, since the
+    nearest texel lookups are piecewise constant and have no useful gradient.
+    Without filtering they return the bilinear value of the finest level and
+    its gradient rather than the nearest texel. With trilinear filtering the
+    value is the same as that of FloatMipmapFilteredLookup and the gradient
+    is exactly its derivative. With EWA filtering the value is the EWA value
+    and the gradient is that of the trilinear reconstruction, which only
+    approximates the derivative of the EWA value.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_MIPMAP_
@@ -225,6 +235,28 @@ FloatMipmapFilteredLookup(
     _Out_ float_t *value
     );
 
+ISTATUS
+FloatMipmapLookupWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    );
+
+ISTATUS
+FloatMipmapFilteredLookupWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _In_ float_t dsdx,
+    _In_ float_t dsdy,
+    _In_ float_t dtdx,
+    _In_ float_t dtdy,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    );
+
 ISTATUS
 FloatMipmapGetDimensions(
     _In_ PCFLOAT_MIPMAP mipmap,
@@ -0,0 +1,1293 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    path_guide.c
+
+Abstract:
+
+    Implements a path guide.
+
+--*/
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <threads.h>
+
+#include "common/safe_math.h"
+#include "iris_physx_toolkit/path_guide.h"
+
+//
+// Defines
+//
+
+#define PATH_GUIDE_MAX_SPATIAL_DEPTH 24
+#define PATH_GUIDE_MAX_DIRECTIONAL_DEPTH 16
+#define PATH_GUIDE_SUBDIVISION_THRESHOLD ((float_t)0.01)
+#define PATH_GUIDE_NO_NODE UINT32_MAX
+#define PATH_GUIDE_MINIMUM_OFFSET ((float_t)0.001)
+#define PATH_GUIDE_MAXIMUM_OFFSET ((float_t)0.999)
+
+//
+// Types
+//
+
+typedef struct _PATH_GUIDE_SPATIAL_NODE {
+    uint32_t children[2];
+    uint32_t directional_root;
+    uint32_t leaf_index;
+} PATH_GUIDE_SPATIAL_NODE, *PPATH_GUIDE_SPATIAL_NODE;
+
+typedef const PATH_GUIDE_SPATIAL_NODE *PCPATH_GUIDE_SPATIAL_NODE;
+
+typedef struct _PATH_GUIDE_DIRECTIONAL_NODE {
+    uint32_t children[4];
+} PATH_GUIDE_DIRECTIONAL_NODE, *PPATH_GUIDE_DIRECTIONAL_NODE;
+
+typedef const PATH_GUIDE_DIRECTIONAL_NODE *PCPATH_GUIDE_DIRECTIONAL_NODE;
+
+typedef struct _PATH_GUIDE_TREE {
+    _Field_size_(num_spatial_nodes) PPATH_GUIDE_SPATIAL_NODE spatial_nodes;
+    _Field_size_(num_directional_nodes)
+        PPATH_GUIDE_DIRECTIONAL_NODE directional_nodes;
+    size_t num_spatial_nodes;
+    size_t spatial_nodes_capacity;
+    size_t num_directional_nodes;
+    size_t directional_nodes_capacity;
+    size_t num_leaves;
+} PATH_GUIDE_TREE, *PPATH_GUIDE_TREE;
+
+typedef const PATH_GUIDE_TREE *PCPATH_GUIDE_TREE;
+
+struct _PATH_GUIDE_REGION {
+    PCPATH_GUIDE_DIRECTIONAL_NODE directional_nodes;
+    const float_t *energies;
+    uint32_t root;
+    float_t energy;
+    float_t radiance;
+};
+
+struct _PATH_GUIDE_RECORDER {
+    PPATH_GUIDE path_guide;
+    _Field_size_(4 * path_guide->training_tree.num_directional_nodes)
+        float_t *energies;
+    _Field_size_(path_guide->training_tree.num_leaves) size_t *sample_counts;
+    float_t observed_minimum[3];
+    float_t observed_maximum[3];
+    struct _PATH_GUIDE_RECORDER *next;
+    struct _PATH_GUIDE_RECORDER *previous;
+};
+
+struct _PATH_GUIDE {
+    PATH_GUIDE_TREE sampling_tree;
+    _Field_size_(4 * sampling_tree.num_directional_nodes)
+        float_t *sampling_energies;
+    _Field_size_(sampling_tree.num_leaves) PPATH_GUIDE_REGION sampling_regions;
+    PATH_GUIDE_TREE training_tree;
+    _Field_size_(4 * training_tree.num_directional_nodes)
+        float_t *training_energies;
+    _Field_size_(training_tree.num_leaves) size_t *training_sample_counts;
+    float_t minimum[3];
+    float_t maximum[3];
+    float_t observed_minimum[3];
+    float_t observed_maximum[3];
+    bool has_bounds;
+    size_t samples_per_region;
+    PPATH_GUIDE_RECORDER recorders;
+    mtx_t lock;
+    atomic_uintmax_t reference_count;
+};
+
+//
+// Static Functions
+//
+
+static
+inline
+size_t
+PathGuideSelectQuadrant(
+    _Inout_ float_t *u,
+    _Inout_ float_t *v
+    )
+{
+    size_t quadrant = 0;
+
+    if ((float_t)0.5 <= *u)
+    {
+        *u -= (float_t)0.5;
+        quadrant |= 1;
+    }
+
+    if ((float_t)0.5 <= *v)
+    {
+        *v -= (float_t)0.5;
+        quadrant |= 2;
+    }
+
+    *u += *u;
+    *v += *v;
+
+    return quadrant;
+}
+
+static
+inline
+void
+PathGuideDirectionToSquare(
+    _In_ VECTOR3 direction,
+    _Out_ float_t *u,
+    _Out_ float_t *v
+    )
+{
+    float_t cos_theta = IMax((float_t)-1.0, IMin((float_t)1.0, direction.z));
+    float_t phi = ShadingAtan2(direction.y, direction.x);
+
+    if (phi < (float_t)0.0)
+    {
+        phi += iris_two_pi;
+    }
+
+    *u = (cos_theta + (float_t)1.0) * (float_t)0.5;
+    *v = IMin((float_t)1.0, phi * iris_inv_two_pi);
+}
+
+static
+inline
+uint32_t
+PathGuideTreeFindLeaf(
+    _In_ PCPATH_GUIDE_TREE tree,
+    _In_ const float_t minimum[3],
+    _In_ const float_t maximum[3],
+    _In_ POINT3 point
+    )
+{
+    float_t coordinates[3] = { point.x, point.y, point.z };
+    float_t lower[3] = { minimum[0], minimum[1], minimum[2] };
+    float_t upper[3] = { maximum[0], maximum[1], maximum[2] };
+
+    uint32_t node = 0;
+    size_t axis = 0;
+    while (tree->spatial_nodes[node].children[0] != 0)
+    {
+        float_t middle = (lower[axis] + upper[axis]) * (float_t)0.5;
+
+        if (coordinates[axis] < middle)
+        {
+            node = tree->spatial_nodes[node].children[0];
+            upper[axis] = middle;
+        }
+        else
+        {
+            node = tree->spatial_nodes[node].children[1];
+            lower[axis] = middle;
+        }
+
+        axis = (axis == 2) ? 0 : axis + 1;
+    }
+
+    return node;
+}
+
+static
+bool
+PathGuideGrowArray(
+    _Inout_ void **array,
+    _In_ size_t element_size,
+    _Inout_ size_t *capacity
+    )
+{
+    size_t new_capacity;
+    bool success = CheckedMultiplySizeT(*capacity, 2, &new_capacity);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    if (new_capacity == 0)
+    {
+        new_capacity = 16;
+    }
+
+    size_t new_size;
+    success = CheckedMultiplySizeT(new_capacity, element_size, &new_size);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    void *new_array = realloc(*array, new_size);
+
+    if (new_array == NULL)
+    {
+        return false;
+    }
+
+    *array = new_array;
+    *capacity = new_capacity;
+
+    return true;
+}
+
+static
+bool
+PathGuideTreeAddSpatialNode(
+    _Inout_ PPATH_GUIDE_TREE tree,
+    _Out_ uint32_t *index
+    )
+{
+    if (tree->num_spatial_nodes == PATH_GUIDE_NO_NODE)
+    {
+        return false;
+    }
+
+    if (tree->num_spatial_nodes == tree->spatial_nodes_capacity)
+    {
+        bool success =
+            PathGuideGrowArray((void**)&tree->spatial_nodes,
+                               sizeof(PATH_GUIDE_SPATIAL_NODE),
+                               &tree->spatial_nodes_capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+    }
+
+    *index = (uint32_t)tree->num_spatial_nodes;
+
+    PPATH_GUIDE_SPATIAL_NODE node = tree->spatial_nodes + *index;
+    node->children[0] = 0;
+    node->children[1] = 0;
+    node->directional_root = 0;
+    node->leaf_index = 0;
+
+    tree->num_spatial_nodes += 1;
+
+    return true;
+}
+
+static
+bool
+PathGuideTreeAddDirectionalNode(
+    _Inout_ PPATH_GUIDE_TREE tree,
+    _Out_ uint32_t *index
+    )
+{
+    if (tree->num_directional_nodes == PATH_GUIDE_NO_NODE)
+    {
+        return false;
+    }
+
+    if (tree->num_directional_nodes == tree->directional_nodes_capacity)
+    {
+        bool success =
+            PathGuideGrowArray((void**)&tree->directional_nodes,
+                               sizeof(PATH_GUIDE_DIRECTIONAL_NODE),
+                               &tree->directional_nodes_capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+    }
+
+    *index = (uint32_t)tree->num_directional_nodes;
+
+    PPATH_GUIDE_DIRECTIONAL_NODE node = tree->directional_nodes + *index;
+    for (size_t i = 0; i < 4; i++)
+    {
+        node->children[i] = 0;
+    }
+
+    tree->num_directional_nodes += 1;
+
+    return true;
+}
+
+static
+void
+PathGuideTreeDestroy(
+    _Inout_ PPATH_GUIDE_TREE tree
+    )
+{
+    free(tree->spatial_nodes);
+    free(tree->directional_nodes);
+}
+
+//
+// The training tree of the next pass is built from the training tree and the
+// energies of the pass that just completed. Each directional quadtree is
+// refined where its quadrants hold more than the subdivision threshold of the
+// energy of the region, assuming energy is spread evenly below the nodes that
+// already exist. Regions with too many samples are split, with both halves
+// inheriting the directional refinement of the region.
+//
+
+static
+bool
+PathGuideRefineDirectional(
+    _In_ PCPATH_GUIDE_DIRECTIONAL_NODE template_nodes,
+    _In_ const float_t *template_energies,
+    _In_ uint32_t template_node,
+    _In_ float_t template_energy,
+    _In_ float_t fraction,
+    _In_ size_t depth,
+    _Inout_ PPATH_GUIDE_TREE tree,
+    _In_ uint32_t node
+    )
+{
+    for (size_t quadrant = 0; quadrant < 4; quadrant++)
+    {
+        uint32_t template_child = PATH_GUIDE_NO_NODE;
+        float_t child_fraction;
+        if (template_node != PATH_GUIDE_NO_NODE)
+        {
+            child_fraction = template_energies[4 * template_node + quadrant] /
+                             template_energy;
+
+            uint32_t child = template_nodes[template_node].children[quadrant];
+            if (child != 0)
+            {
+                template_child = child;
+            }
+        }
+        else
+        {
+            child_fraction = fraction * (float_t)0.25;
+        }
+
+        if (child_fraction <= PATH_GUIDE_SUBDIVISION_THRESHOLD ||
+            depth == PATH_GUIDE_MAX_DIRECTIONAL_DEPTH)
+        {
+            continue;
+        }
+
+        uint32_t child;
+        bool success = PathGuideTreeAddDirectionalNode(tree, &child);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        tree->directional_nodes[node].children[quadrant] = child;
+
+        success = PathGuideRefineDirectional(template_nodes,
+                                             template_energies,
+                                             template_child,
+                                             template_energy,
+                                             child_fraction,
+                                             depth + 1,
+                                             tree,
+                                             child);
+
+        if (!success)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+bool
+PathGuideBuildRegion(
+    _In_ PCPATH_GUIDE_DIRECTIONAL_NODE template_nodes,
+    _In_ const float_t *template_energies,
+    _In_ uint32_t template_root,
+    _In_ size_t sample_count,
+    _In_ size_t samples_per_region,
+    _In_ size_t depth,
+    _Inout_ PPATH_GUIDE_TREE tree,
+    _Out_ uint32_t *index
+    )
+{
+    uint32_t node;
+    bool success = PathGuideTreeAddSpatialNode(tree, &node);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    *index = node;
+
+    if (samples_per_region < sample_count &&
+        depth < PATH_GUIDE_MAX_SPATIAL_DEPTH)
+    {
+        for (size_t i = 0; i < 2; i++)
+        {
+            uint32_t child;
+            success = PathGuideBuildRegion(template_nodes,
+                                           template_energies,
+                                           template_root,
+                                           sample_count / 2,
+                                           samples_per_region,
+                                           depth + 1,
+                                           tree,
+                                           &child);
+
+            if (!success)
+            {
+                return false;
+            }
+
+            tree->spatial_nodes[node].children[i] = child;
+        }
+
+        return true;
+    }
+
+    uint32_t root;
+    success = PathGuideTreeAddDirectionalNode(tree, &root);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    tree->spatial_nodes[node].directional_root = root;
+    tree->spatial_nodes[node].leaf_index = (uint32_t)tree->num_leaves;
+    tree->num_leaves += 1;
+
+    const float_t *root_energies = template_energies + 4 * template_root;
+    float_t template_energy = root_energies[0] + root_energies[1] +
+                              root_energies[2] + root_energies[3];
+
+    if (template_energy <= (float_t)0.0)
+    {
+        return true;
+    }
+
+    success = PathGuideRefineDirectional(template_nodes,
+                                         template_energies,
+                                         template_root,
+                                         template_energy,
+                                         (float_t)1.0,
+                                         1,
+                                         tree,
+                                         root);
+
+    return success;
+}
+
+static
+bool
+PathGuideBuildTree(
+    _In_ PCPATH_GUIDE_TREE template_tree,
+    _In_ const float_t *template_energies,
+    _In_ const size_t *template_sample_counts,
+    _In_ uint32_t template_node,
+    _In_ size_t samples_per_region,
+    _In_ size_t depth,
+    _Inout_ PPATH_GUIDE_TREE tree,
+    _Out_ uint32_t *index
+    )
+{
+    PCPATH_GUIDE_SPATIAL_NODE template_spatial_node =
+        template_tree->spatial_nodes + template_node;
+
+    if (template_spatial_node->children[0] == 0)
+    {
+        bool success =
+            PathGuideBuildRegion(
+                template_tree->directional_nodes,
+                template_energies,
+                template_spatial_node->directional_root,
+                template_sample_counts[template_spatial_node->leaf_index],
+                samples_per_region,
+                depth,
+                tree,
+                index);
+
+        return success;
+    }
+
+    uint32_t node;
+    bool success = PathGuideTreeAddSpatialNode(tree, &node);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    *index = node;
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        uint32_t child;
+        success = PathGuideBuildTree(template_tree,
+                                     template_energies,
+                                     template_sample_counts,
+                                     template_spatial_node->children[i],
+                                     samples_per_region,
+                                     depth + 1,
+                                     tree,
+                                     &child);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        tree->spatial_nodes[node].children[i] = child;
+    }
+
+    return true;
+}
+
+static
+bool
+PathGuideAllocateTrainingData(
+    _In_ PCPATH_GUIDE_TREE tree,
+    _Out_ float_t **energies,
+    _Out_ size_t **sample_counts
+    )
+{
+    size_t num_energies;
+    bool success = CheckedMultiplySizeT(tree->num_directional_nodes,
+                                        4,
+                                        &num_energies);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    *energies = (float_t*)calloc(num_energies, sizeof(float_t));
+
+    if (*energies == NULL)
+    {
+        return false;
+    }
+
+    *sample_counts = (size_t*)calloc(tree->num_leaves, sizeof(size_t));
+
+    if (*sample_counts == NULL)
+    {
+        free(*energies);
+        return false;
+    }
+
+    return true;
+}
+
+static
+void
+PathGuideResetObservedBounds(
+    _Out_ float_t minimum[3],
+    _Out_ float_t maximum[3]
+    )
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        minimum[i] = (float_t)INFINITY;
+        maximum[i] = (float_t)-INFINITY;
+    }
+}
+
+static
+void
+PathGuideMergeRecorder(
+    _Inout_ PPATH_GUIDE path_guide,
+    _Inout_ PPATH_GUIDE_RECORDER recorder
+    )
+{
+    size_t num_energies = 4 * path_guide->training_tree.num_directional_nodes;
+    for (size_t i = 0; i < num_energies; i++)
+    {
+        path_guide->training_energies[i] += recorder->energies[i];
+        recorder->energies[i] = (float_t)0.0;
+    }
+
+    for (size_t i = 0; i < path_guide->training_tree.num_leaves; i++)
+    {
+        path_guide->training_sample_counts[i] += recorder->sample_counts[i];
+        recorder->sample_counts[i] = 0;
+    }
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        path_guide->observed_minimum[i] =
+            IMin(path_guide->observed_minimum[i],
+                 recorder->observed_minimum[i]);
+        path_guide->observed_maximum[i] =
+            IMax(path_guide->observed_maximum[i],
+                 recorder->observed_maximum[i]);
+    }
+
+    PathGuideResetObservedBounds(recorder->observed_minimum,
+                                 recorder->observed_maximum);
+}
+
+//
+// Functions
+//
+
+ISTATUS
+PathGuideAllocate(
+    _In_ size_t samples_per_region,
+    _Out_ PPATH_GUIDE *path_guide
+    )
+{
+    if (samples_per_region == 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (path_guide == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    PPATH_GUIDE result = (PPATH_GUIDE)calloc(1, sizeof(PATH_GUIDE));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    uint32_t spatial_root, directional_root;
+    bool success =
+        PathGuideTreeAddSpatialNode(&result->training_tree, &spatial_root) &&
+        PathGuideTreeAddDirectionalNode(&result->training_tree,
+                                        &directional_root);
+
+    if (!success)
+    {
+        PathGuideTreeDestroy(&result->training_tree);
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->training_tree.num_leaves = 1;
+
+    success = PathGuideAllocateTrainingData(&result->training_tree,
+                                            &result->training_energies,
+                                            &result->training_sample_counts);
+
+    if (!success)
+    {
+        PathGuideTreeDestroy(&result->training_tree);
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    if (mtx_init(&result->lock, mtx_plain) != thrd_success)
+    {
+        free(result->training_energies);
+        free(result->training_sample_counts);
+        PathGuideTreeDestroy(&result->training_tree);
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PathGuideResetObservedBounds(result->observed_minimum,
+                                 result->observed_maximum);
+
+    result->samples_per_region = samples_per_region;
+    result->reference_count = 1;
+
+    *path_guide = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+PathGuideUpdate(
+    _Inout_ PPATH_GUIDE path_guide
+    )
+{
+    if (path_guide == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    mtx_lock(&path_guide->lock);
+
+    size_t num_recorders = 0;
+    for (PPATH_GUIDE_RECORDER recorder = path_guide->recorders;
+         recorder != NULL;
+         recorder = recorder->next)
+    {
+        PathGuideMergeRecorder(path_guide, recorder);
+        num_recorders += 1;
+    }
+
+    if (!path_guide->has_bounds &&
+        path_guide->observed_minimum[0] <= path_guide->observed_maximum[0])
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            path_guide->minimum[i] = path_guide->observed_minimum[i];
+            path_guide->maximum[i] = path_guide->observed_maximum[i];
+        }
+
+        path_guide->has_bounds = true;
+    }
+
+    size_t samples_per_region =
+        path_guide->has_bounds ? path_guide->samples_per_region : SIZE_MAX;
+
+    PATH_GUIDE_TREE tree = { 0 };
+    uint32_t root;
+    bool success = PathGuideBuildTree(&path_guide->training_tree,
+                                      path_guide->training_energies,
+                                      path_guide->training_sample_counts,
+                                      0,
+                                      samples_per_region,
+                                      0,
+                                      &tree,
+                                      &root);
+
+    if (!success)
+    {
+        PathGuideTreeDestroy(&tree);
+        mtx_unlock(&path_guide->lock);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PPATH_GUIDE_REGION regions = (PPATH_GUIDE_REGION)calloc(
+        path_guide->training_tree.num_leaves, sizeof(PATH_GUIDE_REGION));
+
+    if (regions == NULL)
+    {
+        PathGuideTreeDestroy(&tree);
+        mtx_unlock(&path_guide->lock);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    size_t num_training_arrays;
+    success = CheckedAddSizeT(num_recorders, 1, &num_training_arrays);
+
+    float_t **energies = NULL;
+    size_t **sample_counts = NULL;
+    if (success)
+    {
+        energies = (float_t**)calloc(num_training_arrays, sizeof(float_t*));
+        sample_counts = (size_t**)calloc(num_training_arrays, sizeof(size_t*));
+    }
+
+    size_t allocated = 0;
+    if (energies != NULL && sample_counts != NULL)
+    {
+        while (allocated < num_training_arrays &&
+               PathGuideAllocateTrainingData(&tree,
+                                             energies + allocated,
+                                             sample_counts + allocated))
+        {
+            allocated += 1;
+        }
+    }
+
+    if (energies == NULL ||
+        sample_counts == NULL ||
+        allocated != num_training_arrays)
+    {
+        for (size_t i = 0; i < allocated; i++)
+        {
+            free(energies[i]);
+            free(sample_counts[i]);
+        }
+
+        free(energies);
+        free(sample_counts);
+        free(regions);
+        PathGuideTreeDestroy(&tree);
+        mtx_unlock(&path_guide->lock);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PathGuideTreeDestroy(&path_guide->sampling_tree);
+    free(path_guide->sampling_energies);
+    free(path_guide->sampling_regions);
+
+    path_guide->sampling_tree = path_guide->training_tree;
+    path_guide->sampling_energies = path_guide->training_energies;
+    path_guide->sampling_regions = regions;
+
+    for (size_t i = 0; i < path_guide->sampling_tree.num_spatial_nodes; i++)
+    {
+        PCPATH_GUIDE_SPATIAL_NODE node =
+            path_guide->sampling_tree.spatial_nodes + i;
+
+        if (node->children[0] != 0)
+        {
+            continue;
+        }
+
+        const float_t *root_energies =
+            path_guide->sampling_energies + 4 * node->directional_root;
+
+        PPATH_GUIDE_REGION region = regions + node->leaf_index;
+        region->directional_nodes =
+            path_guide->sampling_tree.directional_nodes;
+        region->energies = path_guide->sampling_energies;
+        region->root = node->directional_root;
+        region->energy = root_energies[0] + root_energies[1] +
+                         root_energies[2] + root_energies[3];
+
+        size_t sample_count =
+            path_guide->training_sample_counts[node->leaf_index];
+
+        if (sample_count != 0)
+        {
+            region->radiance = region->energy * iris_inv_pi * (float_t)0.25 /
+                               (float_t)sample_count;
+        }
+    }
+
+    free(path_guide->training_sample_counts);
+
+    path_guide->training_tree = tree;
+    path_guide->training_energies = energies[0];
+    path_guide->training_sample_counts = sample_counts[0];
+
+    size_t index = 1;
+    for (PPATH_GUIDE_RECORDER recorder = path_guide->recorders;
+         recorder != NULL;
+         recorder = recorder->next)
+    {
+        free(recorder->energies);
+        free(recorder->sample_counts);
+        recorder->energies = energies[index];
+        recorder->sample_counts = sample_counts[index];
+        index += 1;
+    }
+
+    free(energies);
+    free(sample_counts);
+
+    mtx_unlock(&path_guide->lock);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+PathGuideLookup(
+    _In_ PCPATH_GUIDE path_guide,
+    _In_ POINT3 point,
+    _Out_ PCPATH_GUIDE_REGION *region
+    )
+{
+    if (path_guide == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!PointValidate(point))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (region == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (path_guide->sampling_tree.num_spatial_nodes == 0)
+    {
+        *region = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    uint32_t node = PathGuideTreeFindLeaf(&path_guide->sampling_tree,
+                                          path_guide->minimum,
+                                          path_guide->maximum,
+                                          point);
+
+    uint32_t leaf_index =
+        path_guide->sampling_tree.spatial_nodes[node].leaf_index;
+    PCPATH_GUIDE_REGION result = path_guide->sampling_regions + leaf_index;
+
+    if (result->energy <= (float_t)0.0)
+    {
+        *region = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    *region = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+PathGuideRegionSample(
+    _In_ PCPATH_GUIDE_REGION region,
+    _Inout_ PRANDOM rng,
+    _Out_ PVECTOR3 direction,
+    _Out_ float_t *pdf
+    )
+{
+    if (region == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (rng == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (direction == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (pdf == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    float_t u = (float_t)0.0;
+    float_t v = (float_t)0.0;
+    float_t size = (float_t)1.0;
+    uint32_t node = region->root;
+    for (;;)
+    {
+        const float_t *energies = region->energies + 4 * node;
+        float_t total = energies[0] + energies[1] + energies[2] + energies[3];
+
+        float_t selector;
+        ISTATUS status = RandomGenerateFloat(rng,
+                                             (float_t)0.0,
+                                             total,
+                                             &selector);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        size_t quadrant = 0;
+        while (quadrant < 3 && energies[quadrant] <= selector)
+        {
+            selector -= energies[quadrant];
+            quadrant += 1;
+        }
+
+        while (energies[quadrant] <= (float_t)0.0)
+        {
+            quadrant -= 1;
+        }
+
+        size *= (float_t)0.5;
+
+        if (quadrant & 1)
+        {
+            u += size;
+        }
+
+        if (quadrant & 2)
+        {
+            v += size;
+        }
+
+        uint32_t child = region->directional_nodes[node].children[quadrant];
+
+        if (child == 0)
+        {
+            break;
+        }
+
+        node = child;
+    }
+
+    float_t offsets[2];
+    ISTATUS status = RandomGenerateFloats(rng,
+                                          (float_t)0.0,
+                                          (float_t)1.0,
+                                          2,
+                                          offsets);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    //
+    // The offsets are kept away from the edges of the leaf so that rounding
+    // in the mapping to the sphere does not move the direction into a
+    // neighbouring leaf. The pdf is then computed from the direction itself,
+    // which makes it agree with PathGuideRegionComputePdf even if the
+    // direction did move.
+    //
+
+    offsets[0] = IMax(PATH_GUIDE_MINIMUM_OFFSET,
+                      IMin(offsets[0], PATH_GUIDE_MAXIMUM_OFFSET));
+    offsets[1] = IMax(PATH_GUIDE_MINIMUM_OFFSET,
+                      IMin(offsets[1], PATH_GUIDE_MAXIMUM_OFFSET));
+
+    u += offsets[0] * size;
+    v += offsets[1] * size;
+
+    float_t cos_theta = IMin((float_t)1.0, u + u - (float_t)1.0);
+    float_t sin_theta =
+        sqrt(IMax((float_t)0.0, (float_t)1.0 - cos_theta * cos_theta));
+
+    float_t sin_phi, cos_phi;
+    ShadingSinCos(v * iris_two_pi, &sin_phi, &cos_phi);
+
+    *direction = VectorCreate(sin_theta * cos_phi,
+                              sin_theta * sin_phi,
+                              cos_theta);
+    *direction = VectorNormalize(*direction, NULL, NULL);
+    *pdf = PathGuideRegionComputePdf(region, *direction);
+
+    return ISTATUS_SUCCESS;
+}
+
+float_t
+PathGuideRegionComputePdf(
+    _In_ PCPATH_GUIDE_REGION region,
+    _In_ VECTOR3 direction
+    )
+{
+    assert(region != NULL);
+    assert(VectorValidate(direction));
+
+    float_t u, v;
+    PathGuideDirectionToSquare(direction, &u, &v);
+
+    float_t probability = (float_t)1.0;
+    uint32_t node = region->root;
+    for (;;)
+    {
+        const float_t *energies = region->energies + 4 * node;
+        float_t total = energies[0] + energies[1] + energies[2] + energies[3];
+
+        size_t quadrant = PathGuideSelectQuadrant(&u, &v);
+
+        if (energies[quadrant] <= (float_t)0.0)
+        {
+            return (float_t)0.0;
+        }
+
+        probability *= (float_t)4.0 * energies[quadrant] / total;
+
+        uint32_t child = region->directional_nodes[node].children[quadrant];
+
+        if (child == 0)
+        {
+            break;
+        }
+
+        node = child;
+    }
+
+    return probability * iris_inv_pi * (float_t)0.25;
+}
+
+float_t
+PathGuideRegionAverageRadiance(
+    _In_ PCPATH_GUIDE_REGION region
+    )
+{
+    assert(region != NULL);
+
+    return region->radiance;
+}
+
+void
+PathGuideRetain(
+    _In_opt_ PPATH_GUIDE path_guide
+    )
+{
+    if (path_guide == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add(&path_guide->reference_count, 1);
+}
+
+void
+PathGuideRelease(
+    _In_opt_ _Post_invalid_ PPATH_GUIDE path_guide
+    )
+{
+    if (path_guide == NULL)
+    {
+        return;
+    }
+
+    if (atomic_fetch_sub(&path_guide->reference_count, 1) == 1)
+    {
+        assert(path_guide->recorders == NULL);
+
+        PathGuideTreeDestroy(&path_guide->sampling_tree);
+        free(path_guide->sampling_energies);
+        free(path_guide->sampling_regions);
+        PathGuideTreeDestroy(&path_guide->training_tree);
+        free(path_guide->training_energies);
+        free(path_guide->training_sample_counts);
+        mtx_destroy(&path_guide->lock);
+        free(path_guide);
+    }
+}
+
+ISTATUS
+PathGuideRecorderAllocate(
+    _In_ PPATH_GUIDE path_guide,
+    _Out_ PPATH_GUIDE_RECORDER *recorder
+    )
+{
+    if (path_guide == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (recorder == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    PPATH_GUIDE_RECORDER result =
+        (PPATH_GUIDE_RECORDER)malloc(sizeof(PATH_GUIDE_RECORDER));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    mtx_lock(&path_guide->lock);
+
+    bool success = PathGuideAllocateTrainingData(&path_guide->training_tree,
+                                                 &result->energies,
+                                                 &result->sample_counts);
+
+    if (!success)
+    {
+        mtx_unlock(&path_guide->lock);
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PathGuideResetObservedBounds(result->observed_minimum,
+                                 result->observed_maximum);
+
+    result->path_guide = path_guide;
+    result->previous = NULL;
+    result->next = path_guide->recorders;
+
+    if (path_guide->recorders != NULL)
+    {
+        path_guide->recorders->previous = result;
+    }
+
+    path_guide->recorders = result;
+
+    mtx_unlock(&path_guide->lock);
+
+    PathGuideRetain(path_guide);
+
+    *recorder = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+void
+PathGuideRecorderRecord(
+    _Inout_ PPATH_GUIDE_RECORDER recorder,
+    _In_ POINT3 point,
+    _In_ VECTOR3 direction,
+    _In_ float_t radiance
+    )
+{
+    assert(recorder != NULL);
+    assert(PointValidate(point));
+    assert(VectorValidate(direction));
+
+    PCPATH_GUIDE path_guide = recorder->path_guide;
+
+    float_t coordinates[3] = { point.x, point.y, point.z };
+    for (size_t i = 0; i < 3; i++)
+    {
+        recorder->observed_minimum[i] =
+            IMin(recorder->observed_minimum[i], coordinates[i]);
+        recorder->observed_maximum[i] =
+            IMax(recorder->observed_maximum[i], coordinates[i]);
+    }
+
+    uint32_t node_index = PathGuideTreeFindLeaf(&path_guide->training_tree,
+                                                path_guide->minimum,
+                                                path_guide->maximum,
+                                                point);
+
+    PCPATH_GUIDE_SPATIAL_NODE node =
+        path_guide->training_tree.spatial_nodes + node_index;
+
+    recorder->sample_counts[node->leaf_index] += 1;
+
+    if (!isfinite(radiance) || radiance <= (float_t)0.0)
+    {
+        return;
+    }
+
+    float_t u, v;
+    PathGuideDirectionToSquare(direction, &u, &v);
+
+    PCPATH_GUIDE_DIRECTIONAL_NODE directional_nodes =
+        path_guide->training_tree.directional_nodes;
+
+    uint32_t directional_node = node->directional_root;
+    for (;;)
+    {
+        size_t quadrant = PathGuideSelectQuadrant(&u, &v);
+        recorder->energies[4 * directional_node + quadrant] += radiance;
+
+        uint32_t child = directional_nodes[directional_node].children[quadrant];
+
+        if (child == 0)
+        {
+            break;
+        }
+
+        directional_node = child;
+    }
+}
+
+void
+PathGuideRecorderFree(
+    _In_opt_ _Post_invalid_ PPATH_GUIDE_RECORDER recorder
+    )
+{
+    if (recorder == NULL)
+    {
+        return;
+    }
+
+    PPATH_GUIDE path_guide = recorder->path_guide;
+
+    mtx_lock(&path_guide->lock);
+
+    PathGuideMergeRecorder(path_guide, recorder);
+
+    if (recorder->previous != NULL)
+    {
+        recorder->previous->next = recorder->next;
+    }
+    else
+    {
+        path_guide->recorders = recorder->next;
+    }
+
+    if (recorder->next != NULL)
+    {
+        recorder->next->previous = recorder->previous;
+    }
+
+    mtx_unlock(&path_guide->lock);
+
+    free(recorder->energies);
+    free(recorder->sample_counts);
+    free(recorder);
+
+    PathGuideRelease(path_guide);
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    path_guide.h
+
+Abstract:
+
+    A path guide learns the distribution of incident radiance over the scene
+    from the paths traced while rendering and can be sampled in place of or
+    alongside the BSDF.
+
+    The distribution is stored in a spatial-directional tree. A binary tree
+    over world space, split at its midpoints along x, y, and z in turn, holds
+    a quadtree over the sphere of directions at each of its leaves. The
+    quadtrees are parameterized by the cosine of the polar angle and by the
+    azimuth, which makes the mapping from the unit square to the sphere area
+    preserving.
+
+    Training proceeds in passes. During a pass, each integrator records into
+    its own recorder without any synchronization. Recorders are merged into
+    the guide when they are freed and by PathGuideUpdate. PathGuideUpdate
+    replaces the distribution being sampled with the one learned during the
+    pass, refines the tree used for training in the next pass, and must not
+    be called while a render using the guide is in progress. Spatial regions
+    with more than samples_per_region recorded samples are split, and
+    quadrants holding more than one percent of the energy of a region are
+    subdivided.
+
+    The pdf returned by PathGuideRegionSample is the one that
+    PathGuideRegionComputePdf returns for the sampled direction.
+
+    Until the first call to PathGuideUpdate, and in regions where no radiance
+    was recorded, PathGuideLookup returns no region.
+
+    PathGuideRegionAverageRadiance returns the incident radiance of a region
+    averaged over all directions and over the samples recorded in it, which
+    serves as a cached estimate of the light arriving in the region.
+
+--*/
+
+#ifndef _IRIS_PHYSX_TOOLKIT_PATH_GUIDE_
+#define _IRIS_PHYSX_TOOLKIT_PATH_GUIDE_
+
+#include "iris_physx/iris_physx.h"
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//
+// Types
+//
+
+typedef struct _PATH_GUIDE PATH_GUIDE, *PPATH_GUIDE;
+typedef const PATH_GUIDE *PCPATH_GUIDE;
+
+typedef struct _PATH_GUIDE_REGION PATH_GUIDE_REGION, *PPATH_GUIDE_REGION;
+typedef const PATH_GUIDE_REGION *PCPATH_GUIDE_REGION;
+
+typedef struct _PATH_GUIDE_RECORDER PATH_GUIDE_RECORDER;
+typedef PATH_GUIDE_RECORDER *PPATH_GUIDE_RECORDER;
+typedef const PATH_GUIDE_RECORDER *PCPATH_GUIDE_RECORDER;
+
+//
+// Functions
+//
+
+ISTATUS
+PathGuideAllocate(
+    _In_ size_t samples_per_region,
+    _Out_ PPATH_GUIDE *path_guide
+    );
+
+ISTATUS
+PathGuideUpdate(
+    _Inout_ PPATH_GUIDE path_guide
+    );
+
+ISTATUS
+PathGuideLookup(
+    _In_ PCPATH_GUIDE path_guide,
+    _In_ POINT3 point,
+    _Out_ PCPATH_GUIDE_REGION *region
+    );
+
+ISTATUS
+PathGuideRegionSample(
+    _In_ PCPATH_GUIDE_REGION region,
+    _Inout_ PRANDOM rng,
+    _Out_ PVECTOR3 direction,
+    _Out_ float_t *pdf
+    );
+
+float_t
+PathGuideRegionComputePdf(
+    _In_ PCPATH_GUIDE_REGION region,
+    _In_ VECTOR3 direction
+    );
+
+float_t
+PathGuideRegionAverageRadiance(
+    _In_ PCPATH_GUIDE_REGION region
+    );
+
+void
+PathGuideRetain(
+    _In_opt_ PPATH_GUIDE path_guide
+    );
+
+void
+PathGuideRelease(
+    _In_opt_ _Post_invalid_ PPATH_GUIDE path_guide
+    );
+
+ISTATUS
+PathGuideRecorderAllocate(
+    _In_ PPATH_GUIDE path_guide,
+    _Out_ PPATH_GUIDE_RECORDER *recorder
+    );
+
+void
+PathGuideRecorderRecord(
+    _Inout_ PPATH_GUIDE_RECORDER recorder,
+    _In_ POINT3 point,
+    _In_ VECTOR3 direction,
+    _In_ float_t radiance
+    );
+
+void
+PathGuideRecorderFree(
+    _In_opt_ _Post_invalid_ PPATH_GUIDE_RECORDER recorder
+    );
+
+#if __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _IRIS_PHYSX_TOOLKIT_PATH_GUIDE_
\ No newline at end of file
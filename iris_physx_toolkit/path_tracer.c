@@ -10,27 +10,75 @@ Abstract:
 
     Implements a path_tracer.
 
+    The incident radiance recorded into a path guide is the average of the
+    radiance arriving at the vertex over the guide wavelengths, divided by the
+    probability density of the sampled direction. It includes the light
+    emitted by the next vertex even where that light is not added to the
+    path because direct lighting already accounts for it.
+
+    At vertices where the guide is used, the choice between the guide and
+    the BSDF is drawn before the BSDF sample dimensions are selected, so it
+    reads the remaining light position dimensions or the random number
+    generator and leaves every BSDF dimension to the BSDF.
+
+    When splitting is enabled, the first vertex of a path at which the guide
+    holds a cached radiance estimate fixes the expected contribution of the
+    path, which stands in for the estimate of its pixel since the integrator
+    is not told which pixel it is computing. At each later vertex with a
+    cached estimate, the ratio of the expected contribution of the vertex to
+    that of the path is kept within a weight window. Below the window the
+    path survives with a probability equal to the ratio, and above it the
+    path is split into as many branches as the ratio, up to the maximum
+    split factor. Each branch is traced recursively. The sample dimensions
+    reserve a single set of values per bounce, so only the first branch
+    reads them. The remaining branches switch the random number generator
+    to its fallback before they draw, since reading the dimensions again
+    would correlate them with the first branch and reading the values the
+    first branch left over would not be stratified. The window is
+    [2 / (1 + s), s * 2 / (1 + s)] with s = 5, following Vorba and Krivanek,
+    "Adjoint-Driven Russian Roulette and Splitting in Light Transport
+    Simulation", 2016.
+
 --*/
 
 #include <stdalign.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "common/safe_math.h"
+#include "iris_camera/iris_camera.h"
 #include "iris_physx_toolkit/path_tracer.h"
 #include "iris_physx_toolkit/sample_direct_lighting.h"
 
+//
+// Defines
+//
+
+#define PATH_TRACER_WEIGHT_WINDOW_MINIMUM ((float_t)(1.0 / 3.0))
+#define PATH_TRACER_WEIGHT_WINDOW_MAXIMUM ((float_t)(5.0 / 3.0))
+
 //
 // Types
 //
 
 typedef struct _PATH_TRACER {
     _Field_size_(max_bounces) PCSPECTRUM *spectra;
+    _Field_size_(max_bounces) PCSPECTRUM *emissions;
     _Field_size_(max_bounces) PCREFLECTOR *reflectors;
     _Field_size_(max_bounces) float_t *attenuations;
+    _Field_size_(max_bounces) POINT3 *guide_points;
+    _Field_size_(max_bounces) VECTOR3 *guide_directions;
+    _Field_size_(max_bounces) float_t *guide_pdfs;
+    _Field_size_(num_guide_wavelengths) float_t *guide_wavelengths;
+    size_t num_guide_wavelengths;
+    PPATH_GUIDE path_guide;
+    PPATH_GUIDE_RECORDER path_guide_recorder;
+    float_t bsdf_sampling_fraction;
     float_t min_termination_probability;
     float_t roulette_threshold;
     uint8_t min_bounces;
     uint8_t max_bounces;
+    uint8_t max_split_factor;
 } PATH_TRACER, *PPATH_TRACER;
 
 typedef const PATH_TRACER *PCPATH_TRACER;
@@ -41,9 +89,303 @@ typedef const PATH_TRACER *PCPATH_TRACER;
 
 static
 ISTATUS
-PathTracerIntegrate(
-    _In_opt_ const void *context,
-    _In_ PCRAY_DIFFERENTIAL ray_differential,
+PathTracerEstimateRadiance(
+    _In_ PCPATH_TRACER path_tracer,
+    _In_opt_ PCSPECTRUM spectrum,
+    _Out_ float_t *radiance
+    )
+{
+    float_t sum = (float_t)0.0;
+    for (size_t i = 0; i < path_tracer->num_guide_wavelengths; i++)
+    {
+        float_t intensity;
+        ISTATUS status = SpectrumSample(spectrum,
+                                        path_tracer->guide_wavelengths[i],
+                                        &intensity);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        sum += intensity;
+    }
+
+    *radiance = sum / (float_t)path_tracer->num_guide_wavelengths;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+PathTracerSampleGuided(
+    _In_ PCPATH_TRACER path_tracer,
+    _In_ PCBSDF bsdf,
+    _In_ PCPATH_GUIDE_REGION region,
+    _In_ float_t guide_selector,
+    _In_ VECTOR3 incoming,
+    _In_ VECTOR3 surface_normal,
+    _In_ VECTOR3 shading_normal,
+    _Inout_ PRANDOM rng,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Out_ PCREFLECTOR *reflector,
+    _Out_ PBSDF_SAMPLE_TYPE type,
+    _Out_ PVECTOR3 outgoing,
+    _Out_ float_t *pdf
+    )
+{
+    float_t bsdf_sampling_fraction = path_tracer->bsdf_sampling_fraction;
+
+    ISTATUS status;
+    float_t bsdf_pdf, guide_pdf;
+    if (guide_selector < bsdf_sampling_fraction)
+    {
+        status = BsdfSample(bsdf,
+                            incoming,
+                            surface_normal,
+                            shading_normal,
+                            rng,
+                            allocator,
+                            reflector,
+                            type,
+                            outgoing,
+                            &bsdf_pdf);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        if (bsdf_pdf <= (float_t)0.0 || isinf(bsdf_pdf))
+        {
+            *pdf = bsdf_pdf;
+            return ISTATUS_SUCCESS;
+        }
+
+        guide_pdf = PathGuideRegionComputePdf(region, *outgoing);
+    }
+    else
+    {
+        status = PathGuideRegionSample(region, rng, outgoing, &guide_pdf);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        bool transmitted =
+            VectorDotProduct(surface_normal, *outgoing) < (float_t)0.0;
+
+        status = BsdfComputeDiffuseWithPdf(bsdf,
+                                           incoming,
+                                           shading_normal,
+                                           *outgoing,
+                                           transmitted,
+                                           allocator,
+                                           reflector,
+                                           &bsdf_pdf);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        if (bsdf_pdf <= (float_t)0.0)
+        {
+            *reflector = NULL;
+        }
+
+        *type = transmitted ? BSDF_SAMPLE_TYPE_TRANSMISSION_DIFFUSE_ONLY :
+                              BSDF_SAMPLE_TYPE_REFLECTION_DIFFUSE_ONLY;
+    }
+
+    *pdf = bsdf_sampling_fraction * bsdf_pdf +
+           ((float_t)1.0 - bsdf_sampling_fraction) * guide_pdf;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+PathTracerRecordRadiance(
+    _In_ PCPATH_TRACER path_tracer,
+    _In_ POINT3 point,
+    _In_ VECTOR3 direction,
+    _In_ float_t pdf,
+    _In_opt_ PCSPECTRUM spectrum,
+    _In_opt_ PCSPECTRUM emission
+    )
+{
+    float_t radiance;
+    ISTATUS status = PathTracerEstimateRadiance(path_tracer,
+                                                spectrum,
+                                                &radiance);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    float_t emitted_radiance;
+    status = PathTracerEstimateRadiance(path_tracer,
+                                        emission,
+                                        &emitted_radiance);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    radiance = (radiance + emitted_radiance) / pdf;
+
+    PathGuideRecorderRecord(path_tracer->path_guide_recorder,
+                            point,
+                            direction,
+                            radiance);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+PathTracerSelectContinuationDimensions(
+    _In_opt_ PCPATH_GUIDE_REGION guide_region,
+    _In_ uint8_t bounces,
+    _In_ bool select_sample_dimensions,
+    _Inout_ PRANDOM rng,
+    _Out_ float_t *guide_selector
+    )
+{
+    if (guide_region == NULL)
+    {
+        *guide_selector = (float_t)0.0;
+    }
+    else
+    {
+        ISTATUS status = RandomGenerateFloat(rng,
+                                             (float_t)0.0,
+                                             (float_t)1.0,
+                                             guide_selector);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    if (!select_sample_dimensions)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = SampleDimensionsSelect(rng,
+                                            bounces,
+                                            SAMPLE_DIMENSION_SLOT_BSDF);
+
+    return status;
+}
+
+static
+ISTATUS
+PathTracerSampleContinuation(
+    _In_ PCPATH_TRACER path_tracer,
+    _In_ PCBSDF bsdf,
+    _In_opt_ PCPATH_GUIDE_REGION guide_region,
+    _In_ float_t guide_selector,
+    _In_ VECTOR3 incoming,
+    _In_ VECTOR3 surface_normal,
+    _In_ VECTOR3 shading_normal,
+    _Inout_ PRANDOM rng,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Out_ PCREFLECTOR *reflector,
+    _Out_ PBSDF_SAMPLE_TYPE type,
+    _Out_ PVECTOR3 outgoing,
+    _Out_ float_t *pdf,
+    _Out_ float_t *albedo,
+    _Out_ float_t *attenuation
+    )
+{
+    ISTATUS status;
+    float_t specular_attenuation;
+    if (guide_region == NULL)
+    {
+        status = BsdfSample(bsdf,
+                            incoming,
+                            surface_normal,
+                            shading_normal,
+                            rng,
+                            allocator,
+                            reflector,
+                            type,
+                            outgoing,
+                            pdf);
+
+        specular_attenuation = (float_t)1.0;
+    }
+    else
+    {
+        status = PathTracerSampleGuided(path_tracer,
+                                        bsdf,
+                                        guide_region,
+                                        guide_selector,
+                                        incoming,
+                                        surface_normal,
+                                        shading_normal,
+                                        rng,
+                                        allocator,
+                                        reflector,
+                                        type,
+                                        outgoing,
+                                        pdf);
+
+        specular_attenuation =
+            (float_t)1.0 / path_tracer->bsdf_sampling_fraction;
+    }
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (*pdf <= (float_t)0.0 || *reflector == NULL)
+    {
+        *reflector = NULL;
+        return ISTATUS_SUCCESS;
+    }
+
+    status = ReflectorGetAlbedo(*reflector, albedo);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (isfinite(*pdf))
+    {
+        bool transmitted = BsdfSampleIsTransmission(*type);
+        *attenuation = VectorPositiveDotProduct(shading_normal,
+                                                *outgoing,
+                                                transmitted);
+        *attenuation /= *pdf;
+    }
+    else
+    {
+        *attenuation = specular_attenuation;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+PathTracerTracePath(
+    _In_ PCPATH_TRACER path_tracer,
+    _In_ RAY_DIFFERENTIAL trace_ray_differential,
+    _In_ uint8_t bounces,
+    _In_ float_t path_throughput,
+    _In_ bool add_light_emissions,
+    _In_ float_t path_estimate,
+    _In_ bool select_sample_dimensions,
     _In_ PCLIGHT_SAMPLER light_sampler,
     _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
     _Inout_ PSHAPE_RAY_TRACER ray_tracer,
@@ -54,12 +396,7 @@ PathTracerIntegrate(
     _Out_ PCSPECTRUM *spectrum
     )
 {
-    PCPATH_TRACER path_tracer = (PCPATH_TRACER)context;
-
-    float_t path_throughput = (float_t)1.0;
-    bool add_light_emissions = true;
-    RAY_DIFFERENTIAL trace_ray_differential = *ray_differential;
-    uint8_t bounces = 0;
+    uint8_t first_bounce = bounces;
 
     for (;;)
     {
@@ -84,10 +421,20 @@ PathTracerIntegrate(
         {
             path_tracer->spectra[bounces] = emitted_light;
             add_light_emissions = false;
+
+            if (path_tracer->path_guide != NULL)
+            {
+                path_tracer->emissions[bounces] = NULL;
+            }
         }
         else
         {
             path_tracer->spectra[bounces] = NULL;
+
+            if (path_tracer->path_guide != NULL)
+            {
+                path_tracer->emissions[bounces] = emitted_light;
+            }
         }
 
         if (bsdf == NULL)
@@ -95,6 +442,19 @@ PathTracerIntegrate(
             break;
         }
 
+        if (select_sample_dimensions)
+        {
+            status = SampleDimensionsSelect(
+                rng,
+                bounces,
+                SAMPLE_DIMENSION_SLOT_LIGHT_SELECTION);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+
         status = LightSamplerSample(light_sampler,
                                     hit_point,
                                     rng,
@@ -127,6 +487,19 @@ PathTracerIntegrate(
                 continue;
             }
 
+            if (select_sample_dimensions)
+            {
+                status = SampleDimensionsSelect(
+                    rng,
+                    bounces,
+                    SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+
             PCSPECTRUM direct_lighting;
             status = SampleDirectLighting(light,
                                           bsdf,
@@ -171,60 +544,278 @@ PathTracerIntegrate(
             break;
         }
 
-        BSDF_SAMPLE_TYPE type;
-        VECTOR3 next_direction;
-        float_t bsdf_pdf;
-        status = BsdfSample(bsdf,
-                            trace_ray_differential.ray.direction,
-                            surface_normal,
-                            shading_normal,
-                            rng,
-                            allocator,
-                            path_tracer->reflectors + bounces,
-                            &type,
-                            &next_direction,
-                            &bsdf_pdf);
+        PCPATH_GUIDE_REGION region = NULL;
+        PCPATH_GUIDE_REGION guide_region = NULL;
+        if (path_tracer->path_guide != NULL)
+        {
+            status = PathGuideLookup(path_tracer->path_guide,
+                                     hit_point,
+                                     &region);
 
-        if (status != ISTATUS_SUCCESS)
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            if (region != NULL)
+            {
+                bool is_diffuse;
+                status = BsdfIsDiffuse(bsdf, &is_diffuse);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                if (is_diffuse)
+                {
+                    guide_region = region;
+                }
+            }
+        }
+
+        bool efficiency_aware = false;
+        float_t continuation_weight = (float_t)1.0;
+        size_t num_branches = 1;
+        if (path_tracer->max_split_factor != 0 && region != NULL)
         {
-            return status;
+            float_t estimate =
+                path_throughput * PathGuideRegionAverageRadiance(region);
+
+            if (path_estimate <= (float_t)0.0)
+            {
+                path_estimate = estimate;
+            }
+            else
+            {
+                efficiency_aware = true;
+
+                float_t ratio = estimate / path_estimate;
+                if (ratio < PATH_TRACER_WEIGHT_WINDOW_MINIMUM)
+                {
+                    float_t random_value;
+                    status = RandomGenerateFloat(rng,
+                                                 (float_t)0.0,
+                                                 (float_t)1.0,
+                                                 &random_value);
+
+                    if (status != ISTATUS_SUCCESS)
+                    {
+                        return status;
+                    }
+
+                    if (ratio <= random_value)
+                    {
+                        break;
+                    }
+
+                    continuation_weight = (float_t)1.0 / ratio;
+                }
+                else if (PATH_TRACER_WEIGHT_WINDOW_MAXIMUM < ratio)
+                {
+                    float_t branches =
+                        IMin(ceil(ratio),
+                             (float_t)path_tracer->max_split_factor);
+
+                    num_branches = (size_t)branches;
+                    continuation_weight = (float_t)1.0 / branches;
+                }
+            }
         }
 
-        if (bsdf_pdf <= (float_t)0.0 ||
-            path_tracer->reflectors[bounces] == NULL)
+        if (num_branches != 1)
         {
+            for (size_t branch = 0; branch < num_branches; branch++)
+            {
+                bool select_branch_dimensions =
+                    select_sample_dimensions && branch == 0;
+
+                //
+                // Selecting past the last bounce leaves this branch and its
+                // descendants on the unstratified fallback generator.
+                //
+
+                if (select_sample_dimensions && branch != 0)
+                {
+                    status = SampleDimensionsSelect(
+                        rng,
+                        SAMPLE_DIMENSIONS_MAX_BOUNCES,
+                        SAMPLE_DIMENSION_SLOT_BSDF);
+
+                    if (status != ISTATUS_SUCCESS)
+                    {
+                        return status;
+                    }
+                }
+
+                float_t guide_selector;
+                status = PathTracerSelectContinuationDimensions(
+                    guide_region,
+                    bounces,
+                    select_branch_dimensions,
+                    rng,
+                    &guide_selector);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                PCREFLECTOR reflector;
+                BSDF_SAMPLE_TYPE type;
+                VECTOR3 next_direction;
+                float_t pdf, albedo, attenuation;
+                status =
+                    PathTracerSampleContinuation(
+                        path_tracer,
+                        bsdf,
+                        guide_region,
+                        guide_selector,
+                        trace_ray_differential.ray.direction,
+                        surface_normal,
+                        shading_normal,
+                        rng,
+                        allocator,
+                        &reflector,
+                        &type,
+                        &next_direction,
+                        &pdf,
+                        &albedo,
+                        &attenuation);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                if (reflector == NULL)
+                {
+                    continue;
+                }
+
+                attenuation *= continuation_weight;
+
+                RAY next_ray = RayCreate(hit_point, next_direction);
+
+                PCSPECTRUM branch_spectrum;
+                status = PathTracerTracePath(
+                    path_tracer,
+                    RayDifferentialCreateWithoutDifferentials(next_ray),
+                    bounces + 1,
+                    path_throughput * albedo * attenuation,
+                    BsdfSampleContainsSpecular(type),
+                    path_estimate,
+                    select_branch_dimensions,
+                    light_sampler,
+                    light_sample_list,
+                    ray_tracer,
+                    visibility_tester,
+                    compositor,
+                    allocator,
+                    rng,
+                    &branch_spectrum);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                if (path_tracer->path_guide != NULL && isfinite(pdf))
+                {
+                    status = PathTracerRecordRadiance(
+                        path_tracer,
+                        hit_point,
+                        next_direction,
+                        pdf,
+                        branch_spectrum,
+                        path_tracer->emissions[bounces + 1]);
+
+                    if (status != ISTATUS_SUCCESS)
+                    {
+                        return status;
+                    }
+                }
+
+                status = SpectrumCompositorAttenuateReflection(
+                    compositor,
+                    branch_spectrum,
+                    reflector,
+                    attenuation,
+                    &branch_spectrum);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+
+                status = SpectrumCompositorAddSpectra(
+                    compositor,
+                    branch_spectrum,
+                    path_tracer->spectra[bounces],
+                    path_tracer->spectra + bounces);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+
             break;
         }
 
-        float_t albedo;
-        status = ReflectorGetAlbedo(path_tracer->reflectors[bounces],
-                                    &albedo);
+        float_t guide_selector;
+        status = PathTracerSelectContinuationDimensions(
+            guide_region,
+            bounces,
+            select_sample_dimensions,
+            rng,
+            &guide_selector);
 
         if (status != ISTATUS_SUCCESS)
         {
             return status;
         }
 
-        path_throughput *= albedo;
+        BSDF_SAMPLE_TYPE type;
+        VECTOR3 next_direction;
+        float_t bsdf_pdf, albedo, attenuation;
+        status = PathTracerSampleContinuation(
+            path_tracer,
+            bsdf,
+            guide_region,
+            guide_selector,
+            trace_ray_differential.ray.direction,
+            surface_normal,
+            shading_normal,
+            rng,
+            allocator,
+            path_tracer->reflectors + bounces,
+            &type,
+            &next_direction,
+            &bsdf_pdf,
+            &albedo,
+            &attenuation);
 
-        float_t attenuation;
-        if (isfinite(bsdf_pdf))
+        if (status != ISTATUS_SUCCESS)
         {
-            bool transmitted = BsdfSampleIsTransmission(type);
-            attenuation = VectorPositiveDotProduct(shading_normal,
-                                                   next_direction,
-                                                   transmitted);
-            attenuation /= bsdf_pdf;
-
-            path_throughput *= attenuation;
+            return status;
         }
-        else
+
+        if (path_tracer->reflectors[bounces] == NULL)
         {
-            attenuation = (float_t)1.0;
+            break;
         }
 
-        if (path_tracer->min_bounces < bounces &&
-            path_throughput < path_tracer->roulette_threshold)
+        path_throughput *= albedo;
+        path_throughput *= attenuation;
+
+        if (efficiency_aware)
+        {
+            attenuation *= continuation_weight;
+            path_throughput *= continuation_weight;
+        }
+        else if (path_tracer->min_bounces < bounces &&
+                 path_throughput < path_tracer->roulette_threshold)
         {
             float_t random_value;
             status = RandomGenerateFloat(rng,
@@ -252,6 +843,14 @@ PathTracerIntegrate(
 
         path_tracer->attenuations[bounces] = attenuation;
 
+        if (path_tracer->path_guide != NULL)
+        {
+            path_tracer->guide_points[bounces] = hit_point;
+            path_tracer->guide_directions[bounces] = next_direction;
+            path_tracer->guide_pdfs[bounces] =
+                isfinite(bsdf_pdf) ? bsdf_pdf : (float_t)0.0;
+        }
+
         if (BsdfSampleContainsSpecular(type))
         {
             add_light_emissions = true;
@@ -264,8 +863,25 @@ PathTracerIntegrate(
         bounces += 1;
     }
 
-    for (; bounces != 0; bounces--)
+    for (; bounces != first_bounce; bounces--)
     {
+        if (path_tracer->path_guide != NULL &&
+            path_tracer->guide_pdfs[bounces - 1] > (float_t)0.0)
+        {
+            ISTATUS status =
+                PathTracerRecordRadiance(path_tracer,
+                                         path_tracer->guide_points[bounces - 1],
+                                         path_tracer->guide_directions[bounces - 1],
+                                         path_tracer->guide_pdfs[bounces - 1],
+                                         path_tracer->spectra[bounces],
+                                         path_tracer->emissions[bounces]);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+
         ISTATUS status = SpectrumCompositorAttenuateReflection(
             compositor, 
             path_tracer->spectra[bounces],
@@ -290,11 +906,62 @@ PathTracerIntegrate(
         }
     }
 
-    *spectrum = path_tracer->spectra[0];
+    *spectrum = path_tracer->spectra[first_bounce];
 
     return ISTATUS_SUCCESS;
 }
 
+static
+ISTATUS
+PathTracerIntegrate(
+    _In_opt_ const void *context,
+    _In_ PCRAY_DIFFERENTIAL ray_differential,
+    _In_ PCLIGHT_SAMPLER light_sampler,
+    _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng,
+    _Out_ PCSPECTRUM *spectrum
+    )
+{
+    PCPATH_TRACER path_tracer = (PCPATH_TRACER)context;
+
+    ISTATUS status = PathTracerTracePath(path_tracer,
+                                         *ray_differential,
+                                         0,
+                                         (float_t)1.0,
+                                         true,
+                                         (float_t)0.0,
+                                         true,
+                                         light_sampler,
+                                         light_sample_list,
+                                         ray_tracer,
+                                         visibility_tester,
+                                         compositor,
+                                         allocator,
+                                         rng,
+                                         spectrum);
+
+    return status;
+}
+
+static
+ISTATUS
+PathTracerAllocateInternal(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _In_opt_ PPATH_GUIDE path_guide,
+    _In_ float_t bsdf_sampling_fraction,
+    _In_ uint8_t max_split_factor,
+    _In_reads_(num_guide_wavelengths) const float_t guide_wavelengths[],
+    _In_ size_t num_guide_wavelengths,
+    _Out_ PINTEGRATOR *integrator
+    );
+
 static
 ISTATUS
 PathTracerDuplicate(
@@ -305,11 +972,16 @@ PathTracerDuplicate(
     PCPATH_TRACER path_tracer = (PCPATH_TRACER)context;
 
     ISTATUS status =
-        PathTracerAllocate(path_tracer->min_bounces,
-                           path_tracer->max_bounces,
-                           path_tracer->min_termination_probability,
-                           path_tracer->roulette_threshold,
-                           duplicate);
+        PathTracerAllocateInternal(path_tracer->min_bounces,
+                                   path_tracer->max_bounces,
+                                   path_tracer->min_termination_probability,
+                                   path_tracer->roulette_threshold,
+                                   path_tracer->path_guide,
+                                   path_tracer->bsdf_sampling_fraction,
+                                   path_tracer->max_split_factor,
+                                   path_tracer->guide_wavelengths,
+                                   path_tracer->num_guide_wavelengths,
+                                   duplicate);
 
     return status;
 }
@@ -323,8 +995,15 @@ PathTracerFree(
     PPATH_TRACER path_tracer = (PPATH_TRACER)context;
 
     free(path_tracer->spectra);
+    free(path_tracer->emissions);
     free(path_tracer->reflectors);
     free(path_tracer->attenuations);
+    free(path_tracer->guide_points);
+    free(path_tracer->guide_directions);
+    free(path_tracer->guide_pdfs);
+    free(path_tracer->guide_wavelengths);
+    PathGuideRecorderFree(path_tracer->path_guide_recorder);
+    PathGuideRelease(path_tracer->path_guide);
 }
 
 //
@@ -334,39 +1013,25 @@ PathTracerFree(
 static const INTEGRATOR_VTABLE path_tracer_vtable = {
     PathTracerIntegrate,
     PathTracerDuplicate,
-    PathTracerFree
+    PathTracerFree,
+    NULL
 };
 
-//
-// Functions
-//
-
+static
 ISTATUS
-PathTracerAllocate(
+PathTracerAllocateInternal(
     _In_ uint8_t min_bounces,
     _In_ uint8_t max_bounces,
     _In_ float_t min_termination_probability,
     _In_ float_t roulette_threshold,
+    _In_opt_ PPATH_GUIDE path_guide,
+    _In_ float_t bsdf_sampling_fraction,
+    _In_ uint8_t max_split_factor,
+    _In_reads_(num_guide_wavelengths) const float_t guide_wavelengths[],
+    _In_ size_t num_guide_wavelengths,
     _Out_ PINTEGRATOR *integrator
     )
 {
-    if (!isfinite(min_termination_probability) ||
-        min_termination_probability < (float_t)0.0 ||
-        (float_t)1.0 < min_termination_probability)
-    {
-        return ISTATUS_INVALID_ARGUMENT_02;
-    }
-
-    if (!isgreaterequal(roulette_threshold, (float_t)0.0))
-    {
-        return ISTATUS_INVALID_ARGUMENT_03;
-    }
-
-    if (integrator == NULL)
-    {
-        return ISTATUS_INVALID_ARGUMENT_04;
-    }
-
     size_t num_spectra;
     bool success = CheckedAddSizeT(max_bounces, 1, &num_spectra);
     if (!success)
@@ -402,12 +1067,63 @@ PathTracerAllocate(
 
     PATH_TRACER path_tracer;
     path_tracer.spectra = spectra;
+    path_tracer.emissions = NULL;
     path_tracer.reflectors = reflectors;
     path_tracer.attenuations = attenuations;
+    path_tracer.guide_points = NULL;
+    path_tracer.guide_directions = NULL;
+    path_tracer.guide_pdfs = NULL;
+    path_tracer.guide_wavelengths = NULL;
+    path_tracer.num_guide_wavelengths = num_guide_wavelengths;
+    path_tracer.path_guide = NULL;
+    path_tracer.path_guide_recorder = NULL;
+    path_tracer.bsdf_sampling_fraction = bsdf_sampling_fraction;
     path_tracer.min_termination_probability = min_termination_probability;
     path_tracer.roulette_threshold = roulette_threshold;
     path_tracer.min_bounces = min_bounces;
     path_tracer.max_bounces = max_bounces;
+    path_tracer.max_split_factor = max_split_factor;
+
+    if (path_guide != NULL)
+    {
+        path_tracer.emissions =
+            (PCSPECTRUM*)calloc(num_spectra, sizeof(PCSPECTRUM));
+        path_tracer.guide_points =
+            (POINT3*)calloc(max_bounces, sizeof(POINT3));
+        path_tracer.guide_directions =
+            (VECTOR3*)calloc(max_bounces, sizeof(VECTOR3));
+        path_tracer.guide_pdfs =
+            (float_t*)calloc(max_bounces, sizeof(float_t));
+        path_tracer.guide_wavelengths =
+            (float_t*)calloc(num_guide_wavelengths, sizeof(float_t));
+
+        if (path_tracer.emissions == NULL ||
+            path_tracer.guide_points == NULL ||
+            path_tracer.guide_directions == NULL ||
+            path_tracer.guide_pdfs == NULL ||
+            path_tracer.guide_wavelengths == NULL)
+        {
+            PathTracerFree(&path_tracer);
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+
+        memcpy(path_tracer.guide_wavelengths,
+               guide_wavelengths,
+               num_guide_wavelengths * sizeof(float_t));
+
+        ISTATUS status =
+            PathGuideRecorderAllocate(path_guide,
+                                      &path_tracer.path_guide_recorder);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            PathTracerFree(&path_tracer);
+            return status;
+        }
+
+        PathGuideRetain(path_guide);
+        path_tracer.path_guide = path_guide;
+    }
 
     ISTATUS status = IntegratorAllocate(&path_tracer_vtable,
                                         &path_tracer,
@@ -415,5 +1131,129 @@ PathTracerAllocate(
                                         alignof(PATH_TRACER),
                                         integrator);
 
+    if (status != ISTATUS_SUCCESS)
+    {
+        PathTracerFree(&path_tracer);
+    }
+
+    return status;
+}
+
+//
+// Functions
+//
+
+ISTATUS
+PathTracerAllocate(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _Out_ PINTEGRATOR *integrator
+    )
+{
+    if (!isfinite(min_termination_probability) ||
+        min_termination_probability < (float_t)0.0 ||
+        (float_t)1.0 < min_termination_probability)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (!isgreaterequal(roulette_threshold, (float_t)0.0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (integrator == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    ISTATUS status = PathTracerAllocateInternal(min_bounces,
+                                                max_bounces,
+                                                min_termination_probability,
+                                                roulette_threshold,
+                                                NULL,
+                                                (float_t)1.0,
+                                                0,
+                                                NULL,
+                                                0,
+                                                integrator);
+
+    return status;
+}
+
+ISTATUS
+PathTracerAllocateWithPathGuide(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _In_ PPATH_GUIDE path_guide,
+    _In_ float_t bsdf_sampling_fraction,
+    _In_ uint8_t max_split_factor,
+    _In_reads_(num_wavelengths) const float_t wavelengths[],
+    _In_ size_t num_wavelengths,
+    _Out_ PINTEGRATOR *integrator
+    )
+{
+    if (!isfinite(min_termination_probability) ||
+        min_termination_probability < (float_t)0.0 ||
+        (float_t)1.0 < min_termination_probability)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (!isgreaterequal(roulette_threshold, (float_t)0.0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (path_guide == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (!isfinite(bsdf_sampling_fraction) ||
+        bsdf_sampling_fraction <= (float_t)0.0 ||
+        (float_t)1.0 < bsdf_sampling_fraction)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (wavelengths == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_07;
+    }
+
+    if (num_wavelengths == 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_08;
+    }
+
+    for (size_t i = 0; i < num_wavelengths; i++)
+    {
+        if (!isfinite(wavelengths[i]))
+        {
+            return ISTATUS_INVALID_ARGUMENT_07;
+        }
+    }
+
+    if (integrator == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_09;
+    }
+
+    ISTATUS status = PathTracerAllocateInternal(min_bounces,
+                                                max_bounces,
+                                                min_termination_probability,
+                                                roulette_threshold,
+                                                path_guide,
+                                                bsdf_sampling_fraction,
+                                                max_split_factor,
+                                                wavelengths,
+                                                num_wavelengths,
+                                                integrator);
+
     return status;
 }
\ No newline at end of file
@@ -10,12 +10,39 @@ Abstract:
 
     Creates an path tracer.
 
+    A path tracer may be given a path guide, which it trains with the
+    incident radiance found at each diffuse vertex of its paths, averaged
+    over the wavelengths passed at allocation, and which it samples
+    with probability one minus bsdf_sampling_fraction at diffuse vertices
+    where the guide has learned a distribution. The two sampling techniques
+    are combined with one-sample multiple importance sampling. Each copy of
+    the path tracer made when rendering owns its own recorder, which is
+    merged into the guide when the copy is freed.
+
+    If max_split_factor is not zero, the path tracer replaces its roulette
+    at vertices where the guide has learned a distribution with roulette
+    and splitting driven by the average incident radiance the guide cached
+    in the previous pass, which kills paths unlikely to contribute and
+    splits paths into up to max_split_factor branches where they are
+    expected to contribute more than usual. Elsewhere, and if
+    max_split_factor is zero, the roulette given by
+    min_termination_probability and roulette_threshold is used.
+
+    Splitting trades stratification for extra samples. The sample dimensions
+    provided by the image sampler hold one set of values per bounce, which
+    only the first branch of a split reads. Every other branch, and each
+    bounce that follows it, draws from the fallback random number generator
+    and is therefore not stratified. Splitting still lowers variance where
+    it fires by averaging several branches, but each additional branch
+    converges like plain random sampling rather than like the sampler.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_PATH_TRACER_
 #define _IRIS_PHYSX_TOOLKIT_PATH_TRACER_
 
 #include "iris_physx/iris_physx.h"
+#include "iris_physx_toolkit/path_guide.h"
 
 #if __cplusplus 
 extern "C" {
@@ -34,6 +61,20 @@ PathTracerAllocate(
     _Out_ PINTEGRATOR *integrator
     );
 
+ISTATUS
+PathTracerAllocateWithPathGuide(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _In_ PPATH_GUIDE path_guide,
+    _In_ float_t bsdf_sampling_fraction,
+    _In_ uint8_t max_split_factor,
+    _In_reads_(num_wavelengths) const float_t wavelengths[],
+    _In_ size_t num_wavelengths,
+    _Out_ PINTEGRATOR *integrator
+    );
+
 #if __cplusplus 
 }
 #endif // __cplusplus
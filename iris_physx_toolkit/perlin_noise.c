@@ -0,0 +1,948 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    perlin_noise.c
+
+Abstract:
+
+    Perlin noise and fractional brownian motion built from it.
+
+--*/
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "common/safe_math.h"
+#include "iris_physx_toolkit/perlin_noise.h"
+
+//
+// Defines
+//
+
+#define PERLIN_NOISE_BLOCK_SIZE 16
+
+//
+// Perlin Noise Data
+//
+
+const static uint8_t noise_permutations[512] = {
+    151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225, 140,
+    36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148, 247, 120,
+    234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32, 57, 177, 33,
+    88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175, 74, 165, 71,
+    134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122, 60, 211, 133,
+    230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54, 65, 25, 63, 161,
+    1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169, 200, 196, 135, 130,
+    116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64, 52, 217, 226, 250,
+    124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212, 207, 206, 59, 227,
+    47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213, 119, 248, 152, 2, 44,
+    154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9, 129, 22, 39, 253, 19, 98,
+    108, 110, 79, 113, 224, 232, 178, 185, 112, 104, 218, 246, 97, 228, 251, 34,
+    242, 193, 238, 210, 144, 12, 191, 179, 162, 241, 81, 51, 145, 235, 249, 14,
+    239, 107, 49, 192, 214, 31, 181, 199, 106, 157, 184, 84, 204, 176, 115, 121,
+    50, 45, 127, 4, 150, 254, 138, 236, 205, 93, 222, 114, 67, 29, 24, 72, 243,
+    141, 128, 195, 78, 66, 215, 61, 156, 180, 151, 160, 137, 91, 90, 15, 131,
+    13, 201, 95, 96, 53, 194, 233, 7, 225, 140, 36, 103, 30, 69, 142, 8, 99, 37,
+    240, 21, 10, 23, 190, 6, 148, 247, 120, 234, 75, 0, 26, 197, 62, 94, 252,
+    219, 203, 117, 35, 11, 32, 57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125,
+    136, 171, 168, 68, 175, 74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158,
+    231, 83, 111, 229, 122, 60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245,
+    40, 244, 102, 143, 54, 65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187,
+    208, 89, 18, 169, 200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198,
+    173, 186, 3, 64, 52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126,
+    255, 82, 85, 212, 207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223,
+    183, 170, 213, 119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167,
+    43, 172, 9, 129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185,
+    112, 104, 218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179,
+    162, 241, 81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199,
+    106, 157, 184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236,
+    205, 93, 222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156,
+    180
+};
+
+//
+// The gradient directions selected by the low four bits of a lattice hash.
+//
+
+const static float_t noise_gradients_x[16] = {
+    1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0,
+    0.0, 0.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0
+};
+
+const static float_t noise_gradients_y[16] = {
+    1.0, 1.0, -1.0, -1.0, 0.0, 0.0, 0.0, 0.0,
+    1.0, -1.0, 1.0, -1.0, 1.0, 1.0, 1.0, -1.0
+};
+
+const static float_t noise_gradients_z[16] = {
+    0.0, 0.0, 0.0, 0.0, 1.0, 1.0, -1.0, -1.0,
+    1.0, 1.0, -1.0, -1.0, 0.0, 0.0, -1.0, -1.0
+};
+
+//
+// Types
+//
+
+typedef struct _PERLIN_NOISE_ACCUMULATOR {
+    POINT3 points[PERLIN_NOISE_BLOCK_SIZE];
+    float_t weights[PERLIN_NOISE_BLOCK_SIZE];
+    float_t *sums[PERLIN_NOISE_BLOCK_SIZE];
+    size_t count;
+} PERLIN_NOISE_ACCUMULATOR, *PPERLIN_NOISE_ACCUMULATOR;
+
+struct _NOISE_VOLUME {
+    float_t *samples;
+    size_t size;
+    float_t resolution;
+    atomic_uintmax_t reference_count;
+};
+
+//
+// Perlin Noise Static Functions
+//
+
+static
+inline
+float_t
+Lerp(
+    _In_ float_t t,
+    _In_ float_t v0,
+    _In_ float_t v1
+    )
+{
+    return v0 + t * (v1 - v0);
+}
+
+static
+inline
+float_t
+SmoothStep(
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ float_t value
+    )
+{
+    float_t v = (value - minimum) / (maximum - minimum);
+
+    v = IMax(v, (float_t)0.0);
+    v = IMin(v, (float_t)1.0);
+
+    return v * v * ((float_t)-2.0 * v + (float_t)3.0);
+}
+
+static
+inline
+float_t
+NoiseWeight(
+    _In_ float_t t
+    )
+{
+    float_t t3 = t * t * t;
+    float_t t4 = t3 * t;
+    return (float_t)6.0 * t4 * t - (float_t)15.0 * t4 + (float_t)10 * t3;
+}
+
+static
+inline
+float_t
+NoiseWeightDerivative(
+    _In_ float_t t
+    )
+{
+    float_t t2 = t * t;
+    float_t t3 = t2 * t;
+    float_t t4 = t3 * t;
+    return (float_t)30.0 * t4 - (float_t)60.0 * t3 + (float_t)30.0 * t2;
+}
+
+static
+inline
+VECTOR3
+LerpVector(
+    _In_ float_t t,
+    _In_ VECTOR3 v0,
+    _In_ VECTOR3 v1
+    )
+{
+    return VectorAddScaled(v0, VectorSubtract(v1, v0), t);
+}
+
+static
+inline
+POINT3
+ScalePoint(
+    _In_ POINT3 point,
+    _In_ float_t scalar
+    )
+{
+    point.x *= scalar;
+    point.y *= scalar;
+    point.z *= scalar;
+
+    return point;
+}
+
+//
+// Corner i of a lattice cell is offset by bit 0 of i along x, by bit 1 along
+// y, and by bit 2 along z.
+//
+
+static
+inline
+void
+NoiseHashes(
+    _In_ uint8_t x0,
+    _In_ uint8_t x1,
+    _In_ uint8_t y0,
+    _In_ uint8_t y1,
+    _In_ uint8_t z0,
+    _In_ uint8_t z1,
+    _Out_writes_(8) uint8_t hashes[8]
+    )
+{
+    uint8_t hx0 = noise_permutations[x0];
+    uint8_t hx1 = noise_permutations[x1];
+
+    uint8_t hx0y0 = noise_permutations[hx0 + y0];
+    uint8_t hx1y0 = noise_permutations[hx1 + y0];
+    uint8_t hx0y1 = noise_permutations[hx0 + y1];
+    uint8_t hx1y1 = noise_permutations[hx1 + y1];
+
+    hashes[0] = noise_permutations[hx0y0 + z0] & 0x0F;
+    hashes[1] = noise_permutations[hx1y0 + z0] & 0x0F;
+    hashes[2] = noise_permutations[hx0y1 + z0] & 0x0F;
+    hashes[3] = noise_permutations[hx1y1 + z0] & 0x0F;
+    hashes[4] = noise_permutations[hx0y0 + z1] & 0x0F;
+    hashes[5] = noise_permutations[hx1y0 + z1] & 0x0F;
+    hashes[6] = noise_permutations[hx0y1 + z1] & 0x0F;
+    hashes[7] = noise_permutations[hx1y1 + z1] & 0x0F;
+}
+
+static
+inline
+void
+NoiseLatticeCell(
+    _In_ POINT3 point,
+    _Out_ float_t *dx,
+    _Out_ float_t *dy,
+    _Out_ float_t *dz,
+    _Out_writes_(8) uint8_t hashes[8]
+    )
+{
+    float_t floor_x = floor(point.x);
+    float_t floor_y = floor(point.y);
+    float_t floor_z = floor(point.z);
+
+    *dx = point.x - floor_x;
+    *dy = point.y - floor_y;
+    *dz = point.z - floor_z;
+
+    uint8_t ix = (uint8_t)(int8_t)(int)floor_x;
+    uint8_t iy = (uint8_t)(int8_t)(int)floor_y;
+    uint8_t iz = (uint8_t)(int8_t)(int)floor_z;
+
+    NoiseHashes(ix,
+                (uint8_t)(ix + 1),
+                iy,
+                (uint8_t)(iy + 1),
+                iz,
+                (uint8_t)(iz + 1),
+                hashes);
+}
+
+static
+inline
+void
+NoiseCorners(
+    _In_reads_(8) const uint8_t hashes[8],
+    _In_ float_t dx,
+    _In_ float_t dy,
+    _In_ float_t dz,
+    _Out_writes_(8) float_t corners[8]
+    )
+{
+    for (size_t i = 0; i < 8; i++)
+    {
+        float_t cx = dx - (float_t)(i & 1);
+        float_t cy = dy - (float_t)((i >> 1) & 1);
+        float_t cz = dz - (float_t)((i >> 2) & 1);
+
+        corners[i] = noise_gradients_x[hashes[i]] * cx +
+                     noise_gradients_y[hashes[i]] * cy +
+                     noise_gradients_z[hashes[i]] * cz;
+    }
+}
+
+static
+inline
+float_t
+NoiseInterpolate(
+    _In_reads_(8) const float_t corners[8],
+    _In_ float_t dx,
+    _In_ float_t dy,
+    _In_ float_t dz
+    )
+{
+    float_t wx = NoiseWeight(dx);
+    float_t wy = NoiseWeight(dy);
+    float_t wz = NoiseWeight(dz);
+
+    float_t x00 = Lerp(wx, corners[0], corners[1]);
+    float_t x10 = Lerp(wx, corners[2], corners[3]);
+    float_t x01 = Lerp(wx, corners[4], corners[5]);
+    float_t x11 = Lerp(wx, corners[6], corners[7]);
+    float_t y0 = Lerp(wy, x00, x10);
+    float_t y1 = Lerp(wy, x01, x11);
+
+    return Lerp(wz, y0, y1);
+}
+
+static
+void
+NoiseBlock(
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) float_t values[]
+    )
+{
+    assert(count <= PERLIN_NOISE_BLOCK_SIZE);
+
+    float_t dx[PERLIN_NOISE_BLOCK_SIZE];
+    float_t dy[PERLIN_NOISE_BLOCK_SIZE];
+    float_t dz[PERLIN_NOISE_BLOCK_SIZE];
+    uint8_t hashes[PERLIN_NOISE_BLOCK_SIZE][8];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        NoiseLatticeCell(points[i], dx + i, dy + i, dz + i, hashes[i]);
+    }
+
+    float_t corners[PERLIN_NOISE_BLOCK_SIZE][8];
+    for (size_t i = 0; i < count; i++)
+    {
+        NoiseCorners(hashes[i], dx[i], dy[i], dz[i], corners[i]);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = NoiseInterpolate(corners[i], dx[i], dy[i], dz[i]);
+    }
+}
+
+//
+// Fractional Brownian Motion Static Functions
+//
+
+static
+inline
+uint32_t
+FractionalBrownianNoiseOctaves(
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ uint32_t max_octaves,
+    _Out_ float_t *partial_octave_weight
+    )
+{
+    float_t dpoint_dx_length_squared = VectorDotProduct(dpoint_dx, dpoint_dx);
+    float_t dpoint_dy_length_squared = VectorDotProduct(dpoint_dy, dpoint_dy);
+    float_t length_squared = IMax(dpoint_dx_length_squared,
+                                  dpoint_dy_length_squared);
+
+    float_t n = (float_t)-1.0 - (float_t)0.5 * log2(length_squared);
+    n = IMax(n, (float_t)0.0);
+    n = IMin(n, (float_t)max_octaves);
+    float_t n_floor = floor(n);
+
+    float_t n_partial = n - n_floor;
+    *partial_octave_weight =
+        SmoothStep((float_t)0.3, (float_t)0.7, n_partial);
+
+    return (uint32_t)n_floor;
+}
+
+static
+void
+PerlinNoiseAccumulatorFlush(
+    _Inout_ PPERLIN_NOISE_ACCUMULATOR accumulator
+    )
+{
+    float_t noise[PERLIN_NOISE_BLOCK_SIZE];
+    NoiseBlock(accumulator->points, accumulator->count, noise);
+
+    for (size_t i = 0; i < accumulator->count; i++)
+    {
+        *accumulator->sums[i] += accumulator->weights[i] * noise[i];
+    }
+
+    accumulator->count = 0;
+}
+
+static
+inline
+void
+PerlinNoiseAccumulatorAdd(
+    _Inout_ PPERLIN_NOISE_ACCUMULATOR accumulator,
+    _In_ POINT3 point,
+    _In_ float_t weight,
+    _Inout_ float_t *sum
+    )
+{
+    if (accumulator->count == PERLIN_NOISE_BLOCK_SIZE)
+    {
+        PerlinNoiseAccumulatorFlush(accumulator);
+    }
+
+    accumulator->points[accumulator->count] = point;
+    accumulator->weights[accumulator->count] = weight;
+    accumulator->sums[accumulator->count] = sum;
+    accumulator->count += 1;
+}
+
+//
+// Octaves are queued in the same order the scalar sum would visit them so
+// the result does not depend on how they are split into blocks. The partial
+// octave is skipped when its weight is zero.
+//
+
+static
+void
+PerlinNoiseAccumulatorAddFractionalBrownianNoise(
+    _Inout_ PPERLIN_NOISE_ACCUMULATOR accumulator,
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves,
+    _Inout_ float_t *sum
+    )
+{
+    float_t partial_octave_weight;
+    uint32_t octaves = FractionalBrownianNoiseOctaves(dpoint_dx,
+                                                      dpoint_dy,
+                                                      max_octaves,
+                                                      &partial_octave_weight);
+
+    float_t lambda = (float_t)1.0;
+    float_t o = (float_t)1.0;
+
+    for (uint32_t i = 0; i < octaves; i++)
+    {
+        PerlinNoiseAccumulatorAdd(accumulator,
+                                  ScalePoint(point, lambda),
+                                  o,
+                                  sum);
+
+        lambda *= (float_t)1.99;
+        o *= omega;
+    }
+
+    if (partial_octave_weight != (float_t)0.0)
+    {
+        PerlinNoiseAccumulatorAdd(accumulator,
+                                  ScalePoint(point, lambda),
+                                  o * partial_octave_weight,
+                                  sum);
+    }
+}
+
+//
+// Noise Volume Static Functions
+//
+
+static
+inline
+size_t
+NoiseVolumeWrap(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ float_t coordinate,
+    _Out_ float_t *fraction
+    )
+{
+    float_t size = (float_t)noise_volume->size;
+    float_t scaled = coordinate * noise_volume->resolution;
+    float_t wrapped = scaled - size * floor(scaled / size);
+    float_t wrapped_floor = floor(wrapped);
+
+    *fraction = wrapped - wrapped_floor;
+
+    size_t index = (size_t)wrapped_floor;
+
+    if (noise_volume->size <= index)
+    {
+        index = 0;
+    }
+
+    return index;
+}
+
+static
+inline
+size_t
+NoiseVolumeNext(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ size_t index
+    )
+{
+    index += 1;
+
+    if (index == noise_volume->size)
+    {
+        index = 0;
+    }
+
+    return index;
+}
+
+static
+void
+NoiseVolumeBake(
+    _Inout_ PNOISE_VOLUME noise_volume,
+    _In_ size_t resolution
+    )
+{
+    float_t *sample = noise_volume->samples;
+    for (size_t z = 0; z < noise_volume->size; z++)
+    {
+        uint8_t z0 = (uint8_t)(z / resolution);
+        uint8_t z1 = (uint8_t)((z0 + 1) % NOISE_VOLUME_PERIOD);
+        float_t dz = (float_t)(z % resolution) / (float_t)resolution;
+
+        for (size_t y = 0; y < noise_volume->size; y++)
+        {
+            uint8_t y0 = (uint8_t)(y / resolution);
+            uint8_t y1 = (uint8_t)((y0 + 1) % NOISE_VOLUME_PERIOD);
+            float_t dy = (float_t)(y % resolution) / (float_t)resolution;
+
+            for (size_t x = 0; x < noise_volume->size; x++)
+            {
+                uint8_t x0 = (uint8_t)(x / resolution);
+                uint8_t x1 = (uint8_t)((x0 + 1) % NOISE_VOLUME_PERIOD);
+                float_t dx = (float_t)(x % resolution) / (float_t)resolution;
+
+                uint8_t hashes[8];
+                NoiseHashes(x0, x1, y0, y1, z0, z1, hashes);
+
+                float_t corners[8];
+                NoiseCorners(hashes, dx, dy, dz, corners);
+
+                *sample++ = NoiseInterpolate(corners, dx, dy, dz);
+            }
+        }
+    }
+}
+
+//
+// Functions
+//
+
+float_t
+PerlinNoise(
+    _In_ POINT3 point
+    )
+{
+    float_t dx, dy, dz;
+    uint8_t hashes[8];
+    NoiseLatticeCell(point, &dx, &dy, &dz, hashes);
+
+    float_t corners[8];
+    NoiseCorners(hashes, dx, dy, dz, corners);
+
+    return NoiseInterpolate(corners, dx, dy, dz);
+}
+
+float_t
+PerlinNoiseWithGradient(
+    _In_ POINT3 point,
+    _Out_ PVECTOR3 gradient
+    )
+{
+    assert(gradient != NULL);
+
+    float_t dx, dy, dz;
+    uint8_t hashes[8];
+    NoiseLatticeCell(point, &dx, &dy, &dz, hashes);
+
+    float_t corners[8];
+    NoiseCorners(hashes, dx, dy, dz, corners);
+
+    VECTOR3 g[8];
+    for (size_t i = 0; i < 8; i++)
+    {
+        g[i] = VectorCreate(noise_gradients_x[hashes[i]],
+                            noise_gradients_y[hashes[i]],
+                            noise_gradients_z[hashes[i]]);
+    }
+
+    float_t wx = NoiseWeight(dx);
+    float_t wy = NoiseWeight(dy);
+    float_t wz = NoiseWeight(dz);
+
+    float_t dwx = NoiseWeightDerivative(dx);
+    float_t dwy = NoiseWeightDerivative(dy);
+    float_t dwz = NoiseWeightDerivative(dz);
+
+    float_t x00 = Lerp(wx, corners[0], corners[1]);
+    float_t x10 = Lerp(wx, corners[2], corners[3]);
+    float_t x01 = Lerp(wx, corners[4], corners[5]);
+    float_t x11 = Lerp(wx, corners[6], corners[7]);
+
+    VECTOR3 gx00 = LerpVector(wx, g[0], g[1]);
+    VECTOR3 gx10 = LerpVector(wx, g[2], g[3]);
+    VECTOR3 gx01 = LerpVector(wx, g[4], g[5]);
+    VECTOR3 gx11 = LerpVector(wx, g[6], g[7]);
+
+    gx00.x += dwx * (corners[1] - corners[0]);
+    gx10.x += dwx * (corners[3] - corners[2]);
+    gx01.x += dwx * (corners[5] - corners[4]);
+    gx11.x += dwx * (corners[7] - corners[6]);
+
+    float_t y0 = Lerp(wy, x00, x10);
+    float_t y1 = Lerp(wy, x01, x11);
+
+    VECTOR3 gy0 = LerpVector(wy, gx00, gx10);
+    VECTOR3 gy1 = LerpVector(wy, gx01, gx11);
+
+    gy0.y += dwy * (x10 - x00);
+    gy1.y += dwy * (x11 - x01);
+
+    float_t result = Lerp(wz, y0, y1);
+
+    *gradient = LerpVector(wz, gy0, gy1);
+    gradient->z += dwz * (y1 - y0);
+
+    return result;
+}
+
+ISTATUS
+PerlinNoiseBatch(
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) float_t values[]
+    )
+{
+    if (points == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (values == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    for (size_t i = 0; i < count; i += PERLIN_NOISE_BLOCK_SIZE)
+    {
+        size_t block_size = count - i;
+
+        if (PERLIN_NOISE_BLOCK_SIZE < block_size)
+        {
+            block_size = PERLIN_NOISE_BLOCK_SIZE;
+        }
+
+        NoiseBlock(points + i, block_size, values + i);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+float_t
+PerlinFractionalBrownianNoise(
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves
+    )
+{
+    PERLIN_NOISE_ACCUMULATOR accumulator;
+    accumulator.count = 0;
+
+    float_t sum = (float_t)0.0;
+    PerlinNoiseAccumulatorAddFractionalBrownianNoise(&accumulator,
+                                                     point,
+                                                     dpoint_dx,
+                                                     dpoint_dy,
+                                                     omega,
+                                                     max_octaves,
+                                                     &sum);
+
+    PerlinNoiseAccumulatorFlush(&accumulator);
+
+    return sum;
+}
+
+float_t
+PerlinFractionalBrownianNoiseWithGradient(
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves,
+    _Out_ PVECTOR3 gradient
+    )
+{
+    assert(gradient != NULL);
+
+    float_t partial_octave_weight;
+    uint32_t octaves = FractionalBrownianNoiseOctaves(dpoint_dx,
+                                                      dpoint_dy,
+                                                      max_octaves,
+                                                      &partial_octave_weight);
+
+    float_t sum = (float_t)0.0;
+    float_t lambda = (float_t)1.0;
+    float_t o = (float_t)1.0;
+
+    *gradient = VectorCreate((float_t)0.0, (float_t)0.0, (float_t)0.0);
+
+    for (uint32_t i = 0; i < octaves; i++)
+    {
+        VECTOR3 octave_gradient;
+        sum += o * PerlinNoiseWithGradient(ScalePoint(point, lambda),
+                                           &octave_gradient);
+        *gradient = VectorAddScaled(*gradient, octave_gradient, o * lambda);
+
+        lambda *= (float_t)1.99;
+        o *= omega;
+    }
+
+    float_t weight = o * partial_octave_weight;
+
+    VECTOR3 octave_gradient;
+    sum += weight * PerlinNoiseWithGradient(ScalePoint(point, lambda),
+                                            &octave_gradient);
+    *gradient = VectorAddScaled(*gradient, octave_gradient, weight * lambda);
+
+    return sum;
+}
+
+ISTATUS
+PerlinFractionalBrownianNoiseBatch(
+    _In_reads_(count) const POINT3 points[],
+    _In_reads_(count) const VECTOR3 dpoints_dx[],
+    _In_reads_(count) const VECTOR3 dpoints_dy[],
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves,
+    _In_ size_t count,
+    _Out_writes_(count) float_t values[]
+    )
+{
+    if (points == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (dpoints_dx == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (dpoints_dy == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (!isfinite(omega))
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (values == NULL && count != 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_06;
+    }
+
+    PERLIN_NOISE_ACCUMULATOR accumulator;
+    accumulator.count = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = (float_t)0.0;
+        PerlinNoiseAccumulatorAddFractionalBrownianNoise(&accumulator,
+                                                         points[i],
+                                                         dpoints_dx[i],
+                                                         dpoints_dy[i],
+                                                         omega,
+                                                         max_octaves,
+                                                         values + i);
+    }
+
+    PerlinNoiseAccumulatorFlush(&accumulator);
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+NoiseVolumeAllocate(
+    _In_ size_t resolution,
+    _Out_ PNOISE_VOLUME *noise_volume
+    )
+{
+    if (resolution < 2)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (noise_volume == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    size_t size;
+    bool success = CheckedMultiplySizeT(resolution,
+                                        NOISE_VOLUME_PERIOD,
+                                        &size);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    size_t num_samples;
+    success = CheckedMultiplySizeT(size, size, &num_samples);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    success = CheckedMultiplySizeT(num_samples, size, &num_samples);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PNOISE_VOLUME result = (PNOISE_VOLUME)malloc(sizeof(NOISE_VOLUME));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->samples = (float_t *)calloc(num_samples, sizeof(float_t));
+
+    if (result->samples == NULL)
+    {
+        free(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->size = size;
+    result->resolution = (float_t)resolution;
+    result->reference_count = 1;
+
+    NoiseVolumeBake(result, resolution);
+
+    *noise_volume = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+float_t
+NoiseVolumeLookup(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ POINT3 point
+    )
+{
+    assert(noise_volume != NULL);
+
+    float_t dx, dy, dz;
+    size_t ix0 = NoiseVolumeWrap(noise_volume, point.x, &dx);
+    size_t iy0 = NoiseVolumeWrap(noise_volume, point.y, &dy);
+    size_t iz0 = NoiseVolumeWrap(noise_volume, point.z, &dz);
+
+    size_t ix1 = NoiseVolumeNext(noise_volume, ix0);
+    size_t iy1 = NoiseVolumeNext(noise_volume, iy0);
+    size_t iz1 = NoiseVolumeNext(noise_volume, iz0);
+
+    size_t size = noise_volume->size;
+    const float_t *z0_slice = noise_volume->samples + iz0 * size * size;
+    const float_t *z1_slice = noise_volume->samples + iz1 * size * size;
+
+    const float_t *y0z0 = z0_slice + iy0 * size;
+    const float_t *y1z0 = z0_slice + iy1 * size;
+    const float_t *y0z1 = z1_slice + iy0 * size;
+    const float_t *y1z1 = z1_slice + iy1 * size;
+
+    float_t x00 = Lerp(dx, y0z0[ix0], y0z0[ix1]);
+    float_t x10 = Lerp(dx, y1z0[ix0], y1z0[ix1]);
+    float_t x01 = Lerp(dx, y0z1[ix0], y0z1[ix1]);
+    float_t x11 = Lerp(dx, y1z1[ix0], y1z1[ix1]);
+    float_t y0 = Lerp(dy, x00, x10);
+    float_t y1 = Lerp(dy, x01, x11);
+
+    return Lerp(dz, y0, y1);
+}
+
+float_t
+NoiseVolumeFractionalBrownianNoise(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves
+    )
+{
+    assert(noise_volume != NULL);
+
+    float_t partial_octave_weight;
+    uint32_t octaves = FractionalBrownianNoiseOctaves(dpoint_dx,
+                                                      dpoint_dy,
+                                                      max_octaves,
+                                                      &partial_octave_weight);
+
+    float_t sum = (float_t)0.0;
+    float_t lambda = (float_t)1.0;
+    float_t o = (float_t)1.0;
+
+    for (uint32_t i = 0; i < octaves; i++)
+    {
+        sum += o * NoiseVolumeLookup(noise_volume, ScalePoint(point, lambda));
+        lambda *= (float_t)1.99;
+        o *= omega;
+    }
+
+    if (partial_octave_weight != (float_t)0.0)
+    {
+        sum += o * partial_octave_weight *
+               NoiseVolumeLookup(noise_volume, ScalePoint(point, lambda));
+    }
+
+    return sum;
+}
+
+void
+NoiseVolumeRetain(
+    _In_opt_ PNOISE_VOLUME noise_volume
+    )
+{
+    if (noise_volume == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add(&noise_volume->reference_count, 1);
+}
+
+void
+NoiseVolumeRelease(
+    _In_opt_ _Post_invalid_ PNOISE_VOLUME noise_volume
+    )
+{
+    if (noise_volume == NULL)
+    {
+        return;
+    }
+
+    if (atomic_fetch_sub(&noise_volume->reference_count, 1) == 1)
+    {
+        free(noise_volume->samples);
+        free(noise_volume);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    perlin_noise.h
+
+Abstract:
+
+    Perlin noise and fractional brownian motion built from it.
+
+    The batch routines evaluate many noise lookups per call. Lookups are
+    processed in blocks with the eight lattice corners of every lookup laid
+    out side by side so that the compiler can vectorize the corner
+    evaluation. Single point fractional brownian motion batches its octaves
+    the same way.
+
+    A noise volume bakes one period of a tileable variant of the noise into a
+    grid with a configurable number of samples per lattice cell, and answers
+    lookups with trilinear interpolation. It is cheaper to evaluate but it is
+    only an approximation of the noise and it repeats every
+    NOISE_VOLUME_PERIOD units.
+
+--*/
+
+#ifndef _IRIS_PHYSX_TOOLKIT_PERLIN_NOISE_
+#define _IRIS_PHYSX_TOOLKIT_PERLIN_NOISE_
+
+#include "iris_physx/iris_physx.h"
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//
+// Defines
+//
+
+#define NOISE_VOLUME_PERIOD 16
+
+//
+// Types
+//
+
+typedef struct _NOISE_VOLUME NOISE_VOLUME, *PNOISE_VOLUME;
+typedef const NOISE_VOLUME *PCNOISE_VOLUME;
+
+//
+// Functions
+//
+
+float_t
+PerlinNoise(
+    _In_ POINT3 point
+    );
+
+float_t
+PerlinNoiseWithGradient(
+    _In_ POINT3 point,
+    _Out_ PVECTOR3 gradient
+    );
+
+ISTATUS
+PerlinNoiseBatch(
+    _In_reads_(count) const POINT3 points[],
+    _In_ size_t count,
+    _Out_writes_(count) float_t values[]
+    );
+
+float_t
+PerlinFractionalBrownianNoise(
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves
+    );
+
+float_t
+PerlinFractionalBrownianNoiseWithGradient(
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves,
+    _Out_ PVECTOR3 gradient
+    );
+
+ISTATUS
+PerlinFractionalBrownianNoiseBatch(
+    _In_reads_(count) const POINT3 points[],
+    _In_reads_(count) const VECTOR3 dpoints_dx[],
+    _In_reads_(count) const VECTOR3 dpoints_dy[],
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves,
+    _In_ size_t count,
+    _Out_writes_(count) float_t values[]
+    );
+
+ISTATUS
+NoiseVolumeAllocate(
+    _In_ size_t resolution,
+    _Out_ PNOISE_VOLUME *noise_volume
+    );
+
+float_t
+NoiseVolumeLookup(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ POINT3 point
+    );
+
+float_t
+NoiseVolumeFractionalBrownianNoise(
+    _In_ PCNOISE_VOLUME noise_volume,
+    _In_ POINT3 point,
+    _In_ VECTOR3 dpoint_dx,
+    _In_ VECTOR3 dpoint_dy,
+    _In_ float_t omega,
+    _In_ uint32_t max_octaves
+    );
+
+void
+NoiseVolumeRetain(
+    _In_opt_ PNOISE_VOLUME noise_volume
+    );
+
+void
+NoiseVolumeRelease(
+    _In_opt_ _Post_invalid_ PNOISE_VOLUME noise_volume
+    );
+
+#if __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _IRIS_PHYSX_TOOLKIT_PERLIN_NOISE_
\ No newline at end of file
@@ -10,12 +10,17 @@ Abstract:
 
     Reimplementation of PBRT textures generated using Perlin noise.
 
+    The WithNoiseVolume variants read their noise from a baked noise volume
+    instead of evaluating it. Baked float textures do not provide analytic
+    gradients.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_PERLIN_TEXTURE_
 #define _IRIS_PHYSX_TOOLKIT_PERLIN_TEXTURE_
 
 #include "iris_physx_toolkit/float_texture.h"
+#include "iris_physx_toolkit/perlin_noise.h"
 #include "iris_physx_toolkit/reflector_texture.h"
 
 #if __cplusplus 
@@ -32,6 +37,13 @@ WindyFloatTextureAllocate(
     _Out_ PFLOAT_TEXTURE *texture
     );
 
+ISTATUS
+WindyFloatTextureAllocateWithNoiseVolume(
+    _In_opt_ PMATRIX texture_to_world,
+    _In_ PNOISE_VOLUME noise_volume,
+    _Out_ PFLOAT_TEXTURE *texture
+    );
+
 ISTATUS
 WindyReflectorTextureAllocate(
     _In_opt_ PMATRIX texture_to_world,
@@ -39,6 +51,14 @@ WindyReflectorTextureAllocate(
     _Out_ PREFLECTOR_TEXTURE *texture
     );
 
+ISTATUS
+WindyReflectorTextureAllocateWithNoiseVolume(
+    _In_opt_ PMATRIX texture_to_world,
+    _In_ PNOISE_VOLUME noise_volume,
+    _In_opt_ PREFLECTOR reflector,
+    _Out_ PREFLECTOR_TEXTURE *texture
+    );
+
 #if __cplusplus 
 }
 #endif // __cplusplus
@@ -72,6 +72,18 @@ ProductFloatTextureSample(
     return ISTATUS_SUCCESS;
 }
 
+static
+SHADING_ATTRIBUTES
+ProductFloatTextureGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCPRODUCT_FLOAT_TEXTURE texture = (PCPRODUCT_FLOAT_TEXTURE)context;
+
+    return FloatTextureGetAttributes(texture->multiplicand0) |
+           FloatTextureGetAttributes(texture->multiplicand1);
+}
+
 static
 void
 ProductFloatTextureFree(
@@ -89,7 +101,10 @@ ProductFloatTextureFree(
 
 static const FLOAT_TEXTURE_VTABLE product_float_texture_vtable = {
     ProductFloatTextureSample,
-    ProductFloatTextureFree
+    ProductFloatTextureFree,
+    NULL,
+    ProductFloatTextureGetAttributes,
+    NULL
 };
 
 //
@@ -198,6 +213,18 @@ ProductReflectorTextureSample(
     return status;
 }
 
+static
+SHADING_ATTRIBUTES
+ProductReflectorTextureGetAttributes(
+    _In_ const void *context
+    )
+{
+    PCPRODUCT_REFLECTOR_TEXTURE texture = (PCPRODUCT_REFLECTOR_TEXTURE)context;
+
+    return ReflectorTextureGetAttributes(texture->multiplicand0) |
+           ReflectorTextureGetAttributes(texture->multiplicand1);
+}
+
 static
 void
 ProductReflectorTextureFree(
@@ -215,7 +242,9 @@ ProductReflectorTextureFree(
 
 static const REFLECTOR_TEXTURE_VTABLE product_reflector_texture_vtable = {
     ProductReflectorTextureSample,
-    ProductReflectorTextureFree
+    ProductReflectorTextureFree,
+    NULL,
+    ProductReflectorTextureGetAttributes
 };
 
 //
@@ -15,6 +15,7 @@ Abstract:
 #include "common/alloc.h"
 #include "iris_physx_toolkit/reflector_texture.h"
 
+#include <assert.h>
 #include <stdalign.h>
 #include <stdatomic.h>
 #include <string.h>
@@ -137,6 +138,52 @@ ReflectorTextureSample(
     return status;
 }
 
+bool
+ReflectorTextureGetConstant(
+    _In_opt_ PCREFLECTOR_TEXTURE texture,
+    _Out_ PCREFLECTOR *value
+    )
+{
+    assert(value != NULL);
+
+    if (texture == NULL)
+    {
+        *value = NULL;
+        return true;
+    }
+
+    if (texture->vtable->get_constant_routine == NULL)
+    {
+        return false;
+    }
+
+    bool constant = texture->vtable->get_constant_routine(texture->data,
+                                                          value);
+
+    return constant;
+}
+
+SHADING_ATTRIBUTES
+ReflectorTextureGetAttributes(
+    _In_opt_ PCREFLECTOR_TEXTURE texture
+    )
+{
+    if (texture == NULL)
+    {
+        return SHADING_ATTRIBUTES_NONE;
+    }
+
+    if (texture->vtable->get_attributes_routine == NULL)
+    {
+        return SHADING_ATTRIBUTES_ALL;
+    }
+
+    SHADING_ATTRIBUTES attributes =
+        texture->vtable->get_attributes_routine(texture->data);
+
+    return attributes;
+}
+
 void
 ReflectorTextureRetain(
     _In_opt_ PREFLECTOR_TEXTURE texture
@@ -10,6 +10,14 @@ Abstract:
 
     Interface representing a texture of reflectors.
 
+    ReflectorTextureGetConstant returns true and the texture's reflector if
+    the texture is known to have the same reflector everywhere. A NULL texture
+    is constant NULL.
+
+    ReflectorTextureGetAttributes returns the shading attributes the texture
+    reads when it is sampled. A texture without a get attributes routine is
+    assumed to read every attribute.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_REFLECTOR_TEXTURE_
@@ -51,6 +59,17 @@ ReflectorTextureSample(
     _Out_ PCREFLECTOR *value
     );
 
+bool
+ReflectorTextureGetConstant(
+    _In_opt_ PCREFLECTOR_TEXTURE texture,
+    _Out_ PCREFLECTOR *value
+    );
+
+SHADING_ATTRIBUTES
+ReflectorTextureGetAttributes(
+    _In_opt_ PCREFLECTOR_TEXTURE texture
+    );
+
 void
 ReflectorTextureRetain(
     _In_opt_ PREFLECTOR_TEXTURE texture
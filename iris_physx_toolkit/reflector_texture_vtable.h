@@ -36,9 +36,24 @@ ISTATUS
     _Out_ PCREFLECTOR *value
     );
 
+typedef
+bool
+(*PREFLECTOR_TEXTURE_GET_CONSTANT_ROUTINE)(
+    _In_ const void *context,
+    _Out_ PCREFLECTOR *value
+    );
+
+typedef
+SHADING_ATTRIBUTES
+(*PREFLECTOR_TEXTURE_GET_ATTRIBUTES_ROUTINE)(
+    _In_ const void *context
+    );
+
 typedef struct _REFLECTOR_TEXTURE_VTABLE {
     PREFLECTOR_TEXTURE_SAMPLE_ROUTINE sample_routine;
     PFREE_ROUTINE free_routine;
+    PREFLECTOR_TEXTURE_GET_CONSTANT_ROUTINE get_constant_routine;
+    PREFLECTOR_TEXTURE_GET_ATTRIBUTES_ROUTINE get_attributes_routine;
 } REFLECTOR_TEXTURE_VTABLE, *PREFLECTOR_TEXTURE_VTABLE;
 
 typedef const REFLECTOR_TEXTURE_VTABLE *PCREFLECTOR_TEXTURE_VTABLE;
@@ -52,6 +52,30 @@ PhysxSampleTracerTraceRay(
     return status;
 }
 
+static
+ISTATUS
+PhysxSampleTracerTraceRays(
+    _In_opt_ void *context,
+    _In_reads_(num_rays) PCRAY_DIFFERENTIAL ray_differentials,
+    _In_ size_t num_rays,
+    _In_ PRANDOM rng,
+    _In_ float_t epsilon,
+    _Out_writes_(num_rays) PCOLOR3 colors
+    )
+{
+    PPHYSX_SAMPLE_TRACER physx_sample_tracer = (PPHYSX_SAMPLE_TRACER)context;
+
+    ISTATUS status =
+        IntegratorIntegrateBatch(physx_sample_tracer->integrator,
+                                 rng,
+                                 ray_differentials,
+                                 num_rays,
+                                 epsilon,
+                                 colors);
+
+    return status;
+}
+
 static
 ISTATUS
 PhysxSampleTracerDuplicate(
@@ -98,7 +122,15 @@ PhysxSampleTracerFree(
 static const SAMPLE_TRACER_VTABLE sample_tracer_vtable = {
     PhysxSampleTracerTraceRay,
     PhysxSampleTracerDuplicate,
-    PhysxSampleTracerFree
+    PhysxSampleTracerFree,
+    NULL
+};
+
+static const SAMPLE_TRACER_VTABLE batch_sample_tracer_vtable = {
+    PhysxSampleTracerTraceRay,
+    PhysxSampleTracerDuplicate,
+    PhysxSampleTracerFree,
+    PhysxSampleTracerTraceRays
 };
 
 //
@@ -124,7 +156,23 @@ PhysxSampleTracerAllocate(
     PHYSX_SAMPLE_TRACER physx_sample_tracer;
     physx_sample_tracer.integrator = integrator;
 
-    ISTATUS status = SampleTracerAllocate(&sample_tracer_vtable,
+    //
+    // Only expose batches for integrators that trace them natively so that
+    // renders using scalar integrators draw random numbers in the same order
+    // as before.
+    //
+
+    PCSAMPLE_TRACER_VTABLE vtable;
+    if (IntegratorSupportsBatches(integrator))
+    {
+        vtable = &batch_sample_tracer_vtable;
+    }
+    else
+    {
+        vtable = &sample_tracer_vtable;
+    }
+
+    ISTATUS status = SampleTracerAllocate(vtable,
                                           &physx_sample_tracer,
                                           sizeof(PHYSX_SAMPLE_TRACER),
                                           alignof(PHYSX_SAMPLE_TRACER),
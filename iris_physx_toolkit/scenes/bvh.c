@@ -12,9 +12,12 @@ Abstract:
 
 --*/
 
+#include <math.h>
 #include <stdalign.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 
 #include "common/safe_math.h"
 #include "iris_physx_toolkit/scenes/bvh.h"
@@ -29,6 +32,7 @@ typedef struct _SHAPE_BOUNDS {
     PSHAPE shape;
     PMATRIX model_to_world;
     bool premultiplied;
+    size_t index;
 } SHAPE_BOUNDS, *PSHAPE_BOUNDS;
 
 typedef const SHAPE_BOUNDS *PCSHAPE_BOUNDS;
@@ -37,27 +41,52 @@ typedef const SHAPE_BOUNDS *PCSHAPE_BOUNDS;
 // Shape Bounds Static Functions
 //
 
+static
+void
+ShapeBoundsInitializeWithBounds(
+    _Inout_ PSHAPE_BOUNDS bounds,
+    _In_ BOUNDING_BOX world_bounds,
+    _In_ PSHAPE shape,
+    _In_ PMATRIX model_to_world,
+    _In_ bool premultiplied,
+    _In_ size_t index
+    )
+{
+    VECTOR3 diagonal = PointSubtract(world_bounds.corners[1],
+                                     world_bounds.corners[0]);
+    bounds->bounds = world_bounds;
+    bounds->bounds_centroid = PointVectorAddScaled(world_bounds.corners[0],
+                                                   diagonal,
+                                                   (float_t)0.5);
+    bounds->shape = shape;
+    bounds->model_to_world = model_to_world;
+    bounds->premultiplied = premultiplied;
+    bounds->index = index;
+}
+
 static
 ISTATUS
 ShapeBoundsInitialize(
     _Inout_ PSHAPE_BOUNDS bounds,
     _In_ PSHAPE shape,
     _In_ PMATRIX model_to_world,
-    _In_ bool premultiplied
+    _In_ bool premultiplied,
+    _In_ size_t index
     )
 {
+    BOUNDING_BOX world_bounds;
     ISTATUS status;
     if (premultiplied)
     {
         status = ShapeComputeBounds(shape,
                                     NULL,
-                                    &bounds->bounds);
+                                    &world_bounds);
     }
     else
     {
         status = ShapeComputeBounds(shape,
                                     model_to_world,
-                                    &bounds->bounds);
+                                    &world_bounds);
     }
 
     if (status != ISTATUS_SUCCESS)
@@ -65,14 +94,12 @@ ShapeBoundsInitialize(
         return status;
     }
 
-    VECTOR3 diagonal = PointSubtract(bounds->bounds.corners[1],
-                                     bounds->bounds.corners[0]);
-    bounds->bounds_centroid = PointVectorAddScaled(bounds->bounds.corners[0],
-                                                   diagonal,
-                                                   (float_t)0.5);
-    bounds->shape = shape;
-    bounds->model_to_world = model_to_world;
-    bounds->premultiplied = premultiplied;
+    ShapeBoundsInitializeWithBounds(bounds,
+                                    world_bounds,
+                                    shape,
+                                    model_to_world,
+                                    premultiplied,
+                                    index);
 
     return ISTATUS_SUCCESS;
 }
@@ -336,6 +363,274 @@ NodeBuilderInitializeInteriorNode(
     return true;
 }
 
+//
+// Compressed Node Defines
+//
+
+#define COMPRESSED_NODE_STEPS 255
+
+//
+// Compressed Node Type
+//
+// Each node stores its bounds as a number of steps inward from the lower and
+// upper corners of its parent's decoded bounds, with the parent's extent
+// divided into COMPRESSED_NODE_STEPS steps along each axis. Decoding steps
+// from both corners keeps zero steps exact, so a child can always be encoded
+// conservatively. The root is decoded relative to the full precision bounds
+// of the tree.
+//
+
+typedef struct _BVH_COMPRESSED_NODE {
+    uint32_t offset;
+    uint16_t num_shapes;
+    uint8_t axis;
+    uint8_t steps[2][3];
+} BVH_COMPRESSED_NODE, *PBVH_COMPRESSED_NODE;
+
+typedef const BVH_COMPRESSED_NODE *PCBVH_COMPRESSED_NODE;
+
+//
+// Compressed Node Static Functions
+//
+
+static
+inline
+float_t
+BvhCompressedNodeStepSize(
+    _In_ float_t parent_min,
+    _In_ float_t parent_max
+    )
+{
+    float_t step_size =
+        (parent_max - parent_min) / (float_t)COMPRESSED_NODE_STEPS;
+
+    //
+    // Unbounded parents cannot be subdivided, so their children decode to the
+    // parent's bounds along that axis.
+    //
+
+    return (step_size < (float_t)INFINITY) ? step_size : (float_t)0.0;
+}
+
+static
+inline
+void
+BvhCompressedNodeDecodeAxis(
+    _In_ float_t parent_min,
+    _In_ float_t parent_max,
+    _In_ uint8_t min_steps,
+    _In_ uint8_t max_steps,
+    _Out_ float_t *min,
+    _Out_ float_t *max
+    )
+{
+    float_t step_size = BvhCompressedNodeStepSize(parent_min, parent_max);
+    *min = parent_min + (float_t)min_steps * step_size;
+    *max = parent_max - (float_t)max_steps * step_size;
+}
+
+static
+inline
+BOUNDING_BOX
+BvhCompressedNodeDecodeBounds(
+    _In_ PCBVH_COMPRESSED_NODE node,
+    _In_ BOUNDING_BOX parent_bounds
+    )
+{
+    BOUNDING_BOX result;
+    BvhCompressedNodeDecodeAxis(parent_bounds.corners[0].x,
+                                parent_bounds.corners[1].x,
+                                node->steps[0][0],
+                                node->steps[1][0],
+                                &result.corners[0].x,
+                                &result.corners[1].x);
+    BvhCompressedNodeDecodeAxis(parent_bounds.corners[0].y,
+                                parent_bounds.corners[1].y,
+                                node->steps[0][1],
+                                node->steps[1][1],
+                                &result.corners[0].y,
+                                &result.corners[1].y);
+    BvhCompressedNodeDecodeAxis(parent_bounds.corners[0].z,
+                                parent_bounds.corners[1].z,
+                                node->steps[0][2],
+                                node->steps[1][2],
+                                &result.corners[0].z,
+                                &result.corners[1].z);
+
+    return result;
+}
+
+static
+void
+BvhCompressedNodeEncodeAxis(
+    _In_ float_t parent_min,
+    _In_ float_t parent_max,
+    _In_ float_t min,
+    _In_ float_t max,
+    _Out_ uint8_t *min_steps,
+    _Out_ uint8_t *max_steps
+    )
+{
+    float_t step_size = BvhCompressedNodeStepSize(parent_min, parent_max);
+
+    float_t min_estimate = (float_t)0.0;
+    float_t max_estimate = (float_t)0.0;
+    if (step_size != (float_t)0.0)
+    {
+        min_estimate = floor((min - parent_min) / step_size);
+        max_estimate = floor((parent_max - max) / step_size);
+    }
+
+    unsigned int min_count = (unsigned int)IMax((float_t)0.0,
+        IMin(min_estimate, (float_t)COMPRESSED_NODE_STEPS));
+    unsigned int max_count = (unsigned int)IMax((float_t)0.0,
+        IMin(max_estimate, (float_t)COMPRESSED_NODE_STEPS));
+
+    //
+    // The estimates may be off by a step due to rounding, so back off until
+    // the decoded bounds contain the node's bounds. Zero steps decodes to the
+    // parent's bounds exactly, which always contain them.
+    //
+
+    for (;;)
+    {
+        float_t decoded_min, decoded_max;
+        BvhCompressedNodeDecodeAxis(parent_min,
+                                    parent_max,
+                                    (uint8_t)min_count,
+                                    (uint8_t)max_count,
+                                    &decoded_min,
+                                    &decoded_max);
+
+        bool min_contained = !(min < decoded_min);
+        bool max_contained = !(decoded_max < max);
+
+        if (min_contained && max_contained)
+        {
+            break;
+        }
+
+        if (!min_contained)
+        {
+            min_count -= 1;
+        }
+
+        if (!max_contained)
+        {
+            max_count -= 1;
+        }
+    }
+
+    *min_steps = (uint8_t)min_count;
+    *max_steps = (uint8_t)max_count;
+}
+
+static
+BOUNDING_BOX
+BvhCompressedNodeInitialize(
+    _Out_ PBVH_COMPRESSED_NODE compressed_node,
+    _In_ PCBVH_NODE node,
+    _In_ BOUNDING_BOX parent_bounds
+    )
+{
+    BvhCompressedNodeEncodeAxis(parent_bounds.corners[0].x,
+                                parent_bounds.corners[1].x,
+                                node->bounds.corners[0].x,
+                                node->bounds.corners[1].x,
+                                &compressed_node->steps[0][0],
+                                &compressed_node->steps[1][0]);
+    BvhCompressedNodeEncodeAxis(parent_bounds.corners[0].y,
+                                parent_bounds.corners[1].y,
+                                node->bounds.corners[0].y,
+                                node->bounds.corners[1].y,
+                                &compressed_node->steps[0][1],
+                                &compressed_node->steps[1][1]);
+    BvhCompressedNodeEncodeAxis(parent_bounds.corners[0].z,
+                                parent_bounds.corners[1].z,
+                                node->bounds.corners[0].z,
+                                node->bounds.corners[1].z,
+                                &compressed_node->steps[0][2],
+                                &compressed_node->steps[1][2]);
+
+    compressed_node->offset = node->offset;
+    compressed_node->num_shapes = node->num_shapes;
+
+    if (node->num_shapes == 0)
+    {
+        assert(node->axis < UINT8_MAX);
+        compressed_node->axis = (uint8_t)node->axis;
+    }
+    else
+    {
+        compressed_node->axis = UINT8_MAX;
+    }
+
+    return BvhCompressedNodeDecodeBounds(compressed_node, parent_bounds);
+}
+
+static
+bool
+BvhCompressNodes(
+    _In_reads_(num_nodes) PCBVH_NODE nodes,
+    _In_ size_t num_nodes,
+    _Outptr_result_buffer_(num_nodes) PBVH_COMPRESSED_NODE *compressed_nodes
+    )
+{
+    assert(num_nodes != 0);
+
+    PBVH_COMPRESSED_NODE result =
+        (PBVH_COMPRESSED_NODE)calloc(num_nodes, sizeof(BVH_COMPRESSED_NODE));
+
+    if (result == NULL)
+    {
+        return false;
+    }
+
+    //
+    // Children are always stored after their parent, so the decoded bounds of
+    // each parent are known by the time its children are encoded.
+    //
+
+    PBOUNDING_BOX decoded_bounds =
+        (PBOUNDING_BOX)calloc(num_nodes, sizeof(BOUNDING_BOX));
+
+    if (decoded_bounds == NULL)
+    {
+        free(result);
+        return false;
+    }
+
+    decoded_bounds[0] = BvhCompressedNodeInitialize(result,
+                                                    nodes,
+                                                    nodes[0].bounds);
+
+    for (size_t i = 0; i < num_nodes; i++)
+    {
+        if (nodes[i].num_shapes != 0)
+        {
+            continue;
+        }
+
+        size_t below = i + 1;
+        size_t above = i + nodes[i].offset;
+
+        decoded_bounds[below] =
+            BvhCompressedNodeInitialize(result + below,
+                                        nodes + below,
+                                        decoded_bounds[i]);
+        decoded_bounds[above] =
+            BvhCompressedNodeInitialize(result + above,
+                                        nodes + above,
+                                        decoded_bounds[i]);
+    }
+
+    free(decoded_bounds);
+
+    *compressed_nodes = result;
+
+    return true;
+}
+
 //
 // BVH Build Defines
 //
@@ -393,7 +688,8 @@ BvhEvaluateSplitsOnAxis(
     _In_reads_(num_shapes) PCSHAPE_BOUNDS shape_bounds,
     _In_ size_t num_shapes,
     _In_ VECTOR_AXIS axis,
-    _Out_ float_t *split
+    _Out_ float_t *split,
+    _Out_ float_t *split_cost
     )
 {
     assert(num_shapes != 0);
@@ -523,6 +819,8 @@ BvhEvaluateSplitsOnAxis(
         }
     }
 
+    *split_cost = best_cost;
+
     if (num_shapes <= MAX_SHAPES_PER_NODE && (float_t)num_shapes < best_cost)
     {
         return false;
@@ -639,13 +937,14 @@ BvhBuildImpl(
     }
     else
     {
-        float_t split;
+        float_t split, split_cost;
         bool success = BvhEvaluateSplitsOnAxis(node_bounds,
                                                centroid_bounds,
                                                shape_bounds,
                                                num_shapes,
                                                axis,
-                                               &split);
+                                               &split,
+                                               &split_cost);
 
         if (!success)
         {
@@ -716,6 +1015,29 @@ BvhBuildImpl(
     return success;          
 }
 
+static
+bool
+BvhBuildFromShapeBounds(
+    _Inout_ PNODE_BUILDER node_builder,
+    _Inout_updates_(num_shapes) PSHAPE_BOUNDS shape_bounds,
+    _In_ size_t num_shapes,
+    _In_ size_t max_depth
+    )
+{
+    BOUNDING_BOX node_bounds = BvhComputeNodeBounds(shape_bounds, num_shapes);
+
+    size_t unused_index;
+    bool success = BvhBuildImpl(node_builder,
+                                node_bounds,
+                                shape_bounds,
+                                num_shapes,
+                                0,
+                                max_depth - 1,
+                                &unused_index);
+
+    return success;
+}
+
 static
 ISTATUS
 BvhBuild(
@@ -760,7 +1082,8 @@ BvhBuild(
         ISTATUS status = ShapeBoundsInitialize(*shape_bounds + i,
                                                shapes[i],
                                                matrix,
-                                               is_premultiplied);
+                                               is_premultiplied,
+                                               i);
 
         if (status != ISTATUS_SUCCESS)
         {
@@ -769,16 +1092,10 @@ BvhBuild(
         }
     }
 
-    BOUNDING_BOX node_bounds = BvhComputeNodeBounds(*shape_bounds, num_shapes);
-
-    size_t unused_index;
-    bool success = BvhBuildImpl(node_builder,
-                                node_bounds,
-                                *shape_bounds,
-                                num_shapes,
-                                0,
-                                max_depth - 1,
-                                &unused_index);
+    bool success = BvhBuildFromShapeBounds(node_builder,
+                                           *shape_bounds,
+                                           num_shapes,
+                                           max_depth);
 
     if (!success)
     {
@@ -790,104 +1107,606 @@ BvhBuild(
 }
 
 //
-// Scene Defines
+// Spatial BVH Build Types
+//
+// The spatial build follows SBVH. Besides partitioning shapes by centroid, a
+// node may be split by a plane, in which case shapes straddling the plane
+// are referenced from both children with their bounds clipped to each side.
+// Shapes are only available through their bounds, so references are clipped
+// as boxes rather than as primitives.
 //
 
-#define MAX_TREE_DEPTH 64
+typedef struct _SPATIAL_BUILD {
+    PNODE_BUILDER node_builder;
+    _Field_size_(references_capacity) PSHAPE_BOUNDS references;
+    size_t references_capacity;
+    size_t references_size;
+    size_t duplicates_remaining;
+} SPATIAL_BUILD, *PSPATIAL_BUILD;
+
+typedef const SPATIAL_BUILD *PCSPATIAL_BUILD;
 
 //
-// Scene Types
+// Spatial BVH Build Static Functions
 //
 
-typedef struct _BVH_SCENE {
-    PBVH_NODE nodes;
-    _Field_size_(num_shapes) PSHAPE *shapes;
-    _Field_size_opt_(num_shapes) PMATRIX *transforms;
-    _Field_size_opt_(num_shapes) bool *premultiplied;
-    size_t num_shapes;
-} BVH_SCENE, *PBVH_SCENE;
+static
+inline
+BOUNDING_BOX
+BvhClipBounds(
+    _In_ BOUNDING_BOX bounds,
+    _In_ VECTOR_AXIS axis,
+    _In_ float_t plane,
+    _In_ bool keep_above
+    )
+{
+    float_t *lower = &bounds.corners[0].x;
+    float_t *upper = &bounds.corners[1].x;
 
-typedef const BVH_SCENE *PCBVH_SCENE;
+    if (keep_above)
+    {
+        lower[axis] = IMax(lower[axis], plane);
+    }
+    else
+    {
+        upper[axis] = IMin(upper[axis], plane);
+    }
 
-//
-// Scene Static Functions
-//
+    return bounds;
+}
 
 static
-ISTATUS
-BvhSceneTrace(
-    _In_opt_ const void *context,
-    _Inout_ PSHAPE_HIT_TESTER hit_tester,
-    _In_ RAY ray
+inline
+bool
+BvhReferenceIsBelow(
+    _In_ PCSHAPE_BOUNDS reference,
+    _In_ VECTOR_AXIS axis,
+    _In_ float_t plane
     )
 {
-    PCBVH_SCENE bvh_scene = (PCBVH_SCENE)context;
+    float_t lower = PointGetElement(reference->bounds.corners[0], axis);
+    float_t upper = PointGetElement(reference->bounds.corners[1], axis);
+    return lower < plane || upper <= plane;
+}
 
-    float_t closest_hit;
-    ShapeHitTesterFarthestHitAllowed(hit_tester, &closest_hit);
+static
+inline
+bool
+BvhReferenceIsAbove(
+    _In_ PCSHAPE_BOUNDS reference,
+    _In_ VECTOR_AXIS axis,
+    _In_ float_t plane
+    )
+{
+    float_t upper = PointGetElement(reference->bounds.corners[1], axis);
+    return plane < upper;
+}
 
-    PCBVH_NODE work_list[MAX_TREE_DEPTH];
-    PCBVH_NODE current = bvh_scene->nodes;
-    size_t queue_size = 0;
-    for (;;)
+static
+bool
+BvhEvaluateSpatialSplitsOnAxis(
+    _In_ BOUNDING_BOX node_bounds,
+    _In_reads_(num_references) PCSHAPE_BOUNDS references,
+    _In_ size_t num_references,
+    _In_ VECTOR_AXIS axis,
+    _In_ size_t max_duplicates,
+    _Out_ float_t *split,
+    _Out_ float_t *split_cost,
+    _Out_ size_t *num_duplicates
+    )
+{
+    assert(num_references != 0);
+
+    float_t min = PointGetElement(node_bounds.corners[0], axis);
+    float_t max = PointGetElement(node_bounds.corners[1], axis);
+    float_t range = max - min;
+
+    if (!(range > (float_t)0.0) || isinf(range))
     {
-        float_t near, far;
-        if (BoundingBoxIntersect(current->bounds, ray, NULL, &near, &far) &&
-            near <= closest_hit &&
-            (float_t)0.0 <= far)
+        return false;
+    }
+
+    float_t node_surface_area = BoundingBoxSurfaceArea(node_bounds);
+
+    float_t best_cost = (float_t)INFINITY;
+    float_t best_split = (float_t)0.0;
+    size_t best_num_duplicates = 0;
+    bool found = false;
+    for (size_t i = 1; i < SPLITS_TO_EVALUATE; i++)
+    {
+        float_t relative_split = (float_t)i / (float_t)SPLITS_TO_EVALUATE;
+        float_t plane = min + range * relative_split;
+
+        BOUNDING_BOX below_bounds, above_bounds;
+        size_t num_below = 0, num_above = 0, num_straddling = 0;
+        for (size_t j = 0; j < num_references; j++)
         {
-            if (current->num_shapes == 0)
+            bool below = BvhReferenceIsBelow(references + j, axis, plane);
+            bool above = BvhReferenceIsAbove(references + j, axis, plane);
+
+            if (below)
             {
-                float_t direction =
-                    VectorGetElement(ray.direction, current->axis);
-                if (direction < (float_t)0.0)
-                {
-                    work_list[queue_size++] = current + 1;
-                    current = current + current->offset;
-                }
-                else
-                {
-                    work_list[queue_size++] = current + current->offset;
-                    current = current + 1;
-                }
-                continue;
+                BOUNDING_BOX clipped =
+                    BvhClipBounds(references[j].bounds, axis, plane, false);
+                below_bounds = (num_below == 0) ?
+                    clipped : BoundingBoxUnion(below_bounds, clipped);
+                num_below += 1;
             }
 
-            size_t offset = current->offset;
-            for (size_t i = 0; i < current->num_shapes; i++)
+            if (above)
             {
-                PCSHAPE shape = bvh_scene->shapes[offset + i];
-                PCMATRIX matrix = bvh_scene->transforms[offset + i];
-                bool premultiplied = bvh_scene->premultiplied[offset + i];
-                ISTATUS status =
-                    ShapeHitTesterTestShapeWithLimit(hit_tester,
-                                                     shape,
-                                                     matrix,
-                                                     premultiplied,
-                                                     &closest_hit);
+                BOUNDING_BOX clipped =
+                    BvhClipBounds(references[j].bounds, axis, plane, true);
+                above_bounds = (num_above == 0) ?
+                    clipped : BoundingBoxUnion(above_bounds, clipped);
+                num_above += 1;
+            }
 
-                if (status != ISTATUS_SUCCESS)
-                {
-                    return status;
-                }
+            if (below && above)
+            {
+                num_straddling += 1;
             }
         }
 
-        if (queue_size == 0)
+        if (num_straddling == 0 ||
+            max_duplicates < num_straddling ||
+            num_below == 0 ||
+            num_above == 0 ||
+            (num_below == num_references && num_above == num_references))
         {
-            break;
+            continue;
         }
 
-        queue_size -= 1;
-        current = work_list[queue_size];
+        float_t below_cost = BvhComputeNodeCost(below_bounds, num_below);
+        float_t above_cost = BvhComputeNodeCost(above_bounds, num_above);
+        float_t cost =
+            (float_t)1.0 + (below_cost + above_cost) / node_surface_area;
+
+        if (!found || cost < best_cost)
+        {
+            best_cost = cost;
+            best_split = plane;
+            best_num_duplicates = num_straddling;
+            found = true;
+        }
+    }
+
+    *split = best_split;
+    *split_cost = best_cost;
+    *num_duplicates = best_num_duplicates;
+
+    return found;
+}
+
+static
+bool
+BvhPartitionReferencesSpatially(
+    _In_reads_(num_references) PCSHAPE_BOUNDS references,
+    _In_ size_t num_references,
+    _In_ VECTOR_AXIS axis,
+    _In_ float_t split,
+    _Outptr_result_buffer_(*num_below) PSHAPE_BOUNDS *below,
+    _Out_ size_t *num_below,
+    _Outptr_result_buffer_(*num_above) PSHAPE_BOUNDS *above,
+    _Out_ size_t *num_above
+    )
+{
+    size_t below_size = 0, above_size = 0;
+    for (size_t i = 0; i < num_references; i++)
+    {
+        if (BvhReferenceIsBelow(references + i, axis, split))
+        {
+            below_size += 1;
+        }
+
+        if (BvhReferenceIsAbove(references + i, axis, split))
+        {
+            above_size += 1;
+        }
+    }
+
+    PSHAPE_BOUNDS below_references =
+        (PSHAPE_BOUNDS)calloc(below_size, sizeof(SHAPE_BOUNDS));
+    PSHAPE_BOUNDS above_references =
+        (PSHAPE_BOUNDS)calloc(above_size, sizeof(SHAPE_BOUNDS));
+
+    if (below_references == NULL || above_references == NULL)
+    {
+        free(below_references);
+        free(above_references);
+        return false;
+    }
+
+    below_size = 0;
+    above_size = 0;
+    for (size_t i = 0; i < num_references; i++)
+    {
+        PCSHAPE_BOUNDS reference = references + i;
+
+        if (BvhReferenceIsBelow(reference, axis, split))
+        {
+            BOUNDING_BOX clipped =
+                BvhClipBounds(reference->bounds, axis, split, false);
+            ShapeBoundsInitializeWithBounds(below_references + below_size++,
+                                            clipped,
+                                            reference->shape,
+                                            reference->model_to_world,
+                                            reference->premultiplied,
+                                            reference->index);
+        }
+
+        if (BvhReferenceIsAbove(reference, axis, split))
+        {
+            BOUNDING_BOX clipped =
+                BvhClipBounds(reference->bounds, axis, split, true);
+            ShapeBoundsInitializeWithBounds(above_references + above_size++,
+                                            clipped,
+                                            reference->shape,
+                                            reference->model_to_world,
+                                            reference->premultiplied,
+                                            reference->index);
+        }
+    }
+
+    *below = below_references;
+    *num_below = below_size;
+    *above = above_references;
+    *num_above = above_size;
+
+    return true;
+}
+
+static
+bool
+BvhSpatialBuildAllocateLeafNode(
+    _Inout_ PSPATIAL_BUILD build,
+    _In_ BOUNDING_BOX node_bounds,
+    _In_reads_(num_references) PCSHAPE_BOUNDS references,
+    _In_ size_t num_references,
+    _Out_ size_t *index
+    )
+{
+    size_t new_size;
+    bool success = CheckedAddSizeT(build->references_size,
+                                   num_references,
+                                   &new_size);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    if (build->references_capacity < new_size)
+    {
+        size_t new_capacity;
+        success = CheckedMultiplySizeT(new_size, 2, &new_capacity);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        size_t bytes;
+        success = CheckedMultiplySizeT(new_capacity,
+                                       sizeof(SHAPE_BOUNDS),
+                                       &bytes);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        PSHAPE_BOUNDS new_references =
+            (PSHAPE_BOUNDS)realloc(build->references, bytes);
+
+        if (new_references == NULL)
+        {
+            return false;
+        }
+
+        build->references = new_references;
+        build->references_capacity = new_capacity;
+    }
+
+    success = NodeBuilderAllocateLeafNode(build->node_builder,
+                                          node_bounds,
+                                          build->references_size,
+                                          num_references,
+                                          index);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    memcpy(build->references + build->references_size,
+           references,
+           num_references * sizeof(SHAPE_BOUNDS));
+    build->references_size = new_size;
+
+    return true;
+}
+
+static
+bool
+BvhSpatialBuildImpl(
+    _Inout_ PSPATIAL_BUILD build,
+    _In_ BOUNDING_BOX node_bounds,
+    _Inout_updates_(num_references) PSHAPE_BOUNDS references,
+    _In_ size_t num_references,
+    _In_ size_t depth_remaining,
+    _Out_ size_t *index
+    )
+{
+    if (num_references == 1 || depth_remaining == 0)
+    {
+        bool success = BvhSpatialBuildAllocateLeafNode(build,
+                                                       node_bounds,
+                                                       references,
+                                                       num_references,
+                                                       index);
+
+        return success;
+    }
+
+    BOUNDING_BOX centroid_bounds =
+        BoundingBoxCreate(references[0].bounds_centroid,
+                          references[0].bounds_centroid);
+
+    for (size_t i = 1; i < num_references; i++)
+    {
+        centroid_bounds = BoundingBoxEnvelop(centroid_bounds,
+                                             references[i].bounds_centroid);
+    }
+
+    VECTOR3 centroid_diagonal = PointSubtract(centroid_bounds.corners[1],
+                                              centroid_bounds.corners[0]);
+    VECTOR_AXIS object_axis = VectorDominantAxis(centroid_diagonal);
+
+    float_t min = PointGetElement(centroid_bounds.corners[0], object_axis);
+    float_t max = PointGetElement(centroid_bounds.corners[1], object_axis);
+
+    float_t object_split;
+    float_t object_cost = (float_t)INFINITY;
+    bool object_split_found = false;
+    if (min != max)
+    {
+        object_split_found = BvhEvaluateSplitsOnAxis(node_bounds,
+                                                     centroid_bounds,
+                                                     references,
+                                                     num_references,
+                                                     object_axis,
+                                                     &object_split,
+                                                     &object_cost);
+    }
+
+    VECTOR_AXIS spatial_axis = BoundingBoxDominantAxis(node_bounds);
+
+    float_t spatial_split, spatial_cost;
+    size_t num_duplicates;
+    bool spatial_split_found =
+        BvhEvaluateSpatialSplitsOnAxis(node_bounds,
+                                       references,
+                                       num_references,
+                                       spatial_axis,
+                                       build->duplicates_remaining,
+                                       &spatial_split,
+                                       &spatial_cost,
+                                       &num_duplicates);
+
+    if (spatial_split_found && object_cost <= spatial_cost)
+    {
+        spatial_split_found = false;
+    }
+
+    if (spatial_split_found &&
+        num_references <= MAX_SHAPES_PER_NODE &&
+        (float_t)num_references < spatial_cost)
+    {
+        spatial_split_found = false;
+        object_split_found = false;
+    }
+
+    if (!spatial_split_found && !object_split_found)
+    {
+        bool success = BvhSpatialBuildAllocateLeafNode(build,
+                                                       node_bounds,
+                                                       references,
+                                                       num_references,
+                                                       index);
+
+        return success;
+    }
+
+    bool success = NodeBuilderAllocateNode(build->node_builder, index);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    VECTOR_AXIS axis;
+    PSHAPE_BOUNDS above_references, below_references;
+    size_t num_above, num_below;
+    if (spatial_split_found)
+    {
+        axis = spatial_axis;
+        success = BvhPartitionReferencesSpatially(references,
+                                                  num_references,
+                                                  axis,
+                                                  spatial_split,
+                                                  &below_references,
+                                                  &num_below,
+                                                  &above_references,
+                                                  &num_above);
+
+        if (!success)
+        {
+            return false;
+        }
+
+        build->duplicates_remaining -= num_duplicates;
+    }
+    else
+    {
+        axis = object_axis;
+        BvhPartitionShapes(references,
+                           num_references,
+                           axis,
+                           object_split,
+                           &above_references,
+                           &num_above,
+                           &below_references,
+                           &num_below);
+    }
+
+    size_t unused_below_index;
+    BOUNDING_BOX below_node_bounds =
+        BvhComputeNodeBounds(below_references, num_below);
+    success = BvhSpatialBuildImpl(build,
+                                  below_node_bounds,
+                                  below_references,
+                                  num_below,
+                                  depth_remaining - 1,
+                                  &unused_below_index);
+
+    size_t above_index;
+    if (success)
+    {
+        BOUNDING_BOX above_node_bounds =
+            BvhComputeNodeBounds(above_references, num_above);
+        success = BvhSpatialBuildImpl(build,
+                                      above_node_bounds,
+                                      above_references,
+                                      num_above,
+                                      depth_remaining - 1,
+                                      &above_index);
+    }
+
+    if (spatial_split_found)
+    {
+        free(below_references);
+        free(above_references);
+    }
+
+    if (!success)
+    {
+        return false;
+    }
+
+    success = NodeBuilderInitializeInteriorNode(build->node_builder,
+                                                node_bounds,
+                                                *index,
+                                                above_index,
+                                                axis);
+
+    return success;
+}
+
+static
+ISTATUS
+BvhSpatialBuild(
+    _Inout_ PNODE_BUILDER node_builder,
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_ float_t max_duplication,
+    _In_ size_t max_depth,
+    _Outptr_result_buffer_(*num_references) PSHAPE_BOUNDS *references,
+    _Out_ size_t *num_references
+    )
+{
+    PSHAPE_BOUNDS shape_bounds =
+        (PSHAPE_BOUNDS)calloc(num_shapes, sizeof(SHAPE_BOUNDS));
+
+    if (shape_bounds == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        PMATRIX matrix = (transforms != NULL) ? transforms[i] : NULL;
+        bool is_premultiplied =
+            (premultiplied != NULL) ? premultiplied[i] : false;
+
+        ISTATUS status = ShapeBoundsInitialize(shape_bounds + i,
+                                               shapes[i],
+                                               matrix,
+                                               is_premultiplied,
+                                               i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            free(shape_bounds);
+            return status;
+        }
+    }
+
+    float_t max_duplicates = floor((float_t)num_shapes * max_duplication);
+
+    SPATIAL_BUILD build;
+    build.node_builder = node_builder;
+    build.references = NULL;
+    build.references_capacity = 0;
+    build.references_size = 0;
+    build.duplicates_remaining = (max_duplicates < (float_t)SIZE_MAX) ?
+        (size_t)max_duplicates : SIZE_MAX;
+
+    BOUNDING_BOX node_bounds = BvhComputeNodeBounds(shape_bounds, num_shapes);
+
+    size_t unused_index;
+    bool success = BvhSpatialBuildImpl(&build,
+                                       node_bounds,
+                                       shape_bounds,
+                                       num_shapes,
+                                       max_depth - 1,
+                                       &unused_index);
+
+    free(shape_bounds);
+
+    if (!success)
+    {
+        free(build.references);
+        return ISTATUS_ALLOCATION_FAILED;
     }
 
+    *references = build.references;
+    *num_references = build.references_size;
+
     return ISTATUS_SUCCESS;
 }
 
+//
+// Scene Defines
+//
+
+#define MAX_TREE_DEPTH 64
+
+//
+// Scene Types
+//
+
+typedef struct _BVH_SCENE {
+    PBVH_NODE nodes;
+    PBVH_COMPRESSED_NODE compressed_nodes;
+    BOUNDING_BOX root_bounds;
+    _Field_size_(num_shapes) PSHAPE *shapes;
+    _Field_size_opt_(num_shapes) PMATRIX *transforms;
+    _Field_size_opt_(num_shapes) bool *premultiplied;
+    size_t num_shapes;
+} BVH_SCENE, *PBVH_SCENE;
+
+typedef const BVH_SCENE *PCBVH_SCENE;
+
+//
+// Scene Static Functions
+//
+
 static
 ISTATUS
-BvhTransformedSceneTrace(
+BvhSceneTrace(
     _In_opt_ const void *context,
     _Inout_ PSHAPE_HIT_TESTER hit_tester,
     _In_ RAY ray
@@ -930,11 +1749,13 @@ BvhTransformedSceneTrace(
             {
                 PCSHAPE shape = bvh_scene->shapes[offset + i];
                 PCMATRIX matrix = bvh_scene->transforms[offset + i];
+                bool premultiplied = bvh_scene->premultiplied[offset + i];
                 ISTATUS status =
-                    ShapeHitTesterTestTransformedShapeWithLimit(hit_tester,
-                                                                shape,
-                                                                matrix,
-                                                                &closest_hit);
+                    ShapeHitTesterTestShapeWithLimit(hit_tester,
+                                                     shape,
+                                                     matrix,
+                                                     premultiplied,
+                                                     &closest_hit);
 
                 if (status != ISTATUS_SUCCESS)
                 {
@@ -957,7 +1778,7 @@ BvhTransformedSceneTrace(
 
 static
 ISTATUS
-BvhWorldSceneTrace(
+BvhTransformedSceneTrace(
     _In_opt_ const void *context,
     _Inout_ PSHAPE_HIT_TESTER hit_tester,
     _In_ RAY ray
@@ -999,10 +1820,12 @@ BvhWorldSceneTrace(
             for (size_t i = 0; i < current->num_shapes; i++)
             {
                 PCSHAPE shape = bvh_scene->shapes[offset + i];
+                PCMATRIX matrix = bvh_scene->transforms[offset + i];
                 ISTATUS status =
-                    ShapeHitTesterTestWorldShapeWithLimit(hit_tester,
-                                                          shape,
-                                                          &closest_hit);
+                    ShapeHitTesterTestTransformedShapeWithLimit(hit_tester,
+                                                                shape,
+                                                                matrix,
+                                                                &closest_hit);
 
                 if (status != ISTATUS_SUCCESS)
                 {
@@ -1024,7 +1847,166 @@ BvhWorldSceneTrace(
 }
 
 static
-void
+ISTATUS
+BvhWorldSceneTrace(
+    _In_opt_ const void *context,
+    _Inout_ PSHAPE_HIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    PCBVH_SCENE bvh_scene = (PCBVH_SCENE)context;
+
+    float_t closest_hit;
+    ShapeHitTesterFarthestHitAllowed(hit_tester, &closest_hit);
+
+    PCBVH_NODE work_list[MAX_TREE_DEPTH];
+    PCBVH_NODE current = bvh_scene->nodes;
+    size_t queue_size = 0;
+    for (;;)
+    {
+        float_t near, far;
+        if (BoundingBoxIntersect(current->bounds, ray, NULL, &near, &far) &&
+            near <= closest_hit &&
+            (float_t)0.0 <= far)
+        {
+            if (current->num_shapes == 0)
+            {
+                float_t direction =
+                    VectorGetElement(ray.direction, current->axis);
+                if (direction < (float_t)0.0)
+                {
+                    work_list[queue_size++] = current + 1;
+                    current = current + current->offset;
+                }
+                else
+                {
+                    work_list[queue_size++] = current + current->offset;
+                    current = current + 1;
+                }
+                continue;
+            }
+
+            size_t offset = current->offset;
+            for (size_t i = 0; i < current->num_shapes; i++)
+            {
+                PCSHAPE shape = bvh_scene->shapes[offset + i];
+                ISTATUS status =
+                    ShapeHitTesterTestWorldShapeWithLimit(hit_tester,
+                                                          shape,
+                                                          &closest_hit);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+        }
+
+        if (queue_size == 0)
+        {
+            break;
+        }
+
+        queue_size -= 1;
+        current = work_list[queue_size];
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+BvhCompressedSceneTrace(
+    _In_opt_ const void *context,
+    _Inout_ PSHAPE_HIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    PCBVH_SCENE bvh_scene = (PCBVH_SCENE)context;
+
+    float_t closest_hit;
+    ShapeHitTesterFarthestHitAllowed(hit_tester, &closest_hit);
+
+    PCBVH_COMPRESSED_NODE work_list[MAX_TREE_DEPTH];
+    BOUNDING_BOX parent_bounds_list[MAX_TREE_DEPTH];
+    PCBVH_COMPRESSED_NODE current = bvh_scene->compressed_nodes;
+    BOUNDING_BOX parent_bounds = bvh_scene->root_bounds;
+    size_t queue_size = 0;
+    for (;;)
+    {
+        BOUNDING_BOX bounds = BvhCompressedNodeDecodeBounds(current,
+                                                            parent_bounds);
+
+        float_t near, far;
+        if (BoundingBoxIntersect(bounds, ray, NULL, &near, &far) &&
+            near <= closest_hit &&
+            (float_t)0.0 <= far)
+        {
+            if (current->num_shapes == 0)
+            {
+                float_t direction =
+                    VectorGetElement(ray.direction, current->axis);
+                parent_bounds_list[queue_size] = bounds;
+                parent_bounds = bounds;
+                if (direction < (float_t)0.0)
+                {
+                    work_list[queue_size++] = current + 1;
+                    current = current + current->offset;
+                }
+                else
+                {
+                    work_list[queue_size++] = current + current->offset;
+                    current = current + 1;
+                }
+                continue;
+            }
+
+            size_t offset = current->offset;
+            for (size_t i = 0; i < current->num_shapes; i++)
+            {
+                PCSHAPE shape = bvh_scene->shapes[offset + i];
+
+                PCMATRIX matrix = NULL;
+                if (bvh_scene->transforms != NULL)
+                {
+                    matrix = bvh_scene->transforms[offset + i];
+                }
+
+                bool premultiplied = false;
+                if (bvh_scene->premultiplied != NULL)
+                {
+                    premultiplied = bvh_scene->premultiplied[offset + i];
+                }
+
+                ISTATUS status =
+                    ShapeHitTesterTestShapeWithLimit(hit_tester,
+                                                     shape,
+                                                     matrix,
+                                                     premultiplied,
+                                                     &closest_hit);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+        }
+
+        if (queue_size == 0)
+        {
+            break;
+        }
+
+        queue_size -= 1;
+        current = work_list[queue_size];
+        parent_bounds = parent_bounds_list[queue_size];
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+void
 BvhSceneFree(
     _In_opt_ _Post_invalid_ void *context
     )
@@ -1054,6 +2036,7 @@ BvhSceneFree(
     }
 
     free(bvh_scene->nodes);
+    free(bvh_scene->compressed_nodes);
 }
 
 //
@@ -1075,72 +2058,58 @@ static const SCENE_VTABLE bvh_world_scene_vtable = {
     BvhSceneFree
 };
 
+static const SCENE_VTABLE bvh_compressed_scene_vtable = {
+    BvhCompressedSceneTrace,
+    BvhSceneFree
+};
+
 //
-// Scene Functions
+// Scene Static Functions
 //
 
+static
 ISTATUS
-BvhSceneAllocate(
-    _In_reads_(num_shapes) const PSHAPE shapes[],
-    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
-    _In_reads_opt_(num_shapes) const bool premultiplied[],
+BvhSceneAllocateFromShapeBounds(
+    _Inout_ PNODE_BUILDER node_builder,
+    _In_reads_(num_shapes) PCSHAPE_BOUNDS shape_bounds,
     _In_ size_t num_shapes,
+    _In_ bool compressed,
     _In_opt_ PENVIRONMENTAL_LIGHT environment,
     _Out_ PSCENE *scene
     )
 {
-    if (shapes == NULL)
-    {
-        return ISTATUS_INVALID_ARGUMENT_00;
-    }
+    BVH_SCENE result;
+    result.root_bounds = node_builder->nodes[0].bounds;
 
-    for (size_t i = 0; i < num_shapes; i++)
+    if (compressed)
     {
-        if (shapes[i] == NULL)
-        {
-            return ISTATUS_INVALID_ARGUMENT_00;
-        }
-    }
+        bool success = BvhCompressNodes(node_builder->nodes,
+                                        node_builder->nodes_size,
+                                        &result.compressed_nodes);
 
-    if (scene == NULL)
-    {
-        return ISTATUS_INVALID_ARGUMENT_05;
-    }
+        NodeBuilderDestroy(node_builder);
 
-    NODE_BUILDER node_builder;
-    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+        if (!success)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
 
-    if (!success)
-    {
-        return ISTATUS_ALLOCATION_FAILED;
+        result.nodes = NULL;
     }
-
-    PSHAPE_BOUNDS shape_bounds;
-    ISTATUS status = BvhBuild(&node_builder,
-                              shapes,
-                              transforms,
-                              premultiplied,
-                              num_shapes,
-                              MAX_TREE_DEPTH,
-                              &shape_bounds);
-
-    if (status != ISTATUS_SUCCESS)
+    else
     {
-        NodeBuilderDestroy(&node_builder);
-        return status;
+        NodeBuilderResizeToFit(node_builder);
+        result.nodes = node_builder->nodes;
+        result.compressed_nodes = NULL;
     }
 
-    NodeBuilderResizeToFit(&node_builder);
-
-    BVH_SCENE result;
-    result.nodes = node_builder.nodes;
     result.shapes = calloc(num_shapes, sizeof(PSHAPE));
     result.num_shapes = num_shapes;
 
     if (result.shapes == NULL)
     {
-        free(shape_bounds);
-        NodeBuilderDestroy(&node_builder);
+        free(result.nodes);
+        free(result.compressed_nodes);
         return ISTATUS_ALLOCATION_FAILED;
     }
 
@@ -1150,28 +2119,22 @@ BvhSceneAllocate(
     }
 
     bool premultiply_needed = false;
-    if (premultiplied != NULL)
+    for (size_t i = 0; i < num_shapes; i++)
     {
-        for (size_t i = 0; i < num_shapes; i++)
+        if (shape_bounds[i].premultiplied)
         {
-            if (premultiplied[i])
-            {
-                premultiply_needed = true;
-                break;
-            }
+            premultiply_needed = true;
+            break;
         }
     }
 
     bool transform_needed = false;
-    if (transforms != NULL)
+    for (size_t i = 0; i < num_shapes; i++)
     {
-        for (size_t i = 0; i < num_shapes; i++)
+        if (shape_bounds[i].model_to_world != NULL)
         {
-            if (transforms[i] != NULL)
-            {
-                transform_needed = true;
-                break;
-            }
+            transform_needed = true;
+            break;
         }
     }
 
@@ -1191,8 +2154,8 @@ BvhSceneAllocate(
         if (result.transforms == NULL)
         {
             free(result.shapes);
-            free(shape_bounds);
-            NodeBuilderDestroy(&node_builder);
+            free(result.nodes);
+            free(result.compressed_nodes);
             return ISTATUS_ALLOCATION_FAILED;
         }
 
@@ -1212,8 +2175,8 @@ BvhSceneAllocate(
             free(result.shapes);
             free(result.transforms);
             free(result.premultiplied);
-            free(shape_bounds);
-            NodeBuilderDestroy(&node_builder);
+            free(result.nodes);
+            free(result.compressed_nodes);
             return ISTATUS_ALLOCATION_FAILED;
         }
 
@@ -1224,254 +2187,1915 @@ BvhSceneAllocate(
         }
     }
 
-    free(shape_bounds);
+    if (compressed)
+    {
+        vtable = &bvh_compressed_scene_vtable;
+    }
 
-    status = SceneAllocate(vtable,
-                           &result,
-                           sizeof(BVH_SCENE),
-                           alignof(BVH_SCENE),
-                           environment,
-                           scene);
+    ISTATUS status = SceneAllocate(vtable,
+                                   &result,
+                                   sizeof(BVH_SCENE),
+                                   alignof(BVH_SCENE),
+                                   environment,
+                                   scene);
 
     if (status != ISTATUS_SUCCESS)
     {
         free(result.shapes);
         free(result.transforms);
         free(result.premultiplied);
-        NodeBuilderDestroy(&node_builder);
+        free(result.nodes);
+        free(result.compressed_nodes);
         return status;
     }
 
     for (size_t i = 0; i < num_shapes; i++)
     {
-        ShapeRetain(shapes[i]);
+        ShapeRetain(result.shapes[i]);
     }
 
-    if (transform_needed)
+    if (result.transforms != NULL)
     {
         for (size_t i = 0; i < num_shapes; i++)
         {
-            MatrixRetain(transforms[i]);
+            MatrixRetain(result.transforms[i]);
         }
     }
 
     return ISTATUS_SUCCESS;
 }
 
-//
-// BVH Aggregate Type
-//
-
-typedef struct _BVH_AGGREGATE {
-    PBVH_NODE nodes;
-    _Field_size_(num_shapes) PSHAPE *shapes;
-    size_t num_shapes;
-} BVH_AGGREGATE, *PBVH_AGGREGATE;
-
-typedef const BVH_AGGREGATE *PCBVH_AGGREGATE;
-
-//
-// BVH Aggregate Static Functions
-//
-
 static
-inline
 ISTATUS
-BvhAggregateTraceShape(
-    _In_ PCSHAPE shape,
-    _In_ float_t minimum_distance,
-    _Inout_ float_t *maximum_distance,
-    _In_ PSHAPE_HIT_ALLOCATOR allocator,
-    _Out_ PHIT *hit_list,
-    _Out_ ISTATUS *return_status
+BvhSceneAllocateInternal(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_ bool compressed,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
     )
 {
-    PHIT hit;
-    ISTATUS status = ShapeHitTesterTestNestedShape(allocator,
-                                                   shape,
-                                                   minimum_distance,
-                                                   *maximum_distance,
+    if (shapes == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        if (shapes[i] == NULL)
+        {
+            return ISTATUS_INVALID_ARGUMENT_00;
+        }
+    }
+
+    if (scene == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    NODE_BUILDER node_builder;
+    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PSHAPE_BOUNDS shape_bounds;
+    ISTATUS status = BvhBuild(&node_builder,
+                              shapes,
+                              transforms,
+                              premultiplied,
+                              num_shapes,
+                              MAX_TREE_DEPTH,
+                              &shape_bounds);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        NodeBuilderDestroy(&node_builder);
+        return status;
+    }
+
+    status = BvhSceneAllocateFromShapeBounds(&node_builder,
+                                             shape_bounds,
+                                             num_shapes,
+                                             compressed,
+                                             environment,
+                                             scene);
+
+    free(shape_bounds);
+
+    return status;
+}
+
+//
+// Scene Functions
+//
+
+ISTATUS
+BvhSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    ISTATUS status = BvhSceneAllocateInternal(shapes,
+                                              transforms,
+                                              premultiplied,
+                                              num_shapes,
+                                              false,
+                                              environment,
+                                              scene);
+
+    return status;
+}
+
+ISTATUS
+BvhCompressedSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    ISTATUS status = BvhSceneAllocateInternal(shapes,
+                                              transforms,
+                                              premultiplied,
+                                              num_shapes,
+                                              true,
+                                              environment,
+                                              scene);
+
+    return status;
+}
+
+ISTATUS
+BvhSpatialSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_ float_t max_duplication,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    if (shapes == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        if (shapes[i] == NULL)
+        {
+            return ISTATUS_INVALID_ARGUMENT_00;
+        }
+    }
+
+    if (!isfinite(max_duplication) || max_duplication < (float_t)0.0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (scene == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_06;
+    }
+
+    NODE_BUILDER node_builder;
+    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PSHAPE_BOUNDS references;
+    size_t num_references;
+    ISTATUS status = BvhSpatialBuild(&node_builder,
+                                     shapes,
+                                     transforms,
+                                     premultiplied,
+                                     num_shapes,
+                                     max_duplication,
+                                     MAX_TREE_DEPTH,
+                                     &references,
+                                     &num_references);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        NodeBuilderDestroy(&node_builder);
+        return status;
+    }
+
+    status = BvhSceneAllocateFromShapeBounds(&node_builder,
+                                             references,
+                                             num_references,
+                                             false,
+                                             environment,
+                                             scene);
+
+    free(references);
+
+    return status;
+}
+
+//
+// Scene Builder Defines
+//
+
+#define SCENE_BUILDER_INITIAL_CAPACITY 1024
+#define SCENE_BUILDER_GROWTH_FACTOR 2
+
+//
+// Scene Builder Type
+//
+
+struct _BVH_SCENE_BUILDER {
+    _Field_size_(shape_bounds_capacity) PSHAPE_BOUNDS shape_bounds;
+    size_t shape_bounds_capacity;
+    size_t num_shapes;
+};
+
+//
+// Scene Builder Static Functions
+//
+
+static
+void
+BvhSceneBuilderClear(
+    _Inout_ PBVH_SCENE_BUILDER builder
+    )
+{
+    for (size_t i = 0; i < builder->num_shapes; i++)
+    {
+        ShapeRelease(builder->shape_bounds[i].shape);
+        MatrixRelease(builder->shape_bounds[i].model_to_world);
+    }
+
+    free(builder->shape_bounds);
+
+    builder->shape_bounds = NULL;
+    builder->shape_bounds_capacity = 0;
+    builder->num_shapes = 0;
+}
+
+static
+ISTATUS
+BvhSceneBuilderEnsureCapacity(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_ size_t num_shapes
+    )
+{
+    size_t required_capacity;
+    bool success = CheckedAddSizeT(builder->num_shapes,
+                                   num_shapes,
+                                   &required_capacity);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    if (required_capacity <= builder->shape_bounds_capacity)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    size_t new_capacity = builder->shape_bounds_capacity;
+    if (new_capacity == 0)
+    {
+        new_capacity = SCENE_BUILDER_INITIAL_CAPACITY;
+    }
+
+    while (new_capacity < required_capacity)
+    {
+        success = CheckedMultiplySizeT(new_capacity,
+                                       SCENE_BUILDER_GROWTH_FACTOR,
+                                       &new_capacity);
+
+        if (!success)
+        {
+            return ISTATUS_ALLOCATION_FAILED;
+        }
+    }
+
+    size_t bytes;
+    success = CheckedMultiplySizeT(new_capacity,
+                                   sizeof(SHAPE_BOUNDS),
+                                   &bytes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PSHAPE_BOUNDS new_shape_bounds =
+        (PSHAPE_BOUNDS)realloc(builder->shape_bounds, bytes);
+
+    if (new_shape_bounds == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    builder->shape_bounds = new_shape_bounds;
+    builder->shape_bounds_capacity = new_capacity;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+BvhSceneBuilderBuildInternal(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_ bool compressed,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    if (builder == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (scene == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    size_t num_shapes = builder->num_shapes;
+
+    //
+    // Release the slack left over from growing the bound records before the
+    // nodes are allocated alongside them.
+    //
+
+    if (num_shapes != 0 && num_shapes < builder->shape_bounds_capacity)
+    {
+        PSHAPE_BOUNDS shape_bounds =
+            (PSHAPE_BOUNDS)realloc(builder->shape_bounds,
+                                   num_shapes * sizeof(SHAPE_BOUNDS));
+
+        if (shape_bounds != NULL)
+        {
+            builder->shape_bounds = shape_bounds;
+            builder->shape_bounds_capacity = num_shapes;
+        }
+    }
+
+    NODE_BUILDER node_builder;
+    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    success = BvhBuildFromShapeBounds(&node_builder,
+                                      builder->shape_bounds,
+                                      num_shapes,
+                                      MAX_TREE_DEPTH);
+
+    if (!success)
+    {
+        NodeBuilderDestroy(&node_builder);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    ISTATUS status = BvhSceneAllocateFromShapeBounds(&node_builder,
+                                                     builder->shape_bounds,
+                                                     num_shapes,
+                                                     compressed,
+                                                     environment,
+                                                     scene);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    //
+    // The scene holds its own references, so the builder's references and
+    // bound records can be dropped.
+    //
+
+    BvhSceneBuilderClear(builder);
+
+    return ISTATUS_SUCCESS;
+}
+
+//
+// Scene Builder Functions
+//
+
+ISTATUS
+BvhSceneBuilderAllocate(
+    _Out_ PBVH_SCENE_BUILDER *builder
+    )
+{
+    if (builder == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    PBVH_SCENE_BUILDER result =
+        (PBVH_SCENE_BUILDER)malloc(sizeof(BVH_SCENE_BUILDER));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->shape_bounds = NULL;
+    result->shape_bounds_capacity = 0;
+    result->num_shapes = 0;
+
+    *builder = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+BvhSceneBuilderAddShapes(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes
+    )
+{
+    if (builder == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (shapes == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        if (shapes[i] == NULL)
+        {
+            return ISTATUS_INVALID_ARGUMENT_01;
+        }
+    }
+
+    ISTATUS status = BvhSceneBuilderEnsureCapacity(builder, num_shapes);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    PSHAPE_BOUNDS shape_bounds = builder->shape_bounds + builder->num_shapes;
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        PMATRIX matrix = (transforms != NULL) ? transforms[i] : NULL;
+        bool is_premultiplied =
+            (premultiplied != NULL) ? premultiplied[i] : false;
+
+        status = ShapeBoundsInitialize(shape_bounds + i,
+                                       shapes[i],
+                                       matrix,
+                                       is_premultiplied,
+                                       builder->num_shapes + i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        ShapeRetain(shape_bounds[i].shape);
+        MatrixRetain(shape_bounds[i].model_to_world);
+    }
+
+    builder->num_shapes += num_shapes;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+BvhSceneBuilderBuild(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    ISTATUS status = BvhSceneBuilderBuildInternal(builder,
+                                                  false,
+                                                  environment,
+                                                  scene);
+
+    return status;
+}
+
+ISTATUS
+BvhSceneBuilderBuildCompressed(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    ISTATUS status = BvhSceneBuilderBuildInternal(builder,
+                                                  true,
+                                                  environment,
+                                                  scene);
+
+    return status;
+}
+
+void
+BvhSceneBuilderFree(
+    _In_opt_ _Post_invalid_ PBVH_SCENE_BUILDER builder
+    )
+{
+    if (builder == NULL)
+    {
+        return;
+    }
+
+    BvhSceneBuilderClear(builder);
+    free(builder);
+}
+
+//
+// BVH Motion Scene Types
+//
+
+typedef struct _BVH_MOTION_SCENE {
+    _Field_size_(num_nodes) PBVH_NODE nodes;
+    _Field_size_(num_nodes * 2) PBOUNDING_BOX node_bounds;
+    size_t num_nodes;
+    _Field_size_(num_shapes) PSHAPE *shapes;
+    _Field_size_(num_shapes) PMATRIX *transforms0;
+    _Field_size_(num_shapes) PMATRIX *transforms1;
+    size_t num_shapes;
+    float_t time0;
+    float_t inverse_time_delta;
+} BVH_MOTION_SCENE, *PBVH_MOTION_SCENE;
+
+typedef const BVH_MOTION_SCENE *PCBVH_MOTION_SCENE;
+
+//
+// BVH Motion Scene Static Functions
+//
+
+static
+bool
+BvhMotionSceneValidateTransform(
+    _In_opt_ PCMATRIX transform
+    )
+{
+    float_t contents[4][4];
+    ISTATUS status = MatrixReadContents(transform, contents);
+    assert(status == ISTATUS_SUCCESS);
+
+    return contents[3][0] == (float_t)0.0 &&
+           contents[3][1] == (float_t)0.0 &&
+           contents[3][2] == (float_t)0.0 &&
+           contents[3][3] == (float_t)1.0;
+}
+
+static
+void
+BvhMotionSceneComputeNodeBounds(
+    _Inout_ PBVH_MOTION_SCENE motion_scene,
+    _In_reads_(motion_scene->num_shapes) PCSHAPE_BOUNDS shape_bounds,
+    _In_reads_(motion_scene->num_shapes * 2) PCBOUNDING_BOX keyframe_bounds
+    )
+{
+    //
+    // Children are always stored after their parent, so walking the nodes in
+    // reverse visits every child before its parent.
+    //
+
+    for (size_t i = motion_scene->num_nodes; i != 0; i--)
+    {
+        size_t node_index = i - 1;
+        PCBVH_NODE node = motion_scene->nodes + node_index;
+        PBOUNDING_BOX bounds = motion_scene->node_bounds + 2 * node_index;
+
+        if (node->num_shapes == 0)
+        {
+            PCBOUNDING_BOX below = bounds + 2;
+            PCBOUNDING_BOX above = bounds + 2 * node->offset;
+            bounds[0] = BoundingBoxUnion(below[0], above[0]);
+            bounds[1] = BoundingBoxUnion(below[1], above[1]);
+            continue;
+        }
+
+        size_t shape_index = shape_bounds[node->offset].index;
+        bounds[0] = keyframe_bounds[2 * shape_index];
+        bounds[1] = keyframe_bounds[2 * shape_index + 1];
+
+        for (size_t j = 1; j < node->num_shapes; j++)
+        {
+            shape_index = shape_bounds[node->offset + j].index;
+            bounds[0] = BoundingBoxUnion(bounds[0],
+                                         keyframe_bounds[2 * shape_index]);
+            bounds[1] = BoundingBoxUnion(bounds[1],
+                                         keyframe_bounds[2 * shape_index + 1]);
+        }
+    }
+}
+
+static
+ISTATUS
+BvhMotionSceneTrace(
+    _In_opt_ const void *context,
+    _Inout_ PSHAPE_HIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    PCBVH_MOTION_SCENE motion_scene = (PCBVH_MOTION_SCENE)context;
+
+    float_t time;
+    ShapeHitTesterGetTime(hit_tester, &time);
+
+    float_t weight =
+        (time - motion_scene->time0) * motion_scene->inverse_time_delta;
+    weight = IMax((float_t)0.0, IMin(weight, (float_t)1.0));
+
+    float_t closest_hit;
+    ShapeHitTesterFarthestHitAllowed(hit_tester, &closest_hit);
+
+    PCBVH_NODE work_list[MAX_TREE_DEPTH];
+    PCBVH_NODE current = motion_scene->nodes;
+    size_t queue_size = 0;
+    for (;;)
+    {
+        size_t node_index = (size_t)(current - motion_scene->nodes);
+        PCBOUNDING_BOX keyframes = motion_scene->node_bounds + 2 * node_index;
+        BOUNDING_BOX bounds =
+            BoundingBoxInterpolate(keyframes[0], keyframes[1], weight);
+
+        float_t near, far;
+        if (BoundingBoxIntersect(bounds, ray, NULL, &near, &far) &&
+            near <= closest_hit &&
+            (float_t)0.0 <= far)
+        {
+            if (current->num_shapes == 0)
+            {
+                float_t direction =
+                    VectorGetElement(ray.direction, current->axis);
+                if (direction < (float_t)0.0)
+                {
+                    work_list[queue_size++] = current + 1;
+                    current = current + current->offset;
+                }
+                else
+                {
+                    work_list[queue_size++] = current + current->offset;
+                    current = current + 1;
+                }
+                continue;
+            }
+
+            size_t offset = current->offset;
+            for (size_t i = 0; i < current->num_shapes; i++)
+            {
+                PCSHAPE shape = motion_scene->shapes[offset + i];
+                PCMATRIX matrix0 = motion_scene->transforms0[offset + i];
+                PCMATRIX matrix1 = motion_scene->transforms1[offset + i];
+                ISTATUS status =
+                    ShapeHitTesterTestInterpolatedShapeWithLimit(hit_tester,
+                                                                 shape,
+                                                                 matrix0,
+                                                                 matrix1,
+                                                                 weight,
+                                                                 &closest_hit);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+        }
+
+        if (queue_size == 0)
+        {
+            break;
+        }
+
+        queue_size -= 1;
+        current = work_list[queue_size];
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+void
+BvhMotionSceneFree(
+    _In_opt_ _Post_invalid_ void *context
+    )
+{
+    PBVH_MOTION_SCENE motion_scene = (PBVH_MOTION_SCENE)context;
+
+    for (size_t i = 0; i < motion_scene->num_shapes; i++)
+    {
+        ShapeRelease(motion_scene->shapes[i]);
+        MatrixRelease(motion_scene->transforms0[i]);
+        MatrixRelease(motion_scene->transforms1[i]);
+    }
+
+    free(motion_scene->shapes);
+    free(motion_scene->transforms0);
+    free(motion_scene->transforms1);
+    free(motion_scene->node_bounds);
+    free(motion_scene->nodes);
+}
+
+//
+// BVH Motion Scene Static Data
+//
+
+static const SCENE_VTABLE bvh_motion_scene_vtable = {
+    BvhMotionSceneTrace,
+    BvhMotionSceneFree
+};
+
+//
+// BVH Motion Scene Functions
+//
+
+ISTATUS
+BvhMotionSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms0[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms1[],
+    _In_ size_t num_shapes,
+    _In_ float_t time0,
+    _In_ float_t time1,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    if (shapes == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        if (shapes[i] == NULL)
+        {
+            return ISTATUS_INVALID_ARGUMENT_00;
+        }
+    }
+
+    if (transforms0 != NULL)
+    {
+        for (size_t i = 0; i < num_shapes; i++)
+        {
+            if (!BvhMotionSceneValidateTransform(transforms0[i]))
+            {
+                return ISTATUS_INVALID_ARGUMENT_01;
+            }
+        }
+    }
+
+    if (transforms1 != NULL)
+    {
+        for (size_t i = 0; i < num_shapes; i++)
+        {
+            if (!BvhMotionSceneValidateTransform(transforms1[i]))
+            {
+                return ISTATUS_INVALID_ARGUMENT_02;
+            }
+        }
+    }
+
+    if (!isfinite(time0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_04;
+    }
+
+    if (!isfinite(time1))
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    if (scene == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_07;
+    }
+
+    if (time1 <= time0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_COMBINATION_00;
+    }
+
+    BVH_MOTION_SCENE result;
+    result.shapes = calloc(num_shapes, sizeof(PSHAPE));
+    result.transforms0 = calloc(num_shapes, sizeof(PMATRIX));
+    result.transforms1 = calloc(num_shapes, sizeof(PMATRIX));
+    result.num_shapes = num_shapes;
+    result.time0 = time0;
+    result.inverse_time_delta = (float_t)1.0 / (time1 - time0);
+
+    PSHAPE_BOUNDS shape_bounds = calloc(num_shapes, sizeof(SHAPE_BOUNDS));
+    PBOUNDING_BOX keyframe_bounds = calloc(num_shapes, 2 * sizeof(BOUNDING_BOX));
+
+    if (result.shapes == NULL ||
+        result.transforms0 == NULL ||
+        result.transforms1 == NULL ||
+        shape_bounds == NULL ||
+        keyframe_bounds == NULL)
+    {
+        free(result.shapes);
+        free(result.transforms0);
+        free(result.transforms1);
+        free(shape_bounds);
+        free(keyframe_bounds);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    //
+    // Interpolating the transforms component-wise moves every model space
+    // point linearly between its positions at the two keyframes, so the
+    // bounds interpolated between the keyframe bounds contain the shape at
+    // every time in between.
+    //
+
+    ISTATUS status = ISTATUS_SUCCESS;
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        PMATRIX matrix0 = (transforms0 != NULL) ? transforms0[i] : NULL;
+        PMATRIX matrix1 = (transforms1 != NULL) ? transforms1[i] : NULL;
+
+        status = ShapeComputeBounds(shapes[i],
+                                    matrix0,
+                                    keyframe_bounds + 2 * i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            break;
+        }
+
+        status = ShapeComputeBounds(shapes[i],
+                                    matrix1,
+                                    keyframe_bounds + 2 * i + 1);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            break;
+        }
+
+        BOUNDING_BOX swept_bounds = BoundingBoxUnion(keyframe_bounds[2 * i],
+                                                     keyframe_bounds[2 * i + 1]);
+        ShapeBoundsInitializeWithBounds(shape_bounds + i,
+                                        swept_bounds,
+                                        shapes[i],
+                                        matrix0,
+                                        false,
+                                        i);
+    }
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        free(result.shapes);
+        free(result.transforms0);
+        free(result.transforms1);
+        free(shape_bounds);
+        free(keyframe_bounds);
+        return status;
+    }
+
+    NODE_BUILDER node_builder;
+    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+
+    if (success)
+    {
+        success = BvhBuildFromShapeBounds(&node_builder,
+                                          shape_bounds,
+                                          num_shapes,
+                                          MAX_TREE_DEPTH);
+
+        if (!success)
+        {
+            NodeBuilderDestroy(&node_builder);
+        }
+    }
+
+    if (!success)
+    {
+        free(result.shapes);
+        free(result.transforms0);
+        free(result.transforms1);
+        free(shape_bounds);
+        free(keyframe_bounds);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    NodeBuilderResizeToFit(&node_builder);
+
+    result.nodes = node_builder.nodes;
+    result.num_nodes = node_builder.nodes_size;
+    result.node_bounds = calloc(result.num_nodes, 2 * sizeof(BOUNDING_BOX));
+
+    if (result.node_bounds == NULL)
+    {
+        free(result.shapes);
+        free(result.transforms0);
+        free(result.transforms1);
+        free(shape_bounds);
+        free(keyframe_bounds);
+        NodeBuilderDestroy(&node_builder);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    BvhMotionSceneComputeNodeBounds(&result, shape_bounds, keyframe_bounds);
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        size_t index = shape_bounds[i].index;
+        result.shapes[i] = shapes[index];
+        result.transforms0[i] = (transforms0 != NULL) ? transforms0[index] : NULL;
+        result.transforms1[i] = (transforms1 != NULL) ? transforms1[index] : NULL;
+    }
+
+    free(shape_bounds);
+    free(keyframe_bounds);
+
+    status = SceneAllocate(&bvh_motion_scene_vtable,
+                           &result,
+                           sizeof(BVH_MOTION_SCENE),
+                           alignof(BVH_MOTION_SCENE),
+                           environment,
+                           scene);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        free(result.shapes);
+        free(result.transforms0);
+        free(result.transforms1);
+        free(result.node_bounds);
+        NodeBuilderDestroy(&node_builder);
+        return status;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
+    {
+        ShapeRetain(result.shapes[i]);
+        MatrixRetain(result.transforms0[i]);
+        MatrixRetain(result.transforms1[i]);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+//
+// BVH Aggregate Type
+//
+
+typedef struct _BVH_AGGREGATE {
+    PBVH_NODE nodes;
+    _Field_size_(num_shapes) PSHAPE *shapes;
+    size_t num_shapes;
+} BVH_AGGREGATE, *PBVH_AGGREGATE;
+
+typedef const BVH_AGGREGATE *PCBVH_AGGREGATE;
+
+//
+// BVH Aggregate Static Functions
+//
+
+static
+inline
+ISTATUS
+BvhAggregateTraceShape(
+    _In_ PCSHAPE shape,
+    _In_ float_t minimum_distance,
+    _Inout_ float_t *maximum_distance,
+    _In_ PSHAPE_HIT_ALLOCATOR allocator,
+    _Out_ PHIT *hit_list,
+    _Out_ ISTATUS *return_status
+    )
+{
+    PHIT hit;
+    ISTATUS status = ShapeHitTesterTestNestedShape(allocator,
+                                                   shape,
+                                                   minimum_distance,
+                                                   *maximum_distance,
                                                    &hit);
 
-    if (status == ISTATUS_NO_INTERSECTION)
+    if (status == ISTATUS_NO_INTERSECTION)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    while (hit != NULL)
+    {
+        if (minimum_distance < hit->distance &&
+            hit->distance < *maximum_distance)
+        {
+            *maximum_distance = hit->distance;
+            *hit_list = hit;
+            *return_status = ISTATUS_SUCCESS;
+        }
+
+        hit = hit->next;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+BvhAggregateTrace(
+    _In_ const void *context,
+    _In_ PCRAY ray_ptr,
+    _In_ float_t minimum_distance,
+    _In_ float_t maximum_distance,
+    _In_ PSHAPE_HIT_ALLOCATOR allocator,
+    _Out_ PHIT *hit
+    )
+{
+    PCBVH_AGGREGATE aggregate = (PCBVH_AGGREGATE)context;
+
+    RAY ray = *ray_ptr;
+    ISTATUS return_status = ISTATUS_NO_INTERSECTION;
+    PCBVH_NODE work_list[MAX_TREE_DEPTH];
+    PCBVH_NODE current = aggregate->nodes;
+    size_t queue_size = 0;
+    for (;;)
+    {
+        float_t near, far;
+        if (BoundingBoxIntersect(current->bounds, ray, NULL, &near, &far) &&
+            near <= maximum_distance &&
+            minimum_distance <= far)
+        {
+            if (current->num_shapes == 0)
+            {
+                float_t direction =
+                    VectorGetElement(ray.direction, current->axis);
+                if (direction < (float_t)0.0)
+                {
+                    work_list[queue_size++] = current + 1;
+                    current = current + current->offset;
+                }
+                else
+                {
+                    work_list[queue_size++] = current + current->offset;
+                    current = current + 1;
+                }
+                continue;
+            }
+
+            size_t offset = current->offset;
+            for (size_t i = 0; i < current->num_shapes; i++)
+            {
+                PCSHAPE shape = aggregate->shapes[offset + i];
+                ISTATUS status =
+                    BvhAggregateTraceShape(shape,
+                                           minimum_distance,
+                                           &maximum_distance,
+                                           allocator,
+                                           hit,
+                                           &return_status);
+
+                if (status != ISTATUS_SUCCESS)
+                {
+                    return status;
+                }
+            }
+        }
+
+        if (queue_size == 0)
+        {
+            break;
+        }
+
+        queue_size -= 1;
+        current = work_list[queue_size];
+    }
+
+    return return_status;
+}
+
+static
+ISTATUS
+BvhAggregateComputeBounds(
+    _In_ const void *context,
+    _In_opt_ PCMATRIX model_to_world,
+    _Out_ PBOUNDING_BOX world_bounds
+    )
+{
+    PCBVH_AGGREGATE aggregate = (PCBVH_AGGREGATE)context;
+
+    if (model_to_world == NULL)
+    {
+        *world_bounds = aggregate->nodes[0].bounds;
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = ShapeComputeBounds(aggregate->shapes[0],
+                                        model_to_world,
+                                        world_bounds);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t i = 1; i < aggregate->num_shapes; i++)
+    {
+        BOUNDING_BOX bounds;
+        status = ShapeComputeBounds(aggregate->shapes[i],
+                                    model_to_world,
+                                    &bounds);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        *world_bounds = BoundingBoxUnion(*world_bounds, bounds);
+    }
+
+    return status;
+}
+
+static
+void
+BvhAggregateFree(
+    _In_opt_ _Post_invalid_ void *context
+    )
+{
+    PCBVH_AGGREGATE aggregate = (PCBVH_AGGREGATE)context;
+
+    for (size_t i = 0; i < aggregate->num_shapes; i++)
+    {
+        ShapeRelease(aggregate->shapes[i]);
+    }
+
+    free(aggregate->shapes);
+    free(aggregate->nodes);
+}
+
+//
+// BVH Aggregate Static Data
+//
+
+static const SHAPE_VTABLE bvh_aggregate_vtable = {
+    BvhAggregateTrace,
+    BvhAggregateComputeBounds,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    BvhAggregateFree,
+    NULL
+};
+
+//
+// BVH Aggregate Functions
+//
+
+ISTATUS
+BvhAggregateAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_ size_t num_shapes,
+    _Out_ PSHAPE *aggregate
+    )
+{
+    if (shapes == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (num_shapes == 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (aggregate == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    NODE_BUILDER node_builder;
+    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    PSHAPE_BOUNDS shape_bounds;
+    ISTATUS status = BvhBuild(&node_builder,
+                              shapes,
+                              NULL,
+                              NULL,
+                              num_shapes,
+                              MAX_TREE_DEPTH,
+                              &shape_bounds);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        NodeBuilderDestroy(&node_builder);
+        return status;
+    }
+
+    NodeBuilderResizeToFit(&node_builder);
+
+    BVH_AGGREGATE result;
+    result.nodes = node_builder.nodes;
+    result.shapes = calloc(num_shapes, sizeof(PSHAPE));
+    result.num_shapes = num_shapes;
+
+    if (result.shapes == NULL)
+    {
+        free(shape_bounds);
+        NodeBuilderDestroy(&node_builder);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    for (size_t i = 0; i < num_shapes; i++)
     {
-        return ISTATUS_SUCCESS;
+        result.shapes[i] = shape_bounds[i].shape;
     }
 
+    free(shape_bounds);
+
+    status = ShapeAllocate(&bvh_aggregate_vtable,
+                           &result,
+                           sizeof(BVH_AGGREGATE),
+                           alignof(BVH_AGGREGATE),
+                           aggregate);
+
     if (status != ISTATUS_SUCCESS)
     {
+        free(result.shapes);
+        NodeBuilderDestroy(&node_builder);
         return status;
     }
 
-    while (hit != NULL)
+    for (size_t i = 0; i < num_shapes; i++)
     {
-        if (minimum_distance < hit->distance &&
-            hit->distance < *maximum_distance)
+        ShapeRetain(shapes[i]);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+//
+// BVH Instances Defines
+//
+
+#define REFIT_NODES_PER_THREAD 1024
+#define REFIT_SUBTREES_PER_THREAD 4
+
+//
+// BVH Instances Types
+//
+
+struct _BVH_INSTANCES {
+    _Field_size_(num_nodes) PBVH_NODE nodes;
+    size_t num_nodes;
+    _Field_size_(max_nodes) float_t *build_areas;
+    _Field_size_(max_nodes) float_t *costs;
+    _Field_size_(max_nodes) float_t *build_costs;
+    size_t max_nodes;
+    _Field_size_(num_instances) PSHAPE *shapes;
+    _Field_size_(num_instances) PMATRIX *transforms;
+    _Field_size_(num_instances) PBOUNDING_BOX model_bounds;
+    _Field_size_(num_instances) size_t *slots;
+    size_t num_instances;
+    atomic_uintmax_t reference_count;
+};
+
+typedef struct _BVH_INSTANCES_SCENE {
+    PBVH_INSTANCES instances;
+} BVH_INSTANCES_SCENE, *PBVH_INSTANCES_SCENE;
+
+typedef const BVH_INSTANCES_SCENE *PCBVH_INSTANCES_SCENE;
+
+typedef struct _BVH_INSTANCES_REFIT {
+    PBVH_INSTANCES instances;
+    _Field_size_(num_subtrees) size_t *subtrees;
+    size_t num_subtrees;
+    atomic_size_t next_subtree;
+} BVH_INSTANCES_REFIT, *PBVH_INSTANCES_REFIT;
+
+typedef struct _BVH_INSTANCES_REBUILD {
+    PCBVH_INSTANCES instances;
+    float_t max_cost_growth;
+    NODE_BUILDER node_builder;
+    _Field_size_(instances->max_nodes) float_t *build_areas;
+    _Field_size_(instances->num_instances) PSHAPE_BOUNDS shape_bounds;
+    _Field_size_(instances->num_instances) PSHAPE *shapes;
+    _Field_size_(instances->num_instances) PMATRIX *transforms;
+    _Field_size_(instances->num_instances) PBOUNDING_BOX model_bounds;
+    _Field_size_(instances->num_instances) size_t *slots;
+    _Field_size_(instances->num_instances) size_t *instance_indices;
+} BVH_INSTANCES_REBUILD, *PBVH_INSTANCES_REBUILD;
+
+//
+// BVH Instances Static Functions
+//
+
+static
+void
+BvhInstancesFree(
+    _In_ _Post_invalid_ PBVH_INSTANCES instances
+    )
+{
+    if (instances->shapes != NULL)
+    {
+        for (size_t i = 0; i < instances->num_instances; i++)
         {
-            *maximum_distance = hit->distance;
-            *hit_list = hit;
-            *return_status = ISTATUS_SUCCESS;
+            ShapeRelease(instances->shapes[i]);
         }
+    }
 
-        hit = hit->next;
+    if (instances->transforms != NULL)
+    {
+        for (size_t i = 0; i < instances->num_instances; i++)
+        {
+            MatrixRelease(instances->transforms[i]);
+        }
     }
 
-    return ISTATUS_SUCCESS;
+    free(instances->shapes);
+    free(instances->transforms);
+    free(instances->model_bounds);
+    free(instances->slots);
+    free(instances->build_areas);
+    free(instances->costs);
+    free(instances->build_costs);
+    free(instances->nodes);
+    free(instances);
 }
 
 static
-ISTATUS
-BvhAggregateTrace(
-    _In_ const void *context,
-    _In_ PCRAY ray_ptr,
-    _In_ float_t minimum_distance,
-    _In_ float_t maximum_distance,
-    _In_ PSHAPE_HIT_ALLOCATOR allocator,
-    _Out_ PHIT *hit
+inline
+BOUNDING_BOX
+BvhInstancesComputeBounds(
+    _In_ PCBVH_INSTANCES instances,
+    _In_ size_t slot
     )
 {
-    PCBVH_SCENE bvh_scene = (PCBVH_SCENE)context;
+    return BoundingBoxTransform(instances->transforms[slot],
+                                instances->model_bounds[slot]);
+}
+
+static
+size_t
+BvhInstancesSubtreeEnd(
+    _In_ PCBVH_INSTANCES instances,
+    _In_ size_t node_index
+    )
+{
+    PCBVH_NODE node = instances->nodes + node_index;
+    while (node->num_shapes == 0)
+    {
+        node += node->offset;
+    }
+
+    return (size_t)(node - instances->nodes) + 1;
+}
+
+static
+void
+BvhInstancesRefitNode(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ size_t node_index
+    )
+{
+    PBVH_NODE node = instances->nodes + node_index;
+    float_t build_area = instances->build_areas[node_index];
+
+    if (node->num_shapes == 0)
+    {
+        size_t below = node_index + 1;
+        size_t above = node_index + node->offset;
+
+        node->bounds = BoundingBoxUnion(instances->nodes[below].bounds,
+                                        instances->nodes[above].bounds);
+        instances->costs[node_index] = BoundingBoxSurfaceArea(node->bounds) +
+                                       instances->costs[below] +
+                                       instances->costs[above];
+        instances->build_costs[node_index] = build_area +
+                                             instances->build_costs[below] +
+                                             instances->build_costs[above];
+        return;
+    }
+
+    size_t offset = node->offset;
+    BOUNDING_BOX bounds = BvhInstancesComputeBounds(instances, offset);
+    for (size_t i = 1; i < node->num_shapes; i++)
+    {
+        BOUNDING_BOX instance_bounds =
+            BvhInstancesComputeBounds(instances, offset + i);
+        bounds = BoundingBoxUnion(bounds, instance_bounds);
+    }
+
+    node->bounds = bounds;
+    instances->costs[node_index] = BvhComputeNodeCost(bounds,
+                                                      node->num_shapes);
+    instances->build_costs[node_index] =
+        (float_t)node->num_shapes * build_area;
+}
+
+static
+void
+BvhInstancesRefitSubtree(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ size_t node_index
+    )
+{
+    //
+    // Children are always stored after their parent, so walking the nodes of
+    // a subtree in reverse visits every child before its parent.
+    //
+
+    size_t end = BvhInstancesSubtreeEnd(instances, node_index);
+    for (size_t i = end; i != node_index; i--)
+    {
+        BvhInstancesRefitNode(instances, i - 1);
+    }
+}
+
+static
+int
+BvhInstancesRefitThread(
+    _Inout_ void *context
+    )
+{
+    PBVH_INSTANCES_REFIT refit = (PBVH_INSTANCES_REFIT)context;
 
-    RAY ray = *ray_ptr;
-    ISTATUS return_status = ISTATUS_NO_INTERSECTION;
-    PCBVH_NODE work_list[MAX_TREE_DEPTH];
-    PCBVH_NODE current = bvh_scene->nodes;
-    size_t queue_size = 0;
     for (;;)
     {
-        float_t near, far;
-        if (BoundingBoxIntersect(current->bounds, ray, NULL, &near, &far) &&
-            near <= maximum_distance &&
-            minimum_distance <= far)
+        size_t index = atomic_fetch_add(&refit->next_subtree, 1);
+
+        if (refit->num_subtrees <= index)
         {
-            if (current->num_shapes == 0)
+            break;
+        }
+
+        BvhInstancesRefitSubtree(refit->instances, refit->subtrees[index]);
+    }
+
+    return 0;
+}
+
+static
+ISTATUS
+BvhInstancesRefitParallel(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ size_t num_threads
+    )
+{
+    assert(1 < num_threads);
+
+    size_t desired_subtrees = num_threads * REFIT_SUBTREES_PER_THREAD;
+    size_t *subtrees = (size_t*)calloc(2 * desired_subtrees, sizeof(size_t));
+    size_t *next = (size_t*)calloc(2 * desired_subtrees, sizeof(size_t));
+    size_t *parents = (size_t*)calloc(2 * desired_subtrees, sizeof(size_t));
+    thrd_t *threads = (thrd_t*)calloc(num_threads - 1, sizeof(thrd_t));
+
+    if (subtrees == NULL || next == NULL || parents == NULL || threads == NULL)
+    {
+        free(subtrees);
+        free(next);
+        free(parents);
+        free(threads);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    //
+    // Split the top of the tree one level at a time until there are enough
+    // independent subtrees to keep every thread busy. The interior nodes
+    // which are split are refit afterwards, deepest level first.
+    //
+
+    size_t num_subtrees = 1;
+    size_t num_parents = 0;
+    subtrees[0] = 0;
+
+    bool split = true;
+    while (split && num_subtrees < desired_subtrees)
+    {
+        split = false;
+
+        size_t num_next = 0;
+        for (size_t i = 0; i < num_subtrees; i++)
+        {
+            PCBVH_NODE node = instances->nodes + subtrees[i];
+
+            if (node->num_shapes != 0)
             {
-                float_t direction =
-                    VectorGetElement(ray.direction, current->axis);
-                if (direction < (float_t)0.0)
-                {
-                    work_list[queue_size++] = current + 1;
-                    current = current + current->offset;
-                }
-                else
-                {
-                    work_list[queue_size++] = current + current->offset;
-                    current = current + 1;
-                }
+                next[num_next++] = subtrees[i];
                 continue;
             }
 
-            size_t offset = current->offset;
-            for (size_t i = 0; i < current->num_shapes; i++)
-            {
-                PCSHAPE shape = bvh_scene->shapes[offset + i];
-                ISTATUS status =
-                    BvhAggregateTraceShape(shape,
-                                           minimum_distance,
-                                           &maximum_distance,
-                                           allocator,
-                                           hit,
-                                           &return_status);
-
-                if (status != ISTATUS_SUCCESS)
-                {
-                    return status;
-                }
-            }
+            parents[num_parents++] = subtrees[i];
+            next[num_next++] = subtrees[i] + 1;
+            next[num_next++] = subtrees[i] + node->offset;
+            split = true;
         }
 
-        if (queue_size == 0)
+        size_t *tmp = subtrees;
+        subtrees = next;
+        next = tmp;
+        num_subtrees = num_next;
+    }
+
+    BVH_INSTANCES_REFIT refit;
+    refit.instances = instances;
+    refit.subtrees = subtrees;
+    refit.num_subtrees = num_subtrees;
+    refit.next_subtree = 0;
+
+    size_t threads_started = 0;
+    for (size_t i = 0; i < num_threads - 1; i++)
+    {
+        int success = thrd_create(threads + i,
+                                  BvhInstancesRefitThread,
+                                  &refit);
+
+        if (success != thrd_success)
         {
             break;
         }
 
-        queue_size -= 1;
-        current = work_list[queue_size];
+        threads_started += 1;
+    }
+
+    BvhInstancesRefitThread(&refit);
+
+    for (size_t i = 0; i < threads_started; i++)
+    {
+        thrd_join(threads[i], NULL);
+    }
+
+    for (size_t i = num_parents; i != 0; i--)
+    {
+        BvhInstancesRefitNode(instances, parents[i - 1]);
+    }
+
+    free(subtrees);
+    free(next);
+    free(parents);
+    free(threads);
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+bool
+BvhInstancesRebuildSubtree(
+    _Inout_ PBVH_INSTANCES_REBUILD rebuild,
+    _In_ size_t old_index,
+    _In_ size_t depth_remaining,
+    _Out_ size_t *new_index
+    )
+{
+    PCBVH_INSTANCES instances = rebuild->instances;
+
+    PCBVH_NODE first_leaf = instances->nodes + old_index;
+    while (first_leaf->num_shapes == 0)
+    {
+        first_leaf += 1;
+    }
+
+    size_t end = BvhInstancesSubtreeEnd(instances, old_index);
+    PCBVH_NODE last_leaf = instances->nodes + end - 1;
+
+    size_t first_slot = first_leaf->offset;
+    size_t num_slots = last_leaf->offset + last_leaf->num_shapes - first_slot;
+
+    for (size_t i = 0; i < num_slots; i++)
+    {
+        size_t slot = first_slot + i;
+        BOUNDING_BOX world_bounds = BvhInstancesComputeBounds(instances, slot);
+        ShapeBoundsInitializeWithBounds(rebuild->shape_bounds + i,
+                                        world_bounds,
+                                        instances->shapes[slot],
+                                        instances->transforms[slot],
+                                        false,
+                                        slot);
+    }
+
+    size_t first_node = rebuild->node_builder.nodes_size;
+    bool success = BvhBuildImpl(&rebuild->node_builder,
+                                instances->nodes[old_index].bounds,
+                                rebuild->shape_bounds,
+                                num_slots,
+                                first_slot,
+                                depth_remaining,
+                                new_index);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    for (size_t i = first_node; i < rebuild->node_builder.nodes_size; i++)
+    {
+        rebuild->build_areas[i] =
+            BoundingBoxSurfaceArea(rebuild->node_builder.nodes[i].bounds);
+    }
+
+    for (size_t i = 0; i < num_slots; i++)
+    {
+        size_t old_slot = rebuild->shape_bounds[i].index;
+        size_t new_slot = first_slot + i;
+        size_t instance = rebuild->instance_indices[old_slot];
+
+        rebuild->shapes[new_slot] = instances->shapes[old_slot];
+        rebuild->transforms[new_slot] = instances->transforms[old_slot];
+        rebuild->model_bounds[new_slot] = instances->model_bounds[old_slot];
+        rebuild->slots[instance] = new_slot;
+    }
+
+    return true;
+}
+
+static
+bool
+BvhInstancesRebuildImpl(
+    _Inout_ PBVH_INSTANCES_REBUILD rebuild,
+    _In_ size_t old_index,
+    _In_ size_t depth_remaining,
+    _Out_ size_t *new_index
+    )
+{
+    PCBVH_INSTANCES instances = rebuild->instances;
+    PCBVH_NODE node = instances->nodes + old_index;
+    float_t growth = rebuild->max_cost_growth;
+
+    if (node->num_shapes != 0 ||
+        instances->costs[old_index] <=
+            growth * instances->build_costs[old_index])
+    {
+        size_t end = BvhInstancesSubtreeEnd(instances, old_index);
+        for (size_t i = old_index; i < end; i++)
+        {
+            size_t index;
+            bool success = NodeBuilderAllocateNode(&rebuild->node_builder,
+                                                   &index);
+
+            if (!success)
+            {
+                return false;
+            }
+
+            if (i == old_index)
+            {
+                *new_index = index;
+            }
+
+            rebuild->node_builder.nodes[index] = instances->nodes[i];
+            rebuild->build_areas[index] = instances->build_areas[i];
+        }
+
+        return true;
+    }
+
+    //
+    // A degraded subtree is rebuilt when its own bounds have grown too much,
+    // or when neither child is degraded enough to account for the growth.
+    // Otherwise the degradation is pushed down to the children.
+    //
+
+    size_t below = old_index + 1;
+    size_t above = old_index + node->offset;
+
+    float_t area = BoundingBoxSurfaceArea(node->bounds);
+    bool rebuild_subtree =
+        growth * instances->build_areas[old_index] < area ||
+        (instances->costs[below] <= growth * instances->build_costs[below] &&
+         instances->costs[above] <= growth * instances->build_costs[above]);
+
+    if (rebuild_subtree)
+    {
+        bool success = BvhInstancesRebuildSubtree(rebuild,
+                                                  old_index,
+                                                  depth_remaining,
+                                                  new_index);
+
+        return success;
+    }
+
+    bool success = NodeBuilderAllocateNode(&rebuild->node_builder, new_index);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    rebuild->build_areas[*new_index] = instances->build_areas[old_index];
+
+    size_t unused_index;
+    success = BvhInstancesRebuildImpl(rebuild,
+                                      below,
+                                      depth_remaining - 1,
+                                      &unused_index);
+
+    if (!success)
+    {
+        return false;
+    }
+
+    size_t above_index;
+    success = BvhInstancesRebuildImpl(rebuild,
+                                      above,
+                                      depth_remaining - 1,
+                                      &above_index);
+
+    if (!success)
+    {
+        return false;
     }
 
-    return return_status;
+    success = NodeBuilderInitializeInteriorNode(&rebuild->node_builder,
+                                                node->bounds,
+                                                *new_index,
+                                                above_index,
+                                                node->axis);
+
+    return success;
 }
 
 static
 ISTATUS
-BvhAggregateComputeBounds(
-    _In_ const void *context,
-    _In_opt_ PCMATRIX model_to_world,
-    _Out_ PBOUNDING_BOX world_bounds
+BvhInstancesRebuild(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ float_t max_cost_growth
     )
 {
-    PCBVH_AGGREGATE aggregate = (PCBVH_AGGREGATE)context;
+    size_t num_instances = instances->num_instances;
+
+    BVH_INSTANCES_REBUILD rebuild;
+    rebuild.instances = instances;
+    rebuild.max_cost_growth = max_cost_growth;
+    rebuild.build_areas =
+        (float_t*)calloc(instances->max_nodes, sizeof(float_t));
+    rebuild.shape_bounds =
+        (PSHAPE_BOUNDS)calloc(num_instances, sizeof(SHAPE_BOUNDS));
+    rebuild.shapes = (PSHAPE*)calloc(num_instances, sizeof(PSHAPE));
+    rebuild.transforms = (PMATRIX*)calloc(num_instances, sizeof(PMATRIX));
+    rebuild.model_bounds =
+        (PBOUNDING_BOX)calloc(num_instances, sizeof(BOUNDING_BOX));
+    rebuild.slots = (size_t*)calloc(num_instances, sizeof(size_t));
+    rebuild.instance_indices = (size_t*)calloc(num_instances, sizeof(size_t));
+
+    bool success = NodeBuilderInitialize(&rebuild.node_builder, num_instances);
+
+    if (!success ||
+        rebuild.build_areas == NULL ||
+        rebuild.shape_bounds == NULL ||
+        rebuild.shapes == NULL ||
+        rebuild.transforms == NULL ||
+        rebuild.model_bounds == NULL ||
+        rebuild.slots == NULL ||
+        rebuild.instance_indices == NULL)
+    {
+        if (success)
+        {
+            NodeBuilderDestroy(&rebuild.node_builder);
+        }
 
-    ISTATUS status = ShapeComputeBounds(aggregate->shapes[0],
-                                        model_to_world,
-                                        world_bounds);
+        free(rebuild.build_areas);
+        free(rebuild.shape_bounds);
+        free(rebuild.shapes);
+        free(rebuild.transforms);
+        free(rebuild.model_bounds);
+        free(rebuild.slots);
+        free(rebuild.instance_indices);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
 
-    if (status != ISTATUS_SUCCESS)
+    memcpy(rebuild.shapes, instances->shapes, num_instances * sizeof(PSHAPE));
+    memcpy(rebuild.transforms,
+           instances->transforms,
+           num_instances * sizeof(PMATRIX));
+    memcpy(rebuild.model_bounds,
+           instances->model_bounds,
+           num_instances * sizeof(BOUNDING_BOX));
+    memcpy(rebuild.slots, instances->slots, num_instances * sizeof(size_t));
+
+    for (size_t i = 0; i < num_instances; i++)
     {
-        return status;
+        rebuild.instance_indices[instances->slots[i]] = i;
     }
 
-    for (size_t i = 1; i < aggregate->num_shapes; i++)
-    {
-        BOUNDING_BOX bounds;
-        status = ShapeComputeBounds(aggregate->shapes[i],
-                                    model_to_world,
-                                    &bounds);
+    size_t unused_index;
+    success = BvhInstancesRebuildImpl(&rebuild,
+                                      0,
+                                      MAX_TREE_DEPTH - 1,
+                                      &unused_index);
 
-        if (status != ISTATUS_SUCCESS)
-        {
-            return status;
-        }
+    free(rebuild.shape_bounds);
+    free(rebuild.instance_indices);
 
-        *world_bounds = BoundingBoxUnion(*world_bounds, bounds);
+    if (!success)
+    {
+        NodeBuilderDestroy(&rebuild.node_builder);
+        free(rebuild.build_areas);
+        free(rebuild.shapes);
+        free(rebuild.transforms);
+        free(rebuild.model_bounds);
+        free(rebuild.slots);
+        return ISTATUS_ALLOCATION_FAILED;
     }
 
+    NodeBuilderResizeToFit(&rebuild.node_builder);
+
+    free(instances->nodes);
+    free(instances->build_areas);
+    free(instances->shapes);
+    free(instances->transforms);
+    free(instances->model_bounds);
+    free(instances->slots);
+
+    instances->nodes = rebuild.node_builder.nodes;
+    instances->num_nodes = rebuild.node_builder.nodes_size;
+    instances->build_areas = rebuild.build_areas;
+    instances->shapes = rebuild.shapes;
+    instances->transforms = rebuild.transforms;
+    instances->model_bounds = rebuild.model_bounds;
+    instances->slots = rebuild.slots;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+BvhInstancesSceneTrace(
+    _In_opt_ const void *context,
+    _Inout_ PSHAPE_HIT_TESTER hit_tester,
+    _In_ RAY ray
+    )
+{
+    PCBVH_INSTANCES_SCENE instances_scene = (PCBVH_INSTANCES_SCENE)context;
+    PCBVH_INSTANCES instances = instances_scene->instances;
+
+    BVH_SCENE bvh_scene;
+    bvh_scene.nodes = instances->nodes;
+    bvh_scene.shapes = instances->shapes;
+    bvh_scene.transforms = instances->transforms;
+    bvh_scene.premultiplied = NULL;
+    bvh_scene.num_shapes = instances->num_instances;
+
+    ISTATUS status = BvhTransformedSceneTrace(&bvh_scene, hit_tester, ray);
+
     return status;
 }
 
 static
 void
-BvhAggregateFree(
+BvhInstancesSceneFree(
     _In_opt_ _Post_invalid_ void *context
     )
 {
-    PCBVH_AGGREGATE aggregate = (PCBVH_AGGREGATE)context;
-
-    for (size_t i = 0; i < aggregate->num_shapes; i++)
-    {
-        ShapeRelease(aggregate->shapes[i]);
-    }
-
-    free(aggregate->shapes);
-    free(aggregate->nodes);
+    PBVH_INSTANCES_SCENE instances_scene = (PBVH_INSTANCES_SCENE)context;
+    BvhInstancesRelease(instances_scene->instances);
 }
 
 //
-// BVH Aggregate Static Data
+// BVH Instances Static Data
 //
 
-static const SHAPE_VTABLE bvh_aggregate_vtable = {
-    BvhAggregateTrace,
-    BvhAggregateComputeBounds,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    BvhAggregateFree
+static const SCENE_VTABLE bvh_instances_scene_vtable = {
+    BvhInstancesSceneTrace,
+    BvhInstancesSceneFree
 };
 
 //
-// BVH Aggregate Functions
+// BVH Instances Functions
 //
 
 ISTATUS
-BvhAggregateAllocate(
-    _In_reads_(num_shapes) const PSHAPE shapes[],
-    _In_ size_t num_shapes,
-    _Out_ PSHAPE *aggregate
+BvhInstancesAllocate(
+    _In_reads_(num_instances) const PSHAPE shapes[],
+    _In_reads_opt_(num_instances) const PMATRIX transforms[],
+    _In_ size_t num_instances,
+    _Out_ PBVH_INSTANCES *instances
     )
 {
     if (shapes == NULL)
@@ -1479,77 +4103,323 @@ BvhAggregateAllocate(
         return ISTATUS_INVALID_ARGUMENT_00;
     }
 
-    if (num_shapes == 0)
+    for (size_t i = 0; i < num_instances; i++)
     {
-        return ISTATUS_INVALID_ARGUMENT_01;
+        if (shapes[i] == NULL)
+        {
+            return ISTATUS_INVALID_ARGUMENT_00;
+        }
     }
 
-    if (aggregate == NULL)
+    if (num_instances == 0)
     {
         return ISTATUS_INVALID_ARGUMENT_02;
     }
 
+    if (instances == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    size_t max_nodes;
+    bool success = CheckedMultiplySizeT(num_instances, 2, &max_nodes);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    max_nodes -= 1;
+
+    PBVH_INSTANCES result =
+        (PBVH_INSTANCES)calloc(1, sizeof(BVH_INSTANCES));
+
+    if (result == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    result->build_areas = (float_t*)calloc(max_nodes, sizeof(float_t));
+    result->costs = (float_t*)calloc(max_nodes, sizeof(float_t));
+    result->build_costs = (float_t*)calloc(max_nodes, sizeof(float_t));
+    result->max_nodes = max_nodes;
+    result->model_bounds =
+        (PBOUNDING_BOX)calloc(num_instances, sizeof(BOUNDING_BOX));
+    result->slots = (size_t*)calloc(num_instances, sizeof(size_t));
+    PSHAPE_BOUNDS shape_bounds =
+        (PSHAPE_BOUNDS)calloc(num_instances, sizeof(SHAPE_BOUNDS));
+
+    if (result->build_areas == NULL ||
+        result->costs == NULL ||
+        result->build_costs == NULL ||
+        result->model_bounds == NULL ||
+        result->slots == NULL ||
+        shape_bounds == NULL)
+    {
+        free(shape_bounds);
+        BvhInstancesFree(result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    //
+    // The bounds of each instance are computed once in model space and
+    // transformed, which is what allows the instances to be refit without
+    // revisiting the shared geometry.
+    //
+
+    for (size_t i = 0; i < num_instances; i++)
+    {
+        ISTATUS status = ShapeComputeBounds(shapes[i],
+                                            NULL,
+                                            result->model_bounds + i);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            free(shape_bounds);
+            BvhInstancesFree(result);
+            return status;
+        }
+
+        PMATRIX transform;
+        if (transforms != NULL)
+        {
+            transform = transforms[i];
+        }
+        else
+        {
+            transform = NULL;
+        }
+
+        BOUNDING_BOX world_bounds =
+            BoundingBoxTransform(transform, result->model_bounds[i]);
+
+        ShapeBoundsInitializeWithBounds(shape_bounds + i,
+                                        world_bounds,
+                                        shapes[i],
+                                        transform,
+                                        false,
+                                        i);
+    }
+
     NODE_BUILDER node_builder;
-    bool success = NodeBuilderInitialize(&node_builder, num_shapes);
+    success = NodeBuilderInitialize(&node_builder, num_instances);
 
     if (!success)
     {
+        free(shape_bounds);
+        BvhInstancesFree(result);
         return ISTATUS_ALLOCATION_FAILED;
     }
 
-    PSHAPE_BOUNDS shape_bounds;
-    ISTATUS status = BvhBuild(&node_builder,
-                              shapes,
-                              NULL,
-                              NULL,
-                              num_shapes,
-                              MAX_TREE_DEPTH,
-                              &shape_bounds);
+    success = BvhBuildFromShapeBounds(&node_builder,
+                                      shape_bounds,
+                                      num_instances,
+                                      MAX_TREE_DEPTH);
 
-    if (status != ISTATUS_SUCCESS)
+    if (!success)
     {
+        free(shape_bounds);
         NodeBuilderDestroy(&node_builder);
-        return status;
+        BvhInstancesFree(result);
+        return ISTATUS_ALLOCATION_FAILED;
     }
 
     NodeBuilderResizeToFit(&node_builder);
 
-    BVH_AGGREGATE result;
-    result.nodes = node_builder.nodes;
-    result.shapes = calloc(num_shapes, sizeof(PSHAPE));
-    result.num_shapes = num_shapes;
+    result->nodes = node_builder.nodes;
+    result->num_nodes = node_builder.nodes_size;
 
-    if (result.shapes == NULL)
+    for (size_t i = 0; i < result->num_nodes; i++)
+    {
+        result->build_areas[i] =
+            BoundingBoxSurfaceArea(result->nodes[i].bounds);
+    }
+
+    PBOUNDING_BOX model_bounds =
+        (PBOUNDING_BOX)calloc(num_instances, sizeof(BOUNDING_BOX));
+    result->shapes = (PSHAPE*)calloc(num_instances, sizeof(PSHAPE));
+    result->transforms = (PMATRIX*)calloc(num_instances, sizeof(PMATRIX));
+
+    if (model_bounds == NULL ||
+        result->shapes == NULL ||
+        result->transforms == NULL)
     {
+        free(model_bounds);
         free(shape_bounds);
-        NodeBuilderDestroy(&node_builder);
+        BvhInstancesFree(result);
         return ISTATUS_ALLOCATION_FAILED;
     }
 
-    for (size_t i = 0; i < num_shapes; i++)
+    for (size_t i = 0; i < num_instances; i++)
     {
-        result.shapes[i] = shape_bounds[i].shape;
+        size_t index = shape_bounds[i].index;
+        result->shapes[i] = shape_bounds[i].shape;
+        result->transforms[i] = shape_bounds[i].model_to_world;
+        model_bounds[i] = result->model_bounds[index];
+        result->slots[index] = i;
+
+        ShapeRetain(result->shapes[i]);
+        MatrixRetain(result->transforms[i]);
     }
 
+    free(result->model_bounds);
     free(shape_bounds);
 
-    status = ShapeAllocate(&bvh_aggregate_vtable,
-                           &result,
-                           sizeof(BVH_AGGREGATE),
-                           alignof(BVH_AGGREGATE),
-                           aggregate);
+    result->model_bounds = model_bounds;
+    result->num_instances = num_instances;
+    result->reference_count = 1;
+
+    *instances = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+BvhInstancesSetTransform(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ size_t index,
+    _In_opt_ PMATRIX transform
+    )
+{
+    if (instances == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (instances->num_instances <= index)
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    size_t slot = instances->slots[index];
+
+    MatrixRetain(transform);
+    MatrixRelease(instances->transforms[slot]);
+    instances->transforms[slot] = transform;
+
+    return ISTATUS_SUCCESS;
+}
+
+ISTATUS
+BvhInstancesRefit(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ float_t max_cost_growth,
+    _In_ size_t num_threads
+    )
+{
+    if (instances == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (!isgreaterequal(max_cost_growth, (float_t)1.0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_01;
+    }
+
+    if (num_threads == 0)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    size_t max_threads = instances->num_nodes / REFIT_NODES_PER_THREAD;
+    if (max_threads < num_threads)
+    {
+        num_threads = max_threads;
+    }
+
+    if (num_threads <= 1)
+    {
+        BvhInstancesRefitSubtree(instances, 0);
+    }
+    else
+    {
+        ISTATUS status = BvhInstancesRefitParallel(instances, num_threads);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    //
+    // The SAH cost of the refit tree is compared against the cost the tree
+    // would have had with the bounds it was built with. Only the subtrees
+    // responsible for growth beyond the limit are rebuilt.
+    //
+
+    if (instances->costs[0] <= max_cost_growth * instances->build_costs[0])
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    ISTATUS status = BvhInstancesRebuild(instances, max_cost_growth);
+
+    return status;
+}
+
+ISTATUS
+BvhInstancesSceneAllocate(
+    _In_ PBVH_INSTANCES instances,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    )
+{
+    if (instances == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_00;
+    }
+
+    if (scene == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    BVH_INSTANCES_SCENE result;
+    result.instances = instances;
+
+    ISTATUS status = SceneAllocate(&bvh_instances_scene_vtable,
+                                   &result,
+                                   sizeof(BVH_INSTANCES_SCENE),
+                                   alignof(BVH_INSTANCES_SCENE),
+                                   environment,
+                                   scene);
 
     if (status != ISTATUS_SUCCESS)
     {
-        free(result.shapes);
-        NodeBuilderDestroy(&node_builder);
         return status;
     }
 
-    for (size_t i = 0; i < num_shapes; i++)
+    BvhInstancesRetain(instances);
+
+    return ISTATUS_SUCCESS;
+}
+
+void
+BvhInstancesRetain(
+    _In_opt_ PBVH_INSTANCES instances
+    )
+{
+    if (instances == NULL)
     {
-        ShapeRetain(shapes[i]);
+        return;
     }
 
-    return ISTATUS_SUCCESS;
+    atomic_fetch_add(&instances->reference_count, 1);
+}
+
+void
+BvhInstancesRelease(
+    _In_opt_ _Post_invalid_ PBVH_INSTANCES instances
+    )
+{
+    if (instances == NULL)
+    {
+        return;
+    }
+
+    if (atomic_fetch_sub(&instances->reference_count, 1) == 1)
+    {
+        BvhInstancesFree(instances);
+    }
 }
\ No newline at end of file
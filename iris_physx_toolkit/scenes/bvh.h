@@ -10,6 +10,33 @@ Abstract:
 
     Creates a BVH scene.
 
+    Compressed scenes store the bounds of each node as 8-bit offsets from the
+    bounds of its parent, halving the size of each node at the cost of
+    slightly looser bounds and decoding them during traversal. This is a
+    memory trade-off only; traversal is slower than for an uncompressed scene
+    unless the uncompressed nodes would not fit in memory.
+
+    Spatial scenes may also split nodes with planes, referencing shapes that
+    straddle the plane from both sides. Duplicated references are limited to
+    max_duplication times the number of shapes.
+
+    Scene builders accept shapes in chunks so that callers streaming a large
+    scene from disk can release each chunk once it has been added. Only the
+    bounds of each shape and its references are kept until the scene is
+    built, after which the builder is empty and may be reused.
+
+    Motion scenes interpolate the transform of each shape between keyframes
+    at time0 and time1. The transforms must be affine. Rays traced at times
+    outside of the keyframes see the shapes at the nearest keyframe.
+
+    Instances reference shared shapes, usually BVH aggregates, through a
+    top-level BVH of their own. Changing the transforms of the instances and
+    refitting them updates the top-level BVH without rebuilding it or
+    revisiting the shared shapes. If refitting grows the SAH cost of the
+    top-level BVH by more than max_cost_growth, the degraded subtrees are
+    rebuilt. Instances must not be modified while a scene that references them
+    is being rendered.
+
 --*/
 
 #ifndef _IRIS_PHYSX_TOOLKIT_SCENES_BVH_
@@ -21,6 +48,16 @@ Abstract:
 extern "C" {
 #endif // __cplusplus
 
+//
+// Types
+//
+
+typedef struct _BVH_SCENE_BUILDER BVH_SCENE_BUILDER, *PBVH_SCENE_BUILDER;
+typedef const BVH_SCENE_BUILDER *PCBVH_SCENE_BUILDER;
+
+typedef struct _BVH_INSTANCES BVH_INSTANCES, *PBVH_INSTANCES;
+typedef const BVH_INSTANCES *PCBVH_INSTANCES;
+
 //
 // Functions
 //
@@ -35,6 +72,72 @@ BvhSceneAllocate(
     _Out_ PSCENE *scene
     );
 
+ISTATUS
+BvhCompressedSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
+ISTATUS
+BvhSpatialSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes,
+    _In_ float_t max_duplication,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
+ISTATUS
+BvhSceneBuilderAllocate(
+    _Out_ PBVH_SCENE_BUILDER *builder
+    );
+
+ISTATUS
+BvhSceneBuilderAddShapes(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms[],
+    _In_reads_opt_(num_shapes) const bool premultiplied[],
+    _In_ size_t num_shapes
+    );
+
+ISTATUS
+BvhSceneBuilderBuild(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
+ISTATUS
+BvhSceneBuilderBuildCompressed(
+    _Inout_ PBVH_SCENE_BUILDER builder,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
+void
+BvhSceneBuilderFree(
+    _In_opt_ _Post_invalid_ PBVH_SCENE_BUILDER builder
+    );
+
+ISTATUS
+BvhMotionSceneAllocate(
+    _In_reads_(num_shapes) const PSHAPE shapes[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms0[],
+    _In_reads_opt_(num_shapes) const PMATRIX transforms1[],
+    _In_ size_t num_shapes,
+    _In_ float_t time0,
+    _In_ float_t time1,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
 ISTATUS
 BvhAggregateAllocate(
     _In_reads_(num_shapes) const PSHAPE shapes[],
@@ -42,6 +145,45 @@ BvhAggregateAllocate(
     _Out_ PSHAPE *aggregate
     );
 
+ISTATUS
+BvhInstancesAllocate(
+    _In_reads_(num_instances) const PSHAPE shapes[],
+    _In_reads_opt_(num_instances) const PMATRIX transforms[],
+    _In_ size_t num_instances,
+    _Out_ PBVH_INSTANCES *instances
+    );
+
+ISTATUS
+BvhInstancesSetTransform(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ size_t index,
+    _In_opt_ PMATRIX transform
+    );
+
+ISTATUS
+BvhInstancesRefit(
+    _Inout_ PBVH_INSTANCES instances,
+    _In_ float_t max_cost_growth,
+    _In_ size_t num_threads
+    );
+
+ISTATUS
+BvhInstancesSceneAllocate(
+    _In_ PBVH_INSTANCES instances,
+    _In_opt_ PENVIRONMENTAL_LIGHT environment,
+    _Out_ PSCENE *scene
+    );
+
+void
+BvhInstancesRetain(
+    _In_opt_ PBVH_INSTANCES instances
+    );
+
+void
+BvhInstancesRelease(
+    _In_opt_ _Post_invalid_ PBVH_INSTANCES instances
+    );
+
 #if __cplusplus 
 }
 #endif // __cplusplus
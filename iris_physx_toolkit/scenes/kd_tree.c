@@ -2396,7 +2396,8 @@ static const SHAPE_VTABLE kd_tree_aggregate_vtable = {
     NULL,
     NULL,
     NULL,
-    KdTreeAggregateFree
+    KdTreeAggregateFree,
+    NULL
 };
 
 //
@@ -12,16 +12,25 @@ Abstract:
 
 --*/
 
+#include <math.h>
 #include <stdalign.h>
 
 #include "iris_physx_toolkit/shapes/constructive_solid_geometry.h"
 
+//
+// Defines
+//
+
+#define CSG_BOUNDS_PADDING ((float_t)0.00001)
+
 //
 // Types
 //
 
 typedef struct _CSG_SHAPE {
     PSHAPE shapes[2];
+    BOUNDING_BOX bounds[2];
+    size_t cheaper_shape;
 } CSG_SHAPE, *PCSG_SHAPE;
 
 typedef const CSG_SHAPE *PCCSG_SHAPE;
@@ -31,180 +40,270 @@ typedef const CSG_SHAPE *PCCSG_SHAPE;
 //
 
 static
-ISTATUS
-DifferenceShapeTrace(
-    _In_ const void *context,
+inline
+bool
+CsgShapeBoundsIntersect(
+    _In_ PCCSG_SHAPE csg_shape,
+    _In_ size_t index,
+    _In_ PCRAY ray,
+    _Out_ float_t *near,
+    _Out_ float_t *far
+    )
+{
+    bool intersects = BoundingBoxIntersect(csg_shape->bounds[index],
+                                           *ray,
+                                           NULL,
+                                           near,
+                                           far);
+
+    return intersects;
+}
+
+static
+inline
+bool
+CsgShapeMayHit(
+    _In_ PCCSG_SHAPE csg_shape,
+    _In_ size_t index,
     _In_ PCRAY ray,
     _In_ float_t minimum_distance,
+    _In_ float_t maximum_distance
+    )
+{
+    float_t near, far;
+    bool intersects = CsgShapeBoundsIntersect(csg_shape,
+                                              index,
+                                              ray,
+                                              &near,
+                                              &far);
+
+    return intersects && near <= maximum_distance && minimum_distance <= far;
+}
+
+static
+inline
+ISTATUS
+CsgShapeTestNestedShape(
+    _In_ PCCSG_SHAPE csg_shape,
+    _In_ size_t index,
     _In_ float_t maximum_distance,
     _In_ PSHAPE_HIT_ALLOCATOR allocator,
-    _Out_ PHIT *hit
+    _Out_ PHIT *hits
     )
 {
-    PCCSG_SHAPE csg_shape = (PCCSG_SHAPE)context;
+    //
+    // The inside state of a child at any distance depends on all of its hits
+    // before that distance, so only the far end of the window can be passed
+    // down.
+    //
 
-    PHIT hits0;
     ISTATUS status = ShapeHitTesterTestNestedShape(allocator,
-                                                   csg_shape->shapes[0],
+                                                   csg_shape->shapes[index],
                                                    -INFINITY,
-                                                   INFINITY,
-                                                   &hits0);
+                                                   maximum_distance,
+                                                   hits);
 
     if (status == ISTATUS_NO_INTERSECTION)
     {
-        return ISTATUS_NO_INTERSECTION;
-    }
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
+        *hits = NULL;
+        return ISTATUS_SUCCESS;
     }
 
-    PHIT hits1;
-    status = ShapeHitTesterTestNestedShape(allocator,
-                                           csg_shape->shapes[1],
-                                           -INFINITY,
-                                           INFINITY,
-                                           &hits1);
+    return status;
+}
 
-    if (status == ISTATUS_NO_INTERSECTION)
-    {
-        hits1 = NULL;
-    }
-    else if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
+//
+// Merges the sorted hit lists of two children into the boundaries of the
+// combined shape. A hit of one child is a boundary if the other child is in
+// the requested state at that distance. A child whose hits are exhausted is
+// treated as being outside.
+//
+// Nested CSG shapes request their children with a minimum distance of
+// -INFINITY and need every boundary up to the maximum distance. For any other
+// caller only the closest boundary in the window matters, so merging stops as
+// soon as it is found.
+//
 
-    PHIT last_hit = NULL;
+static
+ISTATUS
+CsgShapeMergeHits(
+    _In_opt_ PHIT hits0,
+    _In_opt_ PHIT hits1,
+    _In_ bool keep0_when_inside1,
+    _In_ bool keep1_when_inside0,
+    _In_ float_t minimum_distance,
+    _In_ float_t maximum_distance,
+    _Out_ PHIT *hit
+    )
+{
+    bool closest_only = (minimum_distance != -INFINITY);
     bool inside0 = false;
     bool inside1 = false;
-    status = ISTATUS_NO_INTERSECTION;
+    PHIT last_hit = NULL;
     *hit = NULL;
-    while (hits0 != NULL && hits1 != NULL)
+
+    while (hits0 != NULL || hits1 != NULL)
     {
-        assert(!hits0->next || hits0->distance <= hits0->distance);
-        assert(!hits1->next || hits1->distance <= hits1->distance);
-        if (hits0->distance < hits1->distance)
+        if ((hits0 == NULL && keep1_when_inside0) ||
+            (hits1 == NULL && keep0_when_inside1))
         {
-            if (!inside1)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits0 = hits0->next;
-            }
+            break;
+        }
 
+        PHIT current_hit;
+        if (hits1 == NULL ||
+            (hits0 != NULL && hits0->distance < hits1->distance))
+        {
+            assert(!hits0->next || hits0->distance <= hits0->next->distance);
+            current_hit = (inside1 == keep0_when_inside1) ? hits0 : NULL;
+            hits0 = hits0->next;
             inside0 = !inside0;
         }
-        else if (hits0->distance > hits1->distance)
+        else if (hits0 == NULL || hits1->distance < hits0->distance)
         {
-            if (inside0)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits1 = hits1->next;
-            }
-
+            assert(!hits1->next || hits1->distance <= hits1->next->distance);
+            current_hit = (inside0 == keep1_when_inside0) ? hits1 : NULL;
+            hits1 = hits1->next;
             inside1 = !inside1;
         }
         else
         {
-            if (!inside1)
+            if (inside1 == keep0_when_inside1)
             {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
+                current_hit = hits0;
             }
-            else if (inside0)
+            else if (inside0 == keep1_when_inside0)
             {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
+                current_hit = hits1;
             }
             else
             {
-                hits0 = hits0->next;
-                hits1 = hits1->next;
+                current_hit = NULL;
             }
 
+            hits0 = hits0->next;
+            hits1 = hits1->next;
             inside0 = !inside0;
             inside1 = !inside1;
         }
-    }
 
-    while (hits0 != NULL)
-    {
-        assert(!hits0->next || hits0->distance <= hits0->distance);
+        if (hits0 == NULL)
+        {
+            inside0 = false;
+        }
+
+        if (hits1 == NULL)
+        {
+            inside1 = false;
+        }
+
+        if (current_hit == NULL)
+        {
+            continue;
+        }
+
+        if (maximum_distance < current_hit->distance)
+        {
+            break;
+        }
+
+        if (closest_only && current_hit->distance < minimum_distance)
+        {
+            continue;
+        }
+
         if (*hit == NULL)
         {
-            *hit = hits0;
-            status = ISTATUS_SUCCESS;
+            *hit = current_hit;
         }
         else
         {
-            last_hit->next = hits0;
+            last_hit->next = current_hit;
         }
 
-        PHIT current_hit = hits0;
-        hits0 = hits0->next;
         current_hit->next = NULL;
         last_hit = current_hit;
+
+        if (closest_only && minimum_distance < current_hit->distance)
+        {
+            break;
+        }
+    }
+
+    if (*hit == NULL)
+    {
+        return ISTATUS_NO_INTERSECTION;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+DifferenceShapeTrace(
+    _In_ const void *context,
+    _In_ PCRAY ray,
+    _In_ float_t minimum_distance,
+    _In_ float_t maximum_distance,
+    _In_ PSHAPE_HIT_ALLOCATOR allocator,
+    _Out_ PHIT *hit
+    )
+{
+    PCCSG_SHAPE csg_shape = (PCCSG_SHAPE)context;
+
+    if (!CsgShapeMayHit(csg_shape,
+                        0,
+                        ray,
+                        minimum_distance,
+                        maximum_distance))
+    {
+        return ISTATUS_NO_INTERSECTION;
     }
 
+    PHIT hits0;
+    ISTATUS status = CsgShapeTestNestedShape(csg_shape,
+                                             0,
+                                             maximum_distance,
+                                             allocator,
+                                             &hits0);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (hits0 == NULL)
+    {
+        return ISTATUS_NO_INTERSECTION;
+    }
+
+    PHIT hits1 = NULL;
+    if (CsgShapeMayHit(csg_shape,
+                       1,
+                       ray,
+                       minimum_distance,
+                       maximum_distance))
+    {
+        status = CsgShapeTestNestedShape(csg_shape,
+                                         1,
+                                         maximum_distance,
+                                         allocator,
+                                         &hits1);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    status = CsgShapeMergeHits(hits0,
+                               hits1,
+                               false,
+                               true,
+                               minimum_distance,
+                               maximum_distance,
+                               hit);
+
     return status;
 }
 
@@ -238,140 +337,68 @@ IntersectionShapeTrace(
 {
     PCCSG_SHAPE csg_shape = (PCCSG_SHAPE)context;
 
-    PHIT hits0;
-    ISTATUS status = ShapeHitTesterTestNestedShape(allocator,
-                                                   csg_shape->shapes[0],
-                                                   -INFINITY,
-                                                   INFINITY,
-                                                   &hits0);
+    float_t near0, far0;
+    if (!CsgShapeBoundsIntersect(csg_shape, 0, ray, &near0, &far0))
+    {
+        return ISTATUS_NO_INTERSECTION;
+    }
 
-    if (status != ISTATUS_SUCCESS)
+    float_t near1, far1;
+    if (!CsgShapeBoundsIntersect(csg_shape, 1, ray, &near1, &far1))
     {
-        return status;
+        return ISTATUS_NO_INTERSECTION;
     }
 
-    PHIT hits1;
-    status = ShapeHitTesterTestNestedShape(allocator,
-                                           csg_shape->shapes[1],
-                                           -INFINITY,
-                                           INFINITY,
-                                           &hits1);
+    float_t near = IMax(IMax(near0, near1), minimum_distance);
+    float_t far = IMin(IMin(far0, far1), maximum_distance);
+    if (far < near)
+    {
+        return ISTATUS_NO_INTERSECTION;
+    }
+
+    PHIT hits[2];
+    size_t first = csg_shape->cheaper_shape;
+    ISTATUS status = CsgShapeTestNestedShape(csg_shape,
+                                             first,
+                                             maximum_distance,
+                                             allocator,
+                                             &hits[first]);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    PHIT last_hit = NULL;
-    bool inside0 = false;
-    bool inside1 = false;
-    status = ISTATUS_NO_INTERSECTION;
-    *hit = NULL;
-    while (hits0 != NULL && hits1 != NULL)
+    if (hits[first] == NULL)
     {
-        assert(!hits0->next || hits0->distance <= hits0->distance);
-        assert(!hits1->next || hits1->distance <= hits1->distance);
-        if (hits0->distance < hits1->distance)
-        {
-            if (inside1)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits0 = hits0->next;
-            }
+        return ISTATUS_NO_INTERSECTION;
+    }
 
-            inside0 = !inside0;
-        }
-        else if(hits0->distance > hits1->distance)
-        {
-            if (inside0)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits1 = hits1->next;
-            }
+    size_t second = 1 - first;
+    status = CsgShapeTestNestedShape(csg_shape,
+                                     second,
+                                     maximum_distance,
+                                     allocator,
+                                     &hits[second]);
 
-            inside1 = !inside1;
-        }
-        else
-        {
-            if (inside1)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else if (inside0)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-            }
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
 
-            inside0 = !inside0;
-            inside1 = !inside1;
-        }
+    if (hits[second] == NULL)
+    {
+        return ISTATUS_NO_INTERSECTION;
     }
 
+    status = CsgShapeMergeHits(hits[0],
+                               hits[1],
+                               true,
+                               true,
+                               minimum_distance,
+                               maximum_distance,
+                               hit);
+
     return status;
 }
 
@@ -418,185 +445,37 @@ UnionShapeTrace(
 {
     PCCSG_SHAPE csg_shape = (PCCSG_SHAPE)context;
 
-    PHIT hits0;
-    ISTATUS status = ShapeHitTesterTestNestedShape(allocator,
-                                                   csg_shape->shapes[0],
-                                                   -INFINITY,
-                                                   INFINITY,
-                                                   &hits0);
-
-    if (status == ISTATUS_NO_INTERSECTION)
-    {
-        hits0 = NULL;
-    }
-    else if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
-    PHIT hits1;
-    status = ShapeHitTesterTestNestedShape(allocator,
-                                           csg_shape->shapes[1],
-                                           -INFINITY,
-                                           INFINITY,
-                                           &hits1);
-
-    if (status == ISTATUS_NO_INTERSECTION)
-    {
-        hits1 = NULL;
-    }
-    else if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
-
-    PHIT last_hit = NULL;
-    bool inside0 = false;
-    bool inside1 = false;
-    status = ISTATUS_NO_INTERSECTION;
-    *hit = NULL;
-    while (hits0 != NULL && hits1 != NULL)
+    PHIT hits[2] = { NULL, NULL };
+    for (size_t i = 0; i < 2; i++)
     {
-        assert(!hits0->next || hits0->distance <= hits0->distance);
-        assert(!hits1->next || hits1->distance <= hits1->distance);
-        if (hits0->distance < hits1->distance)
+        if (!CsgShapeMayHit(csg_shape,
+                            i,
+                            ray,
+                            minimum_distance,
+                            maximum_distance))
         {
-            if (!inside1)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits0 = hits0->next;
-            }
-
-            inside0 = !inside0;
+            continue;
         }
-        else if (hits0->distance > hits1->distance)
-        {
-            if (!inside0)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits1 = hits1->next;
-            }
-
-            inside1 = !inside1;
-        }
-        else
-        {
-            if (!inside1)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits0;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits0;
-                }
-
-                PHIT current_hit = hits0;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else if (!inside0)
-            {
-                if (*hit == NULL)
-                {
-                    *hit = hits1;
-                    status = ISTATUS_SUCCESS;
-                }
-                else
-                {
-                    last_hit->next = hits1;
-                }
-
-                PHIT current_hit = hits1;
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-                current_hit->next = NULL;
-                last_hit = current_hit;
-            }
-            else
-            {
-                hits0 = hits0->next;
-                hits1 = hits1->next;
-            }
 
-            inside0 = !inside0;
-            inside1 = !inside1;
-        }
-    }
+        ISTATUS status = CsgShapeTestNestedShape(csg_shape,
+                                                 i,
+                                                 maximum_distance,
+                                                 allocator,
+                                                 &hits[i]);
 
-    while (hits0 != NULL)
-    {
-        assert(!hits0->next || hits0->distance <= hits0->distance);
-        if (*hit == NULL)
+        if (status != ISTATUS_SUCCESS)
         {
-            *hit = hits0;
-            status = ISTATUS_SUCCESS;
+            return status;
         }
-        else
-        {
-            last_hit->next = hits0;
-        }
-
-        PHIT current_hit = hits0;
-        hits0 = hits0->next;
-        current_hit->next = NULL;
-        last_hit = current_hit;
     }
 
-    while (hits1 != NULL)
-    {
-        assert(!hits1->next || hits1->distance <= hits1->distance);
-        if (*hit == NULL)
-        {
-            *hit = hits1;
-            status = ISTATUS_SUCCESS;
-        }
-        else
-        {
-            last_hit->next = hits1;
-        }
-
-        PHIT current_hit = hits1;
-        hits1 = hits1->next;
-        current_hit->next = NULL;
-        last_hit = current_hit;
-    }
+    ISTATUS status = CsgShapeMergeHits(hits[0],
+                                       hits[1],
+                                       false,
+                                       false,
+                                       minimum_distance,
+                                       maximum_distance,
+                                       hit);
 
     return status;
 }
@@ -657,7 +536,8 @@ static const SHAPE_VTABLE difference_vtable = {
     NULL,
     NULL,
     NULL,
-    ConstructiveSolidShapeFree
+    ConstructiveSolidShapeFree,
+    NULL
 };
 
 static const SHAPE_VTABLE intersection_vtable = {
@@ -670,7 +550,8 @@ static const SHAPE_VTABLE intersection_vtable = {
     NULL,
     NULL,
     NULL,
-    ConstructiveSolidShapeFree
+    ConstructiveSolidShapeFree,
+    NULL
 };
 
 static const SHAPE_VTABLE union_vtable = {
@@ -683,13 +564,65 @@ static const SHAPE_VTABLE union_vtable = {
     NULL,
     NULL,
     NULL,
-    ConstructiveSolidShapeFree
+    ConstructiveSolidShapeFree,
+    NULL
 };
 
 //
 // Static Functions
 //
 
+static
+inline
+float_t
+CsgShapeBoundsPadding(
+    _In_ float_t minimum,
+    _In_ float_t maximum
+    )
+{
+    float_t magnitude = IMax(IMax(fabs(minimum), fabs(maximum)), (float_t)1.0);
+    return CSG_BOUNDS_PADDING * magnitude;
+}
+
+static
+ISTATUS
+CsgShapeComputeChildBounds(
+    _In_ PCSHAPE shape,
+    _Out_ PBOUNDING_BOX bounds
+    )
+{
+    BOUNDING_BOX model_bounds;
+    ISTATUS status = ShapeComputeBounds(shape, NULL, &model_bounds);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    //
+    // Pad the bounds slightly so that rounding in the ray box test can never
+    // discard a hit on the surface of a child.
+    //
+
+    float_t padding_x = CsgShapeBoundsPadding(model_bounds.corners[0].x,
+                                              model_bounds.corners[1].x);
+    float_t padding_y = CsgShapeBoundsPadding(model_bounds.corners[0].y,
+                                              model_bounds.corners[1].y);
+    float_t padding_z = CsgShapeBoundsPadding(model_bounds.corners[0].z,
+                                              model_bounds.corners[1].z);
+
+    POINT3 corner0 = PointCreate(model_bounds.corners[0].x - padding_x,
+                                 model_bounds.corners[0].y - padding_y,
+                                 model_bounds.corners[0].z - padding_z);
+    POINT3 corner1 = PointCreate(model_bounds.corners[1].x + padding_x,
+                                 model_bounds.corners[1].y + padding_y,
+                                 model_bounds.corners[1].z + padding_z);
+
+    *bounds = BoundingBoxCreate(corner0, corner1);
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 ISTATUS
 CsgAllocate(
@@ -725,7 +658,26 @@ CsgAllocate(
     csg_shape.shapes[0] = shape0;
     csg_shape.shapes[1] = shape1;
 
-    ISTATUS status = ShapeAllocate(vtable,
+    ISTATUS status = CsgShapeComputeChildBounds(shape0,
+                                                &csg_shape.bounds[0]);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = CsgShapeComputeChildBounds(shape1, &csg_shape.bounds[1]);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    float_t area0 = BoundingBoxSurfaceArea(csg_shape.bounds[0]);
+    float_t area1 = BoundingBoxSurfaceArea(csg_shape.bounds[1]);
+    csg_shape.cheaper_shape = (area1 < area0) ? 1 : 0;
+
+    status = ShapeAllocate(vtable,
                                    &csg_shape,
                                    sizeof(CSG_SHAPE),
                                    alignof(CSG_SHAPE),
@@ -372,7 +372,8 @@ static const SHAPE_VTABLE sphere_vtable = {
     NULL,
     NULL,
     NULL,
-    SphereFree
+    SphereFree,
+    NULL
 };
 
 static const SHAPE_VTABLE emissive_sphere_vtable = {
@@ -385,7 +386,8 @@ static const SHAPE_VTABLE emissive_sphere_vtable = {
     EmissiveSphereGetEmissiveMaterial,
     EmissiveSphereSampleFace,
     EmissiveSphereComputePdfBySolidArea,
-    EmissiveSphereFree
+    EmissiveSphereFree,
+    NULL
 };
 
 //
@@ -204,15 +204,6 @@ TriangleMeshTriangleTrace(
     float_t inverse_determinant = (float_t)1.0 / determinant;
     distance *= inverse_determinant;
 
-    TRIANGLE_MESH_ADDITIONAL_DATA data;
-    data.barycentric_coordinates[0] = b0 * inverse_determinant;
-    data.barycentric_coordinates[1] = b1 * inverse_determinant;
-    data.barycentric_coordinates[2] = b2 * inverse_determinant;
-    data.vertex_indices[0] = (size_t)triangle->v0;
-    data.vertex_indices[1] = (size_t)triangle->v1;
-    data.vertex_indices[2] = (size_t)triangle->v2;
-    data.vertices = triangle->mesh->vertices;
-
     float_t dp = VectorDotProduct(ray->direction, triangle->surface_normal);
 
     uint32_t front_face, back_face;
@@ -228,19 +219,51 @@ TriangleMeshTriangleTrace(
     }
 
     ISTATUS status =
-        ShapeHitAllocatorAllocate(allocator,
-                                  NULL,
-                                  distance,
-                                  front_face,
-                                  back_face,
-                                  &data,
-                                  sizeof(TRIANGLE_MESH_ADDITIONAL_DATA),
-                                  alignof(TRIANGLE_MESH_ADDITIONAL_DATA),
-                                  hit);
+        ShapeHitAllocatorAllocateDeferred(allocator,
+                                          NULL,
+                                          distance,
+                                          front_face,
+                                          back_face,
+                                          triangle->mesh_face_index,
+                                          b1 * inverse_determinant,
+                                          b2 * inverse_determinant,
+                                          sizeof(TRIANGLE_MESH_ADDITIONAL_DATA),
+                                          alignof(TRIANGLE_MESH_ADDITIONAL_DATA),
+                                          hit);
 
     return status;
 }
 
+static
+ISTATUS
+TriangleMeshTriangleFinalizeHit(
+    _In_ const void *context,
+    _In_ uint32_t primitive,
+    _In_reads_(2) const float_t coordinates[2],
+    _Out_writes_bytes_(additional_data_size) void *additional_data,
+    _In_ size_t additional_data_size
+    )
+{
+    assert(additional_data_size == sizeof(TRIANGLE_MESH_ADDITIONAL_DATA));
+
+    PCTRIANGLE triangle = (PCTRIANGLE)context;
+    assert(primitive == triangle->mesh_face_index);
+
+    PTRIANGLE_MESH_ADDITIONAL_DATA data =
+        (PTRIANGLE_MESH_ADDITIONAL_DATA)additional_data;
+
+    data->barycentric_coordinates[0] =
+        (float_t)1.0 - coordinates[0] - coordinates[1];
+    data->barycentric_coordinates[1] = coordinates[0];
+    data->barycentric_coordinates[2] = coordinates[1];
+    data->vertex_indices[0] = (size_t)triangle->v0;
+    data->vertex_indices[1] = (size_t)triangle->v1;
+    data->vertex_indices[2] = (size_t)triangle->v2;
+    data->vertices = triangle->mesh->vertices;
+
+    return ISTATUS_SUCCESS;
+}
+
 static
 ISTATUS
 TriangleMeshTriangleComputeBounds(
@@ -466,21 +489,20 @@ EmissiveTriangleMeshTriangleSampleFace(
 {
     PEMISSIVE_TRIANGLE triangle = (PEMISSIVE_TRIANGLE)context;
 
-    float_t u;
-    ISTATUS status = RandomGenerateFloat(rng, (float_t)0.0f, (float_t)1.0f, &u);
+    float_t uv[2];
+    ISTATUS status = RandomGenerateFloats(rng,
+                                          (float_t)0.0f,
+                                          (float_t)1.0f,
+                                          2,
+                                          uv);
 
     if (status != ISTATUS_SUCCESS)
     {
         return status;
     }
 
-    float_t v;
-    status = RandomGenerateFloat(rng, (float_t)0.0f, (float_t)1.0f, &v);
-
-    if (status != ISTATUS_SUCCESS)
-    {
-        return status;
-    }
+    float_t u = uv[0];
+    float_t v = uv[1];
 
     if ((float_t)1.0 < u + v)
     {
@@ -540,7 +562,8 @@ static const SHAPE_VTABLE triangle_vtable = {
     NULL,
     NULL,
     NULL,
-    TriangleMeshTriangleFree
+    TriangleMeshTriangleFree,
+    TriangleMeshTriangleFinalizeHit
 };
 
 static const SHAPE_VTABLE emissive_triangle_vtable = {
@@ -553,7 +576,8 @@ static const SHAPE_VTABLE emissive_triangle_vtable = {
     EmissiveTriangleMeshTriangleGetEmissiveMaterial,
     EmissiveTriangleMeshTriangleSampleFace,
     EmissiveTriangleMeshTriangleComputePdfBySolidArea,
-    TriangleMeshTriangleFree
+    TriangleMeshTriangleFree,
+    TriangleMeshTriangleFinalizeHit
 };
 
 //
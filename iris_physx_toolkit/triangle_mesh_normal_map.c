@@ -84,6 +84,15 @@ TriangleMeshNormalMapCompute(
     return ISTATUS_SUCCESS;
 }
 
+static
+SHADING_ATTRIBUTES
+TriangleMeshNormalMapGetAttributes(
+    _In_ const void *context
+    )
+{
+    return SHADING_ATTRIBUTES_NONE;
+}
+
 static
 void
 TriangleMeshNormalMapFree(
@@ -101,7 +110,8 @@ TriangleMeshNormalMapFree(
 
 static const NORMAL_MAP_VTABLE triangle_mesh_normal_map_vtable = {
     TriangleMeshNormalMapCompute,
-    TriangleMeshNormalMapFree
+    TriangleMeshNormalMapFree,
+    TriangleMeshNormalMapGetAttributes
 };
 
 //
@@ -0,0 +1,761 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    wavefront_path_tracer.c
+
+Abstract:
+
+    Implements a wavefront path tracer.
+
+--*/
+
+#include <stdalign.h>
+#include <stdlib.h>
+
+#include "common/safe_math.h"
+#include "iris_camera/iris_camera.h"
+#include "iris_physx_toolkit/sample_direct_lighting.h"
+#include "iris_physx_toolkit/wavefront_path_tracer.h"
+
+//
+// Types
+//
+
+typedef struct _WAVEFRONT_PATHS {
+    _Field_size_(capacity) PRAY_DIFFERENTIAL ray_differentials;
+    _Field_size_(capacity) float_t *times;
+    _Field_size_(capacity) POINT3 *hit_points;
+    _Field_size_(capacity) VECTOR3 *surface_normals;
+    _Field_size_(capacity) VECTOR3 *shading_normals;
+    _Field_size_(capacity) PCBSDF *bsdfs;
+    _Field_size_(capacity) float_t *path_throughputs;
+    _Field_size_(capacity) bool *add_light_emissions;
+    _Field_size_(capacity) uint8_t *bounces;
+    _Field_size_(capacity) size_t *active;
+    _Field_size_(capacity * (max_bounces + 1)) PCSPECTRUM *spectra;
+    _Field_size_(capacity * (max_bounces + 1)) PCREFLECTOR *reflectors;
+    _Field_size_(capacity * (max_bounces + 1)) float_t *attenuations;
+    size_t capacity;
+} WAVEFRONT_PATHS, *PWAVEFRONT_PATHS;
+
+typedef const WAVEFRONT_PATHS *PCWAVEFRONT_PATHS;
+
+typedef struct _WAVEFRONT_PATH_TRACER {
+    PWAVEFRONT_PATHS paths;
+    float_t min_termination_probability;
+    float_t roulette_threshold;
+    uint8_t min_bounces;
+    uint8_t max_bounces;
+    bool deferred_shading;
+} WAVEFRONT_PATH_TRACER, *PWAVEFRONT_PATH_TRACER;
+
+typedef const WAVEFRONT_PATH_TRACER *PCWAVEFRONT_PATH_TRACER;
+
+//
+// Static Functions
+//
+
+static
+void
+WavefrontPathsDestroy(
+    _Inout_ PWAVEFRONT_PATHS paths
+    )
+{
+    assert(paths != NULL);
+
+    free(paths->ray_differentials);
+    free(paths->times);
+    free(paths->hit_points);
+    free(paths->surface_normals);
+    free(paths->shading_normals);
+    free((void*)paths->bsdfs);
+    free(paths->path_throughputs);
+    free(paths->add_light_emissions);
+    free(paths->bounces);
+    free(paths->active);
+    free((void*)paths->spectra);
+    free((void*)paths->reflectors);
+    free(paths->attenuations);
+}
+
+static
+ISTATUS
+WavefrontPathsEnsureCapacity(
+    _Inout_ PWAVEFRONT_PATHS paths,
+    _In_ size_t num_paths,
+    _In_ uint8_t max_bounces
+    )
+{
+    assert(paths != NULL);
+
+    if (num_paths <= paths->capacity)
+    {
+        return ISTATUS_SUCCESS;
+    }
+
+    size_t num_vertices;
+    bool success = CheckedMultiplySizeT(num_paths,
+                                        (size_t)max_bounces + 1,
+                                        &num_vertices);
+
+    if (!success)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    WAVEFRONT_PATHS result;
+    result.ray_differentials =
+        (PRAY_DIFFERENTIAL)calloc(num_paths, sizeof(RAY_DIFFERENTIAL));
+    result.times = (float_t*)calloc(num_paths, sizeof(float_t));
+    result.hit_points = (PPOINT3)calloc(num_paths, sizeof(POINT3));
+    result.surface_normals = (PVECTOR3)calloc(num_paths, sizeof(VECTOR3));
+    result.shading_normals = (PVECTOR3)calloc(num_paths, sizeof(VECTOR3));
+    result.bsdfs = (PCBSDF*)calloc(num_paths, sizeof(PCBSDF));
+    result.path_throughputs = (float_t*)calloc(num_paths, sizeof(float_t));
+    result.add_light_emissions = (bool*)calloc(num_paths, sizeof(bool));
+    result.bounces = (uint8_t*)calloc(num_paths, sizeof(uint8_t));
+    result.active = (size_t*)calloc(num_paths, sizeof(size_t));
+    result.spectra = (PCSPECTRUM*)calloc(num_vertices, sizeof(PCSPECTRUM));
+    result.reflectors =
+        (PCREFLECTOR*)calloc(num_vertices, sizeof(PCREFLECTOR));
+    result.attenuations = (float_t*)calloc(num_vertices, sizeof(float_t));
+    result.capacity = num_paths;
+
+    if (result.ray_differentials == NULL ||
+        result.times == NULL ||
+        result.hit_points == NULL ||
+        result.surface_normals == NULL ||
+        result.shading_normals == NULL ||
+        result.bsdfs == NULL ||
+        result.path_throughputs == NULL ||
+        result.add_light_emissions == NULL ||
+        result.bounces == NULL ||
+        result.active == NULL ||
+        result.spectra == NULL ||
+        result.reflectors == NULL ||
+        result.attenuations == NULL)
+    {
+        WavefrontPathsDestroy(&result);
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    WavefrontPathsDestroy(paths);
+    *paths = result;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+WavefrontPathTracerIntersect(
+    _In_ PCWAVEFRONT_PATH_TRACER path_tracer,
+    _In_ uint8_t bounce,
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _Inout_ size_t *num_active
+    )
+{
+    PWAVEFRONT_PATHS paths = path_tracer->paths;
+    PCSPECTRUM *spectra = paths->spectra + bounce * paths->capacity;
+
+    if (path_tracer->deferred_shading)
+    {
+        ISTATUS status = ShapeRayTracerTraceDeferred(ray_tracer,
+                                                     paths->ray_differentials,
+                                                     paths->active,
+                                                     *num_active,
+                                                     spectra,
+                                                     paths->bsdfs,
+                                                     paths->hit_points,
+                                                     paths->surface_normals,
+                                                     paths->shading_normals);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < *num_active; i++)
+        {
+            size_t path = paths->active[i];
+
+            ISTATUS status = ShapeRayTracerSetTime(ray_tracer,
+                                                   paths->times[path]);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            status = ShapeRayTracerTrace(ray_tracer,
+                                         paths->ray_differentials[path],
+                                         spectra + path,
+                                         paths->bsdfs + path,
+                                         paths->hit_points + path,
+                                         paths->surface_normals + path,
+                                         paths->shading_normals + path);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+    }
+
+    size_t num_remaining = 0;
+    for (size_t i = 0; i < *num_active; i++)
+    {
+        size_t path = paths->active[i];
+
+        if (paths->add_light_emissions[path])
+        {
+            paths->add_light_emissions[path] = false;
+        }
+        else
+        {
+            spectra[path] = NULL;
+        }
+
+        if (paths->bsdfs[path] == NULL)
+        {
+            continue;
+        }
+
+        paths->active[num_remaining++] = path;
+    }
+
+    *num_active = num_remaining;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+WavefrontPathTracerSampleLights(
+    _In_ PCWAVEFRONT_PATH_TRACER path_tracer,
+    _In_ uint8_t bounce,
+    _In_ size_t num_active,
+    _In_ PCLIGHT_SAMPLER light_sampler,
+    _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng
+    )
+{
+    PWAVEFRONT_PATHS paths = path_tracer->paths;
+    PCSPECTRUM *spectra = paths->spectra + bounce * paths->capacity;
+
+    for (size_t i = 0; i < num_active; i++)
+    {
+        size_t path = paths->active[i];
+
+        ISTATUS status = VisibilityTesterSetTime(visibility_tester,
+                                                 paths->times[path]);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        status = SampleDimensionsSelect(rng,
+                                        bounce,
+                                        SAMPLE_DIMENSION_SLOT_LIGHT_SELECTION);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        status = LightSamplerSample(light_sampler,
+                                    paths->hit_points[path],
+                                    rng,
+                                    light_sample_list);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        size_t light_samples;
+        status = LightSampleListGetSize(light_sample_list, &light_samples);
+
+        for (size_t index = 0; index < light_samples; index++)
+        {
+            PCLIGHT light;
+            float_t pdf;
+            status = LightSampleListGetSample(light_sample_list,
+                                              index,
+                                              &light,
+                                              &pdf);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            if (pdf <= (float_t)0.0)
+            {
+                continue;
+            }
+
+            status = SampleDimensionsSelect(rng,
+                                            bounce,
+                                            SAMPLE_DIMENSION_SLOT_LIGHT_POSITION);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            PCSPECTRUM direct_lighting;
+            status = SampleDirectLighting(
+                light,
+                paths->bsdfs[path],
+                paths->hit_points[path],
+                paths->ray_differentials[path].ray.direction,
+                paths->surface_normals[path],
+                paths->shading_normals[path],
+                rng,
+                visibility_tester,
+                compositor,
+                allocator,
+                &direct_lighting);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            status = SpectrumCompositorAttenuateSpectrum(compositor,
+                                                         direct_lighting,
+                                                         (float_t)1.0 / pdf,
+                                                         &direct_lighting);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            status = SpectrumCompositorAddSpectra(compositor,
+                                                  spectra[path],
+                                                  direct_lighting,
+                                                  spectra + path);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+WavefrontPathTracerSampleBsdfs(
+    _In_ PCWAVEFRONT_PATH_TRACER path_tracer,
+    _In_ uint8_t bounce,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng,
+    _Inout_ size_t *num_active
+    )
+{
+    PWAVEFRONT_PATHS paths = path_tracer->paths;
+    PCREFLECTOR *reflectors = paths->reflectors + bounce * paths->capacity;
+    float_t *attenuations = paths->attenuations + bounce * paths->capacity;
+
+    size_t num_remaining = 0;
+    for (size_t i = 0; i < *num_active; i++)
+    {
+        size_t path = paths->active[i];
+
+        ISTATUS status = SampleDimensionsSelect(rng,
+                                                bounce,
+                                                SAMPLE_DIMENSION_SLOT_BSDF);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        VECTOR3 shading_normal = paths->shading_normals[path];
+
+        BSDF_SAMPLE_TYPE type;
+        VECTOR3 next_direction;
+        float_t bsdf_pdf;
+        status = BsdfSample(paths->bsdfs[path],
+                            paths->ray_differentials[path].ray.direction,
+                            paths->surface_normals[path],
+                            shading_normal,
+                            rng,
+                            allocator,
+                            reflectors + path,
+                            &type,
+                            &next_direction,
+                            &bsdf_pdf);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        if (bsdf_pdf <= (float_t)0.0 || reflectors[path] == NULL)
+        {
+            continue;
+        }
+
+        float_t albedo;
+        status = ReflectorGetAlbedo(reflectors[path], &albedo);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        float_t path_throughput = paths->path_throughputs[path] * albedo;
+
+        float_t attenuation;
+        if (isfinite(bsdf_pdf))
+        {
+            bool transmitted = BsdfSampleIsTransmission(type);
+            attenuation = VectorPositiveDotProduct(shading_normal,
+                                                   next_direction,
+                                                   transmitted);
+            attenuation /= bsdf_pdf;
+
+            path_throughput *= attenuation;
+        }
+        else
+        {
+            attenuation = (float_t)1.0;
+        }
+
+        if (path_tracer->min_bounces < bounce &&
+            path_throughput < path_tracer->roulette_threshold)
+        {
+            float_t random_value;
+            status = RandomGenerateFloat(rng,
+                                         (float_t)0.0,
+                                         (float_t)1.0,
+                                         &random_value);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            float_t cutoff = IMax(path_tracer->min_termination_probability,
+                                  (float_t)1.0 - path_throughput);
+
+            if (random_value < cutoff)
+            {
+                continue;
+            }
+
+            float_t roulette_pdf = (float_t)1.0 - cutoff;
+            attenuation /= roulette_pdf;
+            path_throughput /= roulette_pdf;
+        }
+
+        attenuations[path] = attenuation;
+        paths->path_throughputs[path] = path_throughput;
+
+        if (BsdfSampleContainsSpecular(type))
+        {
+            paths->add_light_emissions[path] = true;
+        }
+
+        RAY next_ray = RayCreate(paths->hit_points[path], next_direction);
+        paths->ray_differentials[path] = RayDifferentialSetTime(
+            RayDifferentialCreateWithoutDifferentials(next_ray),
+            paths->times[path]);
+        paths->bounces[path] = bounce + 1;
+
+        paths->active[num_remaining++] = path;
+    }
+
+    *num_active = num_remaining;
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+WavefrontPathTracerAccumulate(
+    _In_ PCWAVEFRONT_PATH_TRACER path_tracer,
+    _In_ size_t num_paths,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Out_writes_(num_paths) PCSPECTRUM *spectra
+    )
+{
+    PCWAVEFRONT_PATHS paths = path_tracer->paths;
+    size_t capacity = paths->capacity;
+
+    for (size_t path = 0; path < num_paths; path++)
+    {
+        PCSPECTRUM spectrum = paths->spectra[paths->bounces[path] * capacity +
+                                             path];
+
+        for (size_t bounce = paths->bounces[path]; bounce != 0; bounce--)
+        {
+            size_t vertex = (bounce - 1) * capacity + path;
+
+            ISTATUS status = SpectrumCompositorAttenuateReflection(
+                compositor,
+                spectrum,
+                paths->reflectors[vertex],
+                paths->attenuations[vertex],
+                &spectrum);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            status = SpectrumCompositorAddSpectra(compositor,
+                                                  spectrum,
+                                                  paths->spectra[vertex],
+                                                  &spectrum);
+
+            if (status != ISTATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+
+        spectra[path] = spectrum;
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+WavefrontPathTracerIntegrateBatch(
+    _In_opt_ const void *context,
+    _In_reads_(num_rays) PCRAY_DIFFERENTIAL ray_differentials,
+    _In_ size_t num_rays,
+    _In_ PCLIGHT_SAMPLER light_sampler,
+    _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng,
+    _Out_writes_(num_rays) PCSPECTRUM *spectra
+    )
+{
+    PCWAVEFRONT_PATH_TRACER path_tracer = (PCWAVEFRONT_PATH_TRACER)context;
+    PWAVEFRONT_PATHS paths = path_tracer->paths;
+
+    ISTATUS status = WavefrontPathsEnsureCapacity(paths,
+                                                  num_rays,
+                                                  path_tracer->max_bounces);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (size_t path = 0; path < num_rays; path++)
+    {
+        paths->ray_differentials[path] = ray_differentials[path];
+        paths->times[path] = ray_differentials[path].time;
+        paths->path_throughputs[path] = (float_t)1.0;
+        paths->add_light_emissions[path] = true;
+        paths->bounces[path] = 0;
+        paths->active[path] = path;
+    }
+
+    size_t num_active = num_rays;
+    for (uint8_t bounce = 0; num_active != 0; bounce++)
+    {
+        status = WavefrontPathTracerIntersect(path_tracer,
+                                              bounce,
+                                              ray_tracer,
+                                              &num_active);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        status = WavefrontPathTracerSampleLights(path_tracer,
+                                                 bounce,
+                                                 num_active,
+                                                 light_sampler,
+                                                 light_sample_list,
+                                                 visibility_tester,
+                                                 compositor,
+                                                 allocator,
+                                                 rng);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        if (bounce == path_tracer->max_bounces)
+        {
+            break;
+        }
+
+        status = WavefrontPathTracerSampleBsdfs(path_tracer,
+                                                bounce,
+                                                allocator,
+                                                rng,
+                                                &num_active);
+
+        if (status != ISTATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    status = WavefrontPathTracerAccumulate(path_tracer,
+                                           num_rays,
+                                           compositor,
+                                           spectra);
+
+    return status;
+}
+
+static
+ISTATUS
+WavefrontPathTracerIntegrate(
+    _In_opt_ const void *context,
+    _In_ PCRAY_DIFFERENTIAL ray_differential,
+    _In_ PCLIGHT_SAMPLER light_sampler,
+    _Inout_ PLIGHT_SAMPLE_LIST light_sample_list,
+    _Inout_ PSHAPE_RAY_TRACER ray_tracer,
+    _Inout_ PVISIBILITY_TESTER visibility_tester,
+    _Inout_ PSPECTRUM_COMPOSITOR compositor,
+    _Inout_ PREFLECTOR_COMPOSITOR allocator,
+    _Inout_ PRANDOM rng,
+    _Out_ PCSPECTRUM *spectrum
+    )
+{
+    ISTATUS status = WavefrontPathTracerIntegrateBatch(context,
+                                                       ray_differential,
+                                                       1,
+                                                       light_sampler,
+                                                       light_sample_list,
+                                                       ray_tracer,
+                                                       visibility_tester,
+                                                       compositor,
+                                                       allocator,
+                                                       rng,
+                                                       spectrum);
+
+    return status;
+}
+
+static
+ISTATUS
+WavefrontPathTracerDuplicate(
+    _In_opt_ const void *context,
+    _Out_ PINTEGRATOR *duplicate
+    )
+{
+    PCWAVEFRONT_PATH_TRACER path_tracer = (PCWAVEFRONT_PATH_TRACER)context;
+
+    ISTATUS status =
+        WavefrontPathTracerAllocate(path_tracer->min_bounces,
+                                    path_tracer->max_bounces,
+                                    path_tracer->min_termination_probability,
+                                    path_tracer->roulette_threshold,
+                                    path_tracer->deferred_shading,
+                                    duplicate);
+
+    return status;
+}
+
+static
+void
+WavefrontPathTracerFree(
+    _In_opt_ _Post_invalid_ void *context
+    )
+{
+    PWAVEFRONT_PATH_TRACER path_tracer = (PWAVEFRONT_PATH_TRACER)context;
+
+    WavefrontPathsDestroy(path_tracer->paths);
+    free(path_tracer->paths);
+}
+
+//
+// Static Variables
+//
+
+static const INTEGRATOR_VTABLE wavefront_path_tracer_vtable = {
+    WavefrontPathTracerIntegrate,
+    WavefrontPathTracerDuplicate,
+    WavefrontPathTracerFree,
+    WavefrontPathTracerIntegrateBatch
+};
+
+//
+// Functions
+//
+
+ISTATUS
+WavefrontPathTracerAllocate(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _In_ bool deferred_shading,
+    _Out_ PINTEGRATOR *integrator
+    )
+{
+    if (!isfinite(min_termination_probability) ||
+        min_termination_probability < (float_t)0.0 ||
+        (float_t)1.0 < min_termination_probability)
+    {
+        return ISTATUS_INVALID_ARGUMENT_02;
+    }
+
+    if (!isgreaterequal(roulette_threshold, (float_t)0.0))
+    {
+        return ISTATUS_INVALID_ARGUMENT_03;
+    }
+
+    if (integrator == NULL)
+    {
+        return ISTATUS_INVALID_ARGUMENT_05;
+    }
+
+    PWAVEFRONT_PATHS paths =
+        (PWAVEFRONT_PATHS)calloc(1, sizeof(WAVEFRONT_PATHS));
+
+    if (paths == NULL)
+    {
+        return ISTATUS_ALLOCATION_FAILED;
+    }
+
+    WAVEFRONT_PATH_TRACER path_tracer;
+    path_tracer.paths = paths;
+    path_tracer.min_termination_probability = min_termination_probability;
+    path_tracer.roulette_threshold = roulette_threshold;
+    path_tracer.min_bounces = min_bounces;
+    path_tracer.max_bounces = max_bounces;
+    path_tracer.deferred_shading = deferred_shading;
+
+    ISTATUS status = IntegratorAllocate(&wavefront_path_tracer_vtable,
+                                        &path_tracer,
+                                        sizeof(WAVEFRONT_PATH_TRACER),
+                                        alignof(WAVEFRONT_PATH_TRACER),
+                                        integrator);
+
+    if (status != ISTATUS_SUCCESS)
+    {
+        free(paths);
+    }
+
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    wavefront_path_tracer.h
+
+Abstract:
+
+    Creates a path tracer which advances a batch of paths together one stage
+    at a time. Paths are kept in structure of arrays form and each stage
+    (intersection, light sampling, bsdf sampling, and accumulation) runs as a
+    tight loop over the paths which are still active.
+
+    Produces the same estimate as the path tracer but consumes random numbers
+    in a different order. Paths are only advanced in batches when rendering
+    with an image sampler that does not provide its own random number
+    generator; see "iris_camera/render.h".
+
+    If deferred_shading is set, the intersection stage records the hits of
+    the whole batch before evaluating any materials and then shades them
+    grouped by material, which keeps texture and bsdf data in cache for
+    scenes with many materials.
+
+--*/
+
+#ifndef _IRIS_PHYSX_TOOLKIT_WAVEFRONT_PATH_TRACER_
+#define _IRIS_PHYSX_TOOLKIT_WAVEFRONT_PATH_TRACER_
+
+#include "iris_physx/iris_physx.h"
+
+#if __cplusplus 
+extern "C" {
+#endif // __cplusplus
+
+//
+// Functions
+//
+
+ISTATUS
+WavefrontPathTracerAllocate(
+    _In_ uint8_t min_bounces,
+    _In_ uint8_t max_bounces,
+    _In_ float_t min_termination_probability,
+    _In_ float_t roulette_threshold,
+    _In_ bool deferred_shading,
+    _Out_ PINTEGRATOR *integrator
+    );
+
+#if __cplusplus 
+}
+#endif // __cplusplus
+
+#endif // _IRIS_PHYSX_TOOLKIT_WAVEFRONT_PATH_TRACER_
\ No newline at end of file
@@ -133,7 +133,13 @@ AddQuadToScene(
     shapes->push_back(shape1);
 }
 
-TEST(CornellBoxTest, CornellBox)
+static
+void
+CreateCornellBox(
+    _Out_ PSCENE *scene,
+    _Out_ PLIGHT_SAMPLER *light_sampler,
+    _Out_ PCAMERA *camera
+    )
 {
     PCOLOR_INTEGRATOR color_integrator;
     ISTATUS status = CieColorIntegratorAllocate(&color_integrator);
@@ -287,8 +293,7 @@ TEST(CornellBoxTest, CornellBox)
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
     PLIGHT lights[2] = { light0, light1 };
-    PLIGHT_SAMPLER light_sampler;
-    status = OneLightSamplerAllocate(lights, 2, &light_sampler);
+    status = OneLightSamplerAllocate(lights, 2, light_sampler);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
     AddQuadToScene(
@@ -366,16 +371,14 @@ TEST(CornellBoxTest, CornellBox)
                                      &aggregate);
     ASSERT_EQ(ISTATUS_SUCCESS, status);
 
-    PSCENE scene;
     status = KdTreeSceneAllocate(&aggregate,
                                  nullptr,
                                  nullptr,
                                  1,
                                  nullptr,
-                                 &scene);
+                                 scene);
     EXPECT_EQ(ISTATUS_SUCCESS, status);
 
-    PCAMERA camera;
     status = PinholeCameraAllocate(
         cornell_box_camera_location,
         cornell_box_camera_direction,
@@ -383,14 +386,9 @@ TEST(CornellBoxTest, CornellBox)
         cornell_box_focal_length,
         cornell_box_camera_width,
         cornell_box_camera_height,
-        &camera);
+        camera);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
-    TestRenderSingleThreaded(camera,
-                             scene,
-                             light_sampler,
-                             "test_results/cornell_box.pfm");
-
     for (PSHAPE shape : shapes)
     {
         ShapeRelease(shape);
@@ -411,9 +409,200 @@ TEST(CornellBoxTest, CornellBox)
     MaterialRelease(green_material);
     LightRelease(light0);
     LightRelease(light1);
+    ColorExtrapolatorFree(color_extrapolator);
+    ColorIntegratorRelease(color_integrator);
+}
+
+static
+void
+RenderCornellBoxMeanLuma(
+    _In_ PCCAMERA camera,
+    _In_ PSCENE scene,
+    _In_ PLIGHT_SAMPLER light_sampler,
+    _In_ PINTEGRATOR integrator,
+    _In_ uint64_t seed,
+    _Out_ float_t *mean_luma
+    )
+{
+    PIMAGE_SAMPLER image_sampler;
+    ISTATUS status =
+        GridImageSamplerAllocate(4, 4, true, 1, 1, false, &image_sampler);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PRANDOM rng;
+    status = PermutedCongruentialRandomAllocate(seed,
+                                                0xda3e39cb94b95bdbULL,
+                                                &rng);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PSAMPLE_TRACER sample_tracer;
+    status = PhysxSampleTracerAllocate(integrator, &sample_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PCOLOR_INTEGRATOR color_integrator;
+    status = ColorColorIntegratorAllocate(COLOR_SPACE_XYZ, &color_integrator);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = IntegratorPrepare(integrator,
+                               scene,
+                               light_sampler,
+                               color_integrator);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PFRAMEBUFFER framebuffer;
+    status = FramebufferAllocate(64, 64, &framebuffer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = IrisCameraRenderSingleThreaded(camera,
+                                            nullptr,
+                                            image_sampler,
+                                            sample_tracer,
+                                            rng,
+                                            framebuffer,
+                                            nullptr,
+                                            (float_t)0.01);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    float_t sum = (float_t)0.0;
+    for (size_t row = 0; row < 64; row++)
+    {
+        for (size_t column = 0; column < 64; column++)
+        {
+            COLOR3 color;
+            status = FramebufferGetPixel(framebuffer, column, row, &color);
+            ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+            sum += ColorToLuma(color);
+        }
+    }
+
+    *mean_luma = sum / (float_t)(64 * 64);
+
+    ImageSamplerFree(image_sampler);
+    RandomFree(rng);
+    ColorIntegratorRelease(color_integrator);
+    SampleTracerFree(sample_tracer);
+    FramebufferFree(framebuffer);
+}
+
+//
+// Renders the Cornell box with a path tracer trained on its own paths over
+// a few passes and checks that the mean of the last pass matches that of
+// the unguided path tracer. The guide outlives the integrators, which are
+// owned and freed by the sample tracer of each pass.
+//
+
+static
+void
+TestCornellBoxPathGuide(
+    _In_ uint8_t max_split_factor
+    )
+{
+    PSCENE scene;
+    PLIGHT_SAMPLER light_sampler;
+    PCAMERA camera;
+    CreateCornellBox(&scene, &light_sampler, &camera);
+
+    PINTEGRATOR path_tracer;
+    ISTATUS status =
+        PathTracerAllocate(3, 5, (float_t)0.05, INFINITY, &path_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    float_t expected_luma;
+    RenderCornellBoxMeanLuma(camera,
+                             scene,
+                             light_sampler,
+                             path_tracer,
+                             0x4d595df4d0f33173ULL,
+                             &expected_luma);
+
+    PPATH_GUIDE path_guide;
+    status = PathGuideAllocate(4000, &path_guide);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    //
+    // The spectra of the scene are extrapolated into XYZ, whose channels
+    // are sampled at the wavelengths below rather than in nanometers.
+    //
+
+    const float_t wavelengths[] = {
+        (float_t)0.5,
+        (float_t)1.5,
+        (float_t)2.5
+    };
+
+    float_t luma;
+    for (uint64_t pass = 0; pass < 4; pass++)
+    {
+        PINTEGRATOR guided_path_tracer;
+        status = PathTracerAllocateWithPathGuide(3,
+                                                 5,
+                                                 (float_t)0.05,
+                                                 INFINITY,
+                                                 path_guide,
+                                                 (float_t)0.5,
+                                                 max_split_factor,
+                                                 wavelengths,
+                                                 3,
+                                                 &guided_path_tracer);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        RenderCornellBoxMeanLuma(camera,
+                                 scene,
+                                 light_sampler,
+                                 guided_path_tracer,
+                                 0x853c49e6748fea9bULL + pass,
+                                 &luma);
+
+        status = PathGuideUpdate(path_guide);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+    }
+
+    PCPATH_GUIDE_REGION region;
+    POINT3 floor_center = PointCreate(
+        (cornell_box_floor[0].x + cornell_box_floor[2].x) * (float_t)0.5,
+        cornell_box_floor[0].y,
+        (cornell_box_floor[0].z + cornell_box_floor[2].z) * (float_t)0.5);
+    status = PathGuideLookup(path_guide, floor_center, &region);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+    EXPECT_NE(nullptr, region);
+
+    EXPECT_NEAR(expected_luma, luma, expected_luma * (float_t)0.02);
+
+    PathGuideRelease(path_guide);
     SceneRelease(scene);
     LightSamplerRelease(light_sampler);
     CameraFree(camera);
-    ColorExtrapolatorFree(color_extrapolator);
-    ColorIntegratorRelease(color_integrator);
+}
+
+TEST(CornellBoxTest, CornellBox)
+{
+    PSCENE scene;
+    PLIGHT_SAMPLER light_sampler;
+    PCAMERA camera;
+    CreateCornellBox(&scene, &light_sampler, &camera);
+
+    TestRenderSingleThreaded(camera,
+                             scene,
+                             light_sampler,
+                             "test_results/cornell_box.pfm");
+
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+    CameraFree(camera);
+}
+
+TEST(CornellBoxTest, CornellBoxPathGuide)
+{
+    TestCornellBoxPathGuide(0);
+}
+
+TEST(CornellBoxTest, CornellBoxPathGuideWeightWindow)
+{
+    TestCornellBoxPathGuide(1);
+}
+
+TEST(CornellBoxTest, CornellBoxPathGuideSplitting)
+{
+    TestCornellBoxPathGuide(8);
 }
\ No newline at end of file
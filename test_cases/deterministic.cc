@@ -17,8 +17,10 @@ Abstract:
 #include <vector>
 
 #include "iris_advanced_toolkit/halton_sequence.h"
+#include "iris_advanced_toolkit/owen_scrambled_sobol_sequence.h"
 #include "iris_advanced_toolkit/pcg_random.h"
 #include "iris_advanced_toolkit/sobol_sequence.h"
+#include "iris_advanced_toolkit/tabulated_halton_sequence.h"
 #include "iris_camera_toolkit/grid_image_sampler.h"
 #include "iris_camera_toolkit/low_discrepancy_image_sampler.h"
 #include "iris_camera_toolkit/pinhole_camera.h"
@@ -351,6 +353,93 @@ TestRender(
     ColorIntegratorRelease(color_integrator);
 }
 
+void
+TestNextValues(
+    _In_ PLOW_DISCREPANCY_SEQUENCE sequence
+    )
+{
+    const size_t num_values = 32;
+    const uint64_t indices[] = { 0, 1, 7, 1000, 123456 };
+
+    for (uint64_t index : indices)
+    {
+        float_t floats[num_values + 1];
+        ISTATUS status = LowDiscrepancySequenceStart(sequence, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        for (size_t i = 0; i < num_values + 1; i++)
+        {
+            status = LowDiscrepancySequenceNextFloat(sequence, floats + i);
+            ASSERT_EQ(status, ISTATUS_SUCCESS);
+        }
+
+        float_t batch_floats[num_values];
+        status = LowDiscrepancySequenceStart(sequence, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        status = LowDiscrepancySequenceNextFloats(sequence, 0, batch_floats);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        status = LowDiscrepancySequenceNextFloats(sequence,
+                                                  num_values,
+                                                  batch_floats);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        for (size_t i = 0; i < num_values; i++)
+        {
+            EXPECT_EQ(floats[i], batch_floats[i]);
+        }
+
+        float_t next_float;
+        status = LowDiscrepancySequenceNextFloat(sequence, &next_float);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+        EXPECT_EQ(floats[num_values], next_float);
+
+        double_t doubles[num_values + 1];
+        status = LowDiscrepancySequenceStart(sequence, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        for (size_t i = 0; i < num_values + 1; i++)
+        {
+            status = LowDiscrepancySequenceNextDouble(sequence, doubles + i);
+            ASSERT_EQ(status, ISTATUS_SUCCESS);
+        }
+
+        double_t batch_doubles[num_values];
+        status = LowDiscrepancySequenceStart(sequence, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        status = LowDiscrepancySequenceNextDoubles(sequence,
+                                                   num_values,
+                                                   batch_doubles);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        for (size_t i = 0; i < num_values; i++)
+        {
+            EXPECT_EQ(doubles[i], batch_doubles[i]);
+        }
+
+        double_t next_double;
+        status = LowDiscrepancySequenceNextDouble(sequence, &next_double);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+        EXPECT_EQ(doubles[num_values], next_double);
+    }
+
+    float_t value;
+    ISTATUS status = LowDiscrepancySequenceNextFloats(nullptr, 1, &value);
+    EXPECT_EQ(status, ISTATUS_INVALID_ARGUMENT_00);
+
+    status = LowDiscrepancySequenceNextFloats(sequence, 1, nullptr);
+    EXPECT_EQ(status, ISTATUS_INVALID_ARGUMENT_02);
+
+    double_t double_value;
+    status = LowDiscrepancySequenceNextDoubles(nullptr, 1, &double_value);
+    EXPECT_EQ(status, ISTATUS_INVALID_ARGUMENT_00);
+
+    status = LowDiscrepancySequenceNextDoubles(sequence, 1, nullptr);
+    EXPECT_EQ(status, ISTATUS_INVALID_ARGUMENT_02);
+}
+
 TEST(DeterministicTest, PcgGridSampler)
 {
     PRANDOM rng0;
@@ -441,4 +530,224 @@ TEST(DeterministicTest, PcgSobol)
     RandomFree(rng0);
     RandomFree(rng1);
     ImageSamplerFree(pixel_sampler);
+}
+
+TEST(DeterministicTest, PcgOwenScrambledSobol)
+{
+    PRANDOM rng0;
+    ISTATUS status = PermutedCongruentialRandomAllocate(
+        0x853c49e6748fea9bULL,
+        0xda3e39cb94b95bdbULL,
+        &rng0);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PRANDOM rng1;
+    status = PermutedCongruentialRandomAllocate(
+        0x853c49e6748fea9bULL,
+        0xda3e39cb94b95bdbULL,
+        &rng1);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    status = OwenScrambledSobolSequenceAllocate(0, &sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PIMAGE_SAMPLER pixel_sampler;
+    status =
+        LowDiscrepancyImageSamplerAllocate(sequence, 1, &pixel_sampler);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRender(rng0, rng1, pixel_sampler);
+
+    RandomFree(rng0);
+    RandomFree(rng1);
+    ImageSamplerFree(pixel_sampler);
+}
+
+TEST(DeterministicTest, PcgTabulatedHalton)
+{
+    PRANDOM rng0;
+    ISTATUS status = PermutedCongruentialRandomAllocate(
+        0x853c49e6748fea9bULL,
+        0xda3e39cb94b95bdbULL,
+        &rng0);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PRANDOM rng1;
+    status = PermutedCongruentialRandomAllocate(
+        0x853c49e6748fea9bULL,
+        0xda3e39cb94b95bdbULL,
+        &rng1);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    status = TabulatedHaltonSequenceAllocate(&sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PIMAGE_SAMPLER pixel_sampler;
+    status =
+        LowDiscrepancyImageSamplerAllocate(sequence, 1, &pixel_sampler);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRender(rng0, rng1, pixel_sampler);
+
+    RandomFree(rng0);
+    RandomFree(rng1);
+    ImageSamplerFree(pixel_sampler);
+}
+
+TEST(DeterministicTest, SobolNextValues)
+{
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    ISTATUS status = SobolSequenceAllocate(&sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestNextValues(sequence);
+
+    status = LowDiscrepancySequenceStart(sequence, 0);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<float_t> values(1025);
+    status = LowDiscrepancySequenceNextFloats(sequence,
+                                              values.size(),
+                                              values.data());
+    EXPECT_EQ(status, ISTATUS_OUT_OF_ENTROPY);
+
+    status = LowDiscrepancySequenceNextFloats(sequence,
+                                              values.size() - 1,
+                                              values.data());
+    EXPECT_EQ(status, ISTATUS_SUCCESS);
+
+    LowDiscrepancySequenceFree(sequence);
+}
+
+TEST(DeterministicTest, HaltonNextValues)
+{
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    ISTATUS status = HaltonSequenceAllocate(&sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestNextValues(sequence);
+
+    LowDiscrepancySequenceFree(sequence);
+}
+
+TEST(DeterministicTest, OwenScrambledSobolNextValues)
+{
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    ISTATUS status = OwenScrambledSobolSequenceAllocate(0, &sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestNextValues(sequence);
+
+    LowDiscrepancySequenceFree(sequence);
+}
+
+TEST(DeterministicTest, TabulatedHaltonNextValues)
+{
+    PLOW_DISCREPANCY_SEQUENCE sequence;
+    ISTATUS status = TabulatedHaltonSequenceAllocate(&sequence);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestNextValues(sequence);
+
+    LowDiscrepancySequenceFree(sequence);
+}
+
+TEST(DeterministicTest, TabulatedHaltonMatchesHalton)
+{
+    PLOW_DISCREPANCY_SEQUENCE halton;
+    ISTATUS status = HaltonSequenceAllocate(&halton);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PLOW_DISCREPANCY_SEQUENCE tabulated;
+    status = TabulatedHaltonSequenceAllocate(&tabulated);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PLOW_DISCREPANCY_SEQUENCE duplicate;
+    status = LowDiscrepancySequenceDuplicate(tabulated, &duplicate);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    const size_t num_columns = 5;
+    const size_t num_rows = 7;
+    for (size_t row = 0; row < num_rows; row++)
+    {
+        for (size_t column = 0; column < num_columns; column++)
+        {
+            for (uint32_t sample = 0; sample < 3; sample++)
+            {
+                uint64_t index;
+                status = LowDiscrepancySequenceComputeIndex(halton,
+                                                            column,
+                                                            num_columns,
+                                                            row,
+                                                            num_rows,
+                                                            sample,
+                                                            3,
+                                                            &index);
+                ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+                uint64_t tabulated_index;
+                status = LowDiscrepancySequenceComputeIndex(duplicate,
+                                                            column,
+                                                            num_columns,
+                                                            row,
+                                                            num_rows,
+                                                            sample,
+                                                            3,
+                                                            &tabulated_index);
+                ASSERT_EQ(status, ISTATUS_SUCCESS);
+                EXPECT_EQ(index, tabulated_index);
+
+                status = LowDiscrepancySequenceStart(halton, index);
+                ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+                status = LowDiscrepancySequenceStart(duplicate, index);
+                ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+                for (size_t dimension = 0; dimension < 256; dimension++)
+                {
+                    float_t expected;
+                    status = LowDiscrepancySequenceNextFloat(halton,
+                                                             &expected);
+                    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+                    float_t actual;
+                    status = LowDiscrepancySequenceNextFloat(duplicate,
+                                                             &actual);
+                    ASSERT_EQ(status, ISTATUS_SUCCESS);
+                    EXPECT_EQ(expected, actual);
+                }
+            }
+        }
+    }
+
+    for (uint32_t index = 0; index < 100000; index += 97)
+    {
+        status = LowDiscrepancySequenceStart(halton, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        status = LowDiscrepancySequenceStart(tabulated, index);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        for (size_t dimension = 0; dimension < 256; dimension++)
+        {
+            float_t expected;
+            status = LowDiscrepancySequenceNextFloat(halton, &expected);
+            ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+            float_t actual;
+            status = LowDiscrepancySequenceNextFloat(tabulated, &actual);
+            ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+            if (2 <= dimension)
+            {
+                EXPECT_EQ(expected, actual);
+            }
+        }
+    }
+
+    LowDiscrepancySequenceFree(halton);
+    LowDiscrepancySequenceFree(tabulated);
+    LowDiscrepancySequenceFree(duplicate);
 }
\ No newline at end of file
@@ -0,0 +1,438 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    path_guide.cc
+
+Abstract:
+
+    Integration tests which train a path guide from recorded radiance and
+    check the distribution it learns.
+
+--*/
+
+#include <cmath>
+
+#include "iris_advanced_toolkit/pcg_random.h"
+#include "iris_physx_toolkit/path_guide.h"
+#include "iris_physx_toolkit/path_tracer.h"
+#include "googletest/include/gtest/gtest.h"
+
+//
+// Defines
+//
+
+#define TRAINING_PASSES 4
+#define TRAINING_POINTS_PER_AXIS 4
+#define TRAINING_DIRECTIONS_PER_AXIS 32
+#define INTEGRATION_STEPS 1024
+
+//
+// Static Functions
+//
+
+//
+// The fixed RNG always returns the same fraction of the requested range,
+// which drives the guide to the edges of its leaves.
+//
+
+static
+ISTATUS
+FixedGenerateFloat(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _Out_range_(minimum, maximum) float_t *result
+    )
+{
+    float_t fraction = *(const float_t *)context;
+    *result = minimum + (maximum - minimum) * fraction;
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+FixedGenerateFloats(
+    _In_ void *context,
+    _In_ float_t minimum,
+    _In_ float_t maximum,
+    _In_ size_t count,
+    _Out_writes_(count) float_t *results
+    )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        FixedGenerateFloat(context, minimum, maximum, results + i);
+    }
+
+    return ISTATUS_SUCCESS;
+}
+
+static
+ISTATUS
+FixedGenerateIndex(
+    _In_ void *context,
+    _In_ size_t upper_bound,
+    _Out_range_(0, upper_bound - 1) size_t *result
+    )
+{
+    *result = 0;
+    return ISTATUS_SUCCESS;
+}
+
+static const RANDOM_VTABLE fixed_vtable = {
+    FixedGenerateFloat,
+    FixedGenerateIndex,
+    nullptr,
+    nullptr,
+    FixedGenerateFloats
+};
+
+static
+VECTOR3
+SquareToDirection(
+    _In_ float_t u,
+    _In_ float_t v
+    )
+{
+    float_t cos_theta = u + u - (float_t)1.0;
+    float_t sin_theta =
+        std::sqrt(std::fmax((float_t)0.0, (float_t)1.0 - cos_theta * cos_theta));
+    float_t phi = v * (float_t)(2.0 * M_PI);
+
+    return VectorCreate(sin_theta * std::cos(phi),
+                        sin_theta * std::sin(phi),
+                        cos_theta);
+}
+
+//
+// Radiance is only recorded from the upper hemisphere and is strongest
+// around +z, so the guide learns both subdivided and empty quadrants. It
+// also varies with the azimuth so that the leaves on either side of the
+// seam at an azimuth of zero hold different energies.
+//
+
+static
+void
+RecordTrainingPass(
+    _In_ PPATH_GUIDE path_guide
+    )
+{
+    PPATH_GUIDE_RECORDER recorder;
+    ISTATUS status = PathGuideRecorderAllocate(path_guide, &recorder);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    for (size_t x = 0; x < TRAINING_POINTS_PER_AXIS; x++)
+    {
+        for (size_t y = 0; y < TRAINING_POINTS_PER_AXIS; y++)
+        {
+            for (size_t z = 0; z < TRAINING_POINTS_PER_AXIS; z++)
+            {
+                POINT3 point = PointCreate((float_t)x, (float_t)y, (float_t)z);
+
+                for (size_t i = 0; i < TRAINING_DIRECTIONS_PER_AXIS; i++)
+                {
+                    for (size_t j = 0; j < TRAINING_DIRECTIONS_PER_AXIS; j++)
+                    {
+                        float_t u = (float_t)0.5 + (float_t)0.5 *
+                            ((float_t)i + (float_t)0.5) /
+                            (float_t)TRAINING_DIRECTIONS_PER_AXIS;
+                        float_t v = ((float_t)j + (float_t)0.5) /
+                            (float_t)TRAINING_DIRECTIONS_PER_AXIS;
+
+                        VECTOR3 direction = SquareToDirection(u, v);
+                        float_t radiance =
+                            ((float_t)1.0 + (float_t)10.0 *
+                             std::pow(direction.z, (float_t)4.0)) *
+                            ((float_t)1.5 + direction.y);
+
+                        PathGuideRecorderRecord(recorder,
+                                                point,
+                                                direction,
+                                                radiance);
+                    }
+                }
+            }
+        }
+    }
+
+    PathGuideRecorderFree(recorder);
+
+    status = PathGuideUpdate(path_guide);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+}
+
+static
+void
+AllocateTrainedPathGuide(
+    _Out_ PPATH_GUIDE *path_guide,
+    _Out_ PCPATH_GUIDE_REGION *region
+    )
+{
+    ISTATUS status = PathGuideAllocate(1000, path_guide);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    for (size_t i = 0; i < TRAINING_PASSES; i++)
+    {
+        RecordTrainingPass(*path_guide);
+    }
+
+    status = PathGuideLookup(*path_guide,
+                             PointCreate((float_t)1.0,
+                                         (float_t)2.0,
+                                         (float_t)1.0),
+                             region);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    ASSERT_NE(nullptr, *region);
+}
+
+//
+// Tests
+//
+
+TEST(PathGuideTest, AllocateErrors)
+{
+    PPATH_GUIDE path_guide;
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00, PathGuideAllocate(0, &path_guide));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01, PathGuideAllocate(1, nullptr));
+}
+
+TEST(PathGuideTest, LookupBeforeUpdate)
+{
+    PPATH_GUIDE path_guide;
+    ISTATUS status = PathGuideAllocate(1000, &path_guide);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    PCPATH_GUIDE_REGION region;
+    status = PathGuideLookup(path_guide,
+                             PointCreate((float_t)0.0,
+                                         (float_t)0.0,
+                                         (float_t)0.0),
+                             &region);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(nullptr, region);
+
+    PathGuideRelease(path_guide);
+}
+
+TEST(PathGuideTest, SamplePdfMatchesComputePdf)
+{
+    PPATH_GUIDE path_guide;
+    PCPATH_GUIDE_REGION region;
+    AllocateTrainedPathGuide(&path_guide, &region);
+
+    PRANDOM rng;
+    ISTATUS status = PermutedCongruentialRandomAllocate(
+        0x853c49e6748fea9bULL,
+        0xda3e39cb94b95bdbULL,
+        &rng);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    for (size_t i = 0; i < 100000; i++)
+    {
+        VECTOR3 direction;
+        float_t pdf;
+        status = PathGuideRegionSample(region, rng, &direction, &pdf);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        ASSERT_LT((float_t)0.0, pdf);
+        ASSERT_EQ(PathGuideRegionComputePdf(region, direction), pdf);
+    }
+
+    RandomFree(rng);
+    PathGuideRelease(path_guide);
+}
+
+TEST(PathGuideTest, SamplePdfMatchesComputePdfAtLeafEdges)
+{
+    PPATH_GUIDE path_guide;
+    PCPATH_GUIDE_REGION region;
+    AllocateTrainedPathGuide(&path_guide, &region);
+
+    const float_t fractions[] = {
+        (float_t)0.0,
+        (float_t)0.5,
+        (float_t)1.0
+    };
+
+    for (float_t fraction : fractions)
+    {
+        PRANDOM rng;
+        ISTATUS status = RandomAllocate(&fixed_vtable,
+                                        &fraction,
+                                        sizeof(float_t),
+                                        alignof(float_t),
+                                        &rng);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        VECTOR3 direction;
+        float_t pdf;
+        status = PathGuideRegionSample(region, rng, &direction, &pdf);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        EXPECT_LT((float_t)0.0, pdf);
+        EXPECT_EQ(PathGuideRegionComputePdf(region, direction), pdf);
+
+        RandomFree(rng);
+    }
+
+    PathGuideRelease(path_guide);
+}
+
+TEST(PathGuideTest, PdfIntegratesToOne)
+{
+    PPATH_GUIDE path_guide;
+    PCPATH_GUIDE_REGION region;
+    AllocateTrainedPathGuide(&path_guide, &region);
+
+    //
+    // The mapping from the unit square to the sphere preserves area, so the
+    // integral over the sphere is a sum over a grid on the square.
+    //
+
+    double sum = 0.0;
+    size_t empty_cells = 0;
+    for (size_t i = 0; i < INTEGRATION_STEPS; i++)
+    {
+        for (size_t j = 0; j < INTEGRATION_STEPS; j++)
+        {
+            float_t u = ((float_t)i + (float_t)0.5) /
+                        (float_t)INTEGRATION_STEPS;
+            float_t v = ((float_t)j + (float_t)0.5) /
+                        (float_t)INTEGRATION_STEPS;
+
+            float_t pdf =
+                PathGuideRegionComputePdf(region, SquareToDirection(u, v));
+            sum += (double)pdf;
+
+            if (pdf == (float_t)0.0)
+            {
+                empty_cells += 1;
+            }
+        }
+    }
+
+    double cell_area =
+        4.0 * M_PI / (double)(INTEGRATION_STEPS * INTEGRATION_STEPS);
+    EXPECT_NEAR(1.0, sum * cell_area, 0.001);
+    EXPECT_LT(0u, empty_cells);
+
+    PathGuideRelease(path_guide);
+}
+
+TEST(PathGuideTest, PathTracerAllocateWithPathGuideErrors)
+{
+    PPATH_GUIDE path_guide;
+    ISTATUS status = PathGuideAllocate(1000, &path_guide);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t wavelengths[2] = { (float_t)450.0, (float_t)550.0 };
+    float_t bad_wavelengths[2] = { (float_t)450.0, (float_t)INFINITY };
+
+    PINTEGRATOR integrator;
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)2.0,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              wavelengths,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_03,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)-1.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              wavelengths,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_04,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              nullptr,
+                                              (float_t)0.5,
+                                              0,
+                                              wavelengths,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_05,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.0,
+                                              0,
+                                              wavelengths,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_07,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              nullptr,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_07,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              bad_wavelengths,
+                                              2,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_08,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              wavelengths,
+                                              0,
+                                              &integrator));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_09,
+              PathTracerAllocateWithPathGuide(0,
+                                              5,
+                                              (float_t)0.05,
+                                              (float_t)0.0,
+                                              path_guide,
+                                              (float_t)0.5,
+                                              0,
+                                              wavelengths,
+                                              2,
+                                              nullptr));
+
+    status = PathTracerAllocateWithPathGuide(0,
+                                             5,
+                                             (float_t)0.05,
+                                             (float_t)0.0,
+                                             path_guide,
+                                             (float_t)0.5,
+                                             0,
+                                             wavelengths,
+                                             2,
+                                             &integrator);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    IntegratorFree(integrator);
+    PathGuideRelease(path_guide);
+}
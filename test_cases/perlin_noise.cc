@@ -0,0 +1,244 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    perlin_noise.cc
+
+Abstract:
+
+    Integration tests which check that the batched Perlin noise routines and
+    the noise volume agree with the single point routines.
+
+--*/
+
+#include <cmath>
+
+#include "iris_physx_toolkit/perlin_noise.h"
+#include "googletest/include/gtest/gtest.h"
+
+//
+// Defines
+//
+
+#define NUM_TEST_POINTS 37
+#define TEST_OMEGA ((float_t)0.5)
+#define TEST_MAX_OCTAVES 8
+
+//
+// Static Functions
+//
+
+//
+// The number of points is not a multiple of the block size so the final
+// partial block is covered. The points span several lattice periods and
+// both signs, and the derivatives are scaled so that every number of fBm
+// octaves is reached with and without a partial octave.
+//
+
+static
+void
+CreateTestPoints(
+    _Out_writes_(NUM_TEST_POINTS) POINT3 points[],
+    _Out_writes_(NUM_TEST_POINTS) VECTOR3 dpoints_dx[],
+    _Out_writes_(NUM_TEST_POINTS) VECTOR3 dpoints_dy[]
+    )
+{
+    for (size_t i = 0; i < NUM_TEST_POINTS; i++)
+    {
+        float_t index = (float_t)i;
+        points[i] = PointCreate(index * (float_t)7.31 - (float_t)123.4,
+                                index * (float_t)-2.79 + (float_t)0.17,
+                                index * (float_t)0.457 - (float_t)3.9);
+
+        float_t scale =
+            (float_t)std::pow(2.0, -(double)(i % 12) + (double)(i % 3) * 0.3);
+        dpoints_dx[i] = VectorCreate(scale, (float_t)0.0, (float_t)0.0);
+        dpoints_dy[i] = VectorCreate((float_t)0.0,
+                                     scale * (float_t)0.5,
+                                     scale * (float_t)0.5);
+    }
+}
+
+//
+// Tests
+//
+
+TEST(PerlinNoise, BatchErrors)
+{
+    POINT3 point = PointCreate((float_t)0.5, (float_t)0.5, (float_t)0.5);
+    VECTOR3 vector = VectorCreate((float_t)1.0, (float_t)0.0, (float_t)0.0);
+    float_t value;
+
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00,
+              PerlinNoiseBatch(nullptr, 1, &value));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02,
+              PerlinNoiseBatch(&point, 1, nullptr));
+    EXPECT_EQ(ISTATUS_SUCCESS, PerlinNoiseBatch(nullptr, 0, nullptr));
+
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00,
+              PerlinFractionalBrownianNoiseBatch(nullptr,
+                                                 &vector,
+                                                 &vector,
+                                                 TEST_OMEGA,
+                                                 TEST_MAX_OCTAVES,
+                                                 1,
+                                                 &value));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01,
+              PerlinFractionalBrownianNoiseBatch(&point,
+                                                 nullptr,
+                                                 &vector,
+                                                 TEST_OMEGA,
+                                                 TEST_MAX_OCTAVES,
+                                                 1,
+                                                 &value));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_02,
+              PerlinFractionalBrownianNoiseBatch(&point,
+                                                 &vector,
+                                                 nullptr,
+                                                 TEST_OMEGA,
+                                                 TEST_MAX_OCTAVES,
+                                                 1,
+                                                 &value));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_03,
+              PerlinFractionalBrownianNoiseBatch(&point,
+                                                 &vector,
+                                                 &vector,
+                                                 (float_t)INFINITY,
+                                                 TEST_MAX_OCTAVES,
+                                                 1,
+                                                 &value));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_06,
+              PerlinFractionalBrownianNoiseBatch(&point,
+                                                 &vector,
+                                                 &vector,
+                                                 TEST_OMEGA,
+                                                 TEST_MAX_OCTAVES,
+                                                 1,
+                                                 nullptr));
+}
+
+TEST(PerlinNoise, BatchMatchesScalar)
+{
+    POINT3 points[NUM_TEST_POINTS];
+    VECTOR3 dpoints_dx[NUM_TEST_POINTS], dpoints_dy[NUM_TEST_POINTS];
+    CreateTestPoints(points, dpoints_dx, dpoints_dy);
+
+    float_t values[NUM_TEST_POINTS];
+    ISTATUS status = PerlinNoiseBatch(points, NUM_TEST_POINTS, values);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    for (size_t i = 0; i < NUM_TEST_POINTS; i++)
+    {
+        EXPECT_EQ(PerlinNoise(points[i]), values[i]);
+
+        VECTOR3 gradient;
+        EXPECT_EQ(values[i], PerlinNoiseWithGradient(points[i], &gradient));
+    }
+}
+
+TEST(PerlinNoise, FractionalBrownianNoiseBatchMatchesScalar)
+{
+    POINT3 points[NUM_TEST_POINTS];
+    VECTOR3 dpoints_dx[NUM_TEST_POINTS], dpoints_dy[NUM_TEST_POINTS];
+    CreateTestPoints(points, dpoints_dx, dpoints_dy);
+
+    float_t values[NUM_TEST_POINTS];
+    ISTATUS status = PerlinFractionalBrownianNoiseBatch(points,
+                                                        dpoints_dx,
+                                                        dpoints_dy,
+                                                        TEST_OMEGA,
+                                                        TEST_MAX_OCTAVES,
+                                                        NUM_TEST_POINTS,
+                                                        values);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    for (size_t i = 0; i < NUM_TEST_POINTS; i++)
+    {
+        float_t value = PerlinFractionalBrownianNoise(points[i],
+                                                      dpoints_dx[i],
+                                                      dpoints_dy[i],
+                                                      TEST_OMEGA,
+                                                      TEST_MAX_OCTAVES);
+        EXPECT_EQ(value, values[i]);
+
+        VECTOR3 gradient;
+        value = PerlinFractionalBrownianNoiseWithGradient(points[i],
+                                                          dpoints_dx[i],
+                                                          dpoints_dy[i],
+                                                          TEST_OMEGA,
+                                                          TEST_MAX_OCTAVES,
+                                                          &gradient);
+        EXPECT_EQ(value, values[i]);
+    }
+}
+
+TEST(PerlinNoise, GradientMatchesFiniteDifferences)
+{
+    POINT3 points[NUM_TEST_POINTS];
+    VECTOR3 dpoints_dx[NUM_TEST_POINTS], dpoints_dy[NUM_TEST_POINTS];
+    CreateTestPoints(points, dpoints_dx, dpoints_dy);
+
+    const float_t step = (float_t)1e-3;
+    for (size_t i = 0; i < NUM_TEST_POINTS; i++)
+    {
+        VECTOR3 gradient;
+        PerlinNoiseWithGradient(points[i], &gradient);
+
+        POINT3 p = points[i];
+        float_t dx = PerlinNoise(PointCreate(p.x + step, p.y, p.z)) -
+                     PerlinNoise(PointCreate(p.x - step, p.y, p.z));
+        float_t dy = PerlinNoise(PointCreate(p.x, p.y + step, p.z)) -
+                     PerlinNoise(PointCreate(p.x, p.y - step, p.z));
+        float_t dz = PerlinNoise(PointCreate(p.x, p.y, p.z + step)) -
+                     PerlinNoise(PointCreate(p.x, p.y, p.z - step));
+
+        EXPECT_NEAR(dx / ((float_t)2.0 * step), gradient.x, (float_t)0.01);
+        EXPECT_NEAR(dy / ((float_t)2.0 * step), gradient.y, (float_t)0.01);
+        EXPECT_NEAR(dz / ((float_t)2.0 * step), gradient.z, (float_t)0.01);
+    }
+}
+
+TEST(PerlinNoise, NoiseVolumeAllocateErrors)
+{
+    PNOISE_VOLUME noise_volume;
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00,
+              NoiseVolumeAllocate(1, &noise_volume));
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_01, NoiseVolumeAllocate(4, nullptr));
+}
+
+TEST(PerlinNoise, NoiseVolumeMatchesNoiseAtSamples)
+{
+    const size_t resolution = 4;
+
+    PNOISE_VOLUME noise_volume;
+    ISTATUS status = NoiseVolumeAllocate(resolution, &noise_volume);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    //
+    // Away from the last lattice cell of the period the tileable noise is
+    // the same as the noise, so the baked samples reproduce it exactly.
+    //
+
+    for (size_t i = 0; i < NUM_TEST_POINTS; i++)
+    {
+        float_t x = (float_t)(i * 7 % 60) / (float_t)resolution;
+        float_t y = (float_t)(i * 11 % 60) / (float_t)resolution;
+        float_t z = (float_t)(i * 13 % 60) / (float_t)resolution;
+        POINT3 point = PointCreate(x, y, z);
+
+        EXPECT_NEAR(PerlinNoise(point),
+                    NoiseVolumeLookup(noise_volume, point),
+                    (float_t)1e-5);
+
+        POINT3 shifted = PointCreate(x - (float_t)NOISE_VOLUME_PERIOD,
+                                     y + (float_t)NOISE_VOLUME_PERIOD,
+                                     z + (float_t)(2 * NOISE_VOLUME_PERIOD));
+        EXPECT_NEAR(NoiseVolumeLookup(noise_volume, point),
+                    NoiseVolumeLookup(noise_volume, shifted),
+                    (float_t)1e-5);
+    }
+
+    NoiseVolumeRelease(noise_volume);
+}
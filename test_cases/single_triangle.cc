@@ -95,7 +95,9 @@ TriangleMaterialFree(
 
 static const MATERIAL_VTABLE triangle_material_vtable = {
     TriangleMaterialSample,
-    TriangleMaterialFree
+    TriangleMaterialFree,
+    nullptr,
+    nullptr
 };
 
 ISTATUS
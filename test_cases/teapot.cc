@@ -12,25 +12,32 @@ Abstract:
 
 --*/
 
+#include <algorithm>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "iris_advanced_toolkit/matrix_cache.h"
 #include "iris_advanced_toolkit/pcg_random.h"
 #include "iris_camera_toolkit/grid_image_sampler.h"
 #include "iris_camera_toolkit/pinhole_camera.h"
 #include "iris_physx_toolkit/bsdfs/lambertian.h"
 #include "iris_physx_toolkit/materials/constant.h"
+#include "iris_physx_toolkit/materials/matte.h"
 #include "iris_physx_toolkit/scenes/bvh.h"
 #include "iris_physx_toolkit/scenes/kd_tree.h"
 #include "iris_physx_toolkit/shapes/triangle_mesh.h"
 #include "iris_physx_toolkit/all_light_sampler.h"
 #include "iris_physx_toolkit/attenuated_reflector.h"
 #include "iris_physx_toolkit/color_spectra.h"
+#include "iris_physx_toolkit/constant_texture.h"
 #include "iris_physx_toolkit/path_tracer.h"
 #include "iris_physx_toolkit/point_light.h"
+#include "iris_physx_toolkit/product_texture.h"
 #include "iris_physx_toolkit/sample_tracer.h"
 #include "iris_physx_toolkit/triangle_mesh_normal_map.h"
+#include "iris_physx_toolkit/uniform_reflector.h"
+#include "iris_physx_toolkit/wavefront_path_tracer.h"
 #include "googletest/include/gtest/gtest.h"
 #include "test_util/teapot.h"
 #include "test_util/pfm.h"
@@ -40,10 +47,13 @@ Abstract:
 //
 
 void
-TestRenderSingleThreaded(
+RenderWithIntegrator(
     _In_ PSCENE scene,
     _In_ PLIGHT_SAMPLER light_sampler,
-    _In_ const std::string& file_name
+    _In_ PINTEGRATOR integrator,
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close,
+    _Out_ PFRAMEBUFFER *framebuffer
     )
 {
     PCAMERA camera;
@@ -57,6 +67,9 @@ TestRenderSingleThreaded(
         &camera);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
+    status = CameraSetShutter(camera, shutter_open, shutter_close);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
     PIMAGE_SAMPLER image_sampler;
     status = GridImageSamplerAllocate(1, 1, false, 1, 1, false, &image_sampler);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
@@ -68,26 +81,21 @@ TestRenderSingleThreaded(
         &rng);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
-    PINTEGRATOR path_tracer;
-    status = PathTracerAllocate(0, 0, (float_t)0.00, INFINITY, &path_tracer);
-    ASSERT_EQ(status, ISTATUS_SUCCESS);
-
     PCOLOR_INTEGRATOR color_integrator;
     status = ColorColorIntegratorAllocate(COLOR_SPACE_XYZ, &color_integrator);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
     PSAMPLE_TRACER sample_tracer;
-    status = PhysxSampleTracerAllocate(path_tracer, &sample_tracer);
+    status = PhysxSampleTracerAllocate(integrator, &sample_tracer);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
-    status = IntegratorPrepare(path_tracer,
+    status = IntegratorPrepare(integrator,
                                scene,
                                light_sampler,
                                color_integrator);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
-    PFRAMEBUFFER framebuffer;
-    status = FramebufferAllocate(256, 256, &framebuffer);
+    status = FramebufferAllocate(256, 256, framebuffer);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
     status = IrisCameraRender(camera,
@@ -95,29 +103,72 @@ TestRenderSingleThreaded(
                               image_sampler,
                               sample_tracer,
                               rng,
-                              framebuffer,
+                              *framebuffer,
                               nullptr,
                               (float_t)0.01,
                               1);
     ASSERT_EQ(status, ISTATUS_SUCCESS);
 
-    bool equals;
-    status = ApproximatelyEqualsPfmFile(framebuffer,
-                                        file_name.c_str(),
-                                        COLOR_SPACE_XYZ,
-                                        (float_t)0.01,
-                                        &equals);
-    ASSERT_EQ(status, ISTATUS_SUCCESS);
-    EXPECT_TRUE(equals);
-
     CameraFree(camera);
     ImageSamplerFree(image_sampler);
     RandomFree(rng);
     SampleTracerFree(sample_tracer);
     ColorIntegratorRelease(color_integrator);
+}
+
+void
+TestRenderWithIntegrator(
+    _In_ PSCENE scene,
+    _In_ PLIGHT_SAMPLER light_sampler,
+    _In_ PINTEGRATOR integrator,
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close,
+    _In_ const std::string& file_name
+    )
+{
+    PFRAMEBUFFER framebuffer;
+    RenderWithIntegrator(scene,
+                         light_sampler,
+                         integrator,
+                         shutter_open,
+                         shutter_close,
+                         &framebuffer);
+
+    bool equals;
+    ISTATUS status = ApproximatelyEqualsPfmFile(framebuffer,
+                                                file_name.c_str(),
+                                                COLOR_SPACE_XYZ,
+                                                (float_t)0.01,
+                                                &equals);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+    EXPECT_TRUE(equals);
+
     FramebufferFree(framebuffer);
 }
 
+void
+TestRenderSingleThreaded(
+    _In_ PSCENE scene,
+    _In_ PLIGHT_SAMPLER light_sampler,
+    _In_ const std::string& file_name
+    )
+{
+    PINTEGRATOR path_tracer;
+    ISTATUS status = PathTracerAllocate(0,
+                                        0,
+                                        (float_t)0.00,
+                                        INFINITY,
+                                        &path_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderWithIntegrator(scene,
+                             light_sampler,
+                             path_tracer,
+                             (float_t)0.0,
+                             (float_t)0.0,
+                             file_name);
+}
+
 TEST(TeapotTest, FlatShadedTeapot)
 {
     PCOLOR_EXTRAPOLATOR color_extrapolator;
@@ -619,4 +670,1019 @@ TEST(TeapotTest, SmoothShadedTeapotBvhAggregate)
     SceneRelease(scene);
     LightSamplerRelease(light_sampler);
     ColorExtrapolatorFree(color_extrapolator);
+}
+
+static
+void
+CreateTeapotWithMaterial(
+    _In_reads_(TEAPOT_VERTEX_COUNT) const POINT3 vertices[],
+    _In_ bool smooth_shaded,
+    _In_ PMATERIAL material,
+    _Out_writes_(TEAPOT_FACE_COUNT) PSHAPE shapes[],
+    _Out_ size_t *triangles_allocated,
+    _Out_ PLIGHT_SAMPLER *light_sampler
+    )
+{
+    PCOLOR_EXTRAPOLATOR color_extrapolator;
+    ISTATUS status = ColorColorExtrapolatorAllocate(COLOR_SPACE_XYZ,
+                                                    &color_extrapolator);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t spectrum_color_values[3] =
+        { (float_t)32.0, (float_t)0.0, (float_t)0.0 };
+    COLOR3 spectrum_color = ColorCreate(COLOR_SPACE_XYZ, spectrum_color_values);
+
+    PSPECTRUM spectrum;
+    status = ColorExtrapolatorComputeSpectrum(color_extrapolator,
+                                              spectrum_color,
+                                              &spectrum);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PLIGHT light;
+    status = PointLightAllocate(
+        PointCreate((float_t)0.0, (float_t)0.0, (float_t)-5.0),
+        spectrum,
+        &light);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = AllLightSamplerAllocate(&light, 1, light_sampler);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PNORMAL_MAP normal_map = nullptr;
+    if (smooth_shaded)
+    {
+        status = TriangleMeshNormalMapAllocate(teapot_normals,
+                                               TEAPOT_VERTEX_COUNT,
+                                               &normal_map);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+    }
+
+    status = TriangleMeshAllocate(
+        vertices,
+        TEAPOT_VERTEX_COUNT,
+        teapot_face_vertices,
+        TEAPOT_FACE_COUNT,
+        nullptr,
+        nullptr,
+        normal_map,
+        nullptr,
+        material,
+        nullptr,
+        nullptr,
+        nullptr,
+        shapes,
+        triangles_allocated);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    SpectrumRelease(spectrum);
+    NormalMapRelease(normal_map);
+    LightRelease(light);
+    ColorExtrapolatorFree(color_extrapolator);
+}
+
+static
+void
+CreateTeapotReflector(
+    _Out_ PREFLECTOR *reflector
+    )
+{
+    PCOLOR_EXTRAPOLATOR color_extrapolator;
+    ISTATUS status = ColorColorExtrapolatorAllocate(COLOR_SPACE_XYZ,
+                                                    &color_extrapolator);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t reflector_color_values[3] =
+        { (float_t)1.0, (float_t)0.0, (float_t)0.0 };
+    COLOR3 reflector_color = ColorCreate(COLOR_SPACE_XYZ,
+                                         reflector_color_values);
+
+    status = ColorExtrapolatorComputeReflector(color_extrapolator,
+                                               reflector_color,
+                                               reflector);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    ColorExtrapolatorFree(color_extrapolator);
+}
+
+static
+void
+CreateTeapot(
+    _In_reads_(TEAPOT_VERTEX_COUNT) const POINT3 vertices[],
+    _In_ bool smooth_shaded,
+    _Out_writes_(TEAPOT_FACE_COUNT) PSHAPE shapes[],
+    _Out_ size_t *triangles_allocated,
+    _Out_ PLIGHT_SAMPLER *light_sampler
+    )
+{
+    PREFLECTOR reflector;
+    CreateTeapotReflector(&reflector);
+
+    PBSDF bsdf;
+    ISTATUS status = LambertianBsdfAllocate(reflector, &bsdf);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PMATERIAL material;
+    status = ConstantMaterialAllocate(bsdf, &material);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    CreateTeapotWithMaterial(vertices,
+                             smooth_shaded,
+                             material,
+                             shapes,
+                             triangles_allocated,
+                             light_sampler);
+
+    ReflectorRelease(reflector);
+    BsdfRelease(bsdf);
+    MaterialRelease(material);
+}
+
+static
+void
+ReleaseTeapot(
+    _In_reads_(triangles_allocated) PSHAPE shapes[],
+    _In_ size_t triangles_allocated
+    )
+{
+    for (size_t i = 0; i < triangles_allocated; i++)
+    {
+        ShapeRelease(shapes[i]);
+    }
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhInstances)
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSHAPE aggregate;
+    ISTATUS status = BvhAggregateAllocate(shapes,
+                                          triangles_allocated,
+                                          &aggregate);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PMATRIX transforms[2];
+    status = MatrixAllocateTranslation((float_t)100.0,
+                                       (float_t)0.0,
+                                       (float_t)0.0,
+                                       &transforms[0]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       (float_t)-100.0,
+                                       &transforms[1]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PSHAPE instanced_shapes[2] = { aggregate, aggregate };
+    PBVH_INSTANCES instances;
+    status = BvhInstancesAllocate(instanced_shapes,
+                                  transforms,
+                                  2,
+                                  &instances);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PSCENE scene;
+    status = BvhInstancesSceneAllocate(instances, nullptr, &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhInstancesSetTransform(instances, 0, nullptr);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhInstancesRefit(instances, (float_t)1.0, 1);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    ShapeRelease(aggregate);
+    MatrixRelease(transforms[0]);
+    MatrixRelease(transforms[1]);
+    BvhInstancesRelease(instances);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+TestBvhInstancesRebuild(
+    _In_ size_t num_instances,
+    _In_ size_t num_threads
+    )
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSHAPE aggregate;
+    ISTATUS status = BvhAggregateAllocate(shapes,
+                                          triangles_allocated,
+                                          &aggregate);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<PMATRIX> transforms(num_instances);
+    std::vector<PSHAPE> instanced_shapes(num_instances);
+    for (size_t i = 0; i < num_instances; i++)
+    {
+        status = MatrixAllocateTranslation((float_t)(i % 8) * (float_t)10.0,
+                                           (float_t)(i / 8) * (float_t)10.0,
+                                           (float_t)-100.0,
+                                           &transforms[i]);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        instanced_shapes[i] = aggregate;
+    }
+
+    PBVH_INSTANCES instances;
+    status = BvhInstancesAllocate(instanced_shapes.data(),
+                                  transforms.data(),
+                                  num_instances,
+                                  &instances);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PSCENE scene;
+    status = BvhInstancesSceneAllocate(instances, nullptr, &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    for (size_t i = 0; i < num_instances; i++)
+    {
+        MatrixRelease(transforms[i]);
+
+        status = MatrixAllocateTranslation((float_t)(i / 8) * (float_t)-10.0,
+                                           (float_t)(i % 8) * (float_t)-10.0,
+                                           (float_t)(i + 100) * (float_t)-2.0,
+                                           &transforms[i]);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        status = BvhInstancesSetTransform(instances, i, transforms[i]);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+    }
+
+    status = BvhInstancesRefit(instances, (float_t)1.5, num_threads);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhInstancesSetTransform(instances, 37, nullptr);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhInstancesRefit(instances, (float_t)1.5, num_threads);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    ShapeRelease(aggregate);
+
+    for (size_t i = 0; i < num_instances; i++)
+    {
+        MatrixRelease(transforms[i]);
+    }
+
+    BvhInstancesRelease(instances);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhInstancesRebuild)
+{
+    TestBvhInstancesRebuild(64, 1);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhInstancesRebuildMultithreaded)
+{
+    TestBvhInstancesRebuild(4096, 4);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhMatrixCache)
+{
+    std::vector<POINT3> vertices;
+    for (size_t i = 0; i < TEAPOT_VERTEX_COUNT; i++)
+    {
+        vertices.push_back(PointCreate(teapot_vertices[i].x,
+                                       teapot_vertices[i].y,
+                                       teapot_vertices[i].z + (float_t)2.0));
+    }
+
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(vertices.data(),
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PMATRIX_CACHE matrix_cache;
+    ISTATUS status = MatrixCacheAllocate(&matrix_cache);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PMATRIX half_translation;
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       (float_t)-1.0,
+                                       &half_translation);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<PMATRIX> transforms(triangles_allocated);
+    for (size_t i = 0; i < triangles_allocated; i++)
+    {
+        status = MatrixCacheAllocateProduct(matrix_cache,
+                                            half_translation,
+                                            half_translation,
+                                            &transforms[i]);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+        ASSERT_NE(nullptr, transforms[i]);
+        EXPECT_EQ(transforms[0], transforms[i]);
+    }
+
+    PMATRIX translation;
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       (float_t)-2.0,
+                                       &translation);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PMATRIX interned;
+    status = MatrixCacheIntern(matrix_cache, translation, &interned);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+    EXPECT_EQ(transforms[0], interned);
+    MatrixRelease(interned);
+
+    PMATRIX inverse;
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       (float_t)2.0,
+                                       &inverse);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PMATRIX identity;
+    status = MatrixCacheAllocateProduct(matrix_cache,
+                                        translation,
+                                        inverse,
+                                        &identity);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+    EXPECT_EQ(nullptr, identity);
+
+    PSCENE scene;
+    status = BvhSceneAllocate(shapes,
+                              transforms.data(),
+                              nullptr,
+                              triangles_allocated,
+                              nullptr,
+                              &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+
+    for (size_t i = 0; i < triangles_allocated; i++)
+    {
+        MatrixRelease(transforms[i]);
+    }
+
+    MatrixRelease(half_translation);
+    MatrixRelease(translation);
+    MatrixRelease(inverse);
+    MatrixCacheFree(matrix_cache);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+TestBvhMotion(
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close,
+    _In_ float_t offset0,
+    _In_ float_t offset1
+    )
+{
+    std::vector<POINT3> vertices;
+    for (size_t i = 0; i < TEAPOT_VERTEX_COUNT; i++)
+    {
+        vertices.push_back(PointCreate(teapot_vertices[i].x,
+                                       teapot_vertices[i].y,
+                                       teapot_vertices[i].z + (float_t)2.0));
+    }
+
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(vertices.data(),
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PMATRIX translations[2];
+    ISTATUS status = MatrixAllocateTranslation((float_t)0.0,
+                                               (float_t)0.0,
+                                               offset0,
+                                               &translations[0]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       offset1,
+                                       &translations[1]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<PMATRIX> transforms0(triangles_allocated, translations[0]);
+    std::vector<PMATRIX> transforms1(triangles_allocated, translations[1]);
+
+    PSCENE scene;
+    status = BvhMotionSceneAllocate(shapes,
+                                    transforms0.data(),
+                                    transforms1.data(),
+                                    triangles_allocated,
+                                    (float_t)0.0,
+                                    (float_t)1.0,
+                                    nullptr,
+                                    &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PINTEGRATOR path_tracer;
+    status = PathTracerAllocate(0, 0, (float_t)0.00, INFINITY, &path_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderWithIntegrator(scene,
+                             light_sampler,
+                             path_tracer,
+                             shutter_open,
+                             shutter_close,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    MatrixRelease(translations[0]);
+    MatrixRelease(translations[1]);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhMotionStationary)
+{
+    TestBvhMotion((float_t)0.0,
+                  (float_t)1.0,
+                  (float_t)-2.0,
+                  (float_t)-2.0);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhMotionShutterAfterKeyframes)
+{
+    TestBvhMotion((float_t)2.0,
+                  (float_t)3.0,
+                  (float_t)8.0,
+                  (float_t)-2.0);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhSceneBuilder)
+{
+    PBVH_SCENE_BUILDER builder;
+    ISTATUS status = BvhSceneBuilderAllocate(&builder);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<POINT3> vertices;
+    for (size_t i = 0; i < TEAPOT_VERTEX_COUNT; i++)
+    {
+        vertices.push_back(PointCreate(teapot_vertices[i].x,
+                                       teapot_vertices[i].y,
+                                       teapot_vertices[i].z + (float_t)2.0));
+    }
+
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(vertices.data(),
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PMATRIX translation;
+    status = MatrixAllocateTranslation((float_t)0.0,
+                                       (float_t)0.0,
+                                       (float_t)-2.0,
+                                       &translation);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    const size_t chunk_size = 1000;
+    std::vector<PMATRIX> transforms(chunk_size, translation);
+    for (size_t i = 0; i < triangles_allocated; i += chunk_size)
+    {
+        size_t num_shapes = std::min(chunk_size, triangles_allocated - i);
+        status = BvhSceneBuilderAddShapes(builder,
+                                          shapes + i,
+                                          transforms.data(),
+                                          nullptr,
+                                          num_shapes);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        ReleaseTeapot(shapes + i, num_shapes);
+    }
+
+    MatrixRelease(translation);
+
+    PSCENE scene;
+    status = BvhSceneBuilderBuild(builder, nullptr, &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    status = BvhSceneBuilderAddShapes(builder,
+                                      shapes,
+                                      nullptr,
+                                      nullptr,
+                                      triangles_allocated);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    ReleaseTeapot(shapes, triangles_allocated);
+
+    status = BvhSceneBuilderBuild(builder, nullptr, &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    BvhSceneBuilderFree(builder);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhCompressed)
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSCENE scene;
+    ISTATUS status = BvhCompressedSceneAllocate(shapes,
+                                                nullptr,
+                                                nullptr,
+                                                triangles_allocated,
+                                                nullptr,
+                                                &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    SceneRelease(scene);
+
+    PBVH_SCENE_BUILDER builder;
+    status = BvhSceneBuilderAllocate(&builder);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhSceneBuilderAddShapes(builder,
+                                      shapes,
+                                      nullptr,
+                                      nullptr,
+                                      triangles_allocated);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = BvhSceneBuilderBuildCompressed(builder, nullptr, &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    BvhSceneBuilderFree(builder);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, FlatShadedTeapotBvhCompressed)
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 false,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSCENE scene;
+    ISTATUS status = BvhCompressedSceneAllocate(shapes,
+                                                nullptr,
+                                                nullptr,
+                                                triangles_allocated,
+                                                nullptr,
+                                                &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_flat.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+TestBvhSpatial(
+    _In_ bool smooth_shaded,
+    _In_ float_t max_duplication,
+    _In_ const std::string& file_name
+    )
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 smooth_shaded,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSCENE scene;
+    ISTATUS status = BvhSpatialSceneAllocate(shapes,
+                                             nullptr,
+                                             nullptr,
+                                             triangles_allocated,
+                                             max_duplication,
+                                             nullptr,
+                                             &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene, light_sampler, file_name);
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, FlatShadedTeapotBvhSpatial)
+{
+    TestBvhSpatial(false, (float_t)0.5, "test_results/teapot_flat.pfm");
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhSpatial)
+{
+    TestBvhSpatial(true, (float_t)0.5, "test_results/teapot_smooth.pfm");
+}
+
+TEST(TeapotTest, SmoothShadedTeapotBvhSpatialNoDuplication)
+{
+    TestBvhSpatial(true, (float_t)0.0, "test_results/teapot_smooth.pfm");
+}
+
+TEST(TeapotTest, SmoothShadedTeapotWavefront)
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PSCENE scene;
+    ISTATUS status = BvhSceneAllocate(shapes,
+                                      nullptr,
+                                      nullptr,
+                                      triangles_allocated,
+                                      nullptr,
+                                      &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PINTEGRATOR path_tracer;
+    status = WavefrontPathTracerAllocate(0,
+                                         0,
+                                         (float_t)0.00,
+                                         INFINITY,
+                                         false,
+                                         &path_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderWithIntegrator(scene,
+                             light_sampler,
+                             path_tracer,
+                             (float_t)0.0,
+                             (float_t)0.0,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+CreateTwoMaterialTeapotScene(
+    _Out_ PSCENE *scene,
+    _Out_ PLIGHT_SAMPLER *light_sampler
+    )
+{
+    //
+    // Each call to CreateTeapot allocates its own material, so taking half of
+    // the triangles from each teapot gives a scene with two materials for the
+    // deferred shading stage to sort between.
+    //
+
+    PSHAPE shapes[2][TEAPOT_FACE_COUNT] = { { nullptr } };
+    size_t triangles_allocated[2];
+    PLIGHT_SAMPLER light_samplers[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+        CreateTeapot(teapot_vertices,
+                     true,
+                     shapes[i],
+                     triangles_allocated + i,
+                     light_samplers + i);
+    }
+
+    ASSERT_EQ(triangles_allocated[0], triangles_allocated[1]);
+
+    std::vector<PSHAPE> scene_shapes;
+    for (size_t i = 0; i < triangles_allocated[0]; i++)
+    {
+        scene_shapes.push_back(shapes[i % 2][i]);
+    }
+
+    ISTATUS status = BvhSceneAllocate(scene_shapes.data(),
+                                      nullptr,
+                                      nullptr,
+                                      scene_shapes.size(),
+                                      nullptr,
+                                      scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    ReleaseTeapot(shapes[0], triangles_allocated[0]);
+    ReleaseTeapot(shapes[1], triangles_allocated[1]);
+    LightSamplerRelease(light_samplers[1]);
+
+    *light_sampler = light_samplers[0];
+}
+
+TEST(TeapotTest, SmoothShadedTeapotWavefrontDeferred)
+{
+    PSCENE scene;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTwoMaterialTeapotScene(&scene, &light_sampler);
+
+    PINTEGRATOR path_tracer;
+    ISTATUS status = WavefrontPathTracerAllocate(0,
+                                                 0,
+                                                 (float_t)0.00,
+                                                 INFINITY,
+                                                 true,
+                                                 &path_tracer);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderWithIntegrator(scene,
+                             light_sampler,
+                             path_tracer,
+                             (float_t)0.0,
+                             (float_t)0.0,
+                             "test_results/teapot_smooth.pfm");
+
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+TestWavefrontDeferredMatchesImmediate(
+    _In_ PSCENE scene,
+    _In_ PLIGHT_SAMPLER light_sampler,
+    _In_ float_t shutter_open,
+    _In_ float_t shutter_close
+    )
+{
+    PFRAMEBUFFER framebuffers[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+        PINTEGRATOR path_tracer;
+        ISTATUS status = WavefrontPathTracerAllocate(1,
+                                                     4,
+                                                     (float_t)0.05,
+                                                     INFINITY,
+                                                     i == 1,
+                                                     &path_tracer);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        RenderWithIntegrator(scene,
+                             light_sampler,
+                             path_tracer,
+                             shutter_open,
+                             shutter_close,
+                             framebuffers + i);
+    }
+
+    for (size_t row = 0; row < 256; row++)
+    {
+        for (size_t column = 0; column < 256; column++)
+        {
+            COLOR3 colors[2];
+            for (size_t i = 0; i < 2; i++)
+            {
+                ISTATUS status = FramebufferGetPixel(framebuffers[i],
+                                                     column,
+                                                     row,
+                                                     colors + i);
+                ASSERT_EQ(status, ISTATUS_SUCCESS);
+            }
+
+            EXPECT_EQ(colors[0].values[0], colors[1].values[0]);
+            EXPECT_EQ(colors[0].values[1], colors[1].values[1]);
+            EXPECT_EQ(colors[0].values[2], colors[1].values[2]);
+        }
+    }
+
+    FramebufferFree(framebuffers[0]);
+    FramebufferFree(framebuffers[1]);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotWavefrontDeferredMatchesImmediate)
+{
+    PSCENE scene;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTwoMaterialTeapotScene(&scene, &light_sampler);
+
+    TestWavefrontDeferredMatchesImmediate(scene,
+                                          light_sampler,
+                                          (float_t)0.0,
+                                          (float_t)0.0);
+
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+//
+// The teapot slides sideways while the shutter is open, so the bounces after
+// the first only hit it where the immediate render does if the deferred
+// render traces them at the time of their sample.
+//
+
+TEST(TeapotTest, SmoothShadedTeapotWavefrontDeferredMatchesImmediateMotion)
+{
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapot(teapot_vertices,
+                 true,
+                 shapes,
+                 &triangles_allocated,
+                 &light_sampler);
+
+    PMATRIX translations[2];
+    ISTATUS status = MatrixAllocateTranslation((float_t)-0.25,
+                                               (float_t)0.0,
+                                               (float_t)0.0,
+                                               &translations[0]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    status = MatrixAllocateTranslation((float_t)0.25,
+                                       (float_t)0.0,
+                                       (float_t)0.0,
+                                       &translations[1]);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    std::vector<PMATRIX> transforms0(triangles_allocated, translations[0]);
+    std::vector<PMATRIX> transforms1(triangles_allocated, translations[1]);
+
+    PSCENE scene;
+    status = BvhMotionSceneAllocate(shapes,
+                                    transforms0.data(),
+                                    transforms1.data(),
+                                    triangles_allocated,
+                                    (float_t)0.0,
+                                    (float_t)1.0,
+                                    nullptr,
+                                    &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestWavefrontDeferredMatchesImmediate(scene,
+                                          light_sampler,
+                                          (float_t)0.0,
+                                          (float_t)1.0);
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    MatrixRelease(translations[0]);
+    MatrixRelease(translations[1]);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+static
+void
+TestMatteMaterial(
+    _In_ bool constant_inputs
+    )
+{
+    PREFLECTOR reflector;
+    CreateTeapotReflector(&reflector);
+
+    PREFLECTOR_TEXTURE texture;
+    ISTATUS status = ConstantReflectorTextureAllocate(reflector, &texture);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    if (!constant_inputs)
+    {
+        PREFLECTOR white;
+        status = UniformReflectorAllocate((float_t)1.0, &white);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        PREFLECTOR_TEXTURE white_texture;
+        status = ConstantReflectorTextureAllocate(white, &white_texture);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        PREFLECTOR_TEXTURE product;
+        status = ProductReflectorTextureAllocate(texture,
+                                                 white_texture,
+                                                 &product);
+        ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+        ReflectorRelease(white);
+        ReflectorTextureRelease(white_texture);
+        ReflectorTextureRelease(texture);
+        texture = product;
+    }
+
+    PMATERIAL material;
+    status = MatteMaterialAllocate(texture, nullptr, &material);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    PCBSDF bsdf;
+    EXPECT_EQ(constant_inputs, MaterialGetConstantBsdf(material, &bsdf));
+
+    PSHAPE shapes[TEAPOT_FACE_COUNT] = { nullptr };
+    size_t triangles_allocated;
+    PLIGHT_SAMPLER light_sampler;
+    CreateTeapotWithMaterial(teapot_vertices,
+                             true,
+                             material,
+                             shapes,
+                             &triangles_allocated,
+                             &light_sampler);
+
+    PSCENE scene;
+    status = BvhSceneAllocate(shapes,
+                              nullptr,
+                              nullptr,
+                              triangles_allocated,
+                              nullptr,
+                              &scene);
+    ASSERT_EQ(status, ISTATUS_SUCCESS);
+
+    TestRenderSingleThreaded(scene,
+                             light_sampler,
+                             "test_results/teapot_smooth.pfm");
+
+    ReleaseTeapot(shapes, triangles_allocated);
+    ReflectorRelease(reflector);
+    ReflectorTextureRelease(texture);
+    MaterialRelease(material);
+    SceneRelease(scene);
+    LightSamplerRelease(light_sampler);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotConstantMatte)
+{
+    TestMatteMaterial(true);
+}
+
+TEST(TeapotTest, SmoothShadedTeapotTexturedMatte)
+{
+    TestMatteMaterial(false);
 }
\ No newline at end of file
@@ -0,0 +1,305 @@
+/*++
+
+Copyright (c) 2021 Brad Weinberger
+
+Module Name:
+
+    texture_gradients.cc
+
+Abstract:
+
+    Integration tests which check the gradients returned by the float mipmap
+    against the values it returns.
+
+--*/
+
+#include "iris_physx_toolkit/mipmap.h"
+#include "googletest/include/gtest/gtest.h"
+
+//
+// Defines
+//
+
+#define TEXTURE_SIZE 8
+#define FINITE_DIFFERENCE_STEP ((float_t)1e-3)
+
+//
+// Static Functions
+//
+
+static
+void
+AllocateTestMipmap(
+    _In_ TEXTURE_FILTERING_ALGORITHM texture_filtering,
+    _Out_ PFLOAT_MIPMAP *mipmap
+    )
+{
+    float_t texels[TEXTURE_SIZE * TEXTURE_SIZE];
+    for (size_t y = 0; y < TEXTURE_SIZE; y++)
+    {
+        for (size_t x = 0; x < TEXTURE_SIZE; x++)
+        {
+            texels[y * TEXTURE_SIZE + x] =
+                (float_t)((x * 7 + y * 3) % 5) * (float_t)0.25;
+        }
+    }
+
+    ISTATUS status = FloatMipmapAllocateFromFloats(texels,
+                                                   TEXTURE_SIZE,
+                                                   TEXTURE_SIZE,
+                                                   texture_filtering,
+                                                   (float_t)16.0,
+                                                   WRAP_MODE_REPEAT,
+                                                   mipmap);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+}
+
+static
+void
+FilteredLookupWithGradient(
+    _In_ PCFLOAT_MIPMAP mipmap,
+    _In_ float_t s,
+    _In_ float_t t,
+    _In_ float_t footprint,
+    _Out_ float_t *value,
+    _Out_writes_(2) float_t gradient[2]
+    )
+{
+    ISTATUS status = FloatMipmapFilteredLookupWithGradient(mipmap,
+                                                           s,
+                                                           t,
+                                                           footprint,
+                                                           (float_t)0.0,
+                                                           (float_t)0.0,
+                                                           footprint,
+                                                           value,
+                                                           gradient);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+}
+
+//
+// The sample points avoid the texel centers of every level, where the
+// bilinear reconstruction is not differentiable.
+//
+
+static
+void
+TestGradientMatchesFiniteDifferences(
+    _In_ TEXTURE_FILTERING_ALGORITHM texture_filtering,
+    _In_ float_t footprint
+    )
+{
+    PFLOAT_MIPMAP mipmap;
+    AllocateTestMipmap(texture_filtering, &mipmap);
+
+    const float_t points[][2] = {
+        { (float_t)0.11, (float_t)0.37 },
+        { (float_t)0.43, (float_t)0.29 },
+        { (float_t)0.71, (float_t)0.83 },
+        { (float_t)0.97, (float_t)0.02 }
+    };
+
+    for (const float_t *point : points)
+    {
+        float_t value, gradient[2];
+        FilteredLookupWithGradient(mipmap,
+                                   point[0],
+                                   point[1],
+                                   footprint,
+                                   &value,
+                                   gradient);
+
+        float_t filtered_value;
+        ISTATUS status = FloatMipmapFilteredLookup(mipmap,
+                                                   point[0],
+                                                   point[1],
+                                                   footprint,
+                                                   (float_t)0.0,
+                                                   (float_t)0.0,
+                                                   footprint,
+                                                   &filtered_value);
+        ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+        if (texture_filtering == TEXTURE_FILTERING_ALGORITHM_TRILINEAR)
+        {
+            EXPECT_EQ(filtered_value, value);
+        }
+
+        float_t s_plus, s_minus, t_plus, t_minus, unused[2];
+        FilteredLookupWithGradient(mipmap,
+                                   point[0] + FINITE_DIFFERENCE_STEP,
+                                   point[1],
+                                   footprint,
+                                   &s_plus,
+                                   unused);
+        FilteredLookupWithGradient(mipmap,
+                                   point[0] - FINITE_DIFFERENCE_STEP,
+                                   point[1],
+                                   footprint,
+                                   &s_minus,
+                                   unused);
+        FilteredLookupWithGradient(mipmap,
+                                   point[0],
+                                   point[1] + FINITE_DIFFERENCE_STEP,
+                                   footprint,
+                                   &t_plus,
+                                   unused);
+        FilteredLookupWithGradient(mipmap,
+                                   point[0],
+                                   point[1] - FINITE_DIFFERENCE_STEP,
+                                   footprint,
+                                   &t_minus,
+                                   unused);
+
+        float_t dvalue_ds =
+            (s_plus - s_minus) / ((float_t)2.0 * FINITE_DIFFERENCE_STEP);
+        float_t dvalue_dt =
+            (t_plus - t_minus) / ((float_t)2.0 * FINITE_DIFFERENCE_STEP);
+
+        EXPECT_NEAR(dvalue_ds, gradient[0], (float_t)0.01);
+        EXPECT_NEAR(dvalue_dt, gradient[1], (float_t)0.01);
+    }
+
+    FloatMipmapFree(mipmap);
+}
+
+//
+// Tests
+//
+
+TEST(TextureGradients, MipmapLookupWithGradientErrors)
+{
+    PFLOAT_MIPMAP mipmap;
+    AllocateTestMipmap(TEXTURE_FILTERING_ALGORITHM_NONE, &mipmap);
+
+    float_t value, gradient[2];
+    ISTATUS status = FloatMipmapLookupWithGradient(nullptr,
+                                                   (float_t)0.5,
+                                                   (float_t)0.5,
+                                                   &value,
+                                                   gradient);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_00, status);
+
+    status = FloatMipmapLookupWithGradient(mipmap,
+                                           (float_t)0.5,
+                                           (float_t)0.5,
+                                           &value,
+                                           nullptr);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_04, status);
+
+    status = FloatMipmapFilteredLookupWithGradient(mipmap,
+                                                   (float_t)0.5,
+                                                   (float_t)0.5,
+                                                   (float_t)0.0,
+                                                   (float_t)0.0,
+                                                   (float_t)0.0,
+                                                   (float_t)0.0,
+                                                   &value,
+                                                   nullptr);
+    EXPECT_EQ(ISTATUS_INVALID_ARGUMENT_08, status);
+
+    FloatMipmapFree(mipmap);
+}
+
+TEST(TextureGradients, MipmapUnfilteredValueMatchesGradient)
+{
+    PFLOAT_MIPMAP mipmap;
+    AllocateTestMipmap(TEXTURE_FILTERING_ALGORITHM_NONE, &mipmap);
+
+    //
+    // Halfway between two texel centers the nearest lookup returns one of
+    // the texels while the bilinear reconstruction returns their average.
+    //
+
+    float_t s = (float_t)2.0 / (float_t)TEXTURE_SIZE;
+    float_t t = (float_t)2.5 / (float_t)TEXTURE_SIZE;
+
+    float_t value, gradient[2];
+    ISTATUS status = FloatMipmapLookupWithGradient(mipmap,
+                                                   s,
+                                                   t,
+                                                   &value,
+                                                   gradient);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    float_t texel0, texel1;
+    status = FloatMipmapTexelLookup(mipmap, 0, 1, 2, &texel0);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    status = FloatMipmapTexelLookup(mipmap, 0, 2, 2, &texel1);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+
+    EXPECT_NEAR((texel0 + texel1) * (float_t)0.5, value, (float_t)0.0001);
+    EXPECT_NEAR((texel1 - texel0) * (float_t)TEXTURE_SIZE,
+                gradient[0],
+                (float_t)0.0001);
+
+    FloatMipmapFree(mipmap);
+}
+
+TEST(TextureGradients, MipmapUnfiltered)
+{
+    TestGradientMatchesFiniteDifferences(TEXTURE_FILTERING_ALGORITHM_NONE,
+                                         (float_t)0.0);
+}
+
+TEST(TextureGradients, MipmapTrilinearFinestLevel)
+{
+    TestGradientMatchesFiniteDifferences(
+        TEXTURE_FILTERING_ALGORITHM_TRILINEAR,
+        (float_t)0.01);
+}
+
+TEST(TextureGradients, MipmapTrilinearBetweenLevels)
+{
+    TestGradientMatchesFiniteDifferences(
+        TEXTURE_FILTERING_ALGORITHM_TRILINEAR,
+        (float_t)0.3);
+}
+
+TEST(TextureGradients, MipmapEwa)
+{
+    PFLOAT_MIPMAP ewa_mipmap;
+    AllocateTestMipmap(TEXTURE_FILTERING_ALGORITHM_EWA, &ewa_mipmap);
+
+    PFLOAT_MIPMAP trilinear_mipmap;
+    AllocateTestMipmap(TEXTURE_FILTERING_ALGORITHM_TRILINEAR,
+                       &trilinear_mipmap);
+
+    float_t s = (float_t)0.43;
+    float_t t = (float_t)0.29;
+    float_t footprint = (float_t)0.3;
+
+    float_t ewa_value, ewa_gradient[2];
+    FilteredLookupWithGradient(ewa_mipmap,
+                               s,
+                               t,
+                               footprint,
+                               &ewa_value,
+                               ewa_gradient);
+
+    float_t filtered_value;
+    ISTATUS status = FloatMipmapFilteredLookup(ewa_mipmap,
+                                               s,
+                                               t,
+                                               footprint,
+                                               (float_t)0.0,
+                                               (float_t)0.0,
+                                               footprint,
+                                               &filtered_value);
+    ASSERT_EQ(ISTATUS_SUCCESS, status);
+    EXPECT_EQ(filtered_value, ewa_value);
+
+    float_t trilinear_value, trilinear_gradient[2];
+    FilteredLookupWithGradient(trilinear_mipmap,
+                               s,
+                               t,
+                               footprint,
+                               &trilinear_value,
+                               trilinear_gradient);
+    EXPECT_EQ(trilinear_gradient[0], ewa_gradient[0]);
+    EXPECT_EQ(trilinear_gradient[1], ewa_gradient[1]);
+
+    FloatMipmapFree(ewa_mipmap);
+    FloatMipmapFree(trilinear_mipmap);
+}